@@ -298,7 +298,7 @@ public abstract class BasicCPPProject : Project
 
     // Compiler options
     conf.Options.Add(Options.Vc.Compiler.SupportJustMyCode.No); // this adds a call to __CheckForDebuggerJustMyCode into every function that slows down runtime significantly
-    conf.Options.Add(Options.Vc.Compiler.CppLanguageStandard.CPP17);
+    conf.Options.Add(Options.Vc.Compiler.CppLanguageStandard.CPP20); // the task system uses coroutines, every project uses the same standard so they see the same engine headers
     conf.Options.Add(Options.Vc.Compiler.RTTI.Disable);
     conf.Options.Add(Options.Vc.Compiler.RuntimeChecks.Default);
     conf.Options.Add(Options.Vc.Compiler.FloatingPointModel.Fast);
@@ -55,6 +55,7 @@ namespace rex
         conf.AddProject<ProjectedFileSystem>(target);
         conf.AddProject<ConsoleApp>(target);
         conf.AddProject<BackupCreator>(target);
+        conf.AddProject<PakBuilder>(target);
       }
 
       conf.AddProject<PokemonProject>(target);
@@ -56,6 +56,7 @@ namespace rex
     void init_globals();
     void init_engine_globals(const BootSettings& bootSettings);
     void init_cmdline();
+    void enable_guard_allocator_for_tags(rsl::string_view memoryTags);
     void mount_engine_paths();
     void load_settings();
     void init_thread_pool();
@@ -6,6 +6,7 @@
 #include "rex_engine/serialization/serializer_base.h"
 #include "rex_engine/filesystem/vfs.h"
 #include "rex_engine/filesystem/path.h"
+#include "rex_engine/filesystem/path_id.h"
 
 #include "rex_std/bonus/algorithms.h"
 #include "rex_std/bonus/utility.h"
@@ -17,7 +18,7 @@ namespace rex
 	// Asset dependency tracking should not be done in asset DB
 	struct AssetMetaData
 	{
-		rsl::string path;
+		PathId path;
 		bool is_partially_loaded;
 	};
 
@@ -29,13 +30,20 @@ namespace rex
 		template <typename T>
 		T* load(rsl::string_view assetPath, LoadFlags loadFlags = LoadFlags::None)
 		{
-			if (path::extension(assetPath) == ".json")
+			return load<T>(asset_path_id(assetPath), loadFlags);
+		}
+		// Load an asset from disk, given the path id returned by asset_path_id
+		// Assets that are loaded often should keep their path id around, so their path doesn't need to be converted again
+		template <typename T>
+		T* load(PathId assetPath, LoadFlags loadFlags = LoadFlags::None)
+		{
+			if (path::extension(assetPath.string()) == ".json")
 			{
-				return load_from_json<T>(assetPath, loadFlags);
+				return static_cast<T*>(load_from_json(rsl::type_id<T>(), assetPath, loadFlags));
 			}
 			else
 			{
-				return load_from_binary<T>(assetPath, loadFlags);
+				return static_cast<T*>(load_from_binary(rsl::type_id<T>(), assetPath, loadFlags));
 			}
 		}
 
@@ -43,7 +51,7 @@ namespace rex
 		template <typename T>
 		void save(T* asset)
 		{
-			save(asset, m_asset_to_metadata.at(asset).path);
+			save(asset, m_asset_to_metadata.at(asset).path.string());
 		}
 
 		// Save an asset to a given filepath
@@ -74,39 +82,23 @@ namespace rex
 		void unload_all();
 
 		rsl::string_view asset_path(const Asset* asset);
+		// Returns the id the asset database uses for an asset at the given path
+		PathId asset_path_id(rsl::string_view assetPath) const;
 
 	private:
-		template <typename T>
-		T* load_from_json(rsl::string_view assetPath, LoadFlags loadFlags = LoadFlags::None)
-		{
-			scratch_string fullpath = rex::vfs::instance()->abs_path(assetPath);
-			fullpath.replace("\\", "/");
-			rsl::to_lower(fullpath.cbegin(), fullpath.begin(), fullpath.length());
-			return static_cast<T*>(load_from_json(rsl::type_id<T>(), fullpath, loadFlags));
-		}
-
-		template <typename T>
-		T* load_from_binary(rsl::string_view assetPath, LoadFlags loadFlags = LoadFlags::None)
-		{
-			scratch_string fullpath = rex::vfs::instance()->abs_path(assetPath);
-			fullpath.replace("\\", "/");
-			rsl::to_lower(fullpath.cbegin(), fullpath.begin(), fullpath.length());
-			return static_cast<T*>(load_from_binary(rsl::type_id<T>(), fullpath, loadFlags));
-		}
-
-		Asset* load_from_json(rsl::type_id_t assetTypeId, rsl::string_view assetPath, LoadFlags loadFlags);
-		Asset* load_from_binary(rsl::type_id_t assetTypeId, rsl::string_view assetPath, LoadFlags loadFlags);
-		Asset* lookup_cached_asset(rsl::string_view assetPath, LoadFlags loadFlags);
+		Asset* load_from_json(rsl::type_id_t assetTypeId, PathId assetPath, LoadFlags loadFlags);
+		Asset* load_from_binary(rsl::type_id_t assetTypeId, PathId assetPath, LoadFlags loadFlags);
+		Asset* lookup_cached_asset(PathId assetPath, LoadFlags loadFlags);
 
 		void serialize(rsl::type_id_t assetTypeId, Asset* asset, rsl::string_view assetPath);
 
 		void hydrate_asset(rsl::type_id_t assetTypeId, Asset* asset);
-		bool is_partially_loaded(rsl::string_view assetPath);
+		bool is_partially_loaded(PathId assetPath);
 		bool is_partially_loaded(const Asset* asset);
 
 	private:
 		rsl::unordered_map<rsl::string_view, rsl::unique_ptr<Serializer>> m_serializers;
-		rsl::unordered_map<rsl::string, rsl::unique_ptr<Asset>> m_path_to_asset;
+		rsl::unordered_map<PathId, rsl::unique_ptr<Asset>> m_path_to_asset;
 		rsl::unordered_map<const Asset*, AssetMetaData> m_asset_to_metadata;
 	};
 
@@ -4,10 +4,13 @@
 #include "rex_engine/engine/globals.h"
 
 #include "rex_engine/memory/global_allocators/global_allocator.h"
-#include "rex_engine/memory/allocators/circular_allocator.h"
-#include "rex_engine/memory/allocators/stack_allocator.h"
+#include "rex_engine/memory/allocators/virtual_circular_allocator.h"
+#include "rex_engine/memory/allocators/frame_allocator.h"
 
 #include "rex_std/bonus/string.h"
+#include "rex_std/mutex.h"
+#include "rex_std/thread.h"
+#include "rex_std/vector.h"
 
 namespace rex
 {
@@ -24,20 +27,33 @@ namespace rex
 		rsl::string current_session_root;
 	};
 
+	namespace internal
+	{
+		struct ThreadScratchArena;
+	}
+
 	class EngineGlobals
 	{
 	public:
-		using ScratchAllocator = TCircularAllocator<GlobalAllocator>;
-		using SingleFrameAllocator = TStackAllocator<GlobalAllocator>;
+		using ScratchAllocator = VirtualCircularAllocator;
+		using SingleFrameAllocator = FrameAllocator;
 
-		EngineGlobals(rsl::unique_ptr<ScratchAllocator> scratchAlloc, rsl::unique_ptr<SingleFrameAllocator> tempAlloc);
+		EngineGlobals(rsl::unique_ptr<ScratchAllocator> scratchAlloc, rsl::unique_ptr<SingleFrameAllocator> tempAlloc, s64 threadScratchReserveSize = g_thread_scratch_default_reserve_size);
+		EngineGlobals(const EngineGlobals&) = delete;
+		EngineGlobals(EngineGlobals&&) = delete;
+		~EngineGlobals();
+
+		EngineGlobals& operator=(const EngineGlobals&) = delete;
+		EngineGlobals& operator=(EngineGlobals&&) = delete;
 
 		void advance_frame();
 
+		// Scratch memory is allocated from an arena owned by the calling thread
+		// so it never needs to be synchronized with other threads
 		template <typename T>
 		T* scratch_alloc()
 		{
-			return m_scratch_allocator->allocate<T>();
+			return static_cast<T*>(scratch_alloc(sizeof(T)));
 		}
 		void* scratch_alloc(s64 size);
 		void* scratch_realloc(void* ptr, s64 size);
@@ -58,6 +74,18 @@ namespace rex
 
 		const FrameInfo& frame_info() const;
 
+		// Returns the allocator used for temp memory
+		// Jobs and GPU work using temp memory past the end of the frame need to be added to it
+		// so the memory of their frame isn't recycled while they're still using it
+		SingleFrameAllocator& single_frame_allocator();
+
+		// Returns the scratch arena of the calling thread
+		// The thread that created the engine globals uses the scratch allocator they were created with.
+		// Every other thread gets its own arena of the same size on its first scratch allocation.
+		// These arenas are owned by the engine globals, as their memory can still be in use after their thread exits.
+		// The arena of a thread that exits is handed to the next thread that needs one.
+		ScratchAllocator& scratch_allocator();
+
 		// Returns the current project's name
 		rsl::string_view project_name() const;
 
@@ -82,11 +110,29 @@ namespace rex
 		// Returns the root for all files outputed during this session run (eg. logs)
 		rsl::string_view current_session_root() const;
 
+	private:
+		friend struct internal::ThreadScratchArena;
+
+		// Returns an unused scratch arena for a thread, creating a new one if there's none
+		ScratchAllocator* acquire_thread_scratch_allocator();
+		// Give back the scratch arena of a thread that exits, its memory stays valid until it's handed to another thread
+		void release_thread_scratch_allocator(ScratchAllocator* allocator);
+
 	private:
 		// An allocator used for temp memory. deallocation isn't tracked. Memory may or may not last more than 1 frame
 		rsl::unique_ptr<ScratchAllocator> m_scratch_allocator;
-
-		// An allocator used for memory that's used within a single frame. It gets reset at the beginning of the frame
+		// The thread the scratch allocator above belongs to
+		rsl::thread::id m_scratch_allocator_thread_id;
+		// Unique for every engine globals created, so arenas of older engine globals are never used
+		card32 m_scratch_generation;
+		// The scratch arenas of all other threads, the ones of threads that exited are in the free list
+		rsl::vector<rsl::unique_ptr<ScratchAllocator>> m_thread_scratch_allocators;
+		rsl::vector<ScratchAllocator*> m_free_thread_scratch_allocators;
+		s64 m_thread_scratch_reserve_size;
+		mutable rsl::mutex m_thread_scratch_mutex;
+
+		// An allocator used for memory that's used within a single frame. Every thread has its own arena for every frame in flight
+		// a frame's arenas get reset once the frame's jobs and fences have finished
 		rsl::unique_ptr<SingleFrameAllocator> m_single_frame_allocator;
 
 		FrameInfo m_frame_info;
@@ -2,6 +2,7 @@
 
 #include "rex_engine/diagnostics/logging/log_macros.h"
 #include "rex_engine/diagnostics/error.h"
+#include "rex_engine/filesystem/mapped_file.h"
 #include "rex_engine/memory/blob.h"
 #include "rex_std/bonus/time/timepoint.h"
 #include "rex_std/bonus/utility/yes_no.h"
@@ -44,6 +45,8 @@ namespace rex
     memory::Blob read_file(rsl::string_view path);
     // Read from a file, returns number of bytes read
     s32 read_file(rsl::string_view path, rsl::byte* buffer, s64 size);
+    // Map a file into memory, the content stays valid as long as the mapped file is alive
+    MappedFile map_file(rsl::string_view path);
     // Save content to a file
     Error write_to_file(rsl::string_view filepath, const void* data, card64 size);
     // Append a single line to a file
@@ -87,6 +90,15 @@ namespace rex
     memory::Blob read_file_abspath(rsl::string_view path);
     // Read from a file, returns number of bytes read
     s32 read_file_abspath(rsl::string_view path, rsl::byte* buffer, s64 size);
+    // Read multiple files at once, the blobs are returned in the same order as the paths
+    // Platforms that support batched io read all files with as few syscalls as possible
+    rsl::vector<memory::Blob> read_files_abspath(const rsl::vector<rsl::string_view>& paths);
+    // Returns true if read_files_abspath reads the files of a batch together on the calling thread
+    // Returns false if it reads them one after the other
+    bool supports_batched_reads();
+    // Map a file into memory, the content stays valid as long as the mapped file is alive
+    // Empty files and files that can't be opened return a mapped file that doesn't view anything
+    MappedFile map_file_abspath(rsl::string_view path);
     // Save content to a file
     Error write_to_file_abspath(rsl::string_view filepath, const void* data, card64 size);
     // Append a single line to a file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "rex_engine/filesystem/path_id.h"
+#include "rex_engine/memory/blob.h"
+
 #include "rex_std/bonus/string.h"
 #include "rex_std/vector.h"
 #include "rex_std/mutex.h"
@@ -11,26 +14,40 @@ namespace rex
 {
 	class ReadRequest;
 
+	// A queued request is the vfs' side of reading a file asynchronously
+	// All read requests for the same file that come in while it's queued share it, so the file only gets read once
+	// It owns the content of the file, so it stays alive until every read request that uses it is gone
+	// Once the vfs closes it, it destroys itself when the last read request detaches from it
 	class QueuedRequest
 	{
 	public:
-		explicit QueuedRequest(rsl::string_view filepath);
+		explicit QueuedRequest(PathId filepath);
 
+		// Requests added after the file has been read get signaled immediately
 		void add_request_to_signal(ReadRequest* request);
+		// If the request is closed and this was the last read request using it, the request is destroyed
 		void remove_request_to_signal(ReadRequest* request);
 		void swap_request_to_signal(ReadRequest* original, ReadRequest* newRequest);
 
-		void signal_requests(const rsl::byte* buffer, rsl::memory_size size);
+		// Take ownership of the content of the file and signal all requests waiting on it
+		void signal_requests(memory::Blob&& content);
+
+		// Called by the vfs when it stops sharing the request, it passes ownership of the request to its read requests
+		// The request is destroyed immediately if no read requests are using it
+		void close();
 
-		bool all_requests_finished() const;
+		bool is_done() const;
 
 		rsl::string_view filepath() const;
+		PathId path_id() const;
 
 	private:
-		rsl::medium_stack_string m_filepath;
+		PathId m_filepath;
 		rsl::vector<ReadRequest*> m_requests;
-		rsl::mutex m_requests_access_mtx;
+		mutable rsl::mutex m_requests_access_mtx;
 		rsl::atomic<bool> m_is_done;
+		bool m_is_closed;
+		memory::Blob m_content;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "rex_engine/memory/blob.h"
+#include "rex_engine/memory/blob_view.h"
+
+#include "rex_std/bonus/memory.h"
+
+namespace rex
+{
+	// A read only view into the content of a file
+	// When possible the file is mapped into memory, so no copy of its content is made
+	// and pages are only loaded when they're first touched.
+	// If the file can't be mapped, the mapped file owns a copy of the content instead.
+	// The view returned by a mapped file is only valid as long as the mapped file itself is alive
+	//
+	// rex::MappedFile mapped_file = rex::vfs::instance()->map_file("path/to/file");
+	// rex::memory::BlobReader reader(mapped_file.view());
+	class MappedFile
+	{
+	public:
+		// Initialize a mapped file that doesn't view any file
+		MappedFile();
+		// Initialize a mapped file that owns a copy of the file content
+		explicit MappedFile(memory::Blob&& content);
+		// Initialize a mapped file that takes ownership of a memory mapping
+		// The native handle is whatever the platform needs to release the mapping, it can be null
+		MappedFile(const rsl::byte* data, rsl::memory_size size, void* nativeHandle);
+		// Initialize a mapped file that views a mapping owned by something else, eg. a file inside a mounted archive
+		// The mapping is not released when the mapped file is destroyed
+		explicit MappedFile(memory::BlobView mappedContent);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+
+		// Unmap the file or release the copied content
+		~MappedFile();
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		// Returns true if the mapped file views any content
+		explicit operator bool() const;
+
+		// Returns true if the content is mapped straight from the file
+		// Returns false if the mapped file holds a copy instead
+		bool is_mapped() const;
+
+		// Returns a view over the content of the file
+		memory::BlobView view() const;
+		// Returns a const access to the content of the file
+		const rsl::byte* data() const;
+		// Returns the size of the file
+		rsl::memory_size size() const;
+
+	private:
+		// Release the mapping or the copied content, leaving the mapped file empty
+		void reset();
+
+	private:
+		const rsl::byte* m_data;
+		rsl::memory_size m_size;
+		void* m_native_handle;
+		bool m_is_mapped;
+		bool m_owns_mapping;
+		memory::Blob m_content;
+	};
+
+	namespace file
+	{
+		namespace internal
+		{
+			// Release a mapping that was created by map_file_abspath
+			// This is implemented per platform
+			void unmap_file(const rsl::byte* data, rsl::memory_size size, void* nativeHandle);
+		}
+	}
+}
@@ -44,6 +44,9 @@ namespace rex
     // --------------------------------
     REX_NO_DISCARD memory::Blob read_file(rsl::string_view filepath) override;
     s32 read_file(rsl::string_view filepath, rsl::byte* buffer, s32 size) override;
+    REX_NO_DISCARD rsl::vector<memory::Blob> read_files(const rsl::vector<rsl::string_view>& filepaths) override;
+    bool supports_batched_reads() const override;
+    REX_NO_DISCARD MappedFile map_file(rsl::string_view filepath) override;
 
     // --------------------------------
     // WRITING
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "rex_engine/diagnostics/error.h"
+#include "rex_engine/engine/types.h"
+#include "rex_engine/filesystem/mapped_file.h"
+#include "rex_engine/memory/blob_view.h"
+#include "rex_std/bonus/attributes.h"
+#include "rex_std/string.h"
+#include "rex_std/string_view.h"
+#include "rex_std/vector.h"
+
+// A rexpak archive packs all files under a directory into a single file
+// so loading them doesn't need to open, stat and close every file on its own.
+//
+// The layout of an archive is as follows
+//
+// +-------------------+
+// | PakHeader         |
+// +-------------------+
+// | PakEntry[]        | table of contents, sorted by path hash
+// +-------------------+
+// | path names        | the relative paths of all entries, not null terminated
+// +-------------------+
+// | file data         | every file starts at a 64 byte aligned offset
+// +-------------------+
+//
+// The header, table of contents and path names are all at the front of the archive
+// so mounting an archive only touches a small, contiguous part of the file.
+
+namespace rex
+{
+  namespace pak
+  {
+    // The magic value every archive starts with, spells "RPAK"
+    inline constexpr u32 g_magic = 0x4B415052;
+    inline constexpr u32 g_version = 1;
+    // Every file in the archive starts at an offset that's a multiple of this
+    inline constexpr u64 g_entry_alignment = 64;
+    // The extension used for archive files
+    inline constexpr rsl::string_view g_extension = ".rexpak";
+
+    // Loose files on disk take priority over packed files during development
+    // so files can be iterated on without rebuilding the archives
+#ifdef REX_BUILD_RELEASE
+    inline constexpr bool g_loose_files_override_packed = false;
+#else
+    inline constexpr bool g_loose_files_override_packed = true;
+#endif
+
+    // How the data of an entry is stored in the archive
+    // Only uncompressed entries are supported at the moment
+    // the stored size is kept separate from the file size so compressed entries can be added later on
+    enum class Compression : u32
+    {
+      None = 0
+    };
+
+    struct PakHeader
+    {
+      u32 magic;
+      u32 version;
+      u32 num_entries;
+      u32 reserved;
+      u64 toc_offset;
+      u64 names_offset;
+      u64 names_size;
+      u64 data_offset;
+    };
+
+    struct PakEntry
+    {
+      u64 path_hash;     // hash of the normalized relative path
+      u64 data_offset;   // offset of the data from the start of the archive
+      u64 stored_size;   // size of the data in the archive
+      u64 size;          // size of the file once it's loaded
+      u32 name_offset;   // offset of the path from the start of the path names
+      u32 name_length;   // length of the path
+      Compression compression;
+      u32 reserved;
+    };
+
+    // Returns the hash used to look up a path in an archive
+    // Both kinds of seperators hash to the same value so paths are found regardless of the platform they're coming from
+    u64 hash_path(rsl::string_view path);
+    // Returns true if both paths are the same, ignoring the kind of seperators used
+    bool is_same_path(rsl::string_view lhs, rsl::string_view rhs);
+
+    // Pack all files under a directory into a single archive
+    // The paths in the archive are stored relative to the directory
+    Error build(rsl::string_view root, rsl::string_view outputPath);
+  } // namespace pak
+
+  // A mounted archive, the entire file is mapped into memory
+  // Files are looked up by their path relative to the directory the archive was built from
+  class PakArchive
+  {
+  public:
+    PakArchive();
+
+    // Map an archive into memory and validate its table of contents
+    Error open(rsl::string_view pakPath);
+
+    // Returns true if an archive is opened
+    bool is_open() const;
+
+    // Returns the entry for a relative path, returns null if the archive doesn't have the file
+    const pak::PakEntry* find(rsl::string_view path) const;
+    // Returns the relative path of an entry
+    rsl::string_view name(const pak::PakEntry& entry) const;
+    // Returns a view of the data of an entry, this view is valid as long as the archive is opened
+    memory::BlobView data(const pak::PakEntry& entry) const;
+
+    // Returns all entries of the archive
+    const pak::PakEntry* begin() const;
+    const pak::PakEntry* end() const;
+
+  private:
+    MappedFile m_mapped_file;
+    const pak::PakHeader* m_header;
+    const pak::PakEntry* m_entries;
+    rsl::string_view m_names;
+  };
+} // namespace rex
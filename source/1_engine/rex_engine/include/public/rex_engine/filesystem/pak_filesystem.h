@@ -0,0 +1,70 @@
+#pragma once
+
+#include "rex_engine/filesystem/native_filesystem.h"
+#include "rex_engine/filesystem/pak_archive.h"
+#include "rex_std/bonus/utility/yes_no.h"
+#include "rex_std/memory.h"
+#include "rex_std/string.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  DEFINE_YES_NO_ENUM(LooseFilesOverride);
+
+  // The pak filesystem reads files from packed archives mounted on top of the native filesystem
+  // Files that are not in any archive are read from disk, same as the native filesystem.
+  // When loose files override packed ones, a file on disk is always preferred over the same file in an archive
+  // this allows to iterate on files without rebuilding the archives.
+  // Files in an archive are never copied when they're mapped, as the entire archive is mapped when it gets mounted.
+  class PakFileSystem : public NativeFileSystem
+  {
+  public:
+    PakFileSystem(rsl::string_view root, LooseFilesOverride looseFilesOverride = pak::g_loose_files_override_packed ? LooseFilesOverride::yes : LooseFilesOverride::no);
+
+    // Mount a packed archive at a mounting point
+    // The archive is expected to be built from the directory the mounting point is mounted to
+    Error mount_pak(MountingPoint root, rsl::string_view pakPath) override;
+    // Mount a packed archive that was built from the given directory
+    Error mount_pak(rsl::string_view dir, rsl::string_view pakPath);
+
+    // --------------------------------
+    // READING
+    // --------------------------------
+    REX_NO_DISCARD memory::Blob read_file(rsl::string_view filepath) override;
+    s32 read_file(rsl::string_view filepath, rsl::byte* buffer, s32 size) override;
+    REX_NO_DISCARD rsl::vector<memory::Blob> read_files(const rsl::vector<rsl::string_view>& filepaths) override;
+    REX_NO_DISCARD MappedFile map_file(rsl::string_view filepath) override;
+
+    // --------------------------------
+    // QUERYING
+    // --------------------------------
+    bool is_directory(rsl::string_view path) const override;
+    bool is_file(rsl::string_view path) const override;
+    bool exists(rsl::string_view path) const override;
+
+    REX_NO_DISCARD rsl::vector<rsl::string> list_entries(rsl::string_view path, Recursive recursive) override;
+    REX_NO_DISCARD rsl::vector<rsl::string> list_dirs(rsl::string_view path) override;
+    REX_NO_DISCARD rsl::vector<rsl::string> list_files(rsl::string_view path) override;
+
+  private:
+    struct MountedPak
+    {
+      rsl::string dir; // the normalized absolute path of the directory the archive was built from
+      PakArchive archive;
+      rsl::vector<rsl::string_view> sorted_names; // the names of all packed files, sorted so directories can be looked up with a binary search
+    };
+
+    DEFINE_YES_NO_ENUM(ListFiles);
+    DEFINE_YES_NO_ENUM(ListDirs);
+
+    // Returns the data of a packed file, returns an empty view if the file isn't packed
+    // Loose files on disk take priority if they're allowed to override packed files
+    memory::BlobView find_packed_file(rsl::string_view path) const;
+    // Add the packed entries under a directory to the result, skipping entries that are already listed
+    void list_packed_entries(rsl::string_view path, Recursive recursive, ListFiles listFiles, ListDirs listDirs, rsl::vector<rsl::string>& outEntries) const;
+
+  private:
+    rsl::vector<rsl::unique_ptr<MountedPak>> m_mounted_paks;
+    LooseFilesOverride m_loose_files_override;
+  };
+} // namespace rex
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/bonus/functional.h"
+#include "rex_std/format.h"
+#include "rex_std/string_view.h"
+
+// A path id is an interned, normalized path with its hash precomputed
+// It's meant to be used as key for hash tables that are keyed by filepath
+// Creating a path id normalizes and hashes the path once, after which lookups with it
+// don't need to normalize, copy or rehash the path anymore.
+//
+// rex::PathId id = rex::PathId::create("path/to/../to/file.txt");
+// id.string(); // "path/to/file.txt"
+//
+// Paths that normalize to the same string share the same interned string
+// so comparing 2 path ids is a single pointer comparison.
+// The interned strings live until the end of the program, a path id is safe to copy and store anywhere.
+// Path ids don't convert paths to absolute paths, that's up to the caller.
+
+namespace rex
+{
+  namespace internal
+  {
+    class PathPool;
+  }
+
+  class PathId
+  {
+  public:
+    // Create an invalid path id
+    PathId();
+
+    // Normalize the path and intern it
+    // Redundant dots are removed and all seperators are converted to forward slashes
+    static PathId create(rsl::string_view path);
+
+    explicit operator bool() const;
+    bool is_valid() const;
+
+    // Returns the normalized path, this view stays valid until the end of the program
+    rsl::string_view string() const;
+    // Returns the precomputed hash of the normalized path
+    rsl::hash_result hash() const;
+
+    bool operator==(const PathId& other) const;
+    bool operator!=(const PathId& other) const;
+
+  private:
+    friend class internal::PathPool;
+    PathId(rsl::hash_result hash, rsl::string_view path);
+
+  private:
+    rsl::hash_result m_hash;
+    rsl::string_view m_path;
+  };
+} // namespace rex
+
+// custom specialization of rsl::hash can be injected in namespace rsl
+namespace rsl
+{
+  inline namespace v1
+  {
+    //-------------------------------------------------------------------------
+    template <>
+    struct hash<rex::PathId>
+    {
+      rsl::hash_result operator()(const rex::PathId& pathId) const noexcept
+      {
+        return pathId.hash();
+      }
+    };
+
+    //-------------------------------------------------------------------------
+    template <>
+    struct rsl::formatter<rex::PathId>
+    {
+      constexpr auto parse(format_parse_context& ctx) // NOLINT (readability-convert-member-functions-to-static)
+      {
+        return ctx.begin();
+      }
+
+      template <typename FormatContext>
+      auto format(const rex::PathId& pathId, FormatContext& ctx)
+      {
+        return rsl::format_to(ctx.out(), "{}", pathId.string());
+      }
+    };
+  } // namespace v1
+} // namespace rsl
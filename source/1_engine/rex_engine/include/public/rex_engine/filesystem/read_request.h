@@ -1,6 +1,10 @@
 #pragma once
 
+#include "rex_engine/threading/spin_lock.h"
+
+#include "rex_std/atomic.h"
 #include "rex_std/string_view.h"
+#include "rex_std/functional.h"
 #include "rex_std/memory.h"
 #include "rex_std/bonus/memory.h"
 
@@ -23,6 +27,14 @@ namespace rex
 		void signal(const rsl::byte* buffer, rsl::memory_size size);
 		void wait() const;
 
+		// Returns true if the request has finished reading
+		bool is_done() const;
+		// Call the callable when the request has finished reading
+		// If it's already done, the callable is called immediately
+		// Otherwise it's called on the io worker that read the file, so it should hand off any heavy work
+		// The callable must not copy, move or destroy the request itself, nor request to read any files
+		void when_done(rsl::function<void()>&& callback);
+
 		const rsl::byte* data() const;
 		rsl::memory_size count() const;
 
@@ -31,8 +43,10 @@ namespace rex
 	private:
 		rsl::string_view m_filepath;
 		QueuedRequest* m_queued_request;
-		bool m_is_done;
+		rsl::atomic<bool> m_is_done;
 		const rsl::byte* m_buffer;
 		rsl::memory_size m_size;
+		rsl::function<void()> m_on_done;
+		SpinLock m_on_done_lock;
 	};
 }
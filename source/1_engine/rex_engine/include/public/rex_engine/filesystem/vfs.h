@@ -4,7 +4,10 @@
 #include "rex_engine/engine/state_controller.h"
 #include "rex_engine/filesystem/mounting_point.h"
 #include "rex_engine/filesystem/directory.h"
+#include "rex_engine/filesystem/mapped_file.h"
+#include "rex_engine/filesystem/path_id.h"
 #include "rex_engine/filesystem/read_request.h"
+#include "rex_engine/filesystem/vfs_constants.h"
 #include "rex_engine/filesystem/go_recursive_enum.h"
 #include "rex_engine/diagnostics/error.h"
 #include "rex_engine/memory/blob.h"
@@ -14,6 +17,8 @@
 #include "rex_std/bonus/string.h"
 #include "rex_std/bonus/types.h"
 #include "rex_std/bonus/utility/yes_no.h"
+#include "rex_std/condition_variable.h"
+#include "rex_std/mutex.h"
 #include "rex_std/string_view.h"
 #include "rex_std/thread.h"
 
@@ -28,6 +33,10 @@
 /// File Reading:
 // rex::memory::Blob content = rex::vfs::instance()->read_file("path/to/file");
 ///
+/// File Mapping (read only, no copy of the content is made):
+// rex::MappedFile mapped_file = rex::vfs::instance()->map_file("path/to/file");
+// rex::memory::BlobView content = mapped_file.view();
+///
 /// File Writing:
 // int x = 0;
 // rex::vfs::instance()->write_to_file("path/to/file.txt", &x, sizeof(x);
@@ -37,7 +46,7 @@
 /// We only support async file reading, as async file writing
 /// Doesn't make much sense for the moment
 ///
-// rex::vfs::instance()->ReadRequest read_request = rex::vfs::instance()->read_file_async("path/to/file");
+// rex::vfs::instance()->ReadRequest read_request = rex::vfs::instance()->read_file_async(rex::MountingPoint::EngineRoot, "path/to/file");
 ///
 /// Do some code ..
 ///
@@ -49,6 +58,9 @@
 ///
 /// Do something with the content
 /// ..
+///
+/// Or get called back on the io worker once the data is read
+// read_request.when_done([]() { ... });
 
 namespace rex
 {
@@ -76,6 +88,20 @@ namespace rex
 
     // Mounts a new point to a path
     void mount(MountingPoint root, rsl::string_view path);
+    // Returns the absolute path a mounting point is mounted to
+    rsl::string_view mounted_path(MountingPoint root) const;
+    // Mount a packed archive at a mounting point
+    // The archive is expected to be built from the directory the mounting point is mounted to
+    // Filesystems that don't support archives return an error
+    virtual Error mount_pak(MountingPoint root, rsl::string_view pakPath);
+
+    // Set the number of io workers that read files for async read requests
+    // The workers start on the first async read request, this needs to be called before that
+    void set_num_io_workers(s32 numIoWorkers);
+    s32 num_io_workers() const;
+    // Finish all queued async read requests and join the io workers
+    // This needs to be called before the filesystem gets destroyed, as the workers read files through it
+    void stop_io_workers();
 
     // --------------------------------
     // CREATING
@@ -103,11 +129,24 @@ namespace rex
     // --------------------------------
     REX_NO_DISCARD memory::Blob read_file(MountingPoint root, rsl::string_view filepath)           ;
     s32 read_file(MountingPoint root, rsl::string_view filepath, rsl::byte* buffer, s32 size)      ;
+    // The path id of a file read through a mounting point is cached, so reading it again doesn't build its full path anymore
     REX_NO_DISCARD ReadRequest read_file_async(MountingPoint root, rsl::string_view filepath)      ;
-    REX_NO_DISCARD ReadRequest read_file_async(rsl::string_view filepath)                          ;
+    // The path id is expected to be created from an absolute path
+    // Create it where the reference to the file is loaded, so reading the file doesn't rehash the path
+    REX_NO_DISCARD ReadRequest read_file_async(PathId filepath);
 
     REX_NO_DISCARD virtual memory::Blob read_file(rsl::string_view filepath)                               = 0;
     virtual s32 read_file(rsl::string_view filepath, rsl::byte* buffer, s32 size)                          = 0;
+    // Read multiple files at once, the blobs are returned in the same order as the paths
+    // By default the files are read one after the other, filesystems that can batch reads override this
+    REX_NO_DISCARD virtual rsl::vector<memory::Blob> read_files(const rsl::vector<rsl::string_view>& filepaths);
+    // Returns true if read_files reads the files together on the calling thread, instead of one after the other
+    // The io workers only take batches of requests from filesystems that read them together
+    virtual bool supports_batched_reads() const;
+    // Map a file into memory, avoiding a copy of its content
+    // By default the file is read into a buffer owned by the mapped file, filesystems that can map files override this
+    REX_NO_DISCARD MappedFile map_file(MountingPoint root, rsl::string_view filepath);
+    REX_NO_DISCARD virtual MappedFile map_file(rsl::string_view filepath);
 
     // --------------------------------
     // WRITING
@@ -151,6 +190,16 @@ namespace rex
   protected:
     rsl::string_view no_mount_path() const;
 
+  private:
+    // Start the io workers, needs to be called with the read request mutex locked
+    void start_io_workers();
+    // The loop of an io worker, reading the queued requests in the order they came in
+    void process_read_requests();
+    // Stop sharing a request that got read, new requests for the file read it again
+    void close_request(QueuedRequest* queuedRequest);
+    // Return the path id of the full path of a file under a mounting point, creating it on first use
+    PathId mounted_path_id(MountingPoint root, rsl::string_view filepath);
+
   private:
     // Root paths used by the VFS
     rsl::medium_stack_string m_root; // This the root where all relative paths will start from
@@ -160,19 +209,30 @@ namespace rex
 
     // mutices for the asyncronous operation of the vfs
     rsl::mutex m_read_request_mutex;
-    rsl::mutex m_closed_request_mutex;
+
+    // signaled when a request is queued or the io workers need to stop
+    rsl::condition_variable m_read_request_cv;
 
     // queues the vfs uses for its async operations
-    rsl::vector<rsl::string_view> m_read_requests_in_order;
-    rsl::unordered_map<rsl::string, rsl::unique_ptr<QueuedRequest>> m_queued_requests;
-    rsl::vector<rsl::unique_ptr<QueuedRequest>> m_closed_requests;
+    rsl::vector<QueuedRequest*> m_read_requests_in_order;
+    rsl::unordered_map<PathId, rsl::unique_ptr<QueuedRequest>> m_queued_requests;
 
     // mounted roots
     rsl::unordered_map<MountingPoint, rsl::string> m_mounted_roots;
 
+    // The path ids of the files read asynchronously through a mounting point, keyed by their path relative to the mount
+    struct MountedPathId
+    {
+      rsl::unique_ptr<rsl::string> relative_path; // the key views into this, it's heap allocated so it never moves
+      PathId fullpath;
+    };
+    rsl::mutex m_mounted_path_ids_mutex;
+    rsl::unordered_map<MountingPoint, rsl::unordered_map<rsl::string_view, MountedPathId>> m_mounted_path_ids;
+
     // threads used by the vfs to perform the async operations
-    rsl::thread m_reading_thread;
-    rsl::thread m_closing_thread;
+    rsl::vector<rsl::thread> m_io_workers;
+    s32 m_num_io_workers;
+    bool m_is_stopping_io_workers;
   };
 
   namespace vfs
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+
+// Settings of the vfs that other systems need to know about, without having to pull in the whole vfs
+
+namespace rex
+{
+  // The number of threads reading files for async read requests
+#ifdef REX_VFS_NUM_IO_WORKERS
+  inline constexpr s32 g_vfs_default_num_io_workers = REX_VFS_NUM_IO_WORKERS;
+#else
+  inline constexpr s32 g_vfs_default_num_io_workers = 2;
+#endif
+
+  // The max number of queued requests an io worker reads together
+  // Only filesystems that support batched reads get batches, they read all of them with as few syscalls as possible
+#ifdef REX_VFS_MAX_READ_BATCH_SIZE
+  inline constexpr s32 g_vfs_max_read_batch_size = REX_VFS_MAX_READ_BATCH_SIZE;
+#else
+  inline constexpr s32 g_vfs_max_read_batch_size = 32;
+#endif
+} // namespace rex
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rex_engine/engine/globals.h"
+#include "rex_engine/filesystem/path_id.h"
 #include "rex_engine/gfx/resources/shader.h"
 #include "rex_engine/gfx/system/shader_type.h"
 
@@ -16,8 +17,9 @@ namespace rex
 		class ShaderLibrary
 		{
 		public:
-			// Load a shader from the cache, given a filepath and shader type
-			Shader* load(rsl::string_view path, ShaderType type);
+			// Load a shader from the cache, given the path id of its absolute path and shader type
+			// Create the path id where the reference to the shader is loaded, so loading it again doesn't rehash the path
+			Shader* load(PathId pathId, ShaderType type);
 			// Load a shader from the cache, given a shader name
 			Shader* load(rsl::string_view name);
 
@@ -28,6 +30,8 @@ namespace rex
 
 		private:
 			rsl::unordered_map<rsl::tiny_stack_string, rsl::unique_ptr<Shader>> m_shader_map;
+			// Shaders that got loaded from a path, so loading them again doesn't have to check the path on disk
+			rsl::unordered_map<PathId, Shader*> m_path_to_shader;
 		};
 
 		namespace shader_lib
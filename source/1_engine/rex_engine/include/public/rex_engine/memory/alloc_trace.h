@@ -0,0 +1,100 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/memory/memory_tags.h"
+#include "rex_engine/memory/memory_types.h"
+
+#include "rex_std/string_view.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  class MemoryHeader;
+
+  namespace alloc_trace
+  {
+    enum class AllocTraceOp : u8
+    {
+      Alloc,
+      Free
+    };
+
+    // A single allocation or free, as it's stored in a trace file
+    // Pointers aren't stored, every allocation gets an id instead, which its free refers to
+    struct AllocTraceRecord
+    {
+      u32 size;        // the size of the allocation, also stored for a free
+      u32 ptr_id;      // the id of the allocation, starting at 1
+      u32 frame_idx;   // the frame the allocation or free happened in
+      u16 thread_idx;  // the thread the allocation or free happened on, in the order threads first allocated
+      AllocTraceOp op;
+      u8 tag;          // the memory tag of the allocation
+    };
+    static_assert(sizeof(AllocTraceRecord) == 16, "Alloc trace records are expected to be 16 bytes, changing this breaks existing traces");
+
+    // A trace file starts with this header, followed by all the records
+    struct AllocTraceFileHeader
+    {
+      u32 magic;
+      u32 version;
+      u32 record_size;
+      u32 reserved;
+    };
+
+    inline constexpr u32 g_alloc_trace_magic = 0x54415852; // RXAT
+    inline constexpr u32 g_alloc_trace_version = 1;
+    inline constexpr rsl::string_view g_alloc_trace_filename = "alloc_trace.rexalloc";
+
+    // Buffers records and writes them to a trace file in chunks
+    // The writer isn't thread safe, the recorder makes sure only one thread writes at a time
+    class AllocTraceWriter
+    {
+    public:
+      explicit AllocTraceWriter(rsl::string_view filepath);
+      AllocTraceWriter(const AllocTraceWriter&) = delete;
+      AllocTraceWriter(AllocTraceWriter&&) = delete;
+      ~AllocTraceWriter();
+
+      AllocTraceWriter& operator=(const AllocTraceWriter&) = delete;
+      AllocTraceWriter& operator=(AllocTraceWriter&&) = delete;
+
+      void write(const AllocTraceRecord& record);
+      // Write all buffered records to the file
+      void flush();
+
+      s64 num_records_written() const;
+      rsl::string_view filepath() const;
+
+    private:
+      debug_string m_filepath;
+      debug_vector<AllocTraceRecord> m_records;
+      s64 m_num_records_written;
+    };
+
+    // A trace loaded from disk
+    struct AllocTrace
+    {
+      debug_vector<AllocTraceRecord> records;
+      // The highest allocation id in the trace, useful to size lookup tables during replay
+      u32 max_ptr_id;
+    };
+
+    // Start recording every tracked allocation and free to the given file
+    // Only allocations made after recording started are recorded, frees of older allocations are skipped
+    // Recording requires memory tracking to be enabled
+    void start_recording(rsl::string_view filepath);
+    // Stop recording, writing all records that are still buffered
+    void stop_recording();
+    bool is_recording();
+
+    // Load a trace written by the recorder, returns an empty trace if the file isn't a valid trace
+    AllocTrace load_trace(rsl::string_view filepath);
+
+    namespace internal
+    {
+      // Called by the memory tracker for every tracked allocation and free
+      void record_alloc(MemoryHeader* header);
+      void record_free(MemoryHeader* header);
+    } // namespace internal
+  } // namespace alloc_trace
+} // namespace rex
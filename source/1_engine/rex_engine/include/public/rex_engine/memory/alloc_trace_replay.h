@@ -0,0 +1,95 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/memory/alloc_trace.h"
+#include "rex_engine/memory/memory_types.h"
+
+#include "rex_std/algorithm.h"
+
+namespace rex
+{
+  namespace alloc_trace
+  {
+    struct AllocTraceReplayResult
+    {
+      s64 num_allocations;          // the number of allocations replayed
+      s64 num_frees;                // the number of frees replayed
+      s64 num_failed_allocations;   // the number of allocations the allocator returned nullptr for
+      s64 num_skipped_frees;        // frees of allocations that weren't part of the trace or failed to allocate
+      s64 peak_live_bytes;          // the highest number of bytes that were allocated at the same time, as requested by the trace
+      s64 num_leaked_allocations;   // allocations that weren't freed by the end of the trace, these are freed by the replay
+    };
+
+    // Replay a recorded trace by calling allocFunc(size) for every allocation and freeFunc(ptr, size) for every free
+    // The allocations and frees happen in the order they were recorded, on the calling thread.
+    // Allocations that are still alive at the end of the trace are freed as well, so the allocator ends up empty
+    template <typename AllocFunc, typename FreeFunc>
+    AllocTraceReplayResult replay_trace(const AllocTrace& trace, AllocFunc&& allocFunc, FreeFunc&& freeFunc)
+    {
+      AllocTraceReplayResult result{};
+
+      // Allocation ids are handed out sequentially, so they're used to index the live pointers directly
+      debug_vector<void*> live_ptrs;
+      live_ptrs.resize(static_cast<count_t>(trace.max_ptr_id) + 1, nullptr);
+      debug_vector<u32> live_sizes;
+      live_sizes.resize(static_cast<count_t>(trace.max_ptr_id) + 1, 0);
+
+      s64 live_bytes = 0;
+      for (const AllocTraceRecord& record : trace.records)
+      {
+        if (record.op == AllocTraceOp::Alloc)
+        {
+          ++result.num_allocations;
+          void* ptr = allocFunc(static_cast<s64>(record.size));
+          if (ptr == nullptr)
+          {
+            ++result.num_failed_allocations;
+            continue;
+          }
+
+          live_ptrs[record.ptr_id] = ptr;
+          live_sizes[record.ptr_id] = record.size;
+          live_bytes += record.size;
+          result.peak_live_bytes = rsl::max(result.peak_live_bytes, live_bytes);
+        }
+        else
+        {
+          void* ptr = live_ptrs[record.ptr_id];
+          if (ptr == nullptr)
+          {
+            ++result.num_skipped_frees;
+            continue;
+          }
+
+          ++result.num_frees;
+          freeFunc(ptr, static_cast<s64>(live_sizes[record.ptr_id]));
+          live_ptrs[record.ptr_id] = nullptr;
+          live_bytes -= live_sizes[record.ptr_id];
+        }
+      }
+
+      // The trace can stop while allocations are still alive, return them so the allocator can be reused
+      for (count_t id = 0; id < live_ptrs.size(); ++id)
+      {
+        if (live_ptrs[id] != nullptr)
+        {
+          ++result.num_leaked_allocations;
+          freeFunc(live_ptrs[id], static_cast<s64>(live_sizes[id]));
+        }
+      }
+
+      return result;
+    }
+
+    // Replay a recorded trace on an allocator, using its allocate(size) and deallocate(ptr, size) functions
+    template <typename Allocator>
+    AllocTraceReplayResult replay_trace(const AllocTrace& trace, Allocator& allocator)
+    {
+      using size_type = typename Allocator::size_type;
+      return replay_trace(
+        trace,
+        [&allocator](s64 size) { return allocator.allocate(static_cast<size_type>(size)); },
+        [&allocator](void* ptr, s64 size) { allocator.deallocate(ptr, static_cast<size_type>(size)); });
+    }
+  } // namespace alloc_trace
+} // namespace rex
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/diagnostics/stacktrace.h"
+#include "rex_engine/memory/memory_tags.h"
+#include "rex_engine/memory/memory_types.h"
+
+#include "rex_std/array.h"
+#include "rex_std/atomic.h"
+#include "rex_std/bonus/utility/enum_reflection.h"
+#include "rex_std/mutex.h"
+#include "rex_std/string_view.h"
+
+namespace rex
+{
+  // The average number of bytes allocated between 2 samples, 0 disables sampling
+#ifdef REX_ALLOC_SAMPLER_DEFAULT_SAMPLE_RATE
+  inline constexpr s64 g_default_alloc_sample_rate = REX_ALLOC_SAMPLER_DEFAULT_SAMPLE_RATE;
+#else
+  inline constexpr s64 g_default_alloc_sample_rate = 0;
+#endif
+
+  inline constexpr rsl::string_view g_alloc_samples_filename = "alloc_samples.folded";
+
+  // The sampled allocations of a single callstack
+  // Every sample stands for the bytes allocated since the previous sample, so the bytes are an estimate of all bytes allocated by the callstack
+  struct AllocationSample
+  {
+    using BytesPerTag = rsl::array<s64, rsl::enum_refl::enum_count<MemoryTag>()>;
+    using SamplesPerTag = rsl::array<s32, rsl::enum_refl::enum_count<MemoryTag>()>;
+
+    BytesPerTag estimated_bytes_per_tag;
+    SamplesPerTag num_samples_per_tag;
+  };
+
+  struct AllocationSamplerStats
+  {
+    s64 num_samples;        // the number of allocations that got sampled
+    s64 estimated_bytes;    // the estimated number of bytes allocated since sampling started
+    s32 num_callstacks;     // the number of unique callstacks that got sampled
+  };
+
+  // The allocation sampler captures the callstack of roughly one allocation per sample rate bytes
+  // Every thread counts down the bytes it allocates and takes a sample when its counter runs out
+  // after which the counter restarts at a random distance around the sample rate, so allocations that repeat in a pattern don't all get skipped.
+  // An allocation that isn't sampled only costs a subtraction, which makes the sampler cheap enough to leave enabled
+  // The samples are aggregated by callstack and memory tag and can be exported as folded stacks, to be turned into a flamegraph
+  class AllocationSampler
+  {
+  public:
+    AllocationSampler();
+    AllocationSampler(const AllocationSampler&) = delete;
+    AllocationSampler(AllocationSampler&&) = delete;
+    ~AllocationSampler() = default;
+
+    AllocationSampler& operator=(const AllocationSampler&) = delete;
+    AllocationSampler& operator=(AllocationSampler&&) = delete;
+
+    // Sample roughly one allocation per given number of bytes, 0 disables sampling
+    void set_sample_rate(s64 bytesPerSample);
+    s64 sample_rate() const;
+    bool is_enabled() const;
+
+    // Called for every allocation, takes a sample if the calling thread allocated enough bytes since its last sample
+    void on_allocation(s64 size);
+
+    AllocationSamplerStats stats();
+    // Return a copy of the samples of every callstack
+    debug_hash_map<CallStack, AllocationSample> samples();
+    // Remove all samples taken so far
+    void clear();
+
+    // Write the samples to a file as folded stacks, one line per memory tag and callstack
+    // A line lists the memory tag, followed by the callstack from outermost to innermost function, separated by semicolons
+    // and ends with the estimated number of bytes
+    void export_folded_stacks(rsl::string_view filepath);
+
+  private:
+    void take_sample(s64 size);
+
+  private:
+    rsl::atomic<s64> m_sample_rate;
+    // Threads that started counting down for a different sample rate or a different sampler restart their countdown
+    // Generations are unique across all samplers, so a countdown is never reused by another sampler
+    rsl::atomic<card32> m_sample_rate_generation;
+    debug_hash_map<CallStack, AllocationSample> m_samples;
+    s64 m_num_samples;
+    s64 m_estimated_bytes;
+    rsl::mutex m_samples_mutex;
+  };
+
+  // The allocation sampler needs to exist before the first allocation, so like the memory tracker, it's not a regular global
+  AllocationSampler& alloc_sampler();
+} // namespace rex
@@ -2,60 +2,67 @@
 
 #include "rex_engine/engine/types.h"
 #include "rex_engine/engine/defines.h"
+#include "rex_engine/diagnostics/assert.h"
 
 #include "rex_engine/memory/global_allocators/global_allocator.h"
 #include "rex_engine/memory/alloc_unique.h"
+#include "rex_engine/memory/pointer_math.h"
 
+#include "rex_std/array.h"
+#include "rex_std/algorithm.h"
 #include "rex_std/memory.h"
 
 namespace rex
 {
 	namespace internal
 	{
-		struct BuddyBlockHeader
+		// A free block links itself in the free list of its order, using the memory of the block itself
+		struct BuddyFreeBlock
 		{
-			s32 size;
-			BuddyBlockHeader* next;
+			BuddyFreeBlock* prev;
+			BuddyFreeBlock* next;
 		};
+
+		// The state of a block, stored for every block of the minimum size in a side table
+		// Only the entry of the first min block of a block is valid, the others are stale
+		// the high bit is set if the block is free, the other bits hold the order of the block
+		inline constexpr u8 g_buddy_block_free_bit = 0x80;
+		inline constexpr u8 g_buddy_block_order_mask = 0x7F;
 	}
 
+#ifdef REX_BUDDY_ALLOCATOR_MIN_BLOCK_SIZE
+	inline constexpr s64 g_buddy_allocator_min_block_size = REX_BUDDY_ALLOCATOR_MIN_BLOCK_SIZE;
+#else
+	inline constexpr s64 g_buddy_allocator_min_block_size = 32;
+#endif
+
+#ifdef REX_BUDDY_ALLOCATOR_MAX_ALIGNMENT
+	inline constexpr s64 g_buddy_allocator_max_alignment = REX_BUDDY_ALLOCATOR_MAX_ALIGNMENT;
+#else
+	inline constexpr s64 g_buddy_allocator_max_alignment = 256;
+#endif
+
 	//
-	// A buddy allocator is similar to a block allocator but it allows to split a block into smaller blocks. 
-	// This has a performance hit but reduces memory wastage if allocations come in of different sizes
-	// In the beginning, only 1 memory block is allocated of the size of the entire buffer.
-	// This block gets split over time into smaller blocks
-	//   +-------------------------------------------------------------------------------------------------------------------------+
-	//   |    +--------------------------------------------------------------------------------------------------------------+     |
-	//   |    |                                                                                                              |		 |
-	//   |    |                                                                                                              |		 |
-	//   |    |                                                   Block                                                      |		 |
-	//   |    |                                                                                                              |		 |
-	//   |    |                                                                                                              |		 |
-	//   |    +--------------------------------------------------------------------------------------------------------------+     |
-	//   +-------------------------------------------------------------------------------------------------------------------------+
+	// A buddy allocator splits its buffer into blocks that are all a power of 2 in size.
+	// An allocation is served from the smallest block it fits in. If there's no free block of that size
+	// a bigger block gets split in 2 halves, its buddies, until a block of the right size is created.
+	// When a block is freed and its buddy is free as well, they're merged back into the bigger block they came from
+	// so memory doesn't fragment over time.
 	//
-	//   +-------------------------------------------------------------------------------------------------------------------------+
-	//   |    +--------------+				+--------------------------------------+				+--------------------------------------+     |
-	//   |    |              |				|                                      |				|                                      |		 |
-	//   |    |              |				|                                      |				|                                      |		 |
-	//   |    |    Block     |  --> 	|                 Block                |  --> 	|                 Block                |		 |
-	//   |    |              |				|                                      |				|                                      |		 |
-	//   |    |              |				|                                      |				|                                      |		 |
-	//   |    +--------------+				+--------------------------------------+				+--------------------------------------+     |
-	//   +-------------------------------------------------------------------------------------------------------------------------+
+	//   +-----------------------------------------------------------------------------------------------------------------+
+	//   |                                                   Order 3                                                       |
+	//   +--------------------------------------------------------+--------------------------------------------------------+
+	//   |                       Order 2                          |                       Order 2                          |
+	//   +----------------------------+---------------------------+--------------------------------------------------------+
+	//   |          Order 1           |          Order 1          |
+	//   +-------------+--------------+---------------------------+
+	//   |   Order 0   |   Order 0    |
+	//   +-------------+--------------+
 	//
-	//   +-------------------------------------------------------------------------------------------------------------------------+
-	//   |    +--------------+				+--------------+				+--------------+				+--------------+				+--------------+     |
-	//   |    |              |				|              |				|              |				|              |				|              |		 |
-	//   |    |              |				|              |				|              |				|              |				|              |		 |
-	//   |    |    Block     |  --> 	|    Block     |  --> 	|    Block     |  --> 	|    Block     |  --> 	|    Block     |		 |
-	//   |    |              |				|              |				|              |				|              |				|              |		 |
-	//   |    |              |				|              |				|              |				|              |				|              |		 |
-	//   |    +--------------+				+--------------+				+--------------+				+--------------+				+--------------+		 |
-	//   +-------------------------------------------------------------------------------------------------------------------------+
+	// Every order has its own free list, so allocating and freeing only needs to walk the orders, which is O(log n).
+	// Blocks are aligned to their own size, which is used to support alignment as well.
+	// The order of every block is stored in a side table, so no header is needed in front of an allocation.
 	//
-
-
 	template <typename BackendAllocator>
 	class TBuddyAllocator
 	{
@@ -63,43 +70,71 @@ namespace rex
 		using size_type = s64;
 		using pointer = void*;
 
+		// The usable size is the given size rounded down to a power of 2
 		explicit TBuddyAllocator(size_type size, BackendAllocator alloc = BackendAllocator())
+			: m_capacity(round_down_to_power_of_2(size))
+			, m_base(nullptr)
+			, m_num_orders(0)
+			, m_free_lists()
 		{
-			m_buffer = alloc_unique<rsl::byte[]>(alloc, size);
-			m_head = reinterpret_cast<internal::BuddyBlockHeader*>(m_buffer.get());
-			m_head->size = static_cast<s32>(m_buffer.count() - sizeof(internal::BuddyBlockHeader));
-			m_head->next = nullptr;
+			REX_ASSERT_X(m_capacity >= g_buddy_allocator_min_block_size, "Buddy allocator size too small. size: {} min block size: {}", size, g_buddy_allocator_min_block_size);
+
+			// Over allocate a bit so the blocks can be aligned to the max alignment supported
+			m_buffer = alloc_unique<rsl::byte[]>(alloc, m_capacity + max_alignment());
+			m_base = align(m_buffer.get(), static_cast<card32>(max_alignment()));
+
+			// A state of 0 means the min block isn't the start of a free block
+			m_block_states = alloc_unique<u8[]>(alloc, m_capacity / g_buddy_allocator_min_block_size);
+			for (s64 idx = 0; idx < m_block_states.count(); ++idx)
+			{
+				m_block_states[idx] = 0;
+			}
+			m_num_orders = order_of_size(m_capacity) + 1;
+
+			// In the beginning, there's a single free block spanning the entire buffer
+			const s32 top_order = m_num_orders - 1;
+			push_free_block(m_base, top_order);
 		}
 
 		REX_NO_DISCARD pointer allocate(size_type size, size_type alignment)
 		{
-			REX_UNUSED_PARAM(alignment); // Alignment cannot be used for buddy allocator
+			REX_ASSERT_X(alignment <= max_alignment(), "Alignment not supported by buddy allocator. alignment: {} max alignment: {}", alignment, max_alignment());
 
-			internal::BuddyBlockHeader* prev = nullptr;
-			internal::BuddyBlockHeader* current = m_head;
+			// Blocks are aligned to their size, so a block at least as big as the alignment is always aligned
+			const size_type block_size = rsl::max(size, alignment);
+			if (block_size > m_capacity)
+			{
+				REX_ASSERT("Allocation is bigger than the buddy allocator. size: {} capacity: {}", size, m_capacity);
+				return nullptr;
+			}
 
-			while (current)
+			const s32 order = order_of_size(block_size);
+
+			// Find the smallest free block that fits the allocation
+			s32 free_order = order;
+			while (free_order < m_num_orders && m_free_lists[free_order] == nullptr)
 			{
-				if (current->size >= size)
-				{
-					if (can_split_block(current, size))
-					{
-						split_block(current, size);
-					}
-					else
-					{
-						remove_free_block(prev, current);
-					}
-
-					return to_user_pointer(current);
-				}
+				++free_order;
+			}
+
+			if (free_order == m_num_orders)
+			{
+				REX_ASSERT("Ran out of memory in the buddy allocator. size: {} capacity: {}", size, m_capacity);
+				return nullptr;
+			}
+
+			rsl::byte* block = reinterpret_cast<rsl::byte*>(m_free_lists[free_order]); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+			remove_free_block(block, free_order);
 
-				prev = current;
-				current = current->next;
+			// Split the block until it's of the size we need, the upper halves become free blocks
+			while (free_order > order)
+			{
+				--free_order;
+				push_free_block(block + block_size_of_order(free_order), free_order);
 			}
 
-			REX_ASSERT("Ran out of memory in the free list");
-			return nullptr;
+			set_block_state(block, static_cast<u8>(order));
+			return block;
 		}
 		REX_NO_DISCARD pointer allocate(size_type size)
 		{
@@ -112,17 +147,40 @@ namespace rex
 			return static_cast<T*>(allocate(sizeof(T), alignof(T)));
 		}
 
-
+		// The size doesn't need to be passed in, the order of the block is known by the allocator
 		void deallocate(pointer ptr, size_type size)
 		{
 			REX_UNUSED_PARAM(size);
 
-			rsl::byte* ptr_as_bytes = reinterpret_cast<rsl::byte*>(ptr);
-			ptr_as_bytes -= sizeof(internal::BuddyBlockHeader);
-			internal::BuddyBlockHeader* block = reinterpret_cast<internal::BuddyBlockHeader*>(ptr_as_bytes);
+			if (ptr == nullptr)
+			{
+				return;
+			}
+
+			rsl::byte* block = static_cast<rsl::byte*>(ptr);
+			REX_ASSERT_X(owns(block), "Deallocating a pointer that wasn't allocated by this buddy allocator");
+
+			const u8 state = block_state(block);
+			REX_ASSERT_X((state & internal::g_buddy_block_free_bit) == 0, "Double free in buddy allocator");
+			s32 order = state & internal::g_buddy_block_order_mask;
+
+			// Keep merging with the buddy for as long as it's free as well
+			while (order < m_num_orders - 1)
+			{
+				rsl::byte* buddy = buddy_of(block, order);
+				if (block_state(buddy) != (internal::g_buddy_block_free_bit | static_cast<u8>(order)))
+				{
+					break;
+				}
+
+				remove_free_block(buddy, order);
+				// The buddy is no longer the start of a block, so its state isn't valid anymore
+				set_block_state(buddy, 0);
+				block = rsl::min(block, buddy);
+				++order;
+			}
 
-			block->next = m_head;
-			m_head = block;
+			push_free_block(block, order);
 		}
 		template <typename T>
 		void deallocate(T* ptr)
@@ -133,7 +191,7 @@ namespace rex
 		template <typename U, typename... Args>
 		void  construct(U* p, Args&&... args)
 		{
-			new (p) (rsl::forward<Args>(args)...);
+			new (p) U(rsl::forward<Args>(args)...);
 		}
 		template <typename T>
 		void destroy(T* ptr)
@@ -141,6 +199,26 @@ namespace rex
 			ptr->~T();
 		}
 
+		// Return the number of bytes managed by the allocator
+		size_type capacity() const
+		{
+			return m_capacity;
+		}
+
+		// Return the size of the biggest allocation that can currently succeed
+		size_type largest_free_block() const
+		{
+			for (s32 order = m_num_orders - 1; order >= 0; --order)
+			{
+				if (m_free_lists[order] != nullptr)
+				{
+					return block_size_of_order(order);
+				}
+			}
+
+			return 0;
+		}
+
 		bool operator==(const TBuddyAllocator& rhs) const
 		{
 			return m_buffer.get() == rhs.m_buffer.get();
@@ -151,42 +229,104 @@ namespace rex
 		}
 
 	private:
-		pointer to_user_pointer(internal::BuddyBlockHeader* block) const
+		// The maximum supported alignment, blocks can't be aligned to more than the entire buffer
+		size_type max_alignment() const
+		{
+			return rsl::min(m_capacity, g_buddy_allocator_max_alignment);
+		}
+
+		static size_type round_down_to_power_of_2(size_type size)
+		{
+			size_type power = 1;
+			while (power * 2 <= size)
+			{
+				power *= 2;
+			}
+
+			return power;
+		}
+
+		// Return the order of the smallest block that can hold the given size
+		static s32 order_of_size(size_type size)
+		{
+			s32 order = 0;
+			size_type block_size = g_buddy_allocator_min_block_size;
+			while (block_size < size)
+			{
+				block_size *= 2;
+				++order;
+			}
+
+			return order;
+		}
+		static size_type block_size_of_order(s32 order)
+		{
+			return g_buddy_allocator_min_block_size << order;
+		}
+
+		// The buddy of a block is found by flipping the bit of the block's order in its offset
+		rsl::byte* buddy_of(rsl::byte* block, s32 order) const
+		{
+			const size_type offset = block - m_base;
+			return m_base + (offset ^ block_size_of_order(order));
+		}
+
+		bool owns(const rsl::byte* ptr) const
 		{
-			rsl::byte* ptr = reinterpret_cast<rsl::byte*>(block);
-			return ptr += sizeof(internal::BuddyBlockHeader);
+			return ptr >= m_base && ptr < m_base + m_capacity;
 		}
-		bool can_split_block(const internal::BuddyBlockHeader* block, size_type size) const
+
+		u8 block_state(const rsl::byte* block) const
 		{
-			return block->size - size > sizeof(internal::BuddyBlockHeader);
+			return m_block_states[(block - m_base) / g_buddy_allocator_min_block_size];
 		}
-		void split_block(internal::BuddyBlockHeader* block, size_type size) const
+		void set_block_state(const rsl::byte* block, u8 state)
 		{
-			rsl::byte* block_as_bytes = reinterpret_cast<rsl::byte*>(block);
-			block_as_bytes += sizeof(internal::BuddyBlockHeader) + size;
-			internal::BuddyBlockHeader* new_block = reinterpret_cast<internal::BuddyBlockHeader*>(block_as_bytes);
-			new_block->size = static_cast<s32>(block->size - sizeof(internal::BuddyBlockHeader) - size);
-			new_block->next = block->next;
+			m_block_states[(block - m_base) / g_buddy_allocator_min_block_size] = state;
+		}
 
-			block->size = static_cast<s32>(size);
-			block->next = new_block;
+		void push_free_block(rsl::byte* block, s32 order)
+		{
+			internal::BuddyFreeBlock* free_block = reinterpret_cast<internal::BuddyFreeBlock*>(block); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+			free_block->prev = nullptr;
+			free_block->next = m_free_lists[order];
+			if (free_block->next)
+			{
+				free_block->next->prev = free_block;
+			}
+			m_free_lists[order] = free_block;
+
+			set_block_state(block, internal::g_buddy_block_free_bit | static_cast<u8>(order));
 		}
-		void remove_free_block(internal::BuddyBlockHeader* prev, internal::BuddyBlockHeader* toRemove)
+		void remove_free_block(rsl::byte* block, s32 order)
 		{
-			if (prev)
+			internal::BuddyFreeBlock* free_block = reinterpret_cast<internal::BuddyFreeBlock*>(block); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+			if (free_block->prev)
 			{
-				prev->next = toRemove->next;
+				free_block->prev->next = free_block->next;
 			}
 			else
 			{
-				m_head = toRemove->next;
+				m_free_lists[order] = free_block->next;
+			}
+			if (free_block->next)
+			{
+				free_block->next->prev = free_block->prev;
 			}
 		}
 
 	private:
+		// Enough orders to split any 64 bit address space down to a byte
+		static constexpr s32 s_max_num_orders = 64;
+		static_assert(g_buddy_allocator_min_block_size >= sizeof(internal::BuddyFreeBlock), "Min block size of buddy allocator needs to fit a free block");
+
 		rsl::unique_array<rsl::byte, DeleterWithAllocator<rsl::byte, BackendAllocator>> m_buffer;
-		internal::BuddyBlockHeader* m_head;
+		rsl::unique_array<u8, DeleterWithAllocator<u8, BackendAllocator>> m_block_states;
+		size_type m_capacity;
+		rsl::byte* m_base;
+		s32 m_num_orders;
+		rsl::array<internal::BuddyFreeBlock*, s_max_num_orders> m_free_lists;
 	};
 
 	using BuddyAllocator = TBuddyAllocator<GlobalAllocator>;
-}
\ No newline at end of file
+}
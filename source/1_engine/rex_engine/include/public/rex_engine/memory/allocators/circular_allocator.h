@@ -6,6 +6,8 @@
 #include "rex_engine/memory/global_allocators/global_allocator.h"
 
 #include "rex_std/memory.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
 #include "rex_std/bonus/memory/zero_memory.h"
 
 namespace rex
@@ -70,6 +72,7 @@ namespace rex
 			: m_buffer(alloc_unique<rsl::byte[]>(alloc, size))
 			, m_current(m_buffer.get())
 			, m_end(m_buffer.get() + m_buffer.count())
+			, m_last_allocation(nullptr)
 		{
 		}
 
@@ -93,6 +96,7 @@ namespace rex
 			}
 
 			pointer result = m_current;
+			m_last_allocation = m_current;
 			m_current += size;
 
 			return result;
@@ -110,10 +114,32 @@ namespace rex
 			return static_cast<T*>(allocate(sizeof(T), alignof(T)));
 		}
 
+		// The contents of the old allocation are kept
+		// As the allocator doesn't know the size of the old allocation, everything up to the new size is copied over
 		REX_NO_DISCARD pointer reallocate(pointer ptr, size_type size)
 		{
-			deallocate(ptr);
-			return allocate(size);
+			if (ptr == nullptr)
+			{
+				return allocate(size);
+			}
+
+			REX_ASSERT_X(has_allocated_ptr(ptr), "Reallocating a pointer that wasn't allocated by this circular allocator");
+
+			// The last allocation can simply grow in place if there's room left before the end
+			rsl::byte* ptr_as_bytes = static_cast<rsl::byte*>(ptr);
+			if (ptr_as_bytes == m_last_allocation && size <= m_end - ptr_as_bytes)
+			{
+				m_current = ptr_as_bytes + size;
+				return ptr;
+			}
+
+			pointer new_ptr = allocate(size);
+
+			// The new allocation can overlap with the old one if the allocator wrapped around
+			const size_type num_bytes_to_copy = rsl::min(size, static_cast<size_type>(m_end - ptr_as_bytes));
+			rsl::memmove(new_ptr, ptr, num_bytes_to_copy);
+
+			return new_ptr;
 		}
 
 		void deallocate(pointer ptr, size_type size = 0)
@@ -158,6 +184,7 @@ namespace rex
 		rsl::unique_array<rsl::byte, DeleterWithAllocator<rsl::byte, BackendAllocator>> m_buffer;
 		rsl::byte* m_current;
 		const rsl::byte* m_end;
+		rsl::byte* m_last_allocation;
 	};
 
 	using CircularAllocator = TCircularAllocator<GlobalAllocator>;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "rex_engine/engine/defines.h"
+#include "rex_std/bonus/attributes.h"
+#include "rex_std/bonus/memory/memory_size.h"
+#include "rex_std/bonus/types.h"
+#include "rex_std/utility.h"
+
+// IWYU pragma: no_include <new>
+
+namespace rex
+{
+  // The engine heap allocator serves small allocations from the size class heap
+  // and passes bigger allocations through to the OS.
+  // Memory can be freed through it no matter if the engine heap was enabled at the time it was allocated.
+  // The engine heap is disabled by default and enabled from the boot settings
+  // Allocations of memory tags that have the guard allocator enabled are guarded instead
+  class EngineHeapAllocator
+  {
+  public:
+    using size_type = card64;
+    using pointer   = void*;
+
+    REX_NO_DISCARD pointer allocate(rsl::memory_size size);
+    REX_NO_DISCARD pointer allocate(size_type size);
+    template <typename T>
+    REX_NO_DISCARD T* allocate()
+    {
+      return static_cast<T*>(allocate(sizeof(T)));
+    }
+
+    REX_NO_DISCARD pointer reallocate(pointer p, size_type newSize);
+
+    void deallocate(pointer ptr, rsl::memory_size size = 0);
+    void deallocate(pointer ptr, size_type size = 0);
+    template <typename T>
+    void deallocate(T* ptr)
+    {
+      return deallocate(ptr, sizeof(T));
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+      new(static_cast<void*>(p)) U(rsl::forward<Args>(args)...);
+    }
+    template <typename T>
+    void destroy(T* ptr)
+    {
+      ptr->~T();
+    }
+
+    bool operator==(const EngineHeapAllocator& /*other*/) const
+    {
+      return true;
+    }
+    bool operator!=(const EngineHeapAllocator& rhs) const
+    {
+      return !(*this == rhs);
+    }
+  };
+
+  // Enable or disable serving new small allocations from the size class heap
+  void enable_engine_heap(bool enable);
+  bool is_engine_heap_enabled();
+} // namespace rex
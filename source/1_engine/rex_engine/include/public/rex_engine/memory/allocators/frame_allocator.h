@@ -0,0 +1,188 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/engine/defines.h"
+#include "rex_engine/memory/allocators/stack_allocator.h"
+#include "rex_engine/memory/global_allocators/global_allocator.h"
+#include "rex_engine/task_system/job_counter.h"
+#include "rex_engine/task_system/task.h"
+#include "rex_engine/threading/spin_lock.h"
+
+#include "rex_std/array.h"
+#include "rex_std/atomic.h"
+#include "rex_std/memory.h"
+
+namespace rex
+{
+#ifdef REX_NUM_FRAMES_IN_FLIGHT
+  inline constexpr s32 g_num_frames_in_flight = REX_NUM_FRAMES_IN_FLIGHT;
+#else
+  inline constexpr s32 g_num_frames_in_flight = 2;
+#endif
+
+#ifdef REX_MAX_FRAME_ALLOCATOR_THREADS
+  inline constexpr s32 g_max_frame_allocator_threads = REX_MAX_FRAME_ALLOCATOR_THREADS;
+#else
+  inline constexpr s32 g_max_frame_allocator_threads = 64;
+#endif
+
+  class FrameAllocator;
+
+  namespace internal
+  {
+    struct FrameAllocatorThreadSlot;
+  }
+
+  // A fence keeps the memory of the frame it was acquired in alive
+  // The frame doesn't get recycled for as long as a fence on it is active
+  // This is meant for work that isn't a job, eg. GPU work reading from frame memory
+  // Copying a fence adds another hold on the frame, so it can be passed to lambdas by value
+  class FrameFence
+  {
+  public:
+    FrameFence();
+    FrameFence(const FrameFence& other);
+    FrameFence(FrameFence&& other);
+    ~FrameFence();
+
+    FrameFence& operator=(const FrameFence& other);
+    FrameFence& operator=(FrameFence&& other);
+
+    // Signal that the frame's memory is no longer in use by the holder of this fence
+    void release();
+    // Returns true if the fence still holds on to its frame
+    bool is_active() const;
+
+  private:
+    friend class FrameAllocator;
+    FrameFence(FrameAllocator* allocator, s32 frameSlot);
+
+    FrameAllocator* m_allocator;
+    s32 m_frame_slot;
+  };
+
+  // Usage of the frame allocator, gathered whenever a frame gets recycled
+  // These are meant to size the "single_frame_heap_size" setting in boot.ini from data
+  struct FrameAllocatorStats
+  {
+    s64 last_frame_usage;     // The bytes used by all threads in the last recycled frame
+    s64 peak_frame_usage;     // The most bytes used by all threads in a single frame
+    s64 peak_arena_usage;     // The most bytes used by a single thread in a single frame. single_frame_heap_size needs to be at least this
+    s64 num_frames_recycled;  // The number of frames the stats are gathered over
+  };
+
+  // The frame allocator holds memory that only needs to live for a single frame
+  // Every thread allocates from its own linear arena, so allocating never needs to be synchronized
+  // and every thread has an arena for every frame in flight.
+  //
+  //   Frame:     N           N+1         N+2
+  //   Slot:    [  0  ]     [  1  ]     [  0  ]   <-- slot 0 only gets recycled once frame N's jobs and fences are done
+  //
+  // Advancing the frame moves all threads to the next slot, which gets recycled first.
+  // A slot is only recycled once all the jobs and fences added while it was the current frame have finished
+  // so memory of a frame can be used by work that overlaps the frame boundary.
+  class FrameAllocator
+  {
+  public:
+    using size_type = s64;
+    using pointer = void*;
+
+    // arenaSize is the size of a single thread's arena for a single frame
+    explicit FrameAllocator(size_type arenaSize);
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator(FrameAllocator&&) = delete;
+    ~FrameAllocator();
+
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+    // Allocate memory from the calling thread's arena of the current frame
+    REX_NO_DISCARD pointer allocate(size_type size, s32 alignment);
+    REX_NO_DISCARD pointer allocate(size_type size);
+    template <typename T>
+    REX_NO_DISCARD T* allocate()
+    {
+      return static_cast<T*>(allocate(sizeof(T), alignof(T)));
+    }
+
+    // The new memory is always allocated in the calling thread's arena
+    // the old memory is copied over, which is only safe if it's still alive.
+    REX_NO_DISCARD pointer reallocate(pointer ptr, size_type size);
+
+    // This does nothing, memory is freed when its frame gets recycled
+    void deallocate(pointer ptr, size_type size = 0);
+
+    // Move to the next frame.
+    // This blocks until the frame that gets recycled has finished all its jobs and released all its fences
+    void advance_frame();
+
+    // Keep the current frame alive until the task has finished
+    template <typename ReturnType>
+    void add_frame_job(const task_system::Task<ReturnType>& task)
+    {
+      add_frame_job(task.job());
+    }
+    void add_frame_job(const task_system::JobHandle& job);
+
+    // Keep the current frame alive until the fence is released
+    REX_NO_DISCARD FrameFence acquire_fence();
+
+    bool has_allocated_ptr(void* ptr) const;
+
+    // Returns the size of a single thread's arena for a single frame
+    size_type arena_size() const;
+    // Returns the bytes the calling thread used so far in the current frame
+    size_type num_allocated_this_frame() const;
+    // Returns the number of frames advanced since the allocator was created
+    s64 current_frame() const;
+
+    FrameAllocatorStats stats() const;
+    // Log the stats gathered so far
+    void dump_stats() const;
+
+  private:
+    friend class FrameFence;
+    friend struct internal::FrameAllocatorThreadSlot;
+
+    // The arenas a thread uses, one for every frame in flight
+    struct ThreadArenas
+    {
+      rsl::atomic<bool> is_claimed;
+      rsl::array<rsl::unique_ptr<StackAllocator>, g_num_frames_in_flight> arenas;
+    };
+
+    // Everything that keeps a frame from getting recycled
+    struct FrameSync
+    {
+      task_system::JobCounter jobs;
+      SpinLock jobs_lock;
+      rsl::atomic<s32> num_active_fences;
+    };
+
+    // Returns the arena of the calling thread for the current frame, claiming a thread slot if needed
+    StackAllocator& current_arena();
+    s32 claim_thread_slot();
+    // Returns true if the pointer lives in one of the arenas of the thread slot
+    bool has_allocated_ptr(const ThreadArenas& thread, void* ptr) const;
+    void release_thread_slot(s32 slot);
+    s32 current_frame_slot() const;
+
+    // Block until all jobs and fences of a frame have finished
+    void wait_for_frame(s32 frameSlot);
+    // Reset all arenas of a frame and record their usage
+    void recycle_frame(s32 frameSlot);
+
+    void add_fence(s32 frameSlot);
+    void release_fence(s32 frameSlot);
+
+  private:
+    size_type m_arena_size;
+    card32 m_generation;
+    rsl::atomic<s64> m_current_frame;
+    rsl::array<ThreadArenas, g_max_frame_allocator_threads> m_threads;
+    rsl::array<FrameSync, g_num_frames_in_flight> m_frames;
+
+    // Only written by the thread advancing the frames
+    FrameAllocatorStats m_stats;
+  };
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/memory/memory_tags.h"
+#include "rex_engine/threading/spin_lock.h"
+
+#include "rex_std/array.h"
+#include "rex_std/atomic.h"
+#include "rex_std/bonus/utility/enum_reflection.h"
+
+namespace rex
+{
+  // The max number of guarded allocations that can be alive at the same time
+  // Allocations made when this many are alive aren't guarded
+#ifdef REX_GUARD_ALLOCATOR_MAX_ALLOCATIONS
+  inline constexpr s32 g_guard_allocator_max_allocations = REX_GUARD_ALLOCATOR_MAX_ALLOCATIONS;
+#else
+  inline constexpr s32 g_guard_allocator_max_allocations = 16384;
+#endif
+
+  // The number of freed allocations that stay inaccessible before their memory is given back to the OS
+#ifdef REX_GUARD_ALLOCATOR_QUARANTINE_SIZE
+  inline constexpr s32 g_guard_allocator_quarantine_size = REX_GUARD_ALLOCATOR_QUARANTINE_SIZE;
+#else
+  inline constexpr s32 g_guard_allocator_quarantine_size = 1024;
+#endif
+
+  // The alignment of guarded allocations, same as malloc
+  inline constexpr s64 g_guard_allocator_alignment = 16;
+
+  // The byte that fills the unused bytes between the end of an allocation and its guard page
+  // it's checked on free to catch overruns smaller than the alignment
+  inline constexpr u8 g_guard_allocator_fill_byte = 0xFD;
+
+  namespace internal
+  {
+    // A guarded allocation, alive or in quarantine
+    struct GuardAllocation
+    {
+      void* ptr;          // the pointer returned to the user, nullptr if the slot is empty
+      void* base;         // the start of the reserved range
+      s64 reserved_size;  // the size of the reserved range
+      s64 size;           // the size requested by the user
+      bool is_freed;      // true if the allocation is in quarantine
+    };
+
+    // Twice the number of allocations that can be tracked, to keep the probe sequences short
+    inline constexpr s32 g_guard_allocator_table_size = 2 * (g_guard_allocator_max_allocations + g_guard_allocator_quarantine_size);
+  } // namespace internal
+
+  struct GuardAllocatorStats
+  {
+    s32 num_live_allocations;   // the number of guarded allocations that are alive
+    s32 num_quarantined;        // the number of freed allocations that are still inaccessible
+    s64 num_unguarded;          // the number of allocations that couldn't be guarded as too many were alive
+  };
+
+  // The guard allocator places every allocation in its own pages, right against a page that isn't accessible.
+  // Reading or writing past the end of an allocation hits the guard page and crashes the process at the faulty access
+  // instead of silently corrupting a neighbouring allocation.
+  // Freed allocations have their pages made inaccessible and are kept in quarantine for a while,
+  // so using memory after it's freed crashes as well.
+  // Overruns smaller than the alignment don't reach the guard page, those are detected when the allocation is freed.
+  // Define REX_GUARD_ALLOCATOR_DETECT_UNDERRUN to place allocations against the guard page before them instead.
+  //
+  // Every allocation takes at least 2 pages of address space, so this is meant for debugging only.
+  // It's enabled per memory tag, allocations of a tag that has it enabled are guarded through the engine heap allocator
+  class GuardAllocator
+  {
+  public:
+    GuardAllocator();
+    GuardAllocator(const GuardAllocator&) = delete;
+    GuardAllocator(GuardAllocator&&) = delete;
+    ~GuardAllocator();
+
+    GuardAllocator& operator=(const GuardAllocator&) = delete;
+    GuardAllocator& operator=(GuardAllocator&&) = delete;
+
+    // Allocate a guarded allocation, returns nullptr if no more guarded allocations can be made
+    REX_NO_DISCARD void* allocate(s64 size);
+    // Free a guarded allocation, its memory becomes inaccessible and stays in quarantine
+    void deallocate(void* ptr);
+
+    // Return true if the pointer is a guarded allocation, alive or in quarantine
+    bool owns(const void* ptr);
+    // Return the size a guarded allocation was allocated with
+    s64 usable_size(const void* ptr);
+
+    GuardAllocatorStats stats();
+
+  private:
+    // Return the slot of the pointer in the table or the empty slot it would go in
+    s32 find_slot(const void* ptr) const;
+    // Empty a slot in the table, moving entries after it back so they can still be found
+    void remove_slot(s32 slot);
+    // Give the memory of the oldest allocation in quarantine back to the OS
+    void release_oldest_quarantined();
+
+  private:
+    rsl::array<internal::GuardAllocation, internal::g_guard_allocator_table_size> m_allocations;
+    rsl::array<void*, g_guard_allocator_quarantine_size> m_quarantine;
+    s32 m_quarantine_start;
+    s32 m_num_quarantined;
+    s32 m_num_live_allocations;
+    s64 m_num_unguarded;
+    // Used to skip the lookup on free when nothing is guarded
+    rsl::atomic<s32> m_num_owned;
+    SpinLock m_lock;
+  };
+
+  // Like the engine heap, the guard allocator is used by the backend allocator and needs to exist before the first allocation
+  GuardAllocator& guard_allocator();
+
+  // Enable or disable guarding new allocations of a memory tag
+  void enable_guard_allocator(MemoryTag tag, bool enable);
+  bool is_guard_allocator_enabled(MemoryTag tag);
+  // Return true if guarding is enabled for any memory tag
+  bool is_guard_allocator_enabled();
+} // namespace rex
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/engine/defines.h"
+#include "rex_engine/diagnostics/assert.h"
+
+#include "rex_engine/memory/global_allocators/global_allocator.h"
+#include "rex_engine/memory/alloc_unique.h"
+#include "rex_engine/memory/pointer_math.h"
+
+#include "rex_std/algorithm.h"
+#include "rex_std/atomic.h"
+#include "rex_std/memory.h"
+
+namespace rex
+{
+	namespace internal
+	{
+		// A free block links to the next free block using the memory of the block itself
+		// Other threads can read the link while the block is popped, so it's an atomic
+		struct PoolFreeBlock
+		{
+			rsl::atomic<u32> next;
+		};
+
+		inline constexpr u32 g_pool_null_block = 0xFFFFFFFF;
+	}
+
+	//
+	// A pool allocator splits its buffer into blocks of the same size and keeps the free blocks in a free list
+	// Allocating pops the first block from the free list, deallocating pushes it back on.
+	//
+	//   +-------------------------------------------------------------------------------------------------------------------------+
+	//   |    +--------------+    +--------------+    +--------------+    +--------------+    +--------------+    +--------------+  |
+	//   |    |              |    |              |    |              |    |              |    |              |    |              |  |
+	//   |    |    Block     |    |  Free Block  |    |    Block     |    |  Free Block  |    |  Free Block  |    |    Block     |  |
+	//   |    |              |    |              |    |              |    |              |    |              |    |              |  |
+	//   |    +--------------+    +--------------+    +--------------+    +--------------+    +--------------+    +--------------+  |
+	//   +-------------------------------------------------------------------------------------------------------------------------+
+	//                              head ---^                  next ---^        next ---^
+	//
+	// The free list is a lock free stack, so it can be used from any thread.
+	// The link to the next free block is stored in the free block itself and blocks are laid out back to back
+	// so there's no memory spent per block, other than the padding needed to keep every block aligned.
+	// The head of the list is the index of the first free block, combined with a tag that changes on every update
+	// so a thread can't swap in a stale head when the same block got popped and pushed again in between (the ABA problem)
+	//
+	template <typename BackendAllocator>
+	class TPoolAllocator
+	{
+	public:
+		using size_type = s64;
+		using pointer = void*;
+
+		// Every block can hold an object of blockSize bytes, aligned to the given alignment
+		TPoolAllocator(size_type blockSize, s32 numBlocks, size_type alignment = alignof(rsl::max_align), BackendAllocator alloc = BackendAllocator())
+			: m_block_size(0)
+			, m_num_blocks(numBlocks)
+			, m_alignment(rsl::max(alignment, static_cast<size_type>(alignof(internal::PoolFreeBlock))))
+			, m_base(nullptr)
+			, m_head(pack_head(0, 0))
+			, m_num_free_blocks(numBlocks)
+		{
+			REX_ASSERT_X(blockSize > 0, "Pool allocator block size should be bigger than 0");
+			REX_ASSERT_X(numBlocks > 0, "Pool allocator needs at least 1 block");
+			REX_ASSERT_X((alignment & (alignment - 1)) == 0, "Pool allocator alignment needs to be a power of 2. alignment: {}", alignment);
+
+			// The size of every block is rounded up, so the next block is aligned as well
+			m_block_size = align(rsl::max(blockSize, static_cast<size_type>(sizeof(internal::PoolFreeBlock))), static_cast<card32>(m_alignment));
+
+			// Over allocate a bit so the first block can be aligned
+			m_buffer = alloc_unique<rsl::byte[]>(alloc, m_block_size * numBlocks + m_alignment);
+			m_base = align(m_buffer.get(), static_cast<card32>(m_alignment));
+
+			// In the beginning, every block is free and links to the one after it
+			for (s32 idx = 0; idx < m_num_blocks; ++idx)
+			{
+				const u32 next = idx + 1 < m_num_blocks ? static_cast<u32>(idx + 1) : internal::g_pool_null_block;
+				new (block_at(static_cast<u32>(idx))) internal::PoolFreeBlock{ next };
+			}
+		}
+
+		REX_NO_DISCARD pointer allocate(size_type size, size_type alignment)
+		{
+			REX_ASSERT_X(size <= m_block_size, "Trying to allocate something that's bigger than the block size of a pool allocator. alloc size: {} block size: {}", size, m_block_size);
+			REX_ASSERT_X(alignment <= m_alignment, "Alignment not supported by pool allocator. alignment: {} pool alignment: {}", alignment, m_alignment);
+
+			u64 head = m_head.load(rsl::memory_order_acquire);
+			while (true)
+			{
+				const u32 idx = head_index(head);
+				if (idx == internal::g_pool_null_block)
+				{
+					REX_ASSERT("Ran out of blocks in the pool allocator. block size: {} num blocks: {}", m_block_size, m_num_blocks);
+					return nullptr;
+				}
+
+				// The block can get popped by another thread while we read its link
+				// in which case the tag of the head changed and the exchange below fails
+				const u32 next = block_at(idx)->next.load(rsl::memory_order_relaxed);
+				if (m_head.compare_exchange_weak(head, pack_head(next, head_tag(head) + 1), rsl::memory_order_acquire, rsl::memory_order_acquire))
+				{
+					m_num_free_blocks.fetch_sub(1, rsl::memory_order_relaxed);
+					return block_at(idx);
+				}
+			}
+		}
+		REX_NO_DISCARD pointer allocate(size_type size)
+		{
+			return allocate(size, rsl::min(m_alignment, static_cast<size_type>(alignof(rsl::max_align))));
+		}
+		template <typename T>
+		REX_NO_DISCARD T* allocate()
+		{
+			return static_cast<T*>(allocate(sizeof(T), alignof(T)));
+		}
+
+		// The size doesn't need to be passed in, all blocks are of the same size
+		void deallocate(pointer ptr, size_type size)
+		{
+			REX_UNUSED_PARAM(size);
+
+			if (ptr == nullptr)
+			{
+				return;
+			}
+
+			REX_ASSERT_X(has_allocated_ptr(ptr), "Deallocating a pointer that wasn't allocated by this pool allocator");
+			const u32 idx = index_of(ptr);
+			REX_ASSERT_X(block_at(idx) == ptr, "Deallocating a pointer that doesn't point to the start of a block of the pool allocator");
+
+			internal::PoolFreeBlock* block = new (ptr) internal::PoolFreeBlock{ internal::g_pool_null_block };
+			u64 head = m_head.load(rsl::memory_order_relaxed);
+			do
+			{
+				block->next.store(head_index(head), rsl::memory_order_relaxed);
+			} while (!m_head.compare_exchange_weak(head, pack_head(idx, head_tag(head) + 1), rsl::memory_order_release, rsl::memory_order_relaxed));
+
+			m_num_free_blocks.fetch_add(1, rsl::memory_order_relaxed);
+		}
+		template <typename T>
+		void deallocate(T* ptr)
+		{
+			deallocate(ptr, sizeof(T));
+		}
+
+		template <typename U, typename... Args>
+		void  construct(U* p, Args&&... args)
+		{
+			new (p) U(rsl::forward<Args>(args)...);
+		}
+		template <typename T>
+		void destroy(T* ptr)
+		{
+			ptr->~T();
+		}
+
+		bool has_allocated_ptr(const void* ptr) const
+		{
+			const rsl::byte* ptr_as_bytes = static_cast<const rsl::byte*>(ptr);
+			return ptr_as_bytes >= m_base && ptr_as_bytes < m_base + m_block_size * m_num_blocks;
+		}
+
+		// Return the size of a single block, including the padding needed to keep blocks aligned
+		size_type block_size() const
+		{
+			return m_block_size;
+		}
+		// Return the alignment every block is aligned to
+		size_type alignment() const
+		{
+			return m_alignment;
+		}
+		s32 num_blocks() const
+		{
+			return m_num_blocks;
+		}
+		// Return the number of blocks that are free
+		// When other threads are allocating, this is only a snapshot
+		s32 num_free_blocks() const
+		{
+			return m_num_free_blocks.load(rsl::memory_order_relaxed);
+		}
+
+		bool operator==(const TPoolAllocator& rhs) const
+		{
+			return m_buffer.get() == rhs.m_buffer.get();
+		}
+		bool operator!=(const TPoolAllocator& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+	private:
+		static u64 pack_head(u32 idx, u32 tag)
+		{
+			return (static_cast<u64>(tag) << 32) | idx;
+		}
+		static u32 head_index(u64 head)
+		{
+			return static_cast<u32>(head & 0xFFFFFFFF);
+		}
+		static u32 head_tag(u64 head)
+		{
+			return static_cast<u32>(head >> 32);
+		}
+
+		internal::PoolFreeBlock* block_at(u32 idx) const
+		{
+			return reinterpret_cast<internal::PoolFreeBlock*>(m_base + m_block_size * idx); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		}
+		u32 index_of(const void* ptr) const
+		{
+			return static_cast<u32>((static_cast<const rsl::byte*>(ptr) - m_base) / m_block_size);
+		}
+
+	private:
+		rsl::unique_array<rsl::byte, DeleterWithAllocator<rsl::byte, BackendAllocator>> m_buffer;
+		size_type m_block_size;
+		s32 m_num_blocks;
+		size_type m_alignment;
+		rsl::byte* m_base;
+		// The index of the first free block in the lower 32 bits, the tag in the upper 32 bits
+		alignas(64) rsl::atomic<u64> m_head;
+		rsl::atomic<s32> m_num_free_blocks;
+	};
+
+	using PoolAllocator = TPoolAllocator<GlobalAllocator>;
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/engine/defines.h"
+#include "rex_engine/threading/spin_lock.h"
+
+#include "rex_std/array.h"
+#include "rex_std/atomic.h"
+#include "rex_std/bonus/memory.h"
+
+namespace rex
+{
+  // Allocations bigger than this aren't served by the size class heap
+#ifdef REX_SIZE_CLASS_HEAP_MAX_SMALL_SIZE
+  inline constexpr s64 g_size_class_heap_max_small_size = REX_SIZE_CLASS_HEAP_MAX_SMALL_SIZE;
+#else
+  inline constexpr s64 g_size_class_heap_max_small_size = 32_kib;
+#endif
+
+  // The number of bytes a thread caches per size class before it hands blocks back to the heap
+#ifdef REX_SIZE_CLASS_HEAP_THREAD_CACHE_SIZE
+  inline constexpr s64 g_size_class_heap_thread_cache_size = REX_SIZE_CLASS_HEAP_THREAD_CACHE_SIZE;
+#else
+  inline constexpr s64 g_size_class_heap_thread_cache_size = 32_kib;
+#endif
+
+  namespace internal
+  {
+    // Size classes go up in steps of 16 bytes up to 128 bytes
+    // after that every power of 2 is split in 4 size classes, which keeps the waste under 25%
+    inline constexpr s64 g_size_class_heap_small_step = 16;
+    inline constexpr s32 g_size_class_heap_num_small_classes = 8;
+    inline constexpr s32 g_size_class_heap_classes_per_power_of_2 = 4;
+
+    // Spans are the unit the heap hands out to size classes
+    // they're part of segments, which is the unit the heap requests from the OS
+    inline constexpr s64 g_size_class_heap_span_size = 64_kib;
+    inline constexpr s64 g_size_class_heap_segment_size = 4_mib;
+    // The address space reserved for a segment, large enough to hold a segment aligned to its size
+    inline constexpr s64 g_size_class_heap_segment_reserve_size = 2 * g_size_class_heap_segment_size;
+    inline constexpr s32 g_size_class_heap_spans_per_segment = static_cast<s32>(g_size_class_heap_segment_size / g_size_class_heap_span_size);
+    inline constexpr s32 g_size_class_heap_max_segments = 4096;
+
+    // Return the size class an allocation of the given size falls in
+    constexpr s32 size_class_of(s64 size)
+    {
+      const s64 last = size > 0 ? size - 1 : 0;
+      if (last < g_size_class_heap_small_step * g_size_class_heap_num_small_classes)
+      {
+        return static_cast<s32>(last / g_size_class_heap_small_step);
+      }
+
+      s32 power = 0;
+      while ((static_cast<s64>(2) << power) <= last)
+      {
+        ++power;
+      }
+      const s64 step = (static_cast<s64>(1) << power) / g_size_class_heap_classes_per_power_of_2;
+      const s32 first_power = 7; // 128, the last small size class
+      return g_size_class_heap_num_small_classes + (power - first_power) * g_size_class_heap_classes_per_power_of_2 + static_cast<s32>((last - (static_cast<s64>(1) << power)) / step);
+    }
+    // Return the size of the blocks of a size class
+    constexpr s64 size_of_class(s32 sizeClass)
+    {
+      if (sizeClass < g_size_class_heap_num_small_classes)
+      {
+        return (sizeClass + 1) * g_size_class_heap_small_step;
+      }
+
+      const s32 idx = sizeClass - g_size_class_heap_num_small_classes;
+      const s64 power_of_2 = static_cast<s64>(128) << (idx / g_size_class_heap_classes_per_power_of_2);
+      return power_of_2 + (idx % g_size_class_heap_classes_per_power_of_2 + 1) * (power_of_2 / g_size_class_heap_classes_per_power_of_2);
+    }
+
+    inline constexpr s32 g_size_class_heap_num_classes = size_class_of(g_size_class_heap_max_small_size) + 1;
+    static_assert(size_of_class(g_size_class_heap_num_classes - 1) == g_size_class_heap_max_small_size, "The max small size needs to be the size of a size class");
+    static_assert(g_size_class_heap_max_small_size <= g_size_class_heap_span_size, "A span needs to fit at least a single block of every size class");
+
+    // A span serves blocks of a single size class
+    // Blocks are carved from the span on demand and freed blocks link themselves in the span's free list
+    struct SizeClassSpan
+    {
+      rsl::byte* start;
+      void* free_list;
+      SizeClassSpan* next_partial;  // the next span of the same size class with free blocks
+      SizeClassSpan* prev_partial;
+      SizeClassSpan* next_free;     // the next span that's not assigned to a size class
+      s32 size_class;               // -1 if the span isn't assigned to a size class
+      s32 num_used;
+      s32 num_carved;
+      bool is_partial;
+    };
+
+    // A segment is aligned to its size, so the segment of a block is found by masking its address
+    // The metadata of its spans is stored at the start of the segment, taking up its first span
+    struct SizeClassSegment
+    {
+      rsl::array<SizeClassSpan, g_size_class_heap_spans_per_segment> spans;
+      void* os_allocation; // the start of the reserved range the segment lives in
+    };
+    static_assert(sizeof(SizeClassSegment) <= g_size_class_heap_span_size, "Segment metadata needs to fit in the first span of a segment");
+
+    // The spans of a size class that still have free blocks, shared by all threads
+    struct alignas(64) SizeClassCentralList
+    {
+      SizeClassSpan* partial_spans;
+      SpinLock lock;
+    };
+  } // namespace internal
+
+  struct SizeClassHeapThreadCache;
+
+  struct SizeClassHeapStats
+  {
+    s64 num_segments;        // the number of segments requested from the OS
+    s64 reserved_memory;     // the number of bytes requested from the OS
+    s64 num_spans_in_use;    // the number of spans assigned to a size class
+  };
+
+  // The size class heap serves small allocations from blocks of fixed size classes
+  // Every thread caches freed blocks per size class, so most allocations and frees don't synchronize with other threads
+  // When a thread cache runs empty, it takes a batch of blocks from the spans shared by all threads
+  // and when it holds too many blocks, it gives a batch back.
+  // Spans whose blocks are all freed go back to the heap, so they can be used for another size class
+  // Memory requested from the OS is never returned, it's reused for new spans instead.
+  class SizeClassHeap
+  {
+  public:
+    SizeClassHeap(const SizeClassHeap&) = delete;
+    SizeClassHeap(SizeClassHeap&&) = delete;
+    ~SizeClassHeap() = delete;
+
+    SizeClassHeap& operator=(const SizeClassHeap&) = delete;
+    SizeClassHeap& operator=(SizeClassHeap&&) = delete;
+
+    // Allocate a block of at least size bytes, size can't be bigger than the max small size
+    // Blocks are aligned to 16 bytes
+    REX_NO_DISCARD void* allocate(s64 size);
+    // Free a block that was allocated by this heap, from any thread
+    void deallocate(void* ptr);
+
+    // Return true if the pointer points into memory owned by the heap
+    bool owns(const void* ptr) const;
+    // Return the number of bytes that can be used by the block the pointer was allocated with
+    s64 usable_size(const void* ptr) const;
+
+    SizeClassHeapStats stats() const;
+
+    // Move all blocks cached by the calling thread back to the heap
+    void flush_thread_cache();
+
+  private:
+    friend SizeClassHeap& size_class_heap();
+    friend struct SizeClassHeapThreadCache;
+
+    SizeClassHeap();
+
+    // Move up to count blocks of a size class into a linked list, returns the number of blocks moved
+    s32 take_blocks(s32 sizeClass, s32 count, void*& outList);
+    // Return a single block to the span it came from
+    void give_block(void* ptr);
+
+    internal::SizeClassSpan* acquire_span(s32 sizeClass);
+    void release_span(internal::SizeClassSpan* span);
+    bool add_segment();
+
+    internal::SizeClassSpan* span_of(const void* ptr) const;
+    internal::SizeClassSegment* find_segment(const void* ptr) const;
+
+  private:
+    rsl::array<internal::SizeClassCentralList, internal::g_size_class_heap_num_classes> m_central_lists;
+
+    // The base addresses of all segments, in an open addressing hash table so owns() doesn't need a lock
+    rsl::array<rsl::atomic<u64>, internal::g_size_class_heap_max_segments * 2> m_segment_table;
+    rsl::atomic<s32> m_num_segments;
+    rsl::atomic<s64> m_num_spans_in_use;
+
+    // Spans not assigned to any size class, guarded by the span lock
+    internal::SizeClassSpan* m_free_spans;
+    SpinLock m_span_lock;
+  };
+
+  // The size class heap is never destroyed
+  // threads can still free memory back to it while the process is shutting down
+  SizeClassHeap& size_class_heap();
+}
@@ -162,6 +162,11 @@ namespace rex
     {
       return m_buffer.count();
     }
+    // Return the beginning of the buffer allocations are made from
+    const rsl::byte* buffer() const
+    {
+      return m_buffer.get();
+    }
   private:
 		rsl::unique_array<rsl::byte, DeleterWithAllocator<rsl::byte, BackendAllocator>> m_buffer;
     rsl::byte* m_current_marker;
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/engine/defines.h"
+#include "rex_engine/engine/casting.h"
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/memory/pointer_math.h"
+#include "rex_engine/memory/virtual_arena.h"
+#include "rex_engine/memory/allocators/virtual_stack_allocator.h"
+
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
+#include "rex_std/memory.h"
+
+namespace rex
+{
+	//
+	// A circular allocator that doesn't allocate its buffer up front
+	// It reserves a big range of virtual memory instead and only commits the size of the ring.
+	// It wraps around the same way a TCircularAllocator does, but an allocation that doesn't fit in the ring at all
+	// grows the ring into the reserved range instead of running out of memory.
+	// When decommitting on reset, the ring shrinks back to its initial size and the memory it grew with is given back to the OS
+	//
+	class VirtualCircularAllocator
+	{
+	public:
+		using size_type = s64;
+		using pointer = void*;
+
+		explicit VirtualCircularAllocator(size_type size, size_type reserveSize = g_virtual_arena_default_reserve_size, DecommitOnReset decommitOnReset = DecommitOnReset::no)
+			: m_arena(rsl::max(size, reserveSize))
+			, m_initial_size(size)
+			, m_current(m_arena.base())
+			, m_end(m_arena.base())
+			, m_last_allocation(nullptr)
+			, m_num_grows(0)
+			, m_decommit_on_reset(decommitOnReset)
+		{
+			const bool committed = m_arena.commit_up_to(size);
+			REX_ASSERT_X(committed, "Failed to commit the initial ring of a virtual circular allocator. size: {}", size);
+			if (committed)
+			{
+				m_end = m_arena.base() + size;
+			}
+		}
+
+		REX_NO_DISCARD pointer allocate(size_type size, s32 alignment)
+		{
+			// As we're not given a type, we need to make sure our memory is aligned within the buffer
+			m_current = align(m_current, alignment);
+
+			if (m_end - m_current < size)
+			{
+				// If we can't fit the entire allocation
+				// We need to reset the allocation pointer to the front
+				m_current = align(m_arena.base(), alignment);
+
+				// If it doesn't fit in the ring at all, the ring grows
+				if (m_end - m_current < size && !grow(narrow_cast<size_type>(m_current + size - m_arena.base())))
+				{
+					REX_ASSERT("Virtual circular allocator ran out of memory. reserved size: {} alloc size: {}", m_arena.reserved_size(), size);
+					return nullptr;
+				}
+			}
+
+			pointer result = m_current;
+			m_last_allocation = m_current;
+			m_current += size;
+
+			return result;
+		}
+
+		REX_NO_DISCARD pointer allocate(size_type size)
+		{
+			s32 alignment = narrow_cast<s32>(alignof(rsl::max_align));
+			return allocate(size, alignment);
+		}
+
+		template <typename T>
+		REX_NO_DISCARD T* allocate()
+		{
+			return static_cast<T*>(allocate(sizeof(T), alignof(T)));
+		}
+
+		// The contents of the old allocation are kept
+		// As the allocator doesn't know the size of the old allocation, everything up to the new size is copied over
+		REX_NO_DISCARD pointer reallocate(pointer ptr, size_type size)
+		{
+			if (ptr == nullptr)
+			{
+				return allocate(size);
+			}
+
+			REX_ASSERT_X(has_allocated_ptr(ptr), "Reallocating a pointer that wasn't allocated by this virtual circular allocator");
+
+			// The last allocation can simply grow in place if there's room left before the end
+			rsl::byte* ptr_as_bytes = static_cast<rsl::byte*>(ptr);
+			if (ptr_as_bytes == m_last_allocation && size <= m_end - ptr_as_bytes)
+			{
+				m_current = ptr_as_bytes + size;
+				return ptr;
+			}
+
+			// The old allocation can't be read past the end of the ring
+			const size_type num_bytes_to_copy = rsl::min(size, static_cast<size_type>(m_end - ptr_as_bytes));
+			pointer new_ptr = allocate(size);
+			if (new_ptr != nullptr)
+			{
+				// The new allocation can overlap with the old one if the allocator wrapped around
+				rsl::memmove(new_ptr, ptr, num_bytes_to_copy);
+			}
+
+			return new_ptr;
+		}
+
+		void deallocate(pointer ptr, size_type size = 0)
+		{
+			// Nothing to implement
+
+			REX_UNUSED_PARAM(ptr);
+			REX_UNUSED_PARAM(size);
+		}
+
+		template <typename U, typename... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new (p) U(rsl::forward<Args>(args)...);
+		}
+		template <typename T>
+		void destroy(T* ptr)
+		{
+			ptr->~T();
+		}
+
+		bool has_allocated_ptr(const void* ptr) const
+		{
+			return m_arena.base() <= ptr && ptr < m_end;
+		}
+
+		bool operator==(const VirtualCircularAllocator& rhs) const
+		{
+			return m_arena.base() == rhs.m_arena.base();
+		}
+		bool operator!=(const VirtualCircularAllocator& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+		// Start allocating from the front of the ring again
+		// When decommitting on reset, the ring shrinks back to its initial size
+		void reset()
+		{
+			m_current = m_arena.base();
+			m_last_allocation = nullptr;
+
+			if (m_decommit_on_reset && ring_size() > m_initial_size)
+			{
+				m_end = m_arena.base() + m_initial_size;
+				m_arena.decommit_after(m_initial_size);
+			}
+		}
+
+		// Return the current size of the ring
+		size_type buffer_size() const
+		{
+			return ring_size();
+		}
+		// Return the size the ring can grow to
+		size_type reserved_size() const
+		{
+			return m_arena.reserved_size();
+		}
+		// Return the number of bytes that are backed by physical memory
+		size_type committed_size() const
+		{
+			return m_arena.committed_size();
+		}
+		// Return how many times the ring had to grow because an allocation didn't fit
+		s32 num_grows() const
+		{
+			return m_num_grows;
+		}
+
+	private:
+		size_type ring_size() const
+		{
+			return narrow_cast<size_type>(m_end - m_arena.base());
+		}
+
+		// Grow the ring so it's at least minSize bytes, it at least doubles so growing doesn't happen often
+		bool grow(size_type minSize)
+		{
+			const size_type new_size = rsl::min(rsl::max(minSize, ring_size() * 2), m_arena.reserved_size());
+			if (new_size < minSize || !m_arena.commit_up_to(new_size))
+			{
+				return false;
+			}
+
+			m_end = m_arena.base() + new_size;
+			++m_num_grows;
+			return true;
+		}
+
+	private:
+		VirtualArena m_arena;
+		size_type m_initial_size;
+		rsl::byte* m_current;
+		const rsl::byte* m_end;
+		rsl::byte* m_last_allocation;
+		s32 m_num_grows;
+		DecommitOnReset m_decommit_on_reset;
+	};
+}
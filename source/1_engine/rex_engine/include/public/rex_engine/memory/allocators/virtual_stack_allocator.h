@@ -0,0 +1,192 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/engine/defines.h"
+#include "rex_engine/engine/casting.h"
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/memory/pointer_math.h"
+#include "rex_engine/memory/virtual_arena.h"
+#include "rex_engine/memory/allocators/stack_allocator.h"
+
+#include "rex_std/algorithm.h"
+#include "rex_std/bonus/utility/yes_no.h"
+#include "rex_std/cstring.h"
+#include "rex_std/memory.h"
+
+namespace rex
+{
+  // Should an arena give its physical memory back to the OS when it's reset
+  DEFINE_YES_NO_ENUM(DecommitOnReset);
+
+  // A stack allocator that doesn't allocate its buffer up front
+  // It reserves a big range of virtual memory instead and commits pages as the stack grows
+  // This allows for a big maximum size, without using physical memory for the part that's never used
+  // When decommitting on reset, the pages past the marker that's set are given back to the OS as well
+  class VirtualStackAllocator
+  {
+  public:
+    using size_type = s64;
+    using pointer = void*;
+
+    explicit VirtualStackAllocator(size_type reserveSize = g_virtual_arena_default_reserve_size, DecommitOnReset decommitOnReset = DecommitOnReset::no)
+      : m_arena(reserveSize)
+      , m_current_marker(m_arena.base())
+      , m_last_allocation(nullptr)
+      , m_decommit_on_reset(decommitOnReset)
+    {
+    }
+
+    // Allocate size bytes from the reserved range, committing more memory if needed
+    REX_NO_DISCARD pointer allocate(size_type size, s32 alignment)
+    {
+      rsl::byte* mem = align(m_current_marker, alignment);
+      const size_type new_marker = narrow_cast<size_type>(mem + size - m_arena.base());
+      if (!m_arena.commit_up_to(new_marker))
+      {
+        REX_ASSERT("Virtual stack allocator ran out of memory. reserved size: {} new size: {}", m_arena.reserved_size(), new_marker);
+        return nullptr;
+      }
+
+      m_current_marker = mem + size;
+      m_last_allocation = mem;
+      return mem;
+    }
+
+    // Allocate size bytes from the reserved range, committing more memory if needed
+    REX_NO_DISCARD pointer allocate(size_type size)
+    {
+      s32 alignment = static_cast<s32>(alignof(rsl::max_align));
+      return allocate(size, alignment);
+    }
+
+    template <typename T>
+    REX_NO_DISCARD T* allocate()
+    {
+      return static_cast<T*>(allocate(sizeof(T), alignof(T)));
+    }
+
+    // The last allocation grows in place, other allocations get copied to the top of the stack
+    // As the allocator doesn't know the size of the old allocation, everything up to the new size is copied over
+    REX_NO_DISCARD pointer reallocate(pointer ptr, size_type size)
+    {
+      if (ptr == nullptr)
+      {
+        return allocate(size);
+      }
+
+      REX_ASSERT_X(has_allocated_ptr(ptr), "Reallocating a pointer that wasn't allocated by this virtual stack allocator");
+
+      rsl::byte* ptr_as_bytes = static_cast<rsl::byte*>(ptr);
+      if (ptr_as_bytes == m_last_allocation)
+      {
+        const size_type new_marker = narrow_cast<size_type>(ptr_as_bytes + size - m_arena.base());
+        if (!m_arena.commit_up_to(new_marker))
+        {
+          REX_ASSERT("Virtual stack allocator ran out of memory. reserved size: {} new size: {}", m_arena.reserved_size(), new_marker);
+          return nullptr;
+        }
+
+        m_current_marker = ptr_as_bytes + size;
+        return ptr;
+      }
+
+      const size_type num_bytes_to_copy = rsl::min(size, static_cast<size_type>(m_current_marker - ptr_as_bytes));
+      pointer new_ptr = allocate(size);
+      if (new_ptr != nullptr)
+      {
+        rsl::memcpy(new_ptr, ptr, num_bytes_to_copy);
+      }
+      return new_ptr;
+    }
+
+    // This does nothing internally but is only provided to follow basic allocator interface
+    void deallocate(pointer ptr, size_type size = 0)
+    {
+      // Nothing to implement
+      REX_UNUSED_PARAM(ptr);
+      REX_UNUSED_PARAM(size);
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+      new (p) U(rsl::forward<Args>(args)...);
+    }
+    template <typename T>
+    void destroy(T* ptr)
+    {
+      ptr->~T();
+    }
+
+    bool has_allocated_ptr(const void* ptr) const
+    {
+      return m_arena.base() <= ptr && ptr < m_current_marker;
+    }
+
+    bool operator==(const VirtualStackAllocator& rhs) const
+    {
+      return m_arena.base() == rhs.m_arena.base();
+    }
+    bool operator!=(const VirtualStackAllocator& rhs) const
+    {
+      return !(*this == rhs);
+    }
+
+    // Reset the current stack pointer to the beginning
+    // New allocations will starts from the front again
+    void reset()
+    {
+      set_marker(0);
+    }
+
+    // Return the offset from the beginning of the buffer allocations will be made from
+    StackMarker current_marker() const
+    {
+      return num_allocated();
+    }
+
+    // Set the offset within the buffer allocations should start from
+    void set_marker(StackMarker marker)
+    {
+      REX_ASSERT_X(marker <= num_allocated(), "Setting the marker of a virtual stack allocator past its current marker. marker: {} current marker: {}", marker, num_allocated());
+      m_current_marker = m_arena.base() + marker;
+      m_last_allocation = nullptr;
+
+      if (m_decommit_on_reset)
+      {
+        m_arena.decommit_after(marker);
+      }
+    }
+
+    bool can_allocate(size_type size, size_type alignment = 1) const
+    {
+      return num_allocated() + size + alignment <= m_arena.reserved_size();
+    }
+
+    size_type num_allocated() const
+    {
+      return narrow_cast<size_type>(m_current_marker - m_arena.base());
+    }
+    // Return the maximum size the stack can grow to
+    size_type buffer_size() const
+    {
+      return m_arena.reserved_size();
+    }
+    // Return the number of bytes that are backed by physical memory
+    size_type committed_size() const
+    {
+      return m_arena.committed_size();
+    }
+    // Return the beginning of the buffer allocations are made from
+    const rsl::byte* buffer() const
+    {
+      return m_arena.base();
+    }
+
+  private:
+    VirtualArena m_arena;
+    rsl::byte* m_current_marker;
+    rsl::byte* m_last_allocation;
+    DecommitOnReset m_decommit_on_reset;
+  };
+}
@@ -22,7 +22,8 @@ namespace rex
       T read();
 
       // Read a number of bytes out of the blob and store it in dst
-      void read(void* dst, rsl::memory_size size);
+      // Reading stops at the end of the blob, the number of bytes that got read is returned
+      rsl::memory_size read(void* dst, rsl::memory_size size);
 
       // Skip a certain amount of bytes
       // it returns the read offset after the skip has been applied
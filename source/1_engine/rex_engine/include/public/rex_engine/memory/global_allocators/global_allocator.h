@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rex_engine/memory/allocators/tracked_allocator.h"
+#include "rex_engine/memory/allocators/engine_heap_allocator.h"
 #include "rex_engine/memory/allocators/untracked_allocator.h"
 
 #include "rex_std/memory.h"
@@ -11,11 +12,13 @@ namespace rex
   // Allocations from the global allocator are to be avoided as they may require a kernell call
   // Prefer other global allocators of the engine instead
 
+  // Small allocations can be served by the engine heap instead, if it's enabled in the boot settings
+
   // Type aliases
 #ifdef REX_ENABLE_MEM_TRACKING
-  using BackendOSAllocator = TrackedAllocator<UntrackedAllocator>;
+  using BackendOSAllocator = TrackedAllocator<EngineHeapAllocator>;
 #else
-  using BackendOSAllocator = UntrackedAllocator;
+  using BackendOSAllocator = EngineHeapAllocator;
 #endif
 
   class GlobalAllocator
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/memory/memory_stats.h"
+#include "rex_engine/memory/memory_tags.h"
+#include "rex_engine/memory/memory_types.h"
+
+#include "rex_std/array.h"
+#include "rex_std/bonus/utility/enum_reflection.h"
+#include "rex_std/string_view.h"
+
+namespace rex
+{
+  // The number of frames the usage per memory tag is kept for
+#ifdef REX_MEMORY_BUDGET_HISTORY_SIZE
+  inline constexpr s32 g_memory_budget_history_size = REX_MEMORY_BUDGET_HISTORY_SIZE;
+#else
+  inline constexpr s32 g_memory_budget_history_size = 300;
+#endif
+
+  inline constexpr rsl::string_view g_memory_budgets_filename = "memory_budgets.csv";
+
+  // What happens when a memory tag goes over its budget
+  enum class MemoryBudgetPolicy
+  {
+    Warn,     // log a warning when a tag goes over budget
+    FailFast  // log and exit the process when a tag goes over budget
+  };
+
+  // Memory budgets limit how much memory every memory tag is allowed to use
+  // The usage of every tag is recorded every frame and kept for the last frames, to be shown in a graph or dumped to a csv file
+  // A tag that goes over its budget is reported once, it's reported again when it went back under its budget and over it again
+  // Budgets are set from the settings under the "memory_budgets" header, in MiB per memory tag.
+  // Memory budgets are only updated and queried from the main thread
+  class MemoryBudgets
+  {
+  public:
+    using UsagePerTag = rsl::array<s64, rsl::enum_refl::enum_count<MemoryTag>()>;
+
+    MemoryBudgets();
+
+    // Set the budget of a memory tag in bytes, 0 means the tag has no budget
+    void set_budget(MemoryTag tag, s64 budget);
+    s64 budget(MemoryTag tag) const;
+    void set_policy(MemoryBudgetPolicy policy);
+    MemoryBudgetPolicy policy() const;
+
+    // Load the budgets and policy from the settings
+    void load_from_settings();
+
+    // Record the usage per tag of a frame and check it against the budgets
+    void record_frame(card32 frameIdx, const MemoryAllocationStats::UsagePerTag& usagePerTag);
+    void record_frame(card32 frameIdx, const UsagePerTag& usagePerTag);
+
+    // Return true if the tag was over its budget in the last recorded frame
+    bool is_over_budget(MemoryTag tag) const;
+
+    // Return the number of frames that are recorded, up to the history size
+    s32 num_recorded_frames() const;
+    // Return the usage of a tag in a recorded frame, 0 is the oldest recorded frame
+    s64 usage(MemoryTag tag, s32 idx) const;
+    // Return the frame index of a recorded frame, 0 is the oldest recorded frame
+    card32 frame_index(s32 idx) const;
+    // Return the usage of a tag in all recorded frames, from oldest to newest
+    // Useful to show the usage of a tag in a graph
+    debug_vector<f32> usage_series(MemoryTag tag) const;
+
+    // Write the usage of every tag in every recorded frame to a csv file
+    void dump_to_csv(rsl::string_view filepath) const;
+
+  private:
+    // Return the index in the ring buffer of a recorded frame, 0 is the oldest recorded frame
+    s32 ring_index(s32 idx) const;
+
+  private:
+    UsagePerTag m_budgets;
+    rsl::array<bool, rsl::enum_refl::enum_count<MemoryTag>()> m_is_over_budget;
+    rsl::array<UsagePerTag, g_memory_budget_history_size> m_history;
+    rsl::array<card32, g_memory_budget_history_size> m_frame_indices;
+    s32 m_next_history_idx;
+    s32 m_num_recorded_frames;
+    MemoryBudgetPolicy m_policy;
+  };
+
+  // The memory budgets of the process, like the memory tracker, it exists before anything else
+  MemoryBudgets& mem_budgets();
+} // namespace rex
@@ -21,6 +21,21 @@ namespace rex
     MemoryTag tag() const;
     card32 frame_index() const;
 
+    // Returns true if the callstack of the allocation got captured
+    // Callstacks are only captured for a sample of the allocations
+    bool has_callstack() const;
+
+    // The shard of the memory tracker the header is tracked in and its index in that shard's list of headers
+    // This allows the tracker to remove the header in constant time
+    void set_tracking_shard(s32 shard);
+    s32 tracking_shard() const;
+    void set_tracking_index(s32 idx);
+    s32 tracking_index() const;
+
+    // The id the allocation got in the allocation trace, 0 if it wasn't recorded
+    void set_trace_id(card32 id);
+    card32 trace_id() const;
+
   private:
     CallStack m_callstack;       // the callstack for this allocation
     rsl::memory_size m_size;     // size of the memory allocated
@@ -28,6 +43,9 @@ namespace rex
     rsl::thread::id m_thread_id; // the thread id this was allocated on
     MemoryTag m_tag;             // memory tag that allocated this memory
     card32 m_frame_idx;          // frame index when this memory was allocated
+    s32 m_tracking_shard;        // shard of the memory tracker tracking this header
+    s32 m_tracking_idx;          // index of this header in its memory tracker shard
+    card32 m_trace_id;           // id of this allocation in the allocation trace
 
   };
 
@@ -8,7 +8,9 @@
 #include "rex_engine/memory/memory_types.h"
 #include "rex_engine/memory/allocators/untracked_allocator.h"
 #include "rex_engine/diagnostics/stacktrace.h"
+#include "rex_engine/threading/spin_lock.h"
 #include "rex_std/array.h"
+#include "rex_std/atomic.h"
 #include "rex_std/bonus/attributes.h"
 #include "rex_std/bonus/defines.h"
 #include "rex_std/bonus/memory/memory_size.h"
@@ -62,6 +64,48 @@ namespace rex
     debug_vector<CallStack> deleter_callstacks;
   };
 
+  // Capturing a callstack walks the stack, which costs more than the allocation itself
+  // so by default only every nth allocation captures one. This can be changed in the boot settings
+#ifdef REX_MEM_TRACKING_CALLSTACK_SAMPLE_RATE
+  inline constexpr card32 g_default_callstack_sample_rate = REX_MEM_TRACKING_CALLSTACK_SAMPLE_RATE;
+#else
+  inline constexpr card32 g_default_callstack_sample_rate = 64;
+#endif
+
+#ifdef REX_MEM_TRACKING_SHARDS
+  inline constexpr s32 g_num_mem_tracking_shards = REX_MEM_TRACKING_SHARDS;
+#else
+  inline constexpr s32 g_num_mem_tracking_shards = 16;
+#endif
+
+  namespace internal
+  {
+    // A shard of the memory tracker
+    // Threads are spread over the shards, so threads allocating at the same time rarely touch the same shard
+    // The global view is only built when the stats are queried
+    struct alignas(64) MemoryTrackingShard
+    {
+      // The usage of the allocations made on threads of this shard that are still alive
+      // Allocations freed on a thread of another shard are still subtracted from this shard, so the usage never goes negative
+      rsl::array<rsl::atomic<s64>, rsl::enum_refl::enum_count<MemoryTag>()> usage_per_tag;
+      rsl::atomic<s64> used_memory;
+      // The peaks are updated on every allocation, so short lived spikes between 2 queries aren't missed
+      rsl::array<rsl::atomic<s64>, rsl::enum_refl::enum_count<MemoryTag>()> max_usage_per_tag;
+      rsl::atomic<s64> max_used_memory;
+      rsl::atomic<s32> num_total_allocations;
+
+      // The headers of the allocations made on threads of this shard
+      // every header knows its own index, so it can be swapped out on removal
+      debug_vector<MemoryHeader*> allocation_headers;
+      SpinLock allocation_headers_lock;
+    };
+  } // namespace internal
+
+  // The memory tracker keeps track of every allocation made through a tracked allocator
+  // Tracking and untracking an allocation is constant time, no matter how many allocations are alive.
+  // Allocations are tracked in per thread shards, so tracking doesn't serialize threads that allocate at the same time
+  // Capturing callstacks is by far the most expensive part of tracking
+  // so they're only captured for a sample of the allocations
   class MemoryTracker
   {
   public:
@@ -85,6 +129,11 @@ namespace rex
 
     MemoryTag current_tag() const;
 
+    // Capture the callstack of every nth allocation, 0 disables capturing callstacks
+    // Only allocations with a callstack show up in the callstack stats
+    void set_callstack_sample_rate(card32 sampleRate);
+    card32 callstack_sample_rate() const;
+
     void dump_stats_to_file(rsl::string_view filepath);
 
     REX_NO_DISCARD MemoryAllocationStats current_tracking_stats();
@@ -95,16 +144,26 @@ namespace rex
     REX_NO_DISCARD MemoryTrackingStats get_stats_for_frame(card32 idx);
 
   private:
-    // stores the headers for all allocations
-    debug_vector<MemoryHeader*> m_allocation_headers;
+    // Returns true if the callstack of the next allocation should be captured
+    bool should_capture_callstack();
+
+    // Returns the shard of the calling thread
+    internal::MemoryTrackingShard& current_shard();
+
+    // Copy the headers of all shards into a single list
+    debug_vector<MemoryHeader*> gather_allocation_headers();
+
+  private:
+    rsl::array<internal::MemoryTrackingShard, g_num_mem_tracking_shards> m_shards;
+    // Holds the allocation info of the allocations that got their callstack captured
     debug_hash_map<CallStack, AllocationInfo> m_allocation_info_table;
-    rsl::high_water_mark<s64> m_mem_usage; // current memory usage
     s64 m_max_mem_budget;                  // maximum allowed memory usage
     MemoryStats m_mem_stats_on_startup;    // stats queried from the OS at init time
-    rsl::mutex m_mem_tracking_mutex;
-    UsagePerTag m_usage_per_tag;
+    rsl::mutex m_mem_tracking_mutex;       // guards the allocation info table
     bool m_is_active;
-    s32 m_num_total_allocations;
+    rsl::atomic<s32> m_next_shard;
+    rsl::atomic<card32> m_callstack_sample_rate;
+    rsl::atomic<card32> m_num_callstack_candidates;
   };
 
   // an object that pushes a memory tag on construction
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+
+#include "rex_std/bonus/memory.h"
+
+namespace rex
+{
+  // The number of bytes reserved by arenas that aren't given an explicit reserve size
+  // This only claims addresses, physical memory is only used for the part that's committed
+  // 32 bit processes don't have the address space to spare, so they reserve less
+#ifdef REX_VIRTUAL_ARENA_DEFAULT_RESERVE_SIZE
+  inline constexpr s64 g_virtual_arena_default_reserve_size = REX_VIRTUAL_ARENA_DEFAULT_RESERVE_SIZE;
+#else
+  inline constexpr s64 g_virtual_arena_default_reserve_size = sizeof(void*) == 8 ? 256_mib : 16_mib;
+#endif
+
+  // The number of bytes reserved by the scratch arena of every thread, other than the one that created the engine globals
+  // Every thread using scratch memory gets its own arena, so this is kept smaller than the default
+#ifdef REX_THREAD_SCRATCH_DEFAULT_RESERVE_SIZE
+  inline constexpr s64 g_thread_scratch_default_reserve_size = REX_THREAD_SCRATCH_DEFAULT_RESERVE_SIZE;
+#else
+  inline constexpr s64 g_thread_scratch_default_reserve_size = sizeof(void*) == 8 ? 16_mib : 1_mib;
+#endif
+
+  // An arena grows its committed memory in steps of at least this size, to avoid a system call for every page
+#ifdef REX_VIRTUAL_ARENA_COMMIT_SIZE
+  inline constexpr s64 g_virtual_arena_commit_size = REX_VIRTUAL_ARENA_COMMIT_SIZE;
+#else
+  inline constexpr s64 g_virtual_arena_commit_size = 64_kib;
+#endif
+
+  // A virtual arena reserves a range of addresses up front and commits the pages at the front of it on demand
+  // The memory of the arena never moves, so it can grow without invalidating pointers into it
+  class VirtualArena
+  {
+  public:
+    explicit VirtualArena(s64 reserveSize);
+    VirtualArena(const VirtualArena&) = delete;
+    VirtualArena(VirtualArena&& other);
+    ~VirtualArena();
+
+    VirtualArena& operator=(const VirtualArena&) = delete;
+    VirtualArena& operator=(VirtualArena&& other);
+
+    // Make sure the first size bytes of the arena are committed
+    // Returns false if the size is bigger than the reserved range or the OS ran out of memory
+    bool commit_up_to(s64 size);
+    // Decommit all pages that are completely past the first size bytes of the arena
+    void decommit_after(s64 size);
+
+    rsl::byte* base() const;
+    s64 reserved_size() const;
+    s64 committed_size() const;
+
+    // Return true if the pointer points inside the committed part of the arena
+    bool is_committed(const void* ptr) const;
+
+  private:
+    void release();
+
+  private:
+    rsl::byte* m_base;
+    s64 m_reserved_size;
+    s64 m_committed_size;
+  };
+} // namespace rex
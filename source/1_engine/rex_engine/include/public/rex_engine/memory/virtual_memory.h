@@ -0,0 +1,29 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+
+namespace rex
+{
+  // Direct access to the virtual memory of the process
+  // Reserving claims a range of addresses without using any physical memory
+  // pages of a reserved range only use physical memory once they're committed
+  namespace vmem
+  {
+    // The granularity memory is committed in
+    s64 page_size();
+    // The granularity memory is reserved in, reserved ranges start at a multiple of this
+    s64 allocation_granularity();
+
+    // Reserve a range of addresses, returns nullptr if the range couldn't be reserved
+    // The size gets rounded up to the allocation granularity
+    void* reserve(s64 size);
+    // Make pages of a reserved range usable, the memory is zero initialized on first commit
+    // ptr and size need to be page aligned, returns false if the memory couldn't be committed
+    bool commit(void* ptr, s64 size);
+    // Give the physical memory of committed pages back to the OS, the addresses stay reserved
+    // ptr and size need to be page aligned
+    void decommit(void* ptr, s64 size);
+    // Release a range returned by reserve, size needs to be the size the range was reserved with
+    void release(void* ptr, s64 size);
+  } // namespace vmem
+} // namespace rex
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace rex
+{
+  namespace file
+  {
+    namespace internal
+    {
+      // The max number of reads that are in flight at the same time on a ring
+#ifdef REX_IO_RING_QUEUE_DEPTH
+      inline constexpr s32 g_io_ring_queue_depth = REX_IO_RING_QUEUE_DEPTH;
+#else
+      inline constexpr s32 g_io_ring_queue_depth = 64;
+#endif
+
+      // The completion of a read on the ring
+      struct IoRingCompletion
+      {
+        u64 user_data; // the user data given when the read was queued
+        s32 result;    // the number of bytes read or a negative errno
+      };
+
+      // A minimal io_uring, talking to the kernel through the raw syscalls
+      // The kernel reads all queued reads of a submission in parallel and posts their completions to the ring
+      // A ring is meant to be used by a single thread
+      class IoRing
+      {
+      public:
+        IoRing();
+        IoRing(const IoRing&) = delete;
+        IoRing(IoRing&&) = delete;
+        ~IoRing();
+
+        IoRing& operator=(const IoRing&) = delete;
+        IoRing& operator=(IoRing&&) = delete;
+
+        // Returns false if the kernel doesn't support io_uring or doesn't allow us to use it
+        bool is_valid() const;
+        // Returns the number of reads that can be queued before they need to be submitted
+        // Reads that are still in flight count as well, so their completions always fit in the completion queue
+        s32 num_free_entries() const;
+
+        // Queue a read into any buffer
+        void queue_read(s32 fd, void* buffer, s32 size, s64 offset, u64 userData);
+        // Submit all queued reads in a single syscall and wait for at least this many to complete
+        // Returns false if the submission failed
+        bool submit_and_wait(s32 numToWaitFor);
+        // Pop the oldest completion, returns false if there are none
+        bool pop_completion(IoRingCompletion& outCompletion);
+        // Drop all reads that are queued but not submitted, wait for the ones in flight and throw away their completions
+        // This is used when a submission failed, so the next batch on this ring doesn't receive completions of this one
+        // If the reads in flight can't be waited for, the ring is closed and the thread reads with pread from then on
+        void discard_reads();
+
+      private:
+        io_uring_sqe* next_sqe();
+        void release();
+
+      private:
+        s32 m_fd;
+        s32 m_num_entries;
+        s32 m_num_cq_entries;
+        s32 m_num_unsubmitted;
+        s32 m_num_in_flight; // reads that are queued or submitted, but not popped from the completion queue yet
+
+        // submission queue ring, shared with the kernel
+        void* m_sq_ring;
+        s64 m_sq_ring_size;
+        u32* m_sq_head;
+        u32* m_sq_tail;
+        u32* m_sq_mask;
+        u32* m_sq_array;
+        io_uring_sqe* m_sqes;
+        s64 m_sqes_size;
+
+        // completion queue ring, shared with the kernel
+        void* m_cq_ring;
+        s64 m_cq_ring_size;
+        u32* m_cq_head;
+        u32* m_cq_tail;
+        u32* m_cq_mask;
+        io_uring_cqe* m_cqes;
+      };
+
+      // Returns the ring of the calling thread, created on first use
+      // Returns nullptr if io_uring isn't available, reads should fall back to pread
+      IoRing* thread_io_ring();
+    } // namespace internal
+  }   // namespace file
+} // namespace rex
@@ -3,6 +3,9 @@
 #include "rex_std/bonus/memory.h"
 
 #include "rex_engine/engine/types.h"
+#include "rex_engine/filesystem/vfs_constants.h"
+#include "rex_engine/memory/memory_tracking.h"
+#include "rex_engine/memory/virtual_arena.h"
 
 namespace rex
 {
@@ -10,5 +13,11 @@ namespace rex
 	{
 		s64 single_frame_heap_size = 4_kib;
 		s64 scratch_heap_size = 4_kib;
+		s64 scratch_heap_reserve_size = g_virtual_arena_default_reserve_size; // the size the scratch heap can grow to when an allocation doesn't fit
+		s64 thread_scratch_heap_reserve_size = g_thread_scratch_default_reserve_size; // the size the scratch heap of every other thread can grow to
+		bool use_engine_heap = false; // serve small allocations from the engine's size class heap instead of the OS
+		s64 alloc_sample_rate = 0; // sample an allocation about every this many bytes for memory profiling, 0 disables it
+		card32 callstack_sample_rate = g_default_callstack_sample_rate; // capture the callstack of every nth tracked allocation, 0 disables it
+		s32 num_io_workers = g_vfs_default_num_io_workers; // the number of threads reading files for async read requests
 	};
 }
\ No newline at end of file
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/engine/defines.h"
+#include "rex_engine/engine/types.h"
+#include "rex_engine/filesystem/read_request.h"
+#include "rex_engine/task_system/job_counter.h"
+#include "rex_engine/task_system/task.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_std/atomic.h"
+#include "rex_std/optional.h"
+
+// Coroutines allow async code to be written linearly without blocking the thread it runs on
+// Every co_await suspends the coroutine, freeing up the thread, until what it waits on has finished
+//
+// eg.
+// rex::Coroutine<void> load_map(rex::PathId path)
+// {
+//   rex::ReadRequest request = co_await rex::vfs::instance()->read_file_async(path);
+//   Map* map = co_await rex::run_async([&]() { return parse_map(request.data(), request.count()); });
+//   co_await rex::next_frame();
+//   activate_map(map);
+// }
+//
+// A coroutine can be resumed by the task system, the frame waiters or a read request at any time
+// so dropping the Coroutine returned before it finished doesn't destroy it. Instead the coroutine
+// keeps running and destroys itself when it finishes. Call detach() to make this explicit
+//
+// load_map(rex::PathId::create(rex::vfs::instance()->abs_path("maps/pallet_town.json"))).detach();
+//
+// Coroutines require C++20, which every project of the solution is compiled with
+// code including this header with an older standard doesn't see the coroutine types
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+  #define REX_HAS_COROUTINES
+  #include <coroutine>
+#endif
+
+namespace rex
+{
+  namespace task_system
+  {
+    // Resume all coroutines that are waiting for the next frame
+    // This is called by the application at the start of every frame
+    void resume_frame_waiters();
+
+    // Return the number of coroutines waiting for the next frame
+    s32 num_frame_waiters();
+  } // namespace task_system
+
+#ifdef REX_HAS_COROUTINES
+  namespace task_system
+  {
+    namespace internal
+    {
+      // Add a coroutine that gets resumed at the start of the next frame
+      void add_frame_waiter(std::coroutine_handle<> coroutine);
+
+      // Queue a job on the task system that resumes the coroutine
+      void resume_on_task_system(std::coroutine_handle<> coroutine);
+
+      // The state of a coroutine with regards to the coroutine awaiting it
+      enum class CoroutineState
+      {
+        Running,  // The coroutine is running, no one is awaiting it yet
+        Awaited,  // Another coroutine has suspended itself until this one finishes
+        Detached, // No one owns the coroutine anymore, it destroys itself when it finishes
+        Finished  // The coroutine has finished, awaiting it won't suspend anymore
+      };
+
+      // The part of the coroutine promise that doesn't depend on the return type
+      class CoroutinePromiseBase
+      {
+      public:
+        CoroutinePromiseBase()
+            : m_state(CoroutineState::Running)
+            , m_continuation()
+        {
+        }
+
+        // Coroutines start executing immediately when called
+        std::suspend_never initial_suspend() noexcept
+        {
+          return {};
+        }
+
+        // When the coroutine finishes, resume the coroutine that's awaiting it, if any
+        // The coroutine stays suspended, so its result can still be read.
+        // It gets destroyed when the Coroutine object referencing it gets destroyed
+        // or right here if it got detached
+        auto final_suspend() noexcept
+        {
+          struct FinalAwaiter
+          {
+            bool await_ready() noexcept
+            {
+              return false;
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> coroutine) noexcept
+            {
+              const CoroutineState previous_state = promise->m_state.exchange(CoroutineState::Finished);
+              if(previous_state == CoroutineState::Awaited)
+              {
+                return promise->m_continuation;
+              }
+              if(previous_state == CoroutineState::Detached)
+              {
+                coroutine.destroy();
+              }
+              return std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+
+            CoroutinePromiseBase* promise;
+          };
+
+          return FinalAwaiter {this};
+        }
+
+        void unhandled_exception()
+        {
+          REX_ASSERT("Unhandled exception in coroutine");
+        }
+
+        // Set the coroutine to resume when this coroutine finishes
+        // returns false if this coroutine has finished already, in which case the continuation isn't resumed
+        bool set_continuation(std::coroutine_handle<> continuation)
+        {
+          m_continuation = continuation;
+          return m_state.exchange(CoroutineState::Awaited) != CoroutineState::Finished;
+        }
+
+        // Returns true if the coroutine has finished
+        bool is_finished() const
+        {
+          return m_state.load() == CoroutineState::Finished;
+        }
+
+        // Give up ownership of the coroutine, so it destroys itself when it finishes
+        // returns true if the coroutine has finished already, in which case the caller needs to destroy it
+        bool detach()
+        {
+          const CoroutineState previous_state = m_state.exchange(CoroutineState::Detached);
+          REX_ASSERT_X(previous_state != CoroutineState::Awaited, "Detaching a coroutine that's being awaited");
+          return previous_state == CoroutineState::Finished;
+        }
+
+      private:
+        rsl::atomic<CoroutineState> m_state;
+        std::coroutine_handle<> m_continuation;
+      };
+    } // namespace internal
+  } // namespace task_system
+
+  // The return type of a coroutine
+  // The coroutine starts executing immediately when it's called, up until its first suspension point
+  // Other coroutines can co_await it to suspend until it has finished
+  // Discarding it detaches the coroutine, which is rarely intended, use detach() when it is
+  template <typename T>
+  class REX_NO_DISCARD Coroutine;
+
+  namespace task_system
+  {
+    namespace internal
+    {
+      // The promise of coroutines that return a value
+      template <typename T>
+      class CoroutinePromise : public CoroutinePromiseBase
+      {
+      public:
+        Coroutine<T> get_return_object();
+
+        template <typename U>
+        void return_value(U&& value)
+        {
+          m_result = rsl::forward<U>(value);
+        }
+
+        T& result()
+        {
+          return m_result.value();
+        }
+
+      private:
+        rsl::optional<T> m_result;
+      };
+
+      // The promise of coroutines that don't return anything
+      template <>
+      class CoroutinePromise<void> : public CoroutinePromiseBase
+      {
+      public:
+        Coroutine<void> get_return_object();
+
+        void return_void() {}
+
+        void result() {}
+      };
+    } // namespace internal
+  } // namespace task_system
+
+  template <typename T>
+  class REX_NO_DISCARD Coroutine
+  {
+  public:
+    using promise_type = task_system::internal::CoroutinePromise<T>;
+
+    explicit Coroutine(std::coroutine_handle<promise_type> coroutine)
+        : m_coroutine(coroutine)
+    {
+    }
+    Coroutine(const Coroutine&) = delete;
+    Coroutine(Coroutine&& other)
+        : m_coroutine(rsl::exchange(other.m_coroutine, nullptr))
+    {
+    }
+    ~Coroutine()
+    {
+      detach();
+    }
+
+    Coroutine& operator=(const Coroutine&) = delete;
+    Coroutine& operator=(Coroutine&& other)
+    {
+      detach();
+      m_coroutine = rsl::exchange(other.m_coroutine, nullptr);
+      return *this;
+    }
+
+    // Let the coroutine run to completion without anyone owning it
+    // A finished coroutine gets destroyed right away, otherwise it destroys itself when it finishes
+    // Its result can't be accessed anymore afterwards
+    void detach()
+    {
+      if(m_coroutine)
+      {
+        if(m_coroutine.promise().detach())
+        {
+          m_coroutine.destroy();
+        }
+        m_coroutine = nullptr;
+      }
+    }
+
+    // Returns true if the coroutine has finished
+    bool is_finished() const
+    {
+      return m_coroutine.promise().is_finished();
+    }
+
+    // Return the result of the coroutine
+    // The coroutine needs to have finished before the result can be accessed
+    decltype(auto) result()
+    {
+      REX_ASSERT_X(is_finished(), "Accessing the result of a coroutine that hasn't finished yet");
+      return m_coroutine.promise().result();
+    }
+
+    // Suspend the awaiting coroutine until this coroutine has finished
+    auto operator co_await() &
+    {
+      struct Awaiter
+      {
+        bool await_ready()
+        {
+          return coroutine.promise().is_finished();
+        }
+        bool await_suspend(std::coroutine_handle<> awaitingCoroutine)
+        {
+          return coroutine.promise().set_continuation(awaitingCoroutine);
+        }
+        decltype(auto) await_resume()
+        {
+          return coroutine.promise().result();
+        }
+
+        std::coroutine_handle<promise_type> coroutine;
+      };
+
+      return Awaiter {m_coroutine};
+    }
+    auto operator co_await() &&
+    {
+      // The awaiter takes ownership, so the coroutine stays alive until its result is read
+      struct Awaiter
+      {
+        bool await_ready()
+        {
+          return coroutine.is_finished();
+        }
+        bool await_suspend(std::coroutine_handle<> awaitingCoroutine)
+        {
+          return coroutine.m_coroutine.promise().set_continuation(awaitingCoroutine);
+        }
+        auto await_resume()
+        {
+          if constexpr(!rsl::is_same_v<void, T>)
+          {
+            return rsl::move(coroutine.result());
+          }
+        }
+
+        Coroutine coroutine;
+      };
+
+      return Awaiter {rsl::move(*this)};
+    }
+
+  private:
+    std::coroutine_handle<promise_type> m_coroutine;
+  };
+
+  namespace task_system
+  {
+    namespace internal
+    {
+      template <typename T>
+      Coroutine<T> CoroutinePromise<T>::get_return_object()
+      {
+        return Coroutine<T>(std::coroutine_handle<CoroutinePromise<T>>::from_promise(*this));
+      }
+      inline Coroutine<void> CoroutinePromise<void>::get_return_object()
+      {
+        return Coroutine<void>(std::coroutine_handle<CoroutinePromise<void>>::from_promise(*this));
+      }
+    } // namespace internal
+
+    // Suspend the awaiting coroutine until the task has finished
+    // The coroutine gets resumed on the task system by a job that runs after the task
+    template <typename ReturnType>
+    auto operator co_await(Task<ReturnType> task)
+    {
+      struct Awaiter
+      {
+        bool await_ready()
+        {
+          return task.is_finished();
+        }
+        void await_suspend(std::coroutine_handle<> awaitingCoroutine)
+        {
+          JobCounter dependencies;
+          dependencies.add(task);
+          add_job_after(internal::create_job([awaitingCoroutine]() { awaitingCoroutine.resume(); }), dependencies);
+        }
+        decltype(auto) await_resume()
+        {
+          if constexpr(!rsl::is_same_v<void, ReturnType>)
+          {
+            return task.result();
+          }
+        }
+
+        Task<ReturnType> task;
+      };
+
+      return Awaiter {rsl::move(task)};
+    }
+  } // namespace task_system
+
+  // Suspend the awaiting coroutine until the read request has finished
+  // The coroutine gets resumed on the task system and receives the finished request
+  inline auto operator co_await(ReadRequest request)
+  {
+    struct Awaiter
+    {
+      bool await_ready()
+      {
+        return request.is_done();
+      }
+      void await_suspend(std::coroutine_handle<> awaitingCoroutine)
+      {
+        request.when_done([awaitingCoroutine]() { task_system::internal::resume_on_task_system(awaitingCoroutine); });
+      }
+      ReadRequest await_resume()
+      {
+        return rsl::move(request);
+      }
+
+      ReadRequest request;
+    };
+
+    return Awaiter {rsl::move(request)};
+  }
+
+  // Suspend the awaiting coroutine until the start of the next frame
+  // The coroutine gets resumed on the main thread
+  inline auto next_frame()
+  {
+    struct Awaiter
+    {
+      bool await_ready()
+      {
+        return false;
+      }
+      void await_suspend(std::coroutine_handle<> awaitingCoroutine)
+      {
+        task_system::internal::add_frame_waiter(awaitingCoroutine);
+      }
+      void await_resume() {}
+    };
+
+    return Awaiter {};
+  }
+#endif
+} // namespace rex
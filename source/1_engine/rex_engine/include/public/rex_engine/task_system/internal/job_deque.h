@@ -0,0 +1,55 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/task_system/job.h"
+#include "rex_engine/threading/spin_lock.h"
+#include "rex_std/memory.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    namespace internal
+    {
+      // A double ended queue of jobs, used by the job scheduler.
+      // Every worker owns one of these. The owner pushes and pops at the back
+      // so the job that was queued last (and is most likely still in cache) runs first.
+      // Other workers steal from the front when they've run out of work themselves.
+      // Each deque has its own lock, so workers only contend with each other when stealing
+      class JobDeque
+      {
+      public:
+        JobDeque();
+
+        // Add a job at the back of the deque
+        void push_back(JobHandle&& job);
+
+        // Remove the job at the back of the deque and return it
+        // returns an empty handle if the deque is empty
+        JobHandle pop_back();
+
+        // Remove the job at the front of the deque and return it
+        // returns an empty handle if the deque is empty
+        JobHandle steal();
+
+        // Returns the number of jobs in the deque
+        s32 size() const;
+
+      private:
+        // Double the capacity of the ring buffer, keeping the order of the jobs
+        void grow();
+
+      private:
+        // The ring buffer holding the jobs, its size is always a power of 2
+        rsl::vector<JobHandle> m_jobs;
+        // The index of the front of the deque within the ring buffer
+        s32 m_head;
+        // The number of jobs currently in the deque
+        s32 m_count;
+        // Lock that needs to be held when accessing the ring buffer
+        mutable SpinLock m_access_lock;
+      };
+    } // namespace internal
+  } // namespace task_system
+} // namespace rex
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/task_system/job.h"
+#include "rex_engine/threading/spin_lock.h"
+#include "rex_std/memory.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    namespace internal
+    {
+      // A pool of jobs that get recycled after they finished
+      // Jobs are allocated in blocks and are never freed until the pool is destroyed.
+      // Once the pool has grown to the number of jobs that are alive at the same time
+      // acquiring a job doesn't allocate anymore
+      class JobPool
+      {
+      public:
+        JobPool();
+        JobPool(const JobPool&) = delete;
+        JobPool(JobPool&&)      = delete;
+        ~JobPool();
+
+        JobPool& operator=(const JobPool&) = delete;
+        JobPool& operator=(JobPool&&)      = delete;
+
+        // Take a job from the pool, growing the pool if no free jobs are left
+        JobHandle acquire();
+        // Return a job that's no longer referenced back to the pool
+        void release(Job* job);
+
+        // Return the number of jobs allocated by the pool
+        s32 num_allocated_jobs() const;
+
+      private:
+        // Allocate a new block of jobs and add them to the free list
+        void grow();
+
+      private:
+        // The blocks of jobs allocated by the pool
+        rsl::vector<rsl::unique_array<Job>> m_blocks;
+        // The first job in the intrusive list of free jobs
+        Job* m_first_free_job;
+        // Lock that needs to be held when accessing the free list
+        mutable SpinLock m_access_lock;
+      };
+
+      // Return the global pool all jobs are allocated from
+      JobPool& job_pool();
+    } // namespace internal
+  } // namespace task_system
+} // namespace rex
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    namespace internal
+    {
+      // The maximum number of workers that can execute jobs at the same time
+#ifdef REX_MAX_TASK_WORKERS
+      inline constexpr s32 g_max_task_workers = REX_MAX_TASK_WORKERS;
+#else
+      inline constexpr s32 g_max_task_workers = 64;
+#endif
+
+      // The number of normal jobs that can be picked while a background job is pending
+      // after which the background job goes first, so a steady stream of normal jobs can't starve background work
+#ifdef REX_MAX_NORMAL_PICKS_OVER_BACKGROUND
+      inline constexpr s32 g_max_normal_picks_over_background = REX_MAX_NORMAL_PICKS_OVER_BACKGROUND;
+#else
+      inline constexpr s32 g_max_normal_picks_over_background = 8;
+#endif
+    } // namespace internal
+  } // namespace task_system
+} // namespace rex
@@ -1,42 +1,243 @@
 #pragma once
 
+#include "rex_engine/engine/types.h"
+#include "rex_engine/task_system/job_handle.h"
+#include "rex_engine/threading/spin_lock.h"
 #include "rex_engine/threading/thread_event.h"
-#include "rex_std/functional.h"
+#include "rex_std/atomic.h"
 #include "rex_std/memory.h"
+#include "rex_std/type_traits.h"
+#include "rex_std/vector.h"
 
 namespace rex
 {
   namespace task_system
   {
-    using job_callable = rsl::function<rsl::unique_array<rsl::byte>()>;
+    namespace internal
+    {
+      class JobPool;
+    } // namespace internal
+
+    // The priority of a job determines the order in which pending jobs get picked up
+    // A job of a higher priority doesn't wait on a pending job of a lower priority
+    // except that a pending background job goes before normal jobs after it got passed over by a few of them
+    enum class JobPriority
+    {
+      FrameCritical, // Work that the current frame is waiting on
+      Normal,        // Default priority
+      Background     // Long running work (eg. IO) that's allowed to take multiple frames
+    };
+
+    // Determines which threads are allowed to execute a job
+    enum class JobAffinity
+    {
+      AnyThread, // The job can get executed by any worker
+      MainThread // The job only gets executed on the main thread, when it drains its job queue
+    };
+
+#ifdef REX_JOB_CALLABLE_STORAGE_SIZE
+    inline constexpr card32 g_job_callable_storage_size = REX_JOB_CALLABLE_STORAGE_SIZE;
+#else
+    inline constexpr card32 g_job_callable_storage_size = 128;
+#endif
+
+#ifdef REX_JOB_RESULT_STORAGE_SIZE
+    inline constexpr card32 g_job_result_storage_size = REX_JOB_RESULT_STORAGE_SIZE;
+#else
+    inline constexpr card32 g_job_result_storage_size = 64;
+#endif
 
     // A job is a wrapper around a callable
     // It can possibly return a result which is the return type of the callable
     // A user is not expect to create a job themselves, instead they should
     // use the task system api to run code async which will create a job for the user
+    //
+    // Jobs are recycled through a pool, they're never created or destroyed on the hot path.
+    // The callable and its result are stored inline in the job when they fit
+    // only callables and results bigger than the inline storage fall back to a heap allocation
     class Job
     {
     public:
-      explicit Job(job_callable&& callable);
+      Job();
+      Job(const Job&) = delete;
+      Job(Job&&)      = delete;
+      ~Job();
+
+      Job& operator=(const Job&) = delete;
+      Job& operator=(Job&&)      = delete;
+
+      // Store the callable to be executed by this job
+      template <typename Callable>
+      void set_callable(Callable&& callable)
+      {
+        using callable_type = rsl::decay_t<Callable>;
+        using return_type   = rsl::invoke_result_t<callable_type&>;
+
+        void* callable_mem = store_callable<callable_type>(rsl::forward<Callable>(callable));
+
+        // Type erase the callable so the job itself doesn't need to be templated
+        m_invoke_func = [](Job& job)
+        {
+          callable_type& stored_callable = *static_cast<callable_type*>(job.m_callable);
+          if constexpr(rsl::is_same_v<void, return_type>)
+          {
+            stored_callable();
+          }
+          else
+          {
+            job.store_result<return_type>(stored_callable());
+          }
+        };
+        m_destroy_callable_func = [](Job& job)
+        {
+          destroy_object<callable_type>(job.m_callable, job.m_callable_storage);
+        };
+        m_callable = callable_mem;
+      }
 
       // Run the callable that's internally stored
+      // Afterwards, all jobs waiting on this one get queued if this was their last dependency
       void run();
 
       // Wait for the callable to finish, this only makes sense
       // if the job is run on a different thread
       void wait_for_me();
 
+      // Returns true if the callable has finished running
+      bool is_finished() const;
+
+      // Add a job that needs to run after this job has finished
+      // Returns false if this job has already finished, in which case the continuation isn't stored
+      bool add_continuation(const JobHandle& job);
+
+      // Add a dependency that needs to finish before this job is allowed to run
+      void add_dependency();
+      // Mark a dependency of this job as finished
+      // Returns true if this was the last dependency, meaning the job can be queued
+      bool release_dependency();
+
+      // Set the priority and affinity of the job, this needs to happen before the job gets queued
+      void set_priority(JobPriority priority);
+      void set_affinity(JobAffinity affinity);
+      JobPriority priority() const;
+      JobAffinity affinity() const;
+
+      // Mark the job as queued, used to measure how long it waits before it starts
+      void mark_submitted(s64 submitTime);
+      // Return the time the job got queued, 0 if it hasn't been queued yet
+      s64 submit_time() const;
+
+      // Add a reference to the job, the job stays alive as long as it's referenced
+      void add_ref();
+      // Remove a reference to the job
+      // When the last reference is removed, the job is returned to the pool
+      void release_ref();
+
       // Return the results of the callable
       template <typename T>
       T& result()
       {
-        return *reinterpret_cast<T*>(m_result_buffer.get());
+        return *static_cast<T*>(m_result);
+      }
+
+    private:
+      // Return true if an object of type T fits in inline storage of the given size
+      template <typename T, card32 StorageSize>
+      static constexpr bool fits_inline()
+      {
+        return sizeof(T) <= StorageSize && alignof(T) <= alignof(rsl::max_align);
+      }
+
+      // Store the callable inline if possible, otherwise allocate it on the heap
+      template <typename CallableType, typename Callable>
+      void* store_callable(Callable&& callable)
+      {
+        if constexpr(fits_inline<CallableType, g_job_callable_storage_size>())
+        {
+          return new(m_callable_storage) CallableType(rsl::forward<Callable>(callable));
+        }
+        else
+        {
+          return new CallableType(rsl::forward<Callable>(callable));
+        }
+      }
+
+      // Store the result inline if possible, otherwise allocate it on the heap
+      template <typename ResultType>
+      void store_result(ResultType&& result)
+      {
+        using result_type = rsl::decay_t<ResultType>;
+        if constexpr(fits_inline<result_type, g_job_result_storage_size>())
+        {
+          m_result = new(m_result_storage) result_type(rsl::forward<ResultType>(result));
+        }
+        else
+        {
+          m_result = new result_type(rsl::forward<ResultType>(result));
+        }
+
+        m_destroy_result_func = [](Job& job)
+        {
+          destroy_object<result_type>(job.m_result, job.m_result_storage);
+        };
       }
 
+      // Destroy an object stored by the job, freeing it if it didn't live in the inline storage
+      template <typename T>
+      static void destroy_object(void* object, rsl::byte* inlineStorage)
+      {
+        T* typed_object = static_cast<T*>(object);
+        if(object == inlineStorage)
+        {
+          typed_object->~T();
+        }
+        else
+        {
+          delete typed_object;
+        }
+      }
+
+      // Destroy the result and callable and reset the job so it can be reused
+      void reset();
+
     private:
-      rsl::unique_array<rsl::byte> m_result_buffer;
-      job_callable m_callable;
+      using job_func = void (*)(Job&);
+
+      alignas(rsl::max_align) rsl::byte m_callable_storage[g_job_callable_storage_size]; // NOLINT(modernize-avoid-c-arrays)
+      alignas(rsl::max_align) rsl::byte m_result_storage[g_job_result_storage_size];     // NOLINT(modernize-avoid-c-arrays)
+
+      // Points to the stored callable, either in the inline storage or on the heap
+      void* m_callable;
+      job_func m_invoke_func;
+      job_func m_destroy_callable_func;
+
+      // Points to the result of the callable, either in the inline storage or on the heap
+      void* m_result;
+      job_func m_destroy_result_func;
+
       ThreadEvent m_finished_event;
+      JobPriority m_priority;
+      JobAffinity m_affinity;
+      s64 m_submit_time;
+
+      // The jobs that are waiting on this job to finish
+      // Its capacity is kept when the job is recycled
+      rsl::vector<JobHandle> m_continuations;
+      SpinLock m_continuations_lock;
+      rsl::atomic<bool> m_is_finished;
+
+      // The number of dependencies that need to finish before this job can run
+      // This starts at 1, which is released when the job gets scheduled
+      // this makes sure the job doesn't get queued while its dependencies are still getting added
+      rsl::atomic<s32> m_num_pending_dependencies;
+
+      // The number of handles referencing this job
+      rsl::atomic<s32> m_ref_count;
+
+      // Intrusive link used by the job pool while the job is free
+      Job* m_next_free;
+
+      friend class internal::JobPool;
     };
   } // namespace task_system
-} // namespace rex
\ No newline at end of file
+} // namespace rex
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/task_system/job.h"
+#include "rex_engine/task_system/task.h"
+#include "rex_std/memory.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    // A job counter tracks a group of tasks.
+    // It's finished when all the tasks added to it have finished.
+    // You can either block the current thread until that happens
+    // or, preferably, use it as the dependency of new work
+    // so that work starts automatically when all the tasks in the counter have finished
+    //
+    // eg.
+    // JobCounter counter;
+    // counter.add(rex::run_async([]() { load_tileset(); }));
+    // counter.add(rex::run_async([]() { load_blockset(); }));
+    // auto build_map = rex::run_async_after(counter, []() { build_map(); });
+    class JobCounter
+    {
+    public:
+      JobCounter();
+
+      // Add a task to the counter
+      template <typename ReturnType>
+      void add(const Task<ReturnType>& task)
+      {
+        add_job(task.job());
+      }
+      // Add a job to the counter
+      void add_job(const JobHandle& job);
+
+      // This is a blocking function.
+      // It'll wait for all jobs in the counter to finish
+      void wait_for_me() const;
+
+      // Returns the number of jobs in the counter that haven't finished yet
+      s32 num_pending() const;
+
+      // Returns true if all jobs in the counter have finished
+      bool is_finished() const;
+
+      // Returns all the jobs tracked by the counter
+      const rsl::vector<JobHandle>& jobs() const;
+
+    private:
+      rsl::vector<JobHandle> m_jobs;
+    };
+  } // namespace task_system
+} // namespace rex
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace rex
+{
+  namespace task_system
+  {
+    class Job;
+
+    // A handle that references a job
+    // Jobs are pooled and reference counted, the job is returned
+    // to the pool when the last handle referencing it goes out of scope
+    class JobHandle
+    {
+    public:
+      JobHandle();
+      explicit JobHandle(Job* job);
+      JobHandle(const JobHandle& other);
+      JobHandle(JobHandle&& other);
+      ~JobHandle();
+
+      JobHandle& operator=(const JobHandle& other);
+      JobHandle& operator=(JobHandle&& other);
+
+      // Release the reference to the job, if any
+      void reset();
+
+      Job* get() const;
+      Job* operator->() const;
+      Job& operator*() const;
+
+      explicit operator bool() const;
+
+    private:
+      Job* m_job;
+    };
+  } // namespace task_system
+} // namespace rex
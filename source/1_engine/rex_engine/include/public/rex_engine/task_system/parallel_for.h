@@ -0,0 +1,155 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/atomic.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    // A half open range of indices [begin, end) to iterate over in parallel
+    struct IndexRange
+    {
+      s32 begin;
+      s32 end;
+    };
+
+    namespace internal
+    {
+      // Return the grain size to use to split the range into chunks
+      // If no grain size is given, the range gets split so that every thread gets a few chunks
+      // this leaves some room for balancing work between threads when some chunks are slower than others
+      s32 calc_grain_size(const IndexRange& range, s32 grainSize);
+
+      // Return the number of helper jobs to queue to process the given number of chunks
+      // The calling thread processes chunks as well, so it doesn't count as a helper
+      s32 calc_num_helpers(s32 numChunks);
+
+      // Block until all the given tasks have finished
+      // While waiting, the calling thread executes pending jobs
+      // so that waiting from within a job doesn't stall the task system
+      void wait_while_helping(rsl::vector<Task<void>>& tasks);
+
+      // Split the range into chunks and call the callable for each chunk with the begin and end of that chunk
+      // Chunks are handed out to the calling thread and helper jobs through an atomic counter
+      // so every thread keeps processing chunks until none are left
+      template <typename ChunkCallable>
+      void for_each_chunk(const IndexRange& range, s32 grainSize, ChunkCallable&& chunkCallable)
+      {
+        const s32 count = range.end - range.begin;
+        if(count <= 0)
+        {
+          return;
+        }
+
+        const s32 grain_size = calc_grain_size(range, grainSize);
+        const s32 num_chunks = (count + grain_size - 1) / grain_size;
+        const s32 num_helpers = calc_num_helpers(num_chunks);
+
+        // No point in going wide if there's only a single chunk to process
+        if(num_helpers == 0)
+        {
+          for(s32 chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+          {
+            const s32 chunk_begin = range.begin + chunk_idx * grain_size;
+            const s32 chunk_end   = rsl::min(chunk_begin + grain_size, range.end);
+            chunkCallable(chunk_idx, chunk_begin, chunk_end);
+          }
+          return;
+        }
+
+        rsl::atomic<s32> next_chunk = 0;
+        auto process_chunks = [&next_chunk, &chunkCallable, &range, grain_size, num_chunks]()
+        {
+          for(s32 chunk_idx = next_chunk++; chunk_idx < num_chunks; chunk_idx = next_chunk++)
+          {
+            const s32 chunk_begin = range.begin + chunk_idx * grain_size;
+            const s32 chunk_end   = rsl::min(chunk_begin + grain_size, range.end);
+            chunkCallable(chunk_idx, chunk_begin, chunk_end);
+          }
+        };
+
+        rsl::vector<Task<void>> helpers;
+        helpers.reserve(num_helpers);
+        for(s32 idx = 0; idx < num_helpers; ++idx)
+        {
+          helpers.push_back(run_async(process_chunks));
+        }
+
+        // The calling thread joins in on the work instead of waiting idle
+        process_chunks();
+
+        // The helpers still reference the chunk counter, so we have to wait until they've all returned
+        wait_while_helping(helpers);
+      }
+    } // namespace internal
+  } // namespace task_system
+
+  // Call the callable for every index in the range, spreading the work over the task system
+  // The range gets split into chunks of grainSize indices, a grain size of 0 picks one automatically
+  // The calling thread processes chunks as well and this function returns when all indices have been processed
+  //
+  // eg.
+  // rex::parallel_for({0, num_pixels}, 0, [&](s32 idx) { pixels[idx] = convert(src[idx]); });
+  template <typename Callable>
+  void parallel_for(const task_system::IndexRange& range, s32 grainSize, Callable&& callable)
+  {
+    task_system::internal::for_each_chunk(range, grainSize,
+                                          [&callable](s32 /*chunkIdx*/, s32 chunkBegin, s32 chunkEnd)
+                                          {
+                                            for(s32 idx = chunkBegin; idx < chunkEnd; ++idx)
+                                            {
+                                              callable(idx);
+                                            }
+                                          });
+  }
+
+  // Map every index in the range to a value and combine all those values into a single result
+  // Every chunk gets reduced on its own and the results of the chunks are reduced in order on the calling thread
+  // so the result is deterministic, even if the reduction isn't commutative
+  // the reduction does need to be associative and identity shouldn't change the result when reduced with it
+  //
+  // eg.
+  // s32 sum = rex::parallel_reduce({0, count}, 0, 0, [&](s32 idx) { return values[idx]; }, [](s32 lhs, s32 rhs) { return lhs + rhs; });
+  template <typename T, typename MapCallable, typename ReduceCallable>
+  T parallel_reduce(const task_system::IndexRange& range, s32 grainSize, const T& identity, MapCallable&& mapCallable, ReduceCallable&& reduceCallable)
+  {
+    const s32 count = range.end - range.begin;
+    if(count <= 0)
+    {
+      return identity;
+    }
+
+    const s32 grain_size = task_system::internal::calc_grain_size(range, grainSize);
+    const s32 num_chunks = (count + grain_size - 1) / grain_size;
+
+    rsl::vector<T> chunk_results;
+    chunk_results.reserve(num_chunks);
+    for(s32 chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+    {
+      chunk_results.push_back(identity);
+    }
+
+    task_system::internal::for_each_chunk(range, grain_size,
+                                          [&chunk_results, &mapCallable, &reduceCallable](s32 chunkIdx, s32 chunkBegin, s32 chunkEnd)
+                                          {
+                                            T chunk_result = chunk_results[chunkIdx];
+                                            for(s32 idx = chunkBegin; idx < chunkEnd; ++idx)
+                                            {
+                                              chunk_result = reduceCallable(chunk_result, mapCallable(idx));
+                                            }
+                                            chunk_results[chunkIdx] = rsl::move(chunk_result);
+                                          });
+
+    T result = identity;
+    for(const T& chunk_result: chunk_results)
+    {
+      result = reduceCallable(result, chunk_result);
+    }
+
+    return result;
+  }
+} // namespace rex
@@ -16,7 +16,7 @@ namespace rex
     class Task
     {
     public:
-      explicit Task(rsl::shared_ptr<Job>&& job)
+      explicit Task(JobHandle&& job)
           : m_job(rsl::move(job))
       {
       }
@@ -37,8 +37,21 @@ namespace rex
         return m_job->result<ReturnType>();
       }
 
+      // Returns true if the job has finished
+      bool is_finished() const
+      {
+        return m_job->is_finished();
+      }
+
+      // Returns the job this task is wrapping
+      // This is used to chain other jobs after this one
+      const JobHandle& job() const
+      {
+        return m_job;
+      }
+
     private:
-      rsl::shared_ptr<Job> m_job;
+      JobHandle m_job;
     };
 
     // A task is the interface into the task system by a user.
@@ -48,7 +61,7 @@ namespace rex
     class Task<void>
     {
     public:
-      explicit Task(rsl::shared_ptr<Job>&& job)
+      explicit Task(JobHandle&& job)
           : m_job(rsl::move(job))
       {
       }
@@ -60,8 +73,21 @@ namespace rex
         m_job->wait_for_me();
       }
 
+      // Returns true if the job has finished
+      bool is_finished() const
+      {
+        return m_job->is_finished();
+      }
+
+      // Returns the job this task is wrapping
+      // This is used to chain other jobs after this one
+      const JobHandle& job() const
+      {
+        return m_job;
+      }
+
     private:
-      rsl::shared_ptr<Job> m_job;
+      JobHandle m_job;
     };
   } // namespace task_system
 } // namespace rex
\ No newline at end of file
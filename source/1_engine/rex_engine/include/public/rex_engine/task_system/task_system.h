@@ -1,6 +1,8 @@
 #pragma once
 
 #include "rex_engine/task_system/job.h"
+#include "rex_engine/task_system/job_counter.h"
+#include "rex_engine/task_system/job_handle.h"
 #include "rex_engine/task_system/task.h"
 #include "rex_engine/threading/thread_event.h"
 #include "rex_std/chrono.h"
@@ -15,52 +17,55 @@ namespace rex
   {
     namespace internal
     {
-      // Create a callable that returns the result in an unique array
-      // this gets filled in automatically, unless the return type is void
-      // then nothing gets filled in
-      template <typename ReturnType, typename Callable>
-      auto create_callable(Callable&& callable)
+      // Take a recycled job from the job pool
+      JobHandle acquire_job();
+
+      // Create a job wrapping the user's callable
+      // The callable is stored inline in a pooled job, so creating a job doesn't allocate
+      // unless the callable or its result is too big to fit in the job
+      template <typename Callable>
+      JobHandle create_job(Callable&& callable)
       {
-        return [moved_callable = rsl::move(callable)]()
-        {
-          rsl::unique_array<rsl::byte> res_buffer;
-
-          if constexpr(!rsl::is_same_v<void, ReturnType>)
-          {
-            res_buffer = rsl::make_unique<rsl::byte[]>(sizeof(ReturnType)); // NOLINT(modernize-avoid-c-arrays)
-            auto res   = moved_callable();
-            memcpy(res_buffer.get(), rsl::addressof(res), sizeof(res));
-          }
-          else
-          {
-            moved_callable();
-          }
-
-          return res_buffer;
-        };
+        JobHandle job = acquire_job();
+        job->set_callable(rsl::forward<Callable>(callable));
+
+        return job;
       }
     } // namespace internal
 
-    // If there's a idle thread available, execute the job immediately
-    // If not, assign the thread to the queue and it'll be executed
-    // when all previous jobs are processed
-    rsl::shared_ptr<Job> add_job_to_queue(rsl::shared_ptr<Job> job);
+    // Queue the job for execution
+    // If there's an idle thread available, it's started to execute the job
+    // If not, the job will be executed by one of the threads currently executing jobs
+    // as soon as it's finished with the jobs queued before it
+    JobHandle add_job_to_queue(JobHandle job);
+
+    // Queue the job as soon as all the given dependencies have finished
+    // If they've all finished already, the job gets queued immediately
+    // The job is kept alive by its dependencies until it's queued
+    JobHandle add_job_after(JobHandle job, const JobCounter& dependencies);
+
+    // Execute a single pending job on the calling thread
+    // Returns false if there was no job pending
+    // This is useful for threads that have to wait on other jobs and can do useful work in the meantime
+    bool run_pending_job();
+
+    // Execute all jobs that are queued to run on the main thread
+    // This needs to be called from the main thread, the application does this once every frame
+    // Returns the number of jobs executed
+    s32 run_main_thread_jobs();
   } // namespace task_system
 
   // Create a job to run async and wrap it in a task that's returned to the user
-  // Both the thread the job runs (or the queue if there isn't an idle thread available)
-  // as well as the task own the job to be run.
-  // When both go out of scope, the job is destroyed.
+  // Both the scheduler (until the job is executed) as well as the task own the job to be run.
+  // When both go out of scope, the job is returned to the job pool.
   template <typename Callable>
-  auto run_async(Callable&& callable)
+  auto run_async(task_system::JobPriority priority, Callable&& callable)
   {
-    // the callable needs to get wrapped as the thread pool only supports 1 interface callable
-    // So we wrap the user's callable and call the user's callable from the wrapped one
     using return_type = rsl::invoke_result_t<Callable>;
-    auto job_callable = task_system::internal::create_callable<return_type>(rsl::move(callable));
 
     // Create a new job which wraps the callable
-    rsl::shared_ptr<task_system::Job> new_job = rsl::make_shared<task_system::Job>(rsl::move(job_callable));
+    task_system::JobHandle new_job = task_system::internal::create_job(rsl::forward<Callable>(callable));
+    new_job->set_priority(priority);
 
     // Add the job to the queue to be scheduled for execution
     task_system::add_job_to_queue(new_job);
@@ -69,4 +74,57 @@ namespace rex
     const task_system::Task<return_type> task(rsl::move(new_job));
     return task;
   }
+
+  // Create a job to run async with normal priority
+  template <typename Callable>
+  auto run_async(Callable&& callable)
+  {
+    return run_async(task_system::JobPriority::Normal, rsl::forward<Callable>(callable));
+  }
+
+  // Create a job that only runs on the main thread and wrap it in a task that's returned to the user
+  // The job runs the next time the main thread drains its job queue, which happens once every frame
+  // Note: waiting on this task from the main thread before the queue is drained never returns
+  template <typename Callable>
+  auto run_on_main_thread(Callable&& callable)
+  {
+    using return_type = rsl::invoke_result_t<Callable>;
+
+    task_system::JobHandle new_job = task_system::internal::create_job(rsl::forward<Callable>(callable));
+    new_job->set_affinity(task_system::JobAffinity::MainThread);
+
+    task_system::add_job_to_queue(new_job);
+
+    const task_system::Task<return_type> task(rsl::move(new_job));
+    return task;
+  }
+
+  // Create a job that runs async once all jobs in the counter have finished
+  // This doesn't block the calling thread, the job gets queued by the last dependency that finishes
+  // This allows work to be expressed as a graph of jobs instead of waiting on each of them
+  template <typename Callable>
+  auto run_async_after(const task_system::JobCounter& dependencies, Callable&& callable)
+  {
+    using return_type = rsl::invoke_result_t<Callable>;
+
+    // Create a new job which wraps the callable
+    task_system::JobHandle new_job = task_system::internal::create_job(rsl::forward<Callable>(callable));
+
+    // Schedule the job to be queued when its dependencies have finished
+    task_system::add_job_after(new_job, dependencies);
+
+    // Return the task to the user so they can wait for the task's completion
+    // or use it as a dependency of other jobs
+    const task_system::Task<return_type> task(rsl::move(new_job));
+    return task;
+  }
+
+  // Create a job that runs async once the given task has finished
+  template <typename ReturnType, typename Callable>
+  auto run_async_after(const task_system::Task<ReturnType>& dependency, Callable&& callable)
+  {
+    task_system::JobCounter dependencies;
+    dependencies.add(dependency);
+    return run_async_after(dependencies, rsl::forward<Callable>(callable));
+  }
 } // namespace rex
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/array.h"
+#include "rex_std/chrono.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    // The number of buckets in a latency histogram
+    // Bucket 0 holds latencies below 1 microsecond, bucket i holds latencies in [2^(i-1), 2^i) microseconds
+    // The last bucket holds everything that doesn't fit in the other buckets
+    inline constexpr s32 g_num_latency_buckets = 24;
+
+    // A histogram of latencies with buckets that double in size
+    struct LatencyHistogram
+    {
+      rsl::array<s64, g_num_latency_buckets> counts;
+
+      // Returns the total number of latencies recorded
+      s64 num_samples() const;
+      // Returns the upper bound, in microseconds, of the bucket the given percentile falls in
+      // percentile is expected to be in the range [0, 1]
+      s64 percentile_upper_bound_us(f32 percentile) const;
+    };
+
+    // The telemetry recorded by a single worker
+    struct WorkerTelemetry
+    {
+      // Time spent executing jobs
+      rsl::chrono::nanoseconds busy_time;
+      // Time spent parked, waiting for jobs
+      rsl::chrono::nanoseconds idle_time;
+      // The number of jobs executed
+      s64 num_jobs_executed;
+      // The number of jobs stolen from other workers
+      s64 num_steals;
+      // The highest number of pending jobs seen when this worker queued a job
+      s64 max_queue_depth;
+      // The time between a job getting queued and it starting
+      LatencyHistogram submit_to_start;
+      // The time between a job starting and it finishing
+      LatencyHistogram start_to_finish;
+    };
+
+    // The telemetry of the entire task system
+    struct TaskSystemTelemetry
+    {
+      // The telemetry of every worker slot that was used, indexed by worker slot
+      rsl::vector<WorkerTelemetry> workers;
+      // The telemetry of threads that aren't workers but did execute or queue jobs (eg. the main thread)
+      WorkerTelemetry external;
+      // The highest number of pending jobs seen
+      s64 max_queue_depth;
+      // The latencies of all threads combined
+      LatencyHistogram submit_to_start;
+      LatencyHistogram start_to_finish;
+    };
+
+    // Gather the telemetry recorded so far
+    // Counters are updated while this is running, so they can be slightly off from each other
+    TaskSystemTelemetry query_telemetry();
+
+    // Reset all telemetry back to 0
+    void reset_telemetry();
+
+    // Log the telemetry recorded so far
+    void dump_telemetry();
+
+    namespace internal
+    {
+      // Return the current time used for job timestamps in nanoseconds
+      s64 telemetry_timestamp();
+
+      // Record that a job was executed by the given worker slot
+      void record_job_executed(s32 workerSlot, s64 submitTime, s64 startTime, s64 endTime);
+      // Record time a worker spent parked
+      void record_idle_time(s32 workerSlot, s64 idleTime);
+      // Record that a worker stole a job from another worker
+      void record_steal(s32 workerSlot);
+      // Record the number of pending jobs after a job got queued
+      void record_queue_depth(s32 workerSlot, s64 queueDepth);
+    } // namespace internal
+  } // namespace task_system
+} // namespace rex
@@ -14,7 +14,17 @@ namespace rex
 	{
 	public:
 		ThreadPool();
-		//~ThreadPool();
+		explicit ThreadPool(s32 numThreads);
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) = delete;
+		~ThreadPool();
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool& operator=(ThreadPool&&) = delete;
+
+		// Return the total number of threads owned by the pool
+		// This only changes when the threads get destroyed
+		s32 num_threads() const;
 
 		// Query if we have any idle threads available
 		// An idle thread is a thread that's not executing a job at the moment.
@@ -27,6 +37,11 @@ namespace rex
 		// Return a thread back to the pool
 		void return_thread(internal::Thread* thread);
 
+		// Register a callable that gets called before the threads get destroyed
+		// Systems that keep threads of the pool busy indefinitely use this
+		// to finish their work and return the threads, so they can be joined
+		void add_destroy_callback(rsl::function<void()>&& callback);
+
 		// Destroy all threads. Used at shutdown of the engine
 		void destroy_threads();
 
@@ -34,6 +49,7 @@ namespace rex
 		rsl::vector<rsl::unique_ptr<internal::Thread>> m_threads; // Holds and owns all the threads used by the thread pool
 		rsl::vector<internal::Thread*> m_idle_threads;            // Holds but doesn't own all the idle threads
 		rsl::mutex m_threads_access_mtx;                // Mutex that's used to access the thread pool
+		rsl::vector<rsl::function<void()>> m_destroy_callbacks;   // Called before the threads get destroyed
 	};
 
 	namespace thread_pool
@@ -17,10 +17,7 @@ public class RexEngine : EngineProject
 
     SourceFilesExcludeFromJumboRegex.Add("new_delete.cpp"); // needs to be excluded to avoid linker issues
 
-    // Only needs to happen on Windows
-    SourceFilesExcludeRegex.Add("unix/*");
-    //// Only needs to happen on Linux
-    //SourceFilesExcludeRegex.Add("win/*");
+    // Platform specific files are excluded per platform, see SetupPlatformRules
 
     DataPath = Path.Combine(Globals.Root, "data", "rex");
   }
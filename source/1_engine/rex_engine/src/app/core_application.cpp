@@ -11,17 +11,27 @@
 #include "rex_engine/filesystem/vfs.h"
 #include "rex_engine/frameinfo/frameinfo.h"
 #include "rex_engine/memory/memory_tracking.h"
+#include "rex_engine/memory/alloc_trace.h"
+#include "rex_engine/memory/allocation_sampler.h"
+#include "rex_engine/memory/allocators/guard_allocator.h"
+#include "rex_engine/memory/memory_budgets.h"
 #include "rex_engine/settings/settings.h"
 #include "rex_engine/system/process.h"
+#include "rex_engine/text_processing/text_processing.h"
 #include "rex_engine/event_system/event_system.h"
+#include "rex_std/bonus/string.h"
 #include "rex_std/bonus/utility.h"
+#include "rex_std/array.h"
 
 #include "rex_engine/diagnostics/log.h"
 #include "rex_engine/profiling/timer.h"
 #include "rex_engine/profiling/profiling_session.h"
 #include "rex_engine/cmdline/cmdline.h"
-#include "rex_engine/filesystem/native_filesystem.h"
+#include "rex_engine/filesystem/pak_filesystem.h"
 #include "rex_engine/threading/thread_pool.h"
+#include "rex_engine/task_system/coroutine.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/task_system/task_system_telemetry.h"
 
 #include "rex_engine/assets/map.h"
 #include "rex_engine/assets/tileset.h"
@@ -169,6 +179,7 @@ namespace rex
     // Settings are loaded now, we can initialize all the sub systems with settings loaded from them
     const rsl::memory_size max_mem_budget = rsl::memory_size::from_mib(settings::instance()->get_int("max_memory_mib"));
     mem_tracker().initialize(max_mem_budget);
+    mem_budgets().load_from_settings();
 
     return res;
   }
@@ -176,6 +187,13 @@ namespace rex
   void CoreApplication::update()
   {
     engine::instance()->advance_frame();
+    mem_budgets().record_frame(engine::instance()->frame_info().index(), mem_tracker().current_tracking_stats().usage_per_tag);
+
+    // Coroutines waiting for the next frame continue here, on the main thread
+    task_system::resume_frame_waiters();
+
+    // Execute the jobs that got queued to run on the main thread
+    task_system::run_main_thread_jobs();
 
     platform_update();
   }
@@ -188,6 +206,15 @@ namespace rex
 
     platform_shutdown();
 
+    task_system::dump_telemetry();
+    engine::instance()->single_frame_allocator().dump_stats();
+    alloc_trace::stop_recording();
+    if (alloc_sampler().is_enabled())
+    {
+      alloc_sampler().export_folded_stacks(path::join(engine::instance()->current_session_root(), g_alloc_samples_filename));
+    }
+    mem_budgets().dump_to_csv(path::join(engine::instance()->current_session_root(), g_memory_budgets_filename));
+
     REX_INFO(LogEngine, "Application shutdown with result: {0}", m_exit_code);
 
     shutdown_globals();
@@ -226,7 +253,21 @@ namespace rex
     vfs::instance()->mount(MountingPoint::EngineMaterials, path::join(engine::instance()->engine_root(), "materials"));
     vfs::instance()->mount(MountingPoint::EngineShaders, path::join(engine::instance()->engine_root(), "shaders"));
 
+    vfs::instance()->mount(MountingPoint::ProjectRoot, engine::instance()->project_root());
+
     vfs::instance()->mount(rex::MountingPoint::Logs, path::join(engine::instance()->current_session_root(), "logs"));
+
+    // Packed archives are stored next to the directory they're built from, eg. data/rex.rexpak packs data/rex
+    // Shipped builds read all engine and project files from the archives, loose files are used when there's none
+    const rsl::array<MountingPoint, 2> packed_roots = { MountingPoint::EngineRoot, MountingPoint::ProjectRoot };
+    for (const MountingPoint root : packed_roots)
+    {
+      const scratch_string pak_path = path::change_extension(vfs::instance()->mounted_path(root), pak::g_extension);
+      if (vfs::instance()->is_file(pak_path))
+      {
+        vfs::instance()->mount_pak(root, pak_path);
+      }
+    }
   }
 
   //--------------------------------------------------------------------------------------------
@@ -272,11 +313,16 @@ namespace rex
     REX_ASSERT_X(bootSettings.single_frame_heap_size > 0, "Single frame heap setting indicates 0 size. The setting is either missing or 0. Please add a setting to \"heaps\" with name \"single_frame_heap_size\" in memory_settings.ini");
     REX_ASSERT_X(bootSettings.scratch_heap_size > 0, "Scratch heap setting indicates 0 size. The setting is either missing or 0. Please add a setting to \"heaps\" with name \"scratch_heap_size\" in memory_settings.ini");
 
+    // Memory allocated before this point stays with the OS, the engine heap only serves new allocations
+    enable_engine_heap(bootSettings.use_engine_heap);
+    alloc_sampler().set_sample_rate(bootSettings.alloc_sample_rate);
+    mem_tracker().set_callstack_sample_rate(bootSettings.callstack_sample_rate);
+
     // Initialize the global heaps and its allocators using the settings loaded from disk
-    auto scratch_alloc = rsl::make_unique<TCircularAllocator<GlobalAllocator>>(bootSettings.scratch_heap_size);
-    auto single_frame_alloc = rsl::make_unique<TStackAllocator<GlobalAllocator>>(bootSettings.single_frame_heap_size);
+    auto scratch_alloc = rsl::make_unique<EngineGlobals::ScratchAllocator>(bootSettings.scratch_heap_size, bootSettings.scratch_heap_reserve_size);
+    auto single_frame_alloc = rsl::make_unique<FrameAllocator>(bootSettings.single_frame_heap_size);
 
-    engine::init(globals::make_unique<EngineGlobals>(rsl::move(scratch_alloc), rsl::move(single_frame_alloc)));
+    engine::init(globals::make_unique<EngineGlobals>(rsl::move(scratch_alloc), rsl::move(single_frame_alloc), bootSettings.thread_scratch_heap_reserve_size));
   }
 
   //--------------------------------------------------------------------------------------------
@@ -315,6 +361,23 @@ namespace rex
     }
   }
 
+  //--------------------------------------------------------------------------------------------
+  void CoreApplication::enable_guard_allocator_for_tags(rsl::string_view memoryTags) // NOLINT(readability-convert-member-functions-to-static)
+  {
+    // eg. FileIO,Renderer
+    for (const rsl::string_view tag_name : rsl::split(memoryTags, ","))
+    {
+      const rsl::optional<MemoryTag> tag = rsl::enum_refl::enum_cast<MemoryTag>(tag_name);
+      if (!tag)
+      {
+        REX_WARN(LogCoreApp, "Cannot guard allocations of unknown memory tag {}", quoted(tag_name));
+        continue;
+      }
+
+      REX_INFO(LogCoreApp, "Guarding allocations of memory tag {}", tag_name);
+      enable_guard_allocator(tag.value(), true);
+    }
+  }
   //--------------------------------------------------------------------------------------------
   void CoreApplication::init_thread_pool()
   {
@@ -338,13 +401,14 @@ namespace rex
   {
     REX_DEBUG(LogCoreApp, "Initializing virtual filesystem");
     rsl::string_view root = cmdline::instance()->get_argument("root").value_or(path::cwd());
-    vfs::init(globals::make_unique<NativeFileSystem>(root));
+    vfs::init(globals::make_unique<PakFileSystem>(root));
 
     REX_DEBUG(LogCoreApp, "Initializing module manager");
     module_manager::init(globals::make_unique<ModuleManager>());
 
     REX_DEBUG(LogCoreApp, "Loading boot settings");
     BootSettings boot_settings = load_boot_settings();
+    vfs::instance()->set_num_io_workers(boot_settings.num_io_workers);
 
     REX_DEBUG(LogCoreApp, "Initializing engine globals");
     init_engine_globals(boot_settings);
@@ -352,6 +416,16 @@ namespace rex
     REX_DEBUG(LogCoreApp, "Initializing commandline arguments");
     init_cmdline();
 
+    // Allocations are recorded as early as possible, so the trace covers the startup of the engine
+    if (cmdline::instance()->get_argument("TraceAllocations"))
+    {
+      alloc_trace::start_recording(path::join(engine::instance()->current_session_root(), alloc_trace::g_alloc_trace_filename));
+    }
+    if (rsl::optional<rsl::string_view> guarded_tags = cmdline::instance()->get_argument("GuardMemoryTags"))
+    {
+      enable_guard_allocator_for_tags(guarded_tags.value());
+    }
+
     REX_DEBUG(LogCoreApp, "Initializing thread pool");
     init_thread_pool();
 
@@ -388,6 +462,12 @@ namespace rex
 
     boot_settings.single_frame_heap_size = rsl::stoi(boot_settings_ini.get("heaps", "single_frame_heap_size", "<invalid int>")).value_or(boot_settings.single_frame_heap_size);
     boot_settings.scratch_heap_size = rsl::stoi(boot_settings_ini.get("heaps", "scratch_heap_size", "<invalid int>")).value_or(boot_settings.scratch_heap_size);
+    boot_settings.scratch_heap_reserve_size = rsl::stoi(boot_settings_ini.get("heaps", "scratch_heap_reserve_size", "<invalid int>")).value_or(boot_settings.scratch_heap_reserve_size);
+    boot_settings.thread_scratch_heap_reserve_size = rsl::stoi(boot_settings_ini.get("heaps", "thread_scratch_heap_reserve_size", "<invalid int>")).value_or(boot_settings.thread_scratch_heap_reserve_size);
+    boot_settings.alloc_sample_rate = rsl::stoi(boot_settings_ini.get("profiling", "alloc_sample_rate", "<invalid int>")).value_or(boot_settings.alloc_sample_rate);
+    boot_settings.callstack_sample_rate = static_cast<card32>(rsl::stoi(boot_settings_ini.get("profiling", "callstack_sample_rate", "<invalid int>")).value_or(static_cast<s32>(boot_settings.callstack_sample_rate)));
+    boot_settings.num_io_workers = rsl::stoi(boot_settings_ini.get("filesystem", "num_io_workers", "<invalid int>")).value_or(boot_settings.num_io_workers);
+    boot_settings.use_engine_heap = rsl::stoi(boot_settings_ini.get("heaps", "use_engine_heap", "<invalid int>")).value_or(boot_settings.use_engine_heap) != 0;
 
     return boot_settings;
   }
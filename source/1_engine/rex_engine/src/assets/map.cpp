@@ -30,9 +30,9 @@ namespace rex
 		m_tiles = rsl::make_unique<u8[]>(m_desc.map_header.width_in_blocks * num_tiles_per_block_row * m_desc.map_header.height_in_blocks * num_tiles_per_block_row);
 
 		Blockset* blockset = asset_db::instance()->load<Blockset>(m_desc.blockset);
-		memory::Blob blockmap = vfs::instance()->read_file(m_desc.blockmap);
+		const MappedFile blockmap = vfs::instance()->map_file(m_desc.blockmap);
 
-		memory::BlobReader reader(blockmap);
+		memory::BlobReader reader(blockmap.view());
 		
 		while (reader.read_offset() < blockmap.size())
 		{
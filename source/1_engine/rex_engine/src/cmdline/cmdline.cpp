@@ -30,6 +30,8 @@ namespace rex
       CommandLineArgument{ "LogLevel", "Specify log level per logger (eg. -LogLevel=Engine=trace,Renderer=info)", "<hardcoded>" },
       CommandLineArgument{ "BreakOnBoot", "Break on boot so you can attach a debugger", "<hardcoded>" },
       CommandLineArgument{ "AttachOnBoot", "Attach the debugger on boot", "<hardcoded>" },
+      CommandLineArgument{ "TraceAllocations", "Record all tracked allocations to the session directory so they can be replayed offline", "<hardcoded>" },
+      CommandLineArgument{ "GuardMemoryTags", "Place allocations of memory tags against guard pages to catch overruns and use after free (eg. -GuardMemoryTags=FileIO,Renderer)", "<hardcoded>" },
 
       CommandLineArgument{ "project", "The project to load by the editor", "<hardcoded>" },
     };
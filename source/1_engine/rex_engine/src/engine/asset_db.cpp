@@ -19,10 +19,16 @@ namespace rex
 
 	rsl::string_view AssetDb::asset_path(const Asset* asset)
 	{
-		return m_asset_to_metadata.at(asset).path;
+		return m_asset_to_metadata.at(asset).path.string();
+	}
+	PathId AssetDb::asset_path_id(rsl::string_view assetPath) const
+	{
+		scratch_string fullpath = rex::vfs::instance()->abs_path(assetPath);
+		rsl::to_lower(fullpath.cbegin(), fullpath.begin(), fullpath.length());
+		return PathId::create(fullpath);
 	}
 
-	Asset* AssetDb::load_from_json(rsl::type_id_t assetTypeId, rsl::string_view assetPath, LoadFlags loadFlags)
+	Asset* AssetDb::load_from_json(rsl::type_id_t assetTypeId, PathId assetPath, LoadFlags loadFlags)
 	{
 		// If we already have the asset loaded, let's return it 
 		Asset* cached_asset = lookup_cached_asset(assetPath, loadFlags);
@@ -32,22 +38,22 @@ namespace rex
 		}
 
 		// If the file doesn't exist, we can't load it
-		if (!rex::vfs::instance()->exists(assetPath))
+		if (!rex::vfs::instance()->exists(assetPath.string()))
 		{
-			REX_ERROR(LogAssetDatabase, "asset at path {} does not exist", quoted(assetPath));
+			REX_ERROR(LogAssetDatabase, "asset at path {} does not exist", quoted(assetPath.string()));
 			return nullptr;
 		}
 
-		REX_VERBOSE(LogAssetDatabase, "Loading {}", assetPath);
+		REX_VERBOSE(LogAssetDatabase, "Loading {}", assetPath.string());
 
 		// load the asset from disk
-		rex::memory::Blob asset_blob = rex::vfs::instance()->read_file(assetPath);
-		rex::json::json asset_json = rex::json::parse(asset_blob);
+		const rex::MappedFile asset_blob = rex::vfs::instance()->map_file(assetPath.string());
+		rex::json::json asset_json = rex::json::parse(asset_blob.view());
 
 		// If the json content could not be parsed, we can't continue, so we return
 		if (asset_json.is_discarded())
 		{
-			REX_ERROR(LogAssetDatabase, "invalid json for asset {}", quoted(assetPath));
+			REX_ERROR(LogAssetDatabase, "invalid json for asset {}", quoted(assetPath.string()));
 			return nullptr;
 		}
 
@@ -55,7 +61,7 @@ namespace rex
 		rsl::string_view asset_type_name = asset_json["type_name"];
 		if (asset_type_name != assetTypeId.name())
 		{
-			REX_ERROR(LogAssetDatabase, "Asset at {} is not of expected type. Expecting {}, actual {}", quoted(assetPath), assetTypeId.name(), asset_type_name);
+			REX_ERROR(LogAssetDatabase, "Asset at {} is not of expected type. Expecting {}, actual {}", quoted(assetPath.string()), assetTypeId.name(), asset_type_name);
 			return nullptr;
 		}
 		
@@ -67,7 +73,7 @@ namespace rex
 		}
 
 		// We know we can load the asset, so fire the event that it's beginning to load
-		event_system::instance()->fire_event(BeginAssetLoad(assetPath));
+		event_system::instance()->fire_event(BeginAssetLoad(assetPath.string()));
 
 		// Hydrate the asset if it was partially loaded before
 		Asset* potentially_partially_loaded_asset = lookup_cached_asset(assetPath, LoadFlags::PartialLoad);
@@ -82,17 +88,17 @@ namespace rex
 		rsl::unique_ptr<Asset> asset = m_serializers.at(asset_type_name)->serialize_from_json(asset_json, loadFlags);
 
 		AssetMetaData metadata{};
-		metadata.path = rsl::string(assetPath);
+		metadata.path = assetPath;
 		metadata.is_partially_loaded = rsl::has_flag(loadFlags, LoadFlags::PartialLoad);
 		m_asset_to_metadata.emplace(asset.get(), metadata);
 		auto emplace_result = m_path_to_asset.emplace(assetPath, rsl::move(asset));
 
 		// Asset is loaded, so fire the event that is has fully loaded
-		event_system::instance()->fire_event(EndAssetLoad(assetPath, asset.get()));
+		event_system::instance()->fire_event(EndAssetLoad(assetPath.string(), asset.get()));
 
 		return emplace_result.inserted_element->value.get();
 	}
-	Asset* AssetDb::load_from_binary(rsl::type_id_t assetTypeId, rsl::string_view assetPath, LoadFlags loadFlags)
+	Asset* AssetDb::load_from_binary(rsl::type_id_t assetTypeId, PathId assetPath, LoadFlags loadFlags)
 	{
 		// If we already have the asset loaded, let's return it 
 		Asset* cached_asset = lookup_cached_asset(assetPath, loadFlags);
@@ -102,13 +108,13 @@ namespace rex
 		}
 
 		// If the file doesn't exist, we can't load it
-		if (!rex::vfs::instance()->exists(assetPath))
+		if (!rex::vfs::instance()->exists(assetPath.string()))
 		{
-			REX_ERROR(LogAssetDatabase, "asset at path {} does not exist", quoted(assetPath));
+			REX_ERROR(LogAssetDatabase, "asset at path {} does not exist", quoted(assetPath.string()));
 			return nullptr;
 		}
 
-		REX_VERBOSE(LogAssetDatabase, "Loading {}", assetPath);
+		REX_VERBOSE(LogAssetDatabase, "Loading {}", assetPath.string());
 
 		// If we don't have a (de)serializer for the type, we can't initialize it, so return
 		if (!m_serializers.contains(assetTypeId.name()))
@@ -118,10 +124,11 @@ namespace rex
 		}
 
 		// We know we can load the asset, so fire the event that it's beginning to load
-		event_system::instance()->fire_event(BeginAssetLoad(assetPath));
+		event_system::instance()->fire_event(BeginAssetLoad(assetPath.string()));
 
 		// load the asset from disk
-		rex::memory::Blob asset_blob = rex::vfs::instance()->read_file(assetPath);
+		const rex::MappedFile asset_file = rex::vfs::instance()->map_file(assetPath.string());
+		const memory::BlobView asset_blob = asset_file.view();
 
 		// Hydrate the asset if it was partially loaded before
 		Asset* potentially_partially_loaded_asset = lookup_cached_asset(assetPath, LoadFlags::PartialLoad);
@@ -135,24 +142,25 @@ namespace rex
 		// Deserialize, initialize and cache the asset
 		rsl::unique_ptr<Asset> asset = m_serializers.at(assetTypeId.name())->serialize_from_binary(asset_blob/*, loadFlags*/);
 		AssetMetaData metadata{};
-		metadata.path = rsl::string(assetPath);
+		metadata.path = assetPath;
 		metadata.is_partially_loaded = rsl::has_flag(loadFlags, LoadFlags::PartialLoad);
 		m_asset_to_metadata.emplace(asset.get(), metadata);
 		auto emplace_result = m_path_to_asset.emplace(assetPath, rsl::move(asset));
 
 		// Asset is loaded, so fire the event that is has fully loaded
-		event_system::instance()->fire_event(EndAssetLoad(assetPath, asset.get()));
+		event_system::instance()->fire_event(EndAssetLoad(assetPath.string(), asset.get()));
 		return emplace_result.inserted_element->value.get();
 	}
 
-	Asset* AssetDb::lookup_cached_asset(rsl::string_view assetPath, LoadFlags loadFlags)
+	Asset* AssetDb::lookup_cached_asset(PathId assetPath, LoadFlags loadFlags)
 	{
-		if (!m_path_to_asset.contains(assetPath))
+		auto it = m_path_to_asset.find(assetPath);
+		if (it == m_path_to_asset.end())
 		{
 			return nullptr;
 		}
 
-		Asset* asset = m_path_to_asset.at(assetPath).get();
+		Asset* asset = it->value.get();
 		const AssetMetaData& asset_metadata = m_asset_to_metadata.at(asset);
 		if (asset_metadata.is_partially_loaded && !rsl::has_flag(loadFlags, LoadFlags::PartialLoad))
 		{
@@ -179,22 +187,23 @@ namespace rex
 			return;
 		}
 
-		rsl::string_view asset_path = m_asset_to_metadata.at(asset).path;
-		rex::memory::Blob asset_blob = rex::vfs::instance()->read_file(asset_path);
-		rex::json::json asset_json = rex::json::parse(asset_blob);
+		rsl::string_view asset_path = m_asset_to_metadata.at(asset).path.string();
+		const rex::MappedFile asset_blob = rex::vfs::instance()->map_file(asset_path);
+		rex::json::json asset_json = rex::json::parse(asset_blob.view());
 
 		m_serializers.at(assetTypeId.name())->hydrate_asset(asset, asset_json);
 		m_asset_to_metadata.at(asset).is_partially_loaded = false;
 	}
 
-	bool AssetDb::is_partially_loaded(rsl::string_view assetPath)
+	bool AssetDb::is_partially_loaded(PathId assetPath)
 	{
-		if (!m_path_to_asset.contains(assetPath))
+		auto it = m_path_to_asset.find(assetPath);
+		if (it == m_path_to_asset.end())
 		{
-			return nullptr;
+			return false;
 		}
 
-		Asset* asset = m_path_to_asset.at(assetPath).get();
+		Asset* asset = it->value.get();
 		return is_partially_loaded(asset);
 	}
 
@@ -7,6 +7,10 @@
 #include "rex_engine/cmdline/cmdline.h"
 #include "rex_engine/engine/globals.h"
 #include "rex_engine/text_processing/json.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/atomic.h"
+#include "rex_std/cstring.h"
+#include "rex_std/mutex.h"
 
 namespace rex
 {
@@ -78,40 +82,204 @@ namespace rex
 		return paths;
 	}
 
-	EngineGlobals::EngineGlobals(rsl::unique_ptr<ScratchAllocator> scratchAlloc, rsl::unique_ptr<SingleFrameAllocator> tempAlloc)
+	namespace internal
+	{
+		// The engine globals that threads give their scratch arena back to when they exit
+		// Only the latest engine globals take arenas back, arenas of older ones are destroyed together with them
+		// This doesn't allocate, as the first engine globals get created while the global allocator is created
+		struct LiveScratchOwner
+		{
+			rsl::mutex mtx;
+			EngineGlobals* owner = nullptr;
+			card32 generation = 0;
+		};
+		LiveScratchOwner& live_scratch_owner()
+		{
+			static LiveScratchOwner live_owner;
+			return live_owner;
+		}
+
+		// The scratch arena of a thread that didn't create the engine globals
+		// The arena is owned by the engine globals, the thread only borrows it
+		struct ThreadScratchArena
+		{
+			EngineGlobals* owner = nullptr;
+			EngineGlobals::ScratchAllocator* allocator = nullptr;
+			// The generation of the engine globals the arena was created for
+			card32 generation = 0;
+
+			~ThreadScratchArena()
+			{
+				release();
+			}
+
+			// Give the arena back, if the engine globals it was borrowed from still exist
+			void release()
+			{
+				if (allocator == nullptr)
+				{
+					return;
+				}
+
+				LiveScratchOwner& live_owner = live_scratch_owner();
+				const rsl::unique_lock lock(live_owner.mtx);
+				if (live_owner.owner == owner && live_owner.generation == generation)
+				{
+					owner->release_thread_scratch_allocator(allocator);
+				}
+
+				owner = nullptr;
+				allocator = nullptr;
+				generation = 0;
+			}
+		};
+
+		// Scratch allocations store their size in front of them, padded to keep the allocation aligned
+		inline constexpr s64 g_scratch_header_size = alignof(rsl::max_align);
+
+		thread_local ThreadScratchArena g_thread_scratch_arena; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+		rsl::atomic<card32> g_next_scratch_generation = 1;      // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+	}
+
+	EngineGlobals::EngineGlobals(rsl::unique_ptr<ScratchAllocator> scratchAlloc, rsl::unique_ptr<SingleFrameAllocator> tempAlloc, s64 threadScratchReserveSize)
 		: m_scratch_allocator(rsl::move(scratchAlloc))
+		, m_scratch_allocator_thread_id(rsl::this_thread::get_id())
+		, m_scratch_generation(internal::g_next_scratch_generation++)
+		, m_thread_scratch_allocators()
+		, m_free_thread_scratch_allocators()
+		, m_thread_scratch_reserve_size(threadScratchReserveSize)
+		, m_thread_scratch_mutex()
 		, m_single_frame_allocator(rsl::move(tempAlloc))
 		, m_frame_info()
 	{
+		internal::LiveScratchOwner& live_owner = internal::live_scratch_owner();
+		const rsl::unique_lock lock(live_owner.mtx);
+		live_owner.owner = this;
+		live_owner.generation = m_scratch_generation;
+	}
+	EngineGlobals::~EngineGlobals()
+	{
+		internal::LiveScratchOwner& live_owner = internal::live_scratch_owner();
+		const rsl::unique_lock lock(live_owner.mtx);
+		if (live_owner.owner == this)
+		{
+			live_owner.owner = nullptr;
+			live_owner.generation = 0;
+		}
 	}
 
 	void EngineGlobals::advance_frame()
 	{
 		m_frame_info.update();
-		m_single_frame_allocator->reset();
+		m_single_frame_allocator->advance_frame();
 	}
 
 	void* EngineGlobals::scratch_alloc(s64 size)
 	{
-		return m_scratch_allocator->allocate(size);
+		// Every scratch allocation remembers its size, so it can be reallocated on any thread
+		rsl::byte* mem = static_cast<rsl::byte*>(scratch_allocator().allocate(size + internal::g_scratch_header_size));
+		*reinterpret_cast<s64*>(mem) = size; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		return mem + internal::g_scratch_header_size;
 	}
 	void* EngineGlobals::scratch_realloc(void* ptr, s64 size)
 	{
-		return m_scratch_allocator->reallocate(ptr, size);
+		if (ptr == nullptr)
+		{
+			return scratch_alloc(size);
+		}
+
+		rsl::byte* old_mem = static_cast<rsl::byte*>(ptr) - internal::g_scratch_header_size;
+		const s64 old_size = *reinterpret_cast<s64*>(old_mem); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+		// Memory from our own arena can possibly grow in place
+		ScratchAllocator& allocator = scratch_allocator();
+		if (allocator.has_allocated_ptr(old_mem))
+		{
+			rsl::byte* mem = static_cast<rsl::byte*>(allocator.reallocate(old_mem, size + internal::g_scratch_header_size));
+			*reinterpret_cast<s64*>(mem) = size; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+			return mem + internal::g_scratch_header_size;
+		}
+
+		// Memory allocated on another thread's arena gets copied into ours
+		void* new_ptr = scratch_alloc(size);
+		rsl::memcpy(new_ptr, ptr, rsl::min(old_size, size));
+		return new_ptr;
 	}
 	void EngineGlobals::scratch_free(void* ptr)
 	{
-		return m_scratch_allocator->deallocate(ptr);
+		// Scratch memory doesn't need to be freed and can be freed from any thread
+		REX_UNUSED_PARAM(ptr);
 	}
 	bool EngineGlobals::is_scratch_alloc(void* ptr) const
 	{
-		return m_scratch_allocator->has_allocated_ptr(ptr);
+		if (m_scratch_allocator->has_allocated_ptr(ptr))
+		{
+			return true;
+		}
+
+		// Scratch memory is almost always checked by the thread that allocated it
+		const internal::ThreadScratchArena& arena = internal::g_thread_scratch_arena;
+		if (arena.generation == m_scratch_generation && arena.allocator->has_allocated_ptr(ptr))
+		{
+			return true;
+		}
+
+		// The memory can come from any other thread, including threads that exited already
+		const rsl::unique_lock lock(m_thread_scratch_mutex);
+		for (const rsl::unique_ptr<ScratchAllocator>& allocator : m_thread_scratch_allocators)
+		{
+			if (allocator->has_allocated_ptr(ptr))
+			{
+				return true;
+			}
+		}
+
+		return false;
 	}
 	s64 EngineGlobals::scratch_buffer_size() const
 	{
 		return m_scratch_allocator->buffer_size();
 	}
 
+	EngineGlobals::ScratchAllocator& EngineGlobals::scratch_allocator()
+	{
+		if (rsl::this_thread::get_id() == m_scratch_allocator_thread_id)
+		{
+			return *m_scratch_allocator;
+		}
+
+		// An arena borrowed from previous engine globals isn't used anymore, a new one is borrowed from these
+		internal::ThreadScratchArena& arena = internal::g_thread_scratch_arena;
+		if (arena.generation != m_scratch_generation)
+		{
+			arena.release();
+			arena.allocator = acquire_thread_scratch_allocator();
+			arena.owner = this;
+			arena.generation = m_scratch_generation;
+		}
+
+		return *arena.allocator;
+	}
+	EngineGlobals::ScratchAllocator* EngineGlobals::acquire_thread_scratch_allocator()
+	{
+		const rsl::unique_lock lock(m_thread_scratch_mutex);
+		if (!m_free_thread_scratch_allocators.empty())
+		{
+			ScratchAllocator* allocator = m_free_thread_scratch_allocators.back();
+			m_free_thread_scratch_allocators.pop_back();
+			return allocator;
+		}
+
+		const s64 buffer_size = m_scratch_allocator->buffer_size();
+		m_thread_scratch_allocators.push_back(rsl::make_unique<ScratchAllocator>(buffer_size, rsl::max(buffer_size, m_thread_scratch_reserve_size)));
+		return m_thread_scratch_allocators.back().get();
+	}
+	void EngineGlobals::release_thread_scratch_allocator(ScratchAllocator* allocator)
+	{
+		const rsl::unique_lock lock(m_thread_scratch_mutex);
+		m_free_thread_scratch_allocators.push_back(allocator);
+	}
+
 	void* EngineGlobals::temp_alloc(s64 size)
 	{
 		return m_single_frame_allocator->allocate(size);
@@ -130,7 +298,7 @@ namespace rex
 	}
 	s64 EngineGlobals::temp_buffer_size() const
 	{
-		return m_single_frame_allocator->buffer_size();
+		return m_single_frame_allocator->arena_size();
 	}
 
 	const FrameInfo& EngineGlobals::frame_info() const
@@ -138,6 +306,11 @@ namespace rex
 		return m_frame_info;
 	}
 
+	EngineGlobals::SingleFrameAllocator& EngineGlobals::single_frame_allocator()
+	{
+		return *m_single_frame_allocator;
+	}
+
 	// Returns the current project's name
 	rsl::string_view EngineGlobals::project_name() const
 	{
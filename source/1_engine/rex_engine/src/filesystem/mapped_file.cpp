@@ -0,0 +1,120 @@
+#include "rex_engine/filesystem/mapped_file.h"
+
+#include "rex_std/utility.h"
+
+namespace rex
+{
+	MappedFile::MappedFile()
+		: m_data(nullptr)
+		, m_size(0_bytes)
+		, m_native_handle(nullptr)
+		, m_is_mapped(false)
+		, m_owns_mapping(false)
+		, m_content()
+	{
+	}
+
+	MappedFile::MappedFile(memory::Blob&& content)
+		: m_data(nullptr)
+		, m_size(0_bytes)
+		, m_native_handle(nullptr)
+		, m_is_mapped(false)
+		, m_owns_mapping(false)
+		, m_content(rsl::move(content))
+	{
+		m_data = m_content.data();
+		m_size = m_content.size();
+	}
+
+	MappedFile::MappedFile(const rsl::byte* data, rsl::memory_size size, void* nativeHandle)
+		: m_data(data)
+		, m_size(size)
+		, m_native_handle(nativeHandle)
+		, m_is_mapped(data != nullptr)
+		, m_owns_mapping(data != nullptr)
+		, m_content()
+	{
+	}
+
+	MappedFile::MappedFile(memory::BlobView mappedContent)
+		: m_data(mappedContent.data())
+		, m_size(mappedContent.size())
+		, m_native_handle(nullptr)
+		, m_is_mapped(mappedContent.data() != nullptr)
+		, m_owns_mapping(false)
+		, m_content()
+	{
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_data(rsl::exchange(other.m_data, nullptr))
+		, m_size(rsl::exchange(other.m_size, 0_bytes))
+		, m_native_handle(rsl::exchange(other.m_native_handle, nullptr))
+		, m_is_mapped(rsl::exchange(other.m_is_mapped, false))
+		, m_owns_mapping(rsl::exchange(other.m_owns_mapping, false))
+		, m_content(rsl::move(other.m_content))
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		reset();
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		reset();
+
+		m_data = rsl::exchange(other.m_data, nullptr);
+		m_size = rsl::exchange(other.m_size, 0_bytes);
+		m_native_handle = rsl::exchange(other.m_native_handle, nullptr);
+		m_is_mapped = rsl::exchange(other.m_is_mapped, false);
+		m_owns_mapping = rsl::exchange(other.m_owns_mapping, false);
+		m_content = rsl::move(other.m_content);
+
+		return *this;
+	}
+
+	MappedFile::operator bool() const
+	{
+		return m_data != nullptr;
+	}
+
+	bool MappedFile::is_mapped() const
+	{
+		return m_is_mapped;
+	}
+
+	memory::BlobView MappedFile::view() const
+	{
+		return memory::BlobView(m_data, m_size);
+	}
+	const rsl::byte* MappedFile::data() const
+	{
+		return m_data;
+	}
+	rsl::memory_size MappedFile::size() const
+	{
+		return m_size;
+	}
+
+	void MappedFile::reset()
+	{
+		if (m_owns_mapping)
+		{
+			file::internal::unmap_file(m_data, m_size, m_native_handle);
+		}
+
+		m_data = nullptr;
+		m_size = 0_bytes;
+		m_native_handle = nullptr;
+		m_is_mapped = false;
+		m_owns_mapping = false;
+		m_content = memory::Blob();
+	}
+}
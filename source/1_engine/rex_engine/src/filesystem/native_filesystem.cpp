@@ -78,6 +78,32 @@ namespace rex
 
     return file::read_file_abspath(path, buffer, size);
   }
+  rsl::vector<memory::Blob> NativeFileSystem::read_files(const rsl::vector<rsl::string_view>& filepaths)
+  {
+    // The absolute paths need to stay alive while the files are read
+    rsl::vector<rsl::string> abs_paths;
+    rsl::vector<rsl::string_view> abs_path_views;
+    abs_paths.reserve(filepaths.size());
+    abs_path_views.reserve(filepaths.size());
+    for (const rsl::string_view filepath : filepaths)
+    {
+      abs_paths.emplace_back(path::unsafe_abs_path(path::remove_quotes(filepath)));
+      abs_path_views.push_back(abs_paths.back());
+    }
+
+    return file::read_files_abspath(abs_path_views);
+  }
+  bool NativeFileSystem::supports_batched_reads() const
+  {
+    return file::supports_batched_reads();
+  }
+  MappedFile NativeFileSystem::map_file(rsl::string_view path)
+  {
+    path = path::remove_quotes(path);
+    path = path::unsafe_abs_path(path);
+
+    return file::map_file_abspath(path);
+  }
 
   // --------------------------------
   // WRITING
@@ -0,0 +1,308 @@
+#include "rex_engine/filesystem/pak_archive.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/engine/casting.h"
+#include "rex_engine/filesystem/directory.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/path.h"
+#include "rex_engine/text_processing/text_processing.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
+#include "rex_std/limits.h"
+
+namespace rex
+{
+  DEFINE_LOG_CATEGORY(LogPak);
+
+  namespace pak
+  {
+    namespace internal
+    {
+      // Both seperators are treated as the same character
+      char8 normalized_char(char8 c)
+      {
+        return c == '\\' ? '/' : c;
+      }
+
+      // The align function in pointer_math works on 32 bit masks, archives can be bigger than that
+      u64 align_offset(u64 offset)
+      {
+        return (offset + g_entry_alignment - 1) & ~(g_entry_alignment - 1);
+      }
+
+      // A file that gets added to the archive
+      struct PackedFile
+      {
+        rsl::string name;
+        rsl::string fullpath;
+        u64 path_hash;
+        u64 size;
+      };
+
+      rsl::vector<PackedFile> files_to_pack(rsl::string_view root, rsl::string_view outputPath)
+      {
+        rsl::vector<PackedFile> files;
+        for (const rsl::string& entry : directory::list_entries(root, Recursive::yes))
+        {
+          const scratch_string fullpath = path::join(root, entry);
+          if (!file::exists_abspath(fullpath) || path::is_same_abspath(fullpath, outputPath))
+          {
+            continue;
+          }
+
+          PackedFile packed_file {};
+          packed_file.name.reserve(entry.length());
+          for (const char8 c : entry)
+          {
+            packed_file.name += normalized_char(c);
+          }
+          packed_file.fullpath.assign(fullpath);
+          packed_file.path_hash = hash_path(packed_file.name);
+          packed_file.size      = file::size_abspath(fullpath);
+          files.push_back(rsl::move(packed_file));
+        }
+
+        // The table of contents is sorted by hash so lookups can binary search it
+        // Names break ties so archives built from the same files are always identical
+        rsl::sort(files.begin(), files.end(),
+          [](const PackedFile& lhs, const PackedFile& rhs)
+          {
+            return lhs.path_hash != rhs.path_hash ? lhs.path_hash < rhs.path_hash : lhs.name < rhs.name;
+          });
+
+        return files;
+      }
+    } // namespace internal
+
+    u64 hash_path(rsl::string_view path)
+    {
+      // FNV-1a, the hash is stored in the archive so it needs to be the same on every platform
+      const u64 fnv_offset_basis = 0xcbf29ce484222325;
+      const u64 fnv_prime        = 0x100000001b3;
+
+      u64 hash = fnv_offset_basis;
+      for (const char8 c : path)
+      {
+        hash ^= static_cast<u8>(internal::normalized_char(c));
+        hash *= fnv_prime;
+      }
+
+      return hash;
+    }
+    bool is_same_path(rsl::string_view lhs, rsl::string_view rhs)
+    {
+      if (lhs.length() != rhs.length())
+      {
+        return false;
+      }
+
+      for (s32 idx = 0; idx < lhs.length(); ++idx)
+      {
+        if (internal::normalized_char(lhs[idx]) != internal::normalized_char(rhs[idx]))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    Error build(rsl::string_view root, rsl::string_view outputPath)
+    {
+      const rsl::string abs_root(path::abs_path(root));
+      const rsl::string abs_output_path(path::abs_path(outputPath));
+      if (!directory::exists_abspath(abs_root))
+      {
+        return Error::create_with_log(LogPak, "Cannot pack {} as it's not a directory", quoted(abs_root));
+      }
+
+      const rsl::vector<internal::PackedFile> files = internal::files_to_pack(abs_root, abs_output_path);
+
+      // Lay out the archive, the header, table of contents and names go first, followed by the data of every file
+      PakHeader header {};
+      header.magic        = g_magic;
+      header.version      = g_version;
+      header.num_entries  = static_cast<u32>(files.size());
+      header.toc_offset   = sizeof(PakHeader);
+      header.names_offset = header.toc_offset + files.size() * sizeof(PakEntry);
+      header.names_size   = 0;
+      for (const internal::PackedFile& packed_file : files)
+      {
+        header.names_size += packed_file.name.length();
+      }
+      header.data_offset = internal::align_offset(header.names_offset + header.names_size);
+
+      rsl::vector<PakEntry> entries;
+      entries.reserve(files.size());
+      u64 name_offset = 0;
+      u64 data_offset = header.data_offset;
+      for (const internal::PackedFile& packed_file : files)
+      {
+        PakEntry entry {};
+        entry.path_hash   = packed_file.path_hash;
+        entry.data_offset = data_offset;
+        entry.stored_size = packed_file.size;
+        entry.size        = packed_file.size;
+        entry.name_offset = static_cast<u32>(name_offset);
+        entry.name_length = static_cast<u32>(packed_file.name.length());
+        entry.compression = Compression::None;
+        entries.push_back(entry);
+
+        name_offset += packed_file.name.length();
+        data_offset = internal::align_offset(data_offset + packed_file.size);
+      }
+
+      // Archives are built in memory and written in one go
+      const u64 archive_size = data_offset;
+      if (archive_size > static_cast<u64>(rsl::numeric_limits<s32>::max()))
+      {
+        return Error::create_with_log(LogPak, "Cannot pack {}, the archive would be bigger than 2GB", quoted(abs_root));
+      }
+
+      rsl::unique_array<rsl::byte> archive = rsl::make_unique<rsl::byte[]>(static_cast<s32>(archive_size)); // NOLINT(modernize-avoid-c-arrays)
+      rsl::memset(archive.get(), 0, static_cast<card32>(archive_size));
+      rsl::memcpy(archive.get(), &header, sizeof(header));
+      rsl::memcpy(archive.get() + header.toc_offset, entries.data(), entries.size() * sizeof(PakEntry));
+      for (count_t idx = 0; idx < files.size(); ++idx)
+      {
+        const internal::PackedFile& packed_file = files[idx];
+        const PakEntry& entry                   = entries[idx];
+        rsl::memcpy(archive.get() + header.names_offset + entry.name_offset, packed_file.name.data(), packed_file.name.length());
+
+        const s32 num_bytes_read = file::read_file_abspath(packed_file.fullpath, archive.get() + entry.data_offset, static_cast<s64>(entry.size));
+        if (static_cast<u64>(num_bytes_read) != entry.size)
+        {
+          return Error::create_with_log(LogPak, "Failed to pack {}, the file could not be read", quoted(packed_file.fullpath));
+        }
+      }
+
+      REX_INFO(LogPak, "Packed {} files from {} into {} ({} bytes)", files.size(), quoted(abs_root), quoted(abs_output_path), archive_size);
+      return file::write_to_file_abspath(abs_output_path, archive.get(), archive_size);
+    }
+  } // namespace pak
+
+  PakArchive::PakArchive()
+    : m_mapped_file()
+    , m_header(nullptr)
+    , m_entries(nullptr)
+    , m_names()
+  {
+  }
+
+  Error PakArchive::open(rsl::string_view pakPath)
+  {
+    m_mapped_file = file::map_file(pakPath);
+    m_header      = nullptr;
+    m_entries     = nullptr;
+    m_names       = rsl::string_view();
+
+    const u64 archive_size = m_mapped_file.size();
+    if (archive_size < sizeof(pak::PakHeader))
+    {
+      return Error::create_with_log(LogPak, "{} is not a valid archive, it's too small", quoted(pakPath));
+    }
+
+    const pak::PakHeader* header = m_mapped_file.view().data_as<pak::PakHeader>();
+    if (header->magic != pak::g_magic || header->version != pak::g_version)
+    {
+      return Error::create_with_log(LogPak, "{} is not a valid archive or was built with a different version", quoted(pakPath));
+    }
+
+    // Make sure the table of contents and every entry lie within the archive
+    // this way lookups never have to check bounds anymore
+    // The offsets and sizes come from the file, so they're compared against what's left of the archive, adding them could overflow
+    const bool is_toc_in_archive    = header->toc_offset <= archive_size && header->num_entries <= (archive_size - header->toc_offset) / sizeof(pak::PakEntry);
+    const bool are_names_in_archive = header->names_offset <= archive_size && header->names_size <= archive_size - header->names_offset;
+    if (!is_toc_in_archive || !are_names_in_archive)
+    {
+      return Error::create_with_log(LogPak, "The table of contents of {} is corrupt", quoted(pakPath));
+    }
+
+    const pak::PakEntry* entries = reinterpret_cast<const pak::PakEntry*>(m_mapped_file.data() + header->toc_offset); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    for (u32 idx = 0; idx < header->num_entries; ++idx)
+    {
+      const pak::PakEntry& entry = entries[idx];
+      const bool is_data_in_archive = entry.data_offset <= archive_size && entry.stored_size <= archive_size - entry.data_offset;
+      const bool is_name_in_names   = entry.name_offset <= header->names_size && entry.name_length <= header->names_size - entry.name_offset;
+      if (!is_data_in_archive || !is_name_in_names)
+      {
+        return Error::create_with_log(LogPak, "Entry {} of {} is corrupt", idx, quoted(pakPath));
+      }
+      if (entry.compression != pak::Compression::None)
+      {
+        return Error::create_with_log(LogPak, "Entry {} of {} uses an unsupported compression", idx, quoted(pakPath));
+      }
+      // Uncompressed data is handed out as is, so its loaded size has to be the size it's stored with
+      if (entry.size != entry.stored_size)
+      {
+        return Error::create_with_log(LogPak, "Entry {} of {} is corrupt, its size doesn't match its stored size", idx, quoted(pakPath));
+      }
+    }
+
+    m_header  = header;
+    m_entries = entries;
+    m_names   = rsl::string_view(m_mapped_file.view().data_as<char8>() + header->names_offset, narrow_cast<s32>(header->names_size));
+
+    REX_INFO(LogPak, "Opened archive {} with {} files", quoted(pakPath), header->num_entries);
+    return Error::no_error();
+  }
+
+  bool PakArchive::is_open() const
+  {
+    return m_header != nullptr;
+  }
+
+  const pak::PakEntry* PakArchive::find(rsl::string_view path) const
+  {
+    if (!is_open())
+    {
+      return nullptr;
+    }
+
+    // Binary search for the first entry with the same hash
+    // and walk all entries with that hash in case multiple paths hash to the same value
+    const u64 path_hash = pak::hash_path(path);
+    u32 first = 0;
+    u32 last  = m_header->num_entries;
+    while (first < last)
+    {
+      const u32 middle = first + (last - first) / 2;
+      if (m_entries[middle].path_hash < path_hash)
+      {
+        first = middle + 1;
+      }
+      else
+      {
+        last = middle;
+      }
+    }
+
+    for (const pak::PakEntry* it = m_entries + first; it != end() && it->path_hash == path_hash; ++it)
+    {
+      if (pak::is_same_path(name(*it), path))
+      {
+        return it;
+      }
+    }
+
+    return nullptr;
+  }
+  rsl::string_view PakArchive::name(const pak::PakEntry& entry) const
+  {
+    return m_names.substr(static_cast<count_t>(entry.name_offset), static_cast<count_t>(entry.name_length));
+  }
+  memory::BlobView PakArchive::data(const pak::PakEntry& entry) const
+  {
+    return memory::BlobView(m_mapped_file.data() + entry.data_offset, rsl::memory_size(entry.stored_size));
+  }
+
+  const pak::PakEntry* PakArchive::begin() const
+  {
+    return m_entries;
+  }
+  const pak::PakEntry* PakArchive::end() const
+  {
+    return is_open() ? m_entries + m_header->num_entries : m_entries;
+  }
+} // namespace rex
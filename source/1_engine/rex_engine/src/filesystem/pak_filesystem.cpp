@@ -0,0 +1,376 @@
+#include "rex_engine/filesystem/pak_filesystem.h"
+
+#include "rex_engine/filesystem/directory.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/path.h"
+#include "rex_engine/text_processing/text_processing.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
+#include "rex_std/unordered_map.h"
+
+namespace rex
+{
+  namespace internal
+  {
+    bool is_seperator(char8 c)
+    {
+      return c == '/' || c == '\\';
+    }
+
+    // Returns the path relative to the directory of an archive
+    // Returns an empty string if the path is not under this directory
+    rsl::string_view path_in_pak(rsl::string_view fullpath, rsl::string_view pakDir)
+    {
+      if (fullpath.length() <= pakDir.length() || !fullpath.starts_with(pakDir) || !is_seperator(fullpath[pakDir.length()]))
+      {
+        return rsl::string_view();
+      }
+
+      return fullpath.substr(pakDir.length() + 1);
+    }
+
+    // Returns the prefix that all packed entries under a directory start with
+    // Returns false if the directory is not in the archive
+    bool dir_prefix_in_pak(rsl::string_view fullpath, rsl::string_view pakDir, scratch_string& outPrefix)
+    {
+      outPrefix.clear();
+      if (fullpath == pakDir)
+      {
+        return true;
+      }
+
+      const rsl::string_view dir_in_pak = path_in_pak(fullpath, pakDir);
+      if (dir_in_pak.empty())
+      {
+        return false;
+      }
+
+      // Packed names always use forward slashes
+      outPrefix.assign(dir_in_pak);
+      for (char8& c : outPrefix)
+      {
+        c = is_seperator(c) ? '/' : c;
+      }
+      outPrefix += '/';
+      return true;
+    }
+
+    // Returns true if the name starts with the prefix, ignoring the kind of seperators used
+    bool starts_with_prefix(rsl::string_view name, rsl::string_view prefix)
+    {
+      return name.length() >= prefix.length() && pak::is_same_path(name.substr(0, prefix.length()), prefix);
+    }
+
+    // Adds entries to a list, skipping the ones already in it
+    // The entries are looked up by their path hash so adding one doesn't compare it against all others
+    class UniqueEntries
+    {
+    public:
+      explicit UniqueEntries(rsl::vector<rsl::string>& entries)
+        : m_entries(entries)
+      {
+        for (count_t idx = 0; idx < m_entries.size(); ++idx)
+        {
+          m_indices.emplace(pak::hash_path(m_entries[idx]), idx);
+        }
+      }
+
+      void add(rsl::string_view entry)
+      {
+        const u64 path_hash = pak::hash_path(entry);
+        auto it = m_indices.find(path_hash);
+        if (it != m_indices.end())
+        {
+          if (pak::is_same_path(m_entries[it->value], entry))
+          {
+            return;
+          }
+
+          // Another path has the same hash, fall back to comparing against all entries
+          const auto entry_it = rsl::find_if(m_entries.cbegin(), m_entries.cend(), [entry](const rsl::string& existing) { return pak::is_same_path(existing, entry); });
+          if (entry_it == m_entries.cend())
+          {
+            m_entries.emplace_back(entry);
+          }
+          return;
+        }
+
+        m_indices.emplace(path_hash, m_entries.size());
+        m_entries.emplace_back(entry);
+      }
+
+    private:
+      rsl::vector<rsl::string>& m_entries;
+      rsl::unordered_map<u64, count_t> m_indices;
+    };
+
+    // Returns true if any of the sorted names starts with the prefix
+    bool has_name_with_prefix(const rsl::vector<rsl::string_view>& sortedNames, rsl::string_view prefix)
+    {
+      // Names starting with the prefix are next to each other, the first one of them is the first name that's not smaller than the prefix
+      count_t first = 0;
+      count_t last  = sortedNames.size();
+      while (first < last)
+      {
+        const count_t middle = first + (last - first) / 2;
+        if (sortedNames[middle] < prefix)
+        {
+          first = middle + 1;
+        }
+        else
+        {
+          last = middle;
+        }
+      }
+
+      return first != sortedNames.size() && sortedNames[first].starts_with(prefix);
+    }
+
+    memory::Blob copy_to_blob(memory::BlobView content)
+    {
+      if (content.size() == 0)
+      {
+        return {};
+      }
+
+      rsl::unique_array<rsl::byte> buffer = rsl::make_unique<rsl::byte[]>(static_cast<s32>(content.size())); // NOLINT(modernize-avoid-c-arrays)
+      rsl::memcpy(buffer.get(), content.data(), content.size());
+      return memory::Blob(rsl::move(buffer));
+    }
+  } // namespace internal
+
+  PakFileSystem::PakFileSystem(rsl::string_view root, LooseFilesOverride looseFilesOverride)
+    : NativeFileSystem(root)
+    , m_mounted_paks()
+    , m_loose_files_override(looseFilesOverride)
+  {
+  }
+
+  Error PakFileSystem::mount_pak(MountingPoint root, rsl::string_view pakPath)
+  {
+    return mount_pak(mounted_path(root), pakPath);
+  }
+  Error PakFileSystem::mount_pak(rsl::string_view dir, rsl::string_view pakPath)
+  {
+    // Archives are only mounted at startup, before any files are read from the io workers
+    rsl::unique_ptr<MountedPak> mounted_pak = rsl::make_unique<MountedPak>();
+    mounted_pak->dir.assign(path::norm_path(abs_path(dir)));
+
+    Error error = mounted_pak->archive.open(abs_path(pakPath));
+    if (error)
+    {
+      return error;
+    }
+
+    for (const pak::PakEntry& entry : mounted_pak->archive)
+    {
+      mounted_pak->sorted_names.push_back(mounted_pak->archive.name(entry));
+    }
+    rsl::sort(mounted_pak->sorted_names.begin(), mounted_pak->sorted_names.end());
+
+    m_mounted_paks.push_back(rsl::move(mounted_pak));
+    return Error::no_error();
+  }
+
+  // --------------------------------
+  // READING
+  // --------------------------------
+  memory::Blob PakFileSystem::read_file(rsl::string_view path)
+  {
+    const memory::BlobView packed_file = find_packed_file(path);
+    if (packed_file)
+    {
+      return internal::copy_to_blob(packed_file);
+    }
+
+    return NativeFileSystem::read_file(path);
+  }
+  s32 PakFileSystem::read_file(rsl::string_view path, rsl::byte* buffer, s32 size)
+  {
+    const memory::BlobView packed_file = find_packed_file(path);
+    if (packed_file)
+    {
+      const s32 num_bytes_read = rsl::min(size, static_cast<s32>(packed_file.size()));
+      rsl::memcpy(buffer, packed_file.data(), num_bytes_read);
+      return num_bytes_read;
+    }
+
+    return NativeFileSystem::read_file(path, buffer, size);
+  }
+  rsl::vector<memory::Blob> PakFileSystem::read_files(const rsl::vector<rsl::string_view>& filepaths)
+  {
+    // Packed files are copied straight from the archive, all other files are read from disk in a single batch
+    rsl::vector<memory::Blob> contents;
+    rsl::vector<rsl::string_view> loose_paths;
+    rsl::vector<count_t> loose_indices;
+    contents.reserve(filepaths.size());
+    for (count_t idx = 0; idx < filepaths.size(); ++idx)
+    {
+      const memory::BlobView packed_file = find_packed_file(filepaths[idx]);
+      if (packed_file)
+      {
+        contents.push_back(internal::copy_to_blob(packed_file));
+      }
+      else
+      {
+        contents.emplace_back();
+        loose_paths.push_back(filepaths[idx]);
+        loose_indices.push_back(idx);
+      }
+    }
+
+    if (!loose_paths.empty())
+    {
+      rsl::vector<memory::Blob> loose_contents = NativeFileSystem::read_files(loose_paths);
+      for (count_t idx = 0; idx < loose_indices.size(); ++idx)
+      {
+        contents[loose_indices[idx]] = rsl::move(loose_contents[idx]);
+      }
+    }
+
+    return contents;
+  }
+  MappedFile PakFileSystem::map_file(rsl::string_view path)
+  {
+    const memory::BlobView packed_file = find_packed_file(path);
+    if (packed_file)
+    {
+      // The archive is mapped as a whole, the mapped file views into it
+      return packed_file.size() != 0 ? MappedFile(packed_file) : MappedFile();
+    }
+
+    return NativeFileSystem::map_file(path);
+  }
+
+  // --------------------------------
+  // QUERYING
+  // --------------------------------
+  bool PakFileSystem::is_directory(rsl::string_view path) const
+  {
+    if (NativeFileSystem::is_directory(path))
+    {
+      return true;
+    }
+
+    const scratch_string fullpath = path::norm_path(abs_path(path));
+    scratch_string prefix;
+    for (const rsl::unique_ptr<MountedPak>& mounted_pak : m_mounted_paks)
+    {
+      if (!internal::dir_prefix_in_pak(fullpath, mounted_pak->dir, prefix))
+      {
+        continue;
+      }
+
+      // The directory doesn't exist on its own in the archive, it exists if any file is packed under it
+      if (internal::has_name_with_prefix(mounted_pak->sorted_names, prefix))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+  bool PakFileSystem::is_file(rsl::string_view path) const
+  {
+    return find_packed_file(path) || NativeFileSystem::is_file(path);
+  }
+  bool PakFileSystem::exists(rsl::string_view path) const
+  {
+    return is_file(path) || is_directory(path);
+  }
+
+  rsl::vector<rsl::string> PakFileSystem::list_entries(rsl::string_view path, Recursive recursive)
+  {
+    rsl::vector<rsl::string> entries = NativeFileSystem::is_directory(path) ? NativeFileSystem::list_entries(path, recursive) : rsl::vector<rsl::string>();
+    list_packed_entries(path, recursive, ListFiles::yes, ListDirs::yes, entries);
+    return entries;
+  }
+  rsl::vector<rsl::string> PakFileSystem::list_dirs(rsl::string_view path)
+  {
+    rsl::vector<rsl::string> dirs = NativeFileSystem::is_directory(path) ? NativeFileSystem::list_dirs(path) : rsl::vector<rsl::string>();
+    list_packed_entries(path, Recursive::no, ListFiles::no, ListDirs::yes, dirs);
+    return dirs;
+  }
+  rsl::vector<rsl::string> PakFileSystem::list_files(rsl::string_view path)
+  {
+    rsl::vector<rsl::string> files = NativeFileSystem::is_directory(path) ? NativeFileSystem::list_files(path) : rsl::vector<rsl::string>();
+    list_packed_entries(path, Recursive::no, ListFiles::yes, ListDirs::no, files);
+    return files;
+  }
+
+  memory::BlobView PakFileSystem::find_packed_file(rsl::string_view path) const
+  {
+    if (m_mounted_paks.empty())
+    {
+      return memory::BlobView();
+    }
+
+    const scratch_string fullpath = path::norm_path(abs_path(path));
+    for (const rsl::unique_ptr<MountedPak>& mounted_pak : m_mounted_paks)
+    {
+      const rsl::string_view path_in_pak = internal::path_in_pak(fullpath, mounted_pak->dir);
+      if (path_in_pak.empty())
+      {
+        continue;
+      }
+
+      const pak::PakEntry* entry = mounted_pak->archive.find(path_in_pak);
+      if (entry == nullptr)
+      {
+        continue;
+      }
+
+      // Only packed files pay for the extra check on disk, other files go to disk anyway
+      if (m_loose_files_override && file::exists_abspath(fullpath))
+      {
+        return memory::BlobView();
+      }
+
+      return mounted_pak->archive.data(*entry);
+    }
+
+    return memory::BlobView();
+  }
+  void PakFileSystem::list_packed_entries(rsl::string_view path, Recursive recursive, ListFiles listFiles, ListDirs listDirs, rsl::vector<rsl::string>& outEntries) const
+  {
+    const scratch_string fullpath = path::norm_path(abs_path(path));
+    scratch_string prefix;
+    internal::UniqueEntries unique_entries(outEntries);
+    for (const rsl::unique_ptr<MountedPak>& mounted_pak : m_mounted_paks)
+    {
+      if (!internal::dir_prefix_in_pak(fullpath, mounted_pak->dir, prefix))
+      {
+        continue;
+      }
+
+      for (const pak::PakEntry& entry : mounted_pak->archive)
+      {
+        const rsl::string_view name = mounted_pak->archive.name(entry);
+        if (!internal::starts_with_prefix(name, prefix))
+        {
+          continue;
+        }
+
+        // Every seperator in the remainder of the name is a directory the file is in
+        const rsl::string_view remainder = name.substr(prefix.length());
+        for (count_t pos = remainder.find('/'); pos != rsl::string_view::npos(); pos = remainder.find('/', pos + 1))
+        {
+          if (listDirs)
+          {
+            unique_entries.add(remainder.substr(0, pos));
+          }
+          if (!recursive)
+          {
+            break;
+          }
+        }
+
+        const bool is_direct_child = remainder.find('/') == rsl::string_view::npos();
+        if (listFiles && (recursive || is_direct_child))
+        {
+          unique_entries.add(remainder);
+        }
+      }
+    }
+  }
+} // namespace rex
@@ -0,0 +1,102 @@
+#include "rex_engine/filesystem/path_id.h"
+
+#include "rex_engine/filesystem/path.h"
+#include "rex_engine/memory/memory_tags.h"
+#include "rex_engine/memory/memory_tracking.h"
+#include "rex_std/memory.h"
+#include "rex_std/mutex.h"
+#include "rex_std/string.h"
+#include "rex_std/unordered_map.h"
+
+namespace rex
+{
+  namespace internal
+  {
+    // The pool owning the strings of all path ids
+    // Path ids can be created from any thread, eg. when an io worker reads a file
+    class PathPool
+    {
+    public:
+      PathId find_or_store(rsl::string_view normPath)
+      {
+        const rsl::hash_result hash = rsl::hash<rsl::string_view>{}(normPath);
+
+        const rsl::unique_lock lock(m_mtx);
+        auto it = m_entries.find(normPath);
+        if (it != m_entries.end())
+        {
+          return PathId(hash, *it->value);
+        }
+
+        REX_MEM_TAG_SCOPE(MemoryTag::StringPool);
+
+        // The key views into the string it maps to, which is heap allocated so it never moves
+        rsl::unique_ptr<rsl::string> path = rsl::make_unique<rsl::string>(normPath);
+        const rsl::string_view interned_path = *path;
+        m_entries.emplace(interned_path, rsl::move(path));
+        return PathId(hash, interned_path);
+      }
+
+    private:
+      rsl::mutex m_mtx;
+      rsl::unordered_map<rsl::string_view, rsl::unique_ptr<rsl::string>> m_entries;
+    };
+
+    PathPool& path_pool()
+    {
+      static PathPool pool;
+      return pool;
+    }
+  } // namespace internal
+
+  PathId::PathId()
+    : m_hash(0)
+    , m_path()
+  {
+  }
+  PathId::PathId(rsl::hash_result hash, rsl::string_view path)
+    : m_hash(hash)
+    , m_path(path)
+  {
+  }
+
+  PathId PathId::create(rsl::string_view path)
+  {
+    scratch_string norm_path = path::norm_path(path);
+    if (norm_path.empty())
+    {
+      return PathId();
+    }
+
+    norm_path.replace("\\", "/");
+    return internal::path_pool().find_or_store(norm_path);
+  }
+
+  PathId::operator bool() const
+  {
+    return is_valid();
+  }
+  bool PathId::is_valid() const
+  {
+    return !m_path.empty();
+  }
+
+  rsl::string_view PathId::string() const
+  {
+    return m_path;
+  }
+  rsl::hash_result PathId::hash() const
+  {
+    return m_hash;
+  }
+
+  bool PathId::operator==(const PathId& other) const
+  {
+    // Equal paths share the same interned string
+    return m_path.data() == other.m_path.data();
+  }
+  bool PathId::operator!=(const PathId& other) const
+  {
+    return !(*this == other);
+  }
+} // namespace rex
@@ -5,11 +5,13 @@
 
 namespace rex
 {
-	QueuedRequest::QueuedRequest(rsl::string_view filepath)
+	QueuedRequest::QueuedRequest(PathId filepath)
 		: m_filepath(filepath)
 		, m_requests()
 		, m_requests_access_mtx()
 		, m_is_done(false)
+		, m_is_closed(false)
+		, m_content()
 	{
 	}
 
@@ -17,15 +19,30 @@ namespace rex
 	{
 		const rsl::unique_lock lock(m_requests_access_mtx);
 		m_requests.push_back(request);
+
+		if (m_is_done)
+		{
+			request->signal(m_content.data(), m_content.size());
+		}
 	}
 	void QueuedRequest::remove_request_to_signal(ReadRequest* request)
 	{
-		const rsl::unique_lock lock(m_requests_access_mtx);
-		auto it = rsl::find(m_requests.cbegin(), m_requests.cend(), request);
+		bool is_last_request = false;
+		{
+			const rsl::unique_lock lock(m_requests_access_mtx);
+			auto it = rsl::find(m_requests.cbegin(), m_requests.cend(), request);
 
-		if (it != m_requests.cend())
+			if (it != m_requests.cend())
+			{
+				m_requests.erase(it);
+			}
+			is_last_request = m_is_closed && m_requests.empty();
+		}
+
+		// Nothing can start using a closed request, so the last read request to detach frees it and the file's content
+		if (is_last_request)
 		{
-			m_requests.erase(it);
+			delete this; // NOLINT(cppcoreguidelines-owning-memory)
 		}
 	}
 	void QueuedRequest::swap_request_to_signal(ReadRequest* original, ReadRequest* newRequest)
@@ -36,26 +53,52 @@ namespace rex
 		REX_ASSERT_X(it != m_requests.end(), "Request at {} not found as a request to signa", reinterpret_cast<void*>(original)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
 
 		*it = newRequest;
+
+		// The original could have been signaled while the new request was copying its state
+		if (m_is_done)
+		{
+			newRequest->signal(m_content.data(), m_content.size());
+		}
 	}
 
-	void QueuedRequest::signal_requests(const rsl::byte* buffer, rsl::memory_size size)
+	void QueuedRequest::signal_requests(memory::Blob&& content)
 	{
 		const rsl::unique_lock lock(m_requests_access_mtx);
 
+		m_content = rsl::move(content);
+		m_is_done = true;
+
 		for (ReadRequest* read_request : m_requests)
 		{
-			read_request->signal(buffer, size);
+			read_request->signal(m_content.data(), m_content.size());
 		}
 	}
 
-	bool QueuedRequest::all_requests_finished() const
+	bool QueuedRequest::is_done() const
 	{
-		return m_requests.empty();
+		return m_is_done;
+	}
+	void QueuedRequest::close()
+	{
+		bool has_requests = false;
+		{
+			const rsl::unique_lock lock(m_requests_access_mtx);
+			m_is_closed = true;
+			has_requests = !m_requests.empty();
+		}
+
+		if (!has_requests)
+		{
+			delete this; // NOLINT(cppcoreguidelines-owning-memory)
+		}
 	}
 
 	rsl::string_view QueuedRequest::filepath() const
+	{
+		return m_filepath.string();
+	}
+	PathId QueuedRequest::path_id() const
 	{
 		return m_filepath;
 	}
 }
-
@@ -4,6 +4,7 @@
 #include "rex_engine/diagnostics/assert.h"
 
 #include "rex_std/chrono.h"
+#include "rex_std/mutex.h"
 #include "rex_std/thread.h"
 
 namespace rex
@@ -14,27 +15,37 @@ namespace rex
 		, m_is_done(false)
 		, m_buffer(nullptr)
 		, m_size(0_bytes)
+		, m_on_done()
+		, m_on_done_lock()
 	{
 	}
 
 	ReadRequest::ReadRequest(const ReadRequest& other)
 		: m_filepath(other.m_filepath)
 		, m_queued_request(other.m_queued_request)
-		, m_is_done(other.m_is_done)
+		, m_is_done(other.m_is_done.load())
 		, m_buffer(other.m_buffer)
 		, m_size(other.m_size)
 	{
-		m_queued_request->add_request_to_signal(this);
+		if (m_queued_request)
+		{
+			m_queued_request->add_request_to_signal(this);
+		}
 	}
 
 	ReadRequest::ReadRequest(ReadRequest&& other)
 		: m_filepath(rsl::exchange(other.m_filepath, ""))
 		, m_queued_request(rsl::exchange(other.m_queued_request, nullptr))
-		, m_is_done(rsl::exchange(other.m_is_done, false))
+		, m_is_done(other.m_is_done.exchange(false))
 		, m_buffer(rsl::exchange(other.m_buffer, nullptr))
 		, m_size(rsl::exchange(other.m_size, 0_bytes))
+		, m_on_done(rsl::move(other.m_on_done))
+		, m_on_done_lock()
 	{
-		m_queued_request->swap_request_to_signal(&other, this);
+		if (m_queued_request)
+		{
+			m_queued_request->swap_request_to_signal(&other, this);
+		}
 	}
 
 	ReadRequest::~ReadRequest()
@@ -49,15 +60,21 @@ namespace rex
 	{
 		REX_ASSERT_X(this != &other, "assigning a read request to itself");
 
-		m_queued_request->remove_request_to_signal(this);
+		if (m_queued_request)
+		{
+			m_queued_request->remove_request_to_signal(this);
+		}
 
 		m_filepath = other.m_filepath;
 		m_queued_request = other.m_queued_request;
-		m_is_done = other.m_is_done;
+		m_is_done = other.m_is_done.load();
 		m_buffer = other.m_buffer;
 		m_size = other.m_size;
 
-		m_queued_request->add_request_to_signal(this);
+		if (m_queued_request)
+		{
+			m_queued_request->add_request_to_signal(this);
+		}
 
 		return *this;
 	}
@@ -65,22 +82,42 @@ namespace rex
 	{
 		REX_ASSERT_X(this != &other, "moving a read request to itself");
 
+		// Stop listening to the request this was waiting on, otherwise it would signal this with the wrong file
+		if (m_queued_request)
+		{
+			m_queued_request->remove_request_to_signal(this);
+		}
+
 		m_filepath = rsl::exchange(other.m_filepath, "");
 		m_queued_request = rsl::exchange(other.m_queued_request, nullptr);
-		m_is_done = rsl::exchange(other.m_is_done, false);
+		m_is_done = other.m_is_done.exchange(false);
 		m_buffer = rsl::exchange(other.m_buffer, nullptr);
 		m_size = rsl::exchange(other.m_size, 0_bytes);
+		m_on_done = rsl::move(other.m_on_done);
 
-		m_queued_request->swap_request_to_signal(&other, this);
+		if (m_queued_request)
+		{
+			m_queued_request->swap_request_to_signal(&other, this);
+		}
 
 		return *this;
 	}
 
 	void ReadRequest::signal(const rsl::byte* buffer, rsl::memory_size size)
 	{
-		m_is_done = true;
-		m_buffer = buffer;
-		m_size = size;
+		rsl::function<void()> on_done;
+		{
+			const rsl::unique_lock lock(m_on_done_lock);
+			m_buffer = buffer;
+			m_size = size;
+			m_is_done = true;
+			on_done = rsl::move(m_on_done);
+		}
+
+		if (on_done)
+		{
+			on_done();
+		}
 	}
 
 	void ReadRequest::wait() const
@@ -93,6 +130,27 @@ namespace rex
 		}
 	}
 
+	// Returns true if the request has finished reading
+	bool ReadRequest::is_done() const
+	{
+		return m_is_done;
+	}
+	// Call the callable when the request has finished reading
+	// If it's already done, the callable is called immediately
+	void ReadRequest::when_done(rsl::function<void()>&& callback)
+	{
+		{
+			const rsl::unique_lock lock(m_on_done_lock);
+			if (!m_is_done)
+			{
+				m_on_done = rsl::move(callback);
+				return;
+			}
+		}
+
+		callback();
+	}
+
 	const rsl::byte* ReadRequest::data() const
 	{
 		return m_buffer;
@@ -11,7 +11,9 @@
 #include "rex_engine/filesystem/file.h"
 #include "rex_engine/filesystem/path.h"
 #include "rex_engine/filesystem/internal/queued_request.h"
-#include "rex_engine/platform/win/diagnostics/win_call.h"
+#include "rex_engine/text_processing/text_processing.h"
+#include "rex_engine/threading/thread.h"
+#include "rex_std/algorithm.h"
 #include "rex_std/bonus/atomic/atomic.h"
 #include "rex_std/bonus/hashtable.h"
 #include "rex_std/bonus/memory.h"
@@ -39,7 +41,7 @@
 // to process the data it just read
 // It works as follows:
 //
-// rex::vfs::instance()->ReadRequest request = rex::vfs::instance()->read_file_async("path/to/file");
+// rex::vfs::instance()->ReadRequest request = rex::vfs::instance()->read_file_async(rex::MountingPoint::EngineRoot, "path/to/file");
 //
 // Do some other code here
 // ..
@@ -76,7 +78,7 @@
 // | User Continues | <-----------------+------------------------------- | Return Read Request To User |   <----------------------+
 // +----------------+                   |                                +-----------------------------+
 //         |                            |
-//         |                            |                                               The following happens on the vfs thread
+//         |                            |                                               The following happens on one of the io workers
 //         |                            |              +----------------------------------------------------------------------------------------------------+
 //         |                            |              |                                                                                                    |
 //         |                            |              |       +----------------------------------+      +--------------------------+      +-----------+    |
@@ -102,6 +104,13 @@
 //                                      |              |                                                                                                    |
 //                                      |              +----------------------------------------------------------------------------------------------------+
 //
+// Requests for a file that's already queued share the queued request, so the file only gets read once.
+// After a queued request is read, it's closed. The next request for the same file reads it again.
+// A closed request owns the content of the file, it's destroyed as soon as the last read request using it is gone.
+// Instead of waiting, users can also register a callback on the read request, it gets called on the io worker
+// When the filesystem reads batches together, an io worker takes its share of the queued requests, up to g_vfs_max_read_batch_size
+// and reads their files together. Otherwise it takes one request at a time.
+//
 
 // #TODO: Remaining cleanup of development/Pokemon -> main merge. ID: MOUNT POINTS
 
@@ -110,9 +119,14 @@ namespace rex
   VfsBase::VfsBase(rsl::string_view root)
     : m_vfs_state_controller(VfsState::NotInitialized)
     , m_root(root)
+    , m_num_io_workers(g_vfs_default_num_io_workers)
+    , m_is_stopping_io_workers(false)
   {}
 
-  VfsBase::~VfsBase() = default;
+  VfsBase::~VfsBase()
+  {
+    stop_io_workers();
+  }
 
   rsl::string_view VfsBase::root() const
   {
@@ -131,6 +145,42 @@ namespace rex
       create_dirs(full_path);
     }
   }
+  rsl::string_view VfsBase::mounted_path(MountingPoint root) const
+  {
+    return m_mounted_roots.at(root);
+  }
+  Error VfsBase::mount_pak(MountingPoint root, rsl::string_view pakPath)
+  {
+    return Error::create_with_log(LogVfs, "Cannot mount {} at {}, this filesystem doesn't support archives", quoted(pakPath), rsl::enum_refl::enum_name(root));
+  }
+
+  void VfsBase::set_num_io_workers(s32 numIoWorkers)
+  {
+    const rsl::unique_lock lock(m_read_request_mutex);
+    REX_ASSERT_X(m_io_workers.empty(), "Changing the number of io workers after they've started");
+    REX_ASSERT_X(numIoWorkers > 0, "The vfs needs at least 1 io worker. requested: {}", numIoWorkers);
+
+    m_num_io_workers = rsl::max(numIoWorkers, 1);
+  }
+  s32 VfsBase::num_io_workers() const
+  {
+    return m_num_io_workers;
+  }
+  void VfsBase::stop_io_workers()
+  {
+    {
+      const rsl::unique_lock lock(m_read_request_mutex);
+      m_is_stopping_io_workers = true;
+    }
+    m_read_request_cv.notify_all();
+
+    for (rsl::thread& io_worker : m_io_workers)
+    {
+      io_worker.join();
+    }
+    m_io_workers.clear();
+    m_is_stopping_io_workers = false;
+  }
 
   // --------------------------------
   // CREATING
@@ -139,14 +189,14 @@ namespace rex
   {
     filepath = path::remove_quotes(filepath);
 
-    scratch_string fullpath = path::join(m_mounted_roots.at(root), filepath);
+    scratch_string fullpath = path::join(mounted_path(root), filepath);
     return create_file(fullpath);
   }
   Error VfsBase::create_dir(MountingPoint root, rsl::string_view path)
   {
     path = path::remove_quotes(path);
 
-    scratch_string fullpath = path::join(m_mounted_roots.at(root), path);
+    scratch_string fullpath = path::join(mounted_path(root), path);
     return create_dir(fullpath);
   }
 
@@ -157,21 +207,21 @@ namespace rex
   {
     path = path::remove_quotes(path);
 
-    scratch_string fullpath = path::join(m_mounted_roots.at(root), path);
+    scratch_string fullpath = path::join(mounted_path(root), path);
     return delete_file(fullpath);
   }
   Error VfsBase::delete_dir(MountingPoint root, rsl::string_view path)
   {
     path = path::remove_quotes(path);
 
-    const scratch_string fullpath = path::join(m_mounted_roots.at(root), path);
+    const scratch_string fullpath = path::join(mounted_path(root), path);
     return delete_dir(fullpath);
   }
   Error VfsBase::delete_dir_recursive(MountingPoint root, rsl::string_view path)
   {
     path = path::remove_quotes(path);
 
-    const scratch_string fullpath = path::join(m_mounted_roots.at(root), path);
+    const scratch_string fullpath = path::join(mounted_path(root), path);
     return delete_dir_recursive(fullpath);
   }
 
@@ -182,46 +232,74 @@ namespace rex
   {
     filepath = path::remove_quotes(filepath);
 
-    const scratch_string fullpath = path::join(m_mounted_roots.at(root), filepath);
+    const scratch_string fullpath = path::join(mounted_path(root), filepath);
     return read_file(fullpath);
   }
   s32 VfsBase::read_file(MountingPoint root, rsl::string_view filepath, rsl::byte* buffer, s32 size)
   {
     filepath = path::remove_quotes(filepath);
 
-    const scratch_string fullpath = path::join(m_mounted_roots.at(root), filepath);
+    const scratch_string fullpath = path::join(mounted_path(root), filepath);
     return read_file(fullpath, buffer, size);
   }
-  REX_NO_DISCARD ReadRequest VfsBase::read_file_async(MountingPoint root, rsl::string_view filepath)
+  rsl::vector<memory::Blob> VfsBase::read_files(const rsl::vector<rsl::string_view>& filepaths)
+  {
+    rsl::vector<memory::Blob> contents;
+    contents.reserve(filepaths.size());
+    for (const rsl::string_view filepath : filepaths)
+    {
+      contents.push_back(read_file(filepath));
+    }
+
+    return contents;
+  }
+  bool VfsBase::supports_batched_reads() const
+  {
+    return false;
+  }
+  REX_NO_DISCARD MappedFile VfsBase::map_file(MountingPoint root, rsl::string_view filepath)
   {
     filepath = path::remove_quotes(filepath);
 
-    const scratch_string fullpath = path::join(m_mounted_roots.at(root), filepath);
-    return read_file_async(fullpath);
+    const scratch_string fullpath = path::join(mounted_path(root), filepath);
+    return map_file(fullpath);
   }
-  ReadRequest VfsBase::read_file_async(rsl::string_view path)
+  MappedFile VfsBase::map_file(rsl::string_view filepath)
   {
-    path = path::remove_quotes(path);
-    path = path::unsafe_abs_path(path);
+    return MappedFile(read_file(filepath));
+  }
+  REX_NO_DISCARD ReadRequest VfsBase::read_file_async(MountingPoint root, rsl::string_view filepath)
+  {
+    filepath = path::remove_quotes(filepath);
+    return read_file_async(mounted_path_id(root, filepath));
+  }
+  ReadRequest VfsBase::read_file_async(PathId fullpath)
+  {
+    const rsl::unique_lock lock(m_read_request_mutex);
+    if (m_io_workers.empty())
+    {
+      start_io_workers();
+    }
 
     // If we already have a request for this file, add a new request to signal to the queued request
-    auto it = m_queued_requests.find(path);
+    auto it = m_queued_requests.find(fullpath);
     if (it != m_queued_requests.end())
     {
-      ReadRequest request(path, it->value.get());
+      ReadRequest request(it->value->filepath(), it->value.get());
       it->value->add_request_to_signal(&request);
       return request;
     }
 
     // If we don't have a request for this file yet, create a new one and add it to the hash table
-    rsl::unique_ptr<QueuedRequest> queued_request = rsl::make_unique<QueuedRequest>(path);
-    ReadRequest request(path, queued_request.get());
+    rsl::unique_ptr<QueuedRequest> queued_request = rsl::make_unique<QueuedRequest>(fullpath);
+    ReadRequest request(queued_request->filepath(), queued_request.get());
 
     // create the read request, which holds a link to the queued request
     queued_request->add_request_to_signal(&request);
 
-    auto emplace_res = m_queued_requests.emplace(rsl::string(path), rsl::move(queued_request));
-    m_read_requests_in_order.push_back(emplace_res.inserted_element->key);
+    m_read_requests_in_order.push_back(queued_request.get());
+    m_queued_requests.emplace(fullpath, rsl::move(queued_request));
+    m_read_request_cv.notify_one();
 
     return request;
   }
@@ -233,7 +311,7 @@ namespace rex
   {
     filepath = path::remove_quotes(filepath);
 
-    const rsl::string_view path = path::join(m_mounted_roots.at(root), filepath);
+    const rsl::string_view path = path::join(mounted_path(root), filepath);
     return write_to_file(path, data, size, shouldAppend);
   }
   Error VfsBase::write_to_file(MountingPoint root, rsl::string_view filepath, rsl::string_view text, AppendToFile shouldAppend)
@@ -253,7 +331,7 @@ namespace rex
     REX_ASSERT_X(m_vfs_state_controller.has_state(VfsState::Running), "Trying to use vfs before it's initialized");
     REX_ASSERT_X(!path::is_absolute(path), "Passed an absolute path into a function that doesn't allow absolute paths");
 
-    scratch_string mount_root = path::join(m_mounted_roots.at(root), path);
+    scratch_string mount_root = path::join(mounted_path(root), path);
 
     return abs_path(mount_root);
   }
@@ -274,21 +352,21 @@ namespace rex
   {
     path = path::remove_quotes(path);
 
-    scratch_string fullpath = path::join(m_mounted_roots.at(root), path);
+    scratch_string fullpath = path::join(mounted_path(root), path);
     return is_directory(fullpath);
   }
   bool VfsBase::is_file(MountingPoint root, rsl::string_view path) const
   {
     path = path::remove_quotes(path);
 
-    scratch_string fullpath = path::join(m_mounted_roots.at(root), path);
+    scratch_string fullpath = path::join(mounted_path(root), path);
     return is_file(fullpath);
   }
   bool VfsBase::exists(MountingPoint root, rsl::string_view path) const
   {
     path = path::remove_quotes(path);
 
-    scratch_string fullpath = path::join(m_mounted_roots.at(root), path);
+    scratch_string fullpath = path::join(mounted_path(root), path);
     return exists(fullpath);
   }
   bool VfsBase::is_mounted(MountingPoint mount) const
@@ -300,24 +378,115 @@ namespace rex
   {
     path = path::remove_quotes(path);
 
-    const rsl::string_view fullpath = path::join(m_mounted_roots.at(root), path);
+    const rsl::string_view fullpath = path::join(mounted_path(root), path);
     return list_entries(fullpath, recursive);
   }
 	REX_NO_DISCARD rsl::vector<rsl::string> VfsBase::list_dirs(MountingPoint root, rsl::string_view path)
 	{
     path = path::remove_quotes(path);
 
-    const rsl::string_view fullpath = path::join(m_mounted_roots.at(root), path);
+    const rsl::string_view fullpath = path::join(mounted_path(root), path);
     return list_dirs(fullpath);
   }
 	REX_NO_DISCARD rsl::vector<rsl::string> VfsBase::list_files(MountingPoint root, rsl::string_view path)
 	{
     path = path::remove_quotes(path);
 
-    const rsl::string_view fullpath = path::join(m_mounted_roots.at(root), path);
+    const rsl::string_view fullpath = path::join(mounted_path(root), path);
     return list_files(fullpath);
   }
 
+  void VfsBase::start_io_workers()
+  {
+    for (s32 idx = 0; idx < m_num_io_workers; ++idx)
+    {
+      m_io_workers.emplace_back(internal::crash_guard_thread_entry([this]() { process_read_requests(); }));
+    }
+  }
+  void VfsBase::process_read_requests()
+  {
+    // Whether the filesystem batches reads can depend on the reading thread, eg. when it has its own io queue
+    const bool reads_in_batches = supports_batched_reads();
+    while (true)
+    {
+      rsl::vector<QueuedRequest*> queued_requests;
+      {
+        rsl::unique_lock lock(m_read_request_mutex);
+        m_read_request_cv.wait(lock, [this]() { return m_is_stopping_io_workers || !m_read_requests_in_order.empty(); });
+
+        // Requests queued before stopping still get read, so nobody waits on them forever
+        if (m_read_requests_in_order.empty())
+        {
+          return;
+        }
+
+        // Filesystems that read a batch one file after the other take a single request at a time
+        // so the other io workers read the rest and every request is signaled as soon as its file is read.
+        // Batches are split evenly over the workers, so no worker idles while another one has a batch queued for it
+        count_t batch_size = 1;
+        if (reads_in_batches)
+        {
+          const count_t num_queued  = m_read_requests_in_order.size();
+          const count_t num_workers = rsl::max(static_cast<count_t>(m_io_workers.size()), static_cast<count_t>(1));
+          const count_t fair_share  = (num_queued + num_workers - 1) / num_workers;
+          batch_size                = rsl::min(fair_share, static_cast<count_t>(g_vfs_max_read_batch_size));
+        }
+        queued_requests.assign(m_read_requests_in_order.begin(), m_read_requests_in_order.begin() + batch_size);
+        m_read_requests_in_order.erase(m_read_requests_in_order.begin(), m_read_requests_in_order.begin() + batch_size);
+      }
+
+      // The requests stay in the hash table while they're read, so requests for the same file coming in meanwhile share them
+      rsl::vector<rsl::string_view> filepaths;
+      filepaths.reserve(queued_requests.size());
+      for (const QueuedRequest* queued_request : queued_requests)
+      {
+        filepaths.push_back(queued_request->filepath());
+      }
+
+      rsl::vector<memory::Blob> contents = read_files(filepaths);
+      for (count_t idx = 0; idx < queued_requests.size(); ++idx)
+      {
+        queued_requests[idx]->signal_requests(rsl::move(contents[idx]));
+        close_request(queued_requests[idx]);
+      }
+    }
+  }
+  void VfsBase::close_request(QueuedRequest* queuedRequest)
+  {
+    rsl::unique_ptr<QueuedRequest> closed_request;
+    {
+      const rsl::unique_lock lock(m_read_request_mutex);
+      auto it = m_queued_requests.find(queuedRequest->path_id());
+      REX_ASSERT_X(it != m_queued_requests.end(), "Closing a request that's not queued. path: {}", queuedRequest->filepath());
+      closed_request = rsl::move(it->value);
+      m_queued_requests.erase(it);
+    }
+
+    // The read requests using it own it from now on, the last one to go destroys it
+    closed_request.release()->close();
+  }
+
+  PathId VfsBase::mounted_path_id(MountingPoint root, rsl::string_view filepath)
+  {
+    const rsl::unique_lock lock(m_mounted_path_ids_mutex);
+    rsl::unordered_map<rsl::string_view, MountedPathId>& path_ids = m_mounted_path_ids[root];
+    auto it = path_ids.find(filepath);
+    if (it != path_ids.end())
+    {
+      return it->value.fullpath;
+    }
+
+    const scratch_string fullpath = path::join(mounted_path(root), filepath);
+    MountedPathId path_id {};
+    path_id.relative_path = rsl::make_unique<rsl::string>(filepath);
+    path_id.fullpath      = PathId::create(path::unsafe_abs_path(fullpath));
+
+    const rsl::string_view relative_path = *path_id.relative_path;
+    const PathId fullpath_id             = path_id.fullpath;
+    path_ids.emplace(relative_path, rsl::move(path_id));
+    return fullpath_id;
+  }
+
   rsl::string_view VfsBase::no_mount_path() const
   {
     // explicitely stating "no mount found" here
@@ -340,6 +509,11 @@ namespace rex
     }
     void shutdown()
     {
+      // The io workers read through the derived filesystem, so they need to stop before it gets destroyed
+      if (g_vfs)
+      {
+        g_vfs->stop_io_workers();
+      }
       g_vfs.reset();
     }
   } // namespace vfs
@@ -51,8 +51,8 @@ namespace rex
 			REX_ASSERT_X(json_blob.contains("vertex_shader"), "No vertex shader found in material, this is not allowed. Path: {}", quoted(filepath));
 			REX_ASSERT_X(json_blob.contains("pixel_shader"), "No pixel shader found in material, this is not allowed. Path: {}", quoted(filepath));
 
-			rsl::string_view vertex_shader = json_blob["vertex_shader"].get<rsl::string_view>();
-			rsl::string_view pixel_shader = json_blob["pixel_shader"].get<rsl::string_view>();
+			const PathId vertex_shader = PathId::create(vfs::instance()->abs_path(json_blob["vertex_shader"].get<rsl::string_view>()));
+			const PathId pixel_shader = PathId::create(vfs::instance()->abs_path(json_blob["pixel_shader"].get<rsl::string_view>()));
 
 			// Process material content so we can create a material object out of it
 			MaterialDesc mat_desc{};
@@ -15,8 +15,17 @@ namespace rex
 	{
 		DEFINE_LOG_CATEGORY(LogShaderLib);
 
-		Shader* ShaderLibrary::load(rsl::string_view path, ShaderType type)
+		Shader* ShaderLibrary::load(PathId pathId, ShaderType type)
 		{
+			// If the shader got loaded from this path before, we know it's in the cache
+			auto path_it = m_path_to_shader.find(pathId);
+			if (path_it != m_path_to_shader.end())
+			{
+				return path_it->value;
+			}
+
+			const rsl::string_view path = pathId.string();
+
 			// Check if the path exists first. Yes it's possible a shader with the same name exists
 			// but to be on the extra safe side, check if the path is correct. Naming of a shader will likely
 			// not be path based in the future
@@ -32,6 +41,7 @@ namespace rex
 			Shader* cached_shader = load(name);
 			if (cached_shader)
 			{
+				m_path_to_shader.emplace(pathId, cached_shader);
 				return cached_shader;
 			}
 
@@ -52,6 +62,7 @@ namespace rex
 			}
 
 			auto res = m_shader_map.emplace(name, rsl::move(new_shader));
+			m_path_to_shader.emplace(pathId, res.inserted_element->value.get());
 			return res.inserted_element->value.get();
 		}
 
@@ -65,6 +76,7 @@ namespace rex
 
 		void ShaderLibrary::clear()
 		{
+			m_path_to_shader.clear();
 			m_shader_map.clear();
 		}
 
@@ -0,0 +1,251 @@
+#include "rex_engine/memory/alloc_trace.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/engine/engine.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/memory/blob.h"
+#include "rex_engine/memory/global_allocators/global_debug_allocator.h"
+#include "rex_engine/memory/memory_header.h"
+
+#include "rex_std/algorithm.h"
+#include "rex_std/atomic.h"
+#include "rex_std/cstring.h"
+#include "rex_std/mutex.h"
+
+namespace rex
+{
+  namespace alloc_trace
+  {
+    DEFINE_LOG_CATEGORY(LogAllocTrace);
+
+    // The number of records buffered before they're written to disk
+#ifdef REX_ALLOC_TRACE_BUFFER_SIZE
+    inline constexpr s32 g_alloc_trace_buffer_size = REX_ALLOC_TRACE_BUFFER_SIZE;
+#else
+    inline constexpr s32 g_alloc_trace_buffer_size = 64 * 1024;
+#endif
+
+    namespace
+    {
+      // Checked on every allocation, so it's kept separate from the writer
+      rsl::atomic<bool> g_is_recording = false;
+      // The writer is only accessed with the lock held
+      AllocTraceWriter* g_writer = nullptr;
+      rsl::mutex g_writer_mutex;
+
+      rsl::atomic<u32> g_next_ptr_id = 1;
+      rsl::atomic<u16> g_next_thread_idx = 0;
+
+      // Writing to disk allocates memory itself, those allocations aren't recorded
+      thread_local bool g_is_inside_recorder = false;
+      thread_local s32 g_thread_idx = -1;
+
+      card32 current_frame_idx()
+      {
+        return rex::engine::instance()
+          ? rex::engine::instance()->frame_info().index()
+          : 0;
+      }
+
+      u16 current_thread_idx()
+      {
+        if (g_thread_idx == -1)
+        {
+          g_thread_idx = g_next_thread_idx.fetch_add(1, rsl::memory_order_relaxed);
+        }
+        return static_cast<u16>(g_thread_idx);
+      }
+
+      // Makes sure allocations made while this scope is alive aren't recorded
+      class RecorderScope
+      {
+      public:
+        RecorderScope()
+        {
+          g_is_inside_recorder = true;
+        }
+        RecorderScope(const RecorderScope&) = delete;
+        RecorderScope(RecorderScope&&) = delete;
+        ~RecorderScope()
+        {
+          g_is_inside_recorder = false;
+        }
+
+        RecorderScope& operator=(const RecorderScope&) = delete;
+        RecorderScope& operator=(RecorderScope&&) = delete;
+      };
+
+      void write_record(const AllocTraceRecord& record)
+      {
+        const RecorderScope scope;
+        const rsl::unique_lock lock(g_writer_mutex);
+        if (g_writer)
+        {
+          g_writer->write(record);
+        }
+      }
+    } // namespace
+
+    AllocTraceWriter::AllocTraceWriter(rsl::string_view filepath)
+      : m_filepath(filepath)
+      , m_num_records_written(0)
+    {
+      m_records.reserve(g_alloc_trace_buffer_size);
+
+      AllocTraceFileHeader header{};
+      header.magic = g_alloc_trace_magic;
+      header.version = g_alloc_trace_version;
+      header.record_size = sizeof(AllocTraceRecord);
+      header.reserved = 0;
+      file::write_to_file_abspath(m_filepath, &header, sizeof(header));
+    }
+
+    AllocTraceWriter::~AllocTraceWriter()
+    {
+      flush();
+    }
+
+    void AllocTraceWriter::write(const AllocTraceRecord& record)
+    {
+      m_records.push_back(record);
+      if (m_records.size() >= g_alloc_trace_buffer_size)
+      {
+        flush();
+      }
+    }
+
+    void AllocTraceWriter::flush()
+    {
+      if (m_records.empty())
+      {
+        return;
+      }
+
+      const rsl::string_view records_as_bytes(reinterpret_cast<const char8*>(m_records.data()), static_cast<s32>(m_records.size() * sizeof(AllocTraceRecord))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      file::append_text_abspath(m_filepath, records_as_bytes);
+      m_num_records_written += m_records.size();
+      m_records.clear();
+    }
+
+    s64 AllocTraceWriter::num_records_written() const
+    {
+      return m_num_records_written;
+    }
+    rsl::string_view AllocTraceWriter::filepath() const
+    {
+      return m_filepath;
+    }
+
+    void start_recording(rsl::string_view filepath)
+    {
+      const RecorderScope scope;
+      const rsl::unique_lock lock(g_writer_mutex);
+      REX_ASSERT_X(g_writer == nullptr, "Allocation trace recording already started");
+
+      void* mem = GlobalDebugAllocator().allocate(sizeof(AllocTraceWriter));
+      g_writer = new (mem) AllocTraceWriter(filepath);
+      g_is_recording.store(true, rsl::memory_order_release);
+
+      REX_INFO(LogAllocTrace, "Recording allocations to {}", filepath);
+    }
+
+    void stop_recording()
+    {
+      const RecorderScope scope;
+      const rsl::unique_lock lock(g_writer_mutex);
+      if (g_writer == nullptr)
+      {
+        return;
+      }
+
+      g_is_recording.store(false, rsl::memory_order_release);
+      g_writer->flush();
+      REX_INFO(LogAllocTrace, "Recorded {} allocation events to {}", g_writer->num_records_written(), g_writer->filepath());
+
+      g_writer->~AllocTraceWriter();
+      GlobalDebugAllocator().deallocate(g_writer, sizeof(AllocTraceWriter));
+      g_writer = nullptr;
+    }
+
+    bool is_recording()
+    {
+      return g_is_recording.load(rsl::memory_order_relaxed);
+    }
+
+    AllocTrace load_trace(rsl::string_view filepath)
+    {
+      AllocTrace trace{};
+      trace.max_ptr_id = 0;
+
+      const memory::Blob blob = file::read_file_abspath(filepath);
+      const s64 blob_size = static_cast<s64>(blob.size());
+      if (blob_size < static_cast<s64>(sizeof(AllocTraceFileHeader)))
+      {
+        REX_ERROR(LogAllocTrace, "{} is not an allocation trace, it's too small", filepath);
+        return trace;
+      }
+
+      AllocTraceFileHeader header{};
+      rsl::memcpy(&header, blob.data(), sizeof(header));
+      if (header.magic != g_alloc_trace_magic || header.version != g_alloc_trace_version || header.record_size != sizeof(AllocTraceRecord))
+      {
+        REX_ERROR(LogAllocTrace, "{} is not a supported allocation trace. version: {} record size: {}", filepath, header.version, header.record_size);
+        return trace;
+      }
+
+      // A trace that got cut off while writing can end in a partial record, which is ignored
+      const s64 num_records = (blob_size - static_cast<s64>(sizeof(AllocTraceFileHeader))) / static_cast<s64>(sizeof(AllocTraceRecord));
+      trace.records.resize(static_cast<count_t>(num_records));
+      rsl::memcpy(trace.records.data(), blob.data() + sizeof(AllocTraceFileHeader), num_records * sizeof(AllocTraceRecord));
+
+      for (const AllocTraceRecord& record : trace.records)
+      {
+        trace.max_ptr_id = rsl::max(trace.max_ptr_id, record.ptr_id);
+      }
+
+      return trace;
+    }
+
+    namespace internal
+    {
+      void record_alloc(MemoryHeader* header)
+      {
+        if (!is_recording() || g_is_inside_recorder)
+        {
+          return;
+        }
+
+        const u32 ptr_id = g_next_ptr_id.fetch_add(1, rsl::memory_order_relaxed);
+        header->set_trace_id(ptr_id);
+
+        AllocTraceRecord record{};
+        record.size = static_cast<u32>(header->size().size_in_bytes());
+        record.ptr_id = ptr_id;
+        record.frame_idx = header->frame_index();
+        record.thread_idx = current_thread_idx();
+        record.op = AllocTraceOp::Alloc;
+        record.tag = static_cast<u8>(rsl::enum_refl::enum_integer(header->tag()));
+        write_record(record);
+      }
+
+      void record_free(MemoryHeader* header)
+      {
+        // Allocations made before recording started don't have an id
+        if (!is_recording() || g_is_inside_recorder || header->trace_id() == 0)
+        {
+          return;
+        }
+
+        AllocTraceRecord record{};
+        record.size = static_cast<u32>(header->size().size_in_bytes());
+        record.ptr_id = header->trace_id();
+        record.frame_idx = current_frame_idx();
+        record.thread_idx = current_thread_idx();
+        record.op = AllocTraceOp::Free;
+        record.tag = static_cast<u8>(rsl::enum_refl::enum_integer(header->tag()));
+        write_record(record);
+      }
+    } // namespace internal
+  } // namespace alloc_trace
+} // namespace rex
@@ -0,0 +1,208 @@
+#include "rex_engine/memory/allocation_sampler.h"
+
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/memory/memory_tracking.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/format.h"
+
+namespace rex
+{
+  DEFINE_LOG_CATEGORY(LogAllocSampler);
+
+  namespace internal
+  {
+    // The countdown of the calling thread to its next sample
+    struct AllocSampleCountdown
+    {
+      s64 bytes_until_sample = 0;
+      // The sample rate generation the countdown was started for
+      card32 generation = 0;
+      u64 random_state = 0;
+      // Taking a sample allocates memory itself, which shouldn't be sampled
+      bool is_sampling = false;
+    };
+
+    thread_local AllocSampleCountdown g_thread_alloc_sample_countdown; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    rsl::atomic<u64> g_next_alloc_sample_seed = 0x9E3779B97F4A7C15;   // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    // Shared by all samplers, as they share the countdown of a thread
+    rsl::atomic<card32> g_last_alloc_sample_rate_generation = 0;       // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    // Return a generation no sampler has used before, a countdown never starts at generation 0
+    card32 next_sample_rate_generation()
+    {
+      return g_last_alloc_sample_rate_generation.fetch_add(1, rsl::memory_order_relaxed) + 1;
+    }
+
+    // Return a random distance to the next sample, averaging to the sample rate
+    s64 next_sample_distance(AllocSampleCountdown& countdown, s64 sampleRate)
+    {
+      if (countdown.random_state == 0)
+      {
+        countdown.random_state = g_next_alloc_sample_seed.fetch_add(0x9E3779B97F4A7C15, rsl::memory_order_relaxed) | 1;
+      }
+
+      // xorshift, good enough to break up allocation patterns
+      u64 x = countdown.random_state;
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      countdown.random_state = x;
+
+      return sampleRate / 2 + static_cast<s64>(x % static_cast<u64>(sampleRate)) + 1;
+    }
+
+    // Frames are separated by semicolons in the folded format, so they can't contain any themselves
+    void append_folded_frame(debug_string& out, rsl::string_view frame)
+    {
+      for (const char8 c : frame)
+      {
+        if (c == ';')
+        {
+          out += ':';
+        }
+        else if (c != '\n' && c != '\r')
+        {
+          out += c;
+        }
+      }
+    }
+  } // namespace internal
+
+  AllocationSampler::AllocationSampler()
+    : m_sample_rate(g_default_alloc_sample_rate)
+    , m_sample_rate_generation(internal::next_sample_rate_generation())
+    , m_num_samples(0)
+    , m_estimated_bytes(0)
+  {
+  }
+
+  void AllocationSampler::set_sample_rate(s64 bytesPerSample)
+  {
+    m_sample_rate.store(rsl::max(bytesPerSample, static_cast<s64>(0)), rsl::memory_order_relaxed);
+    m_sample_rate_generation.store(internal::next_sample_rate_generation(), rsl::memory_order_relaxed);
+  }
+  s64 AllocationSampler::sample_rate() const
+  {
+    return m_sample_rate.load(rsl::memory_order_relaxed);
+  }
+  bool AllocationSampler::is_enabled() const
+  {
+    return sample_rate() > 0;
+  }
+
+  void AllocationSampler::on_allocation(s64 size)
+  {
+    const s64 sample_rate = m_sample_rate.load(rsl::memory_order_relaxed);
+    if (sample_rate == 0)
+    {
+      return;
+    }
+
+    internal::AllocSampleCountdown& countdown = internal::g_thread_alloc_sample_countdown;
+    const card32 generation = m_sample_rate_generation.load(rsl::memory_order_relaxed);
+    if (countdown.generation != generation)
+    {
+      countdown.generation = generation;
+      countdown.bytes_until_sample = internal::next_sample_distance(countdown, sample_rate);
+    }
+
+    countdown.bytes_until_sample -= size;
+    if (countdown.bytes_until_sample > 0 || countdown.is_sampling)
+    {
+      return;
+    }
+
+    countdown.is_sampling = true;
+    take_sample(size);
+    countdown.bytes_until_sample = internal::next_sample_distance(countdown, sample_rate);
+    countdown.is_sampling = false;
+  }
+
+  void AllocationSampler::take_sample(s64 size)
+  {
+    // Allocations smaller than the sample rate only get sampled once every sample rate bytes
+    // so a sample stands for the sample rate in bytes. Bigger allocations are always sampled and only stand for themselves
+    const s64 estimated_bytes = rsl::max(size, sample_rate());
+    const s32 tag_idx = static_cast<s32>(rsl::enum_refl::enum_integer(mem_tracker().current_tag()));
+    const CallStack callstack = current_callstack();
+
+    const rsl::unique_lock lock(m_samples_mutex);
+    auto it = m_samples.find(callstack);
+    if (it == m_samples.end())
+    {
+      m_samples.insert({callstack, AllocationSample{}});
+      it = m_samples.find(callstack);
+    }
+    it->value.estimated_bytes_per_tag[tag_idx] += estimated_bytes;
+    it->value.num_samples_per_tag[tag_idx] += 1;
+
+    ++m_num_samples;
+    m_estimated_bytes += estimated_bytes;
+  }
+
+  AllocationSamplerStats AllocationSampler::stats()
+  {
+    const rsl::unique_lock lock(m_samples_mutex);
+
+    AllocationSamplerStats stats{};
+    stats.num_samples = m_num_samples;
+    stats.estimated_bytes = m_estimated_bytes;
+    stats.num_callstacks = static_cast<s32>(m_samples.size());
+    return stats;
+  }
+
+  debug_hash_map<CallStack, AllocationSample> AllocationSampler::samples()
+  {
+    const rsl::unique_lock lock(m_samples_mutex);
+    return m_samples;
+  }
+
+  void AllocationSampler::clear()
+  {
+    const rsl::unique_lock lock(m_samples_mutex);
+    m_samples.clear();
+    m_num_samples = 0;
+    m_estimated_bytes = 0;
+  }
+
+  void AllocationSampler::export_folded_stacks(rsl::string_view filepath)
+  {
+    // Copy the samples first, resolving callstacks is slow and allocations shouldn't wait for it
+    const debug_hash_map<CallStack, AllocationSample> samples_copy = samples();
+
+    debug_string folded_stacks;
+    for (const auto& [callstack, sample] : samples_copy)
+    {
+      const ResolvedCallstack resolved_callstack(callstack);
+
+      for (count_t tag_idx = 0; tag_idx < sample.estimated_bytes_per_tag.size(); ++tag_idx)
+      {
+        if (sample.num_samples_per_tag[tag_idx] == 0)
+        {
+          continue;
+        }
+
+        folded_stacks += rsl::enum_refl::enum_name(static_cast<MemoryTag>(tag_idx));
+
+        // The callstack starts at the innermost function, folded stacks start at the outermost
+        for (count_t frame_idx = resolved_callstack.size(); frame_idx > 0; --frame_idx)
+        {
+          folded_stacks += ';';
+          internal::append_folded_frame(folded_stacks, rsl::format("{}", resolved_callstack[frame_idx - 1]));
+        }
+
+        folded_stacks += rsl::format(" {}\n", sample.estimated_bytes_per_tag[tag_idx]);
+      }
+    }
+
+    file::write_to_file_abspath(filepath, folded_stacks.data(), folded_stacks.length());
+    REX_INFO(LogAllocSampler, "Exported {} sampled callstacks to {}", samples_copy.size(), filepath);
+  }
+
+  AllocationSampler& alloc_sampler()
+  {
+    static AllocationSampler sampler;
+    return sampler;
+  }
+} // namespace rex
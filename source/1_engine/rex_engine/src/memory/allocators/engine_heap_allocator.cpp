@@ -0,0 +1,117 @@
+#include "rex_engine/memory/allocators/engine_heap_allocator.h"
+
+#include "rex_engine/memory/allocation_sampler.h"
+#include "rex_engine/memory/allocators/guard_allocator.h"
+#include "rex_engine/memory/allocators/size_class_heap.h"
+#include "rex_engine/memory/memory_tracking.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/atomic.h"
+#include "rex_std/cstring.h"
+
+#include <cstdlib>
+
+namespace rex
+{
+  namespace internal
+  {
+    rsl::atomic<bool> g_is_engine_heap_enabled = false; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  }
+
+  EngineHeapAllocator::pointer EngineHeapAllocator::allocate(rsl::memory_size size) // NOLINT(readability-convert-member-functions-to-static)
+  {
+    return allocate(size.size_in_bytes());
+  }
+  EngineHeapAllocator::pointer EngineHeapAllocator::allocate(card64 size) // NOLINT(readability-convert-member-functions-to-static)
+  {
+    // Every allocation of the engine goes through here, so this is where allocations get sampled
+    alloc_sampler().on_allocation(static_cast<s64>(size));
+
+    // Guarded allocations fall back to the regular heap when no more can be guarded
+    if (is_guard_allocator_enabled() && is_guard_allocator_enabled(mem_tracker().current_tag()))
+    {
+      pointer guarded_ptr = guard_allocator().allocate(static_cast<s64>(size));
+      if (guarded_ptr != nullptr)
+      {
+        return guarded_ptr;
+      }
+    }
+
+    if (is_engine_heap_enabled() && size <= static_cast<card64>(g_size_class_heap_max_small_size))
+    {
+      return size_class_heap().allocate(static_cast<s64>(size));
+    }
+
+    return ::malloc(size); // NOLINT(cppcoreguidelines-no-malloc)
+  }
+
+  EngineHeapAllocator::pointer EngineHeapAllocator::reallocate(pointer p, size_type newSize)
+  {
+    if (p == nullptr)
+    {
+      return allocate(newSize);
+    }
+
+    GuardAllocator& guard_alloc = guard_allocator();
+    if (guard_alloc.owns(p))
+    {
+      pointer new_ptr = allocate(newSize);
+      rsl::memcpy(new_ptr, p, rsl::min(static_cast<card64>(guard_alloc.usable_size(p)), newSize));
+      guard_alloc.deallocate(p);
+      return new_ptr;
+    }
+
+    SizeClassHeap& heap = size_class_heap();
+    if (!heap.owns(p))
+    {
+      // We don't know the size of memory coming from the OS, so it can't be moved into the heap
+      alloc_sampler().on_allocation(static_cast<s64>(newSize));
+      return ::realloc(p, newSize); // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
+    // The block might already be big enough
+    const s64 usable_size = heap.usable_size(p);
+    if (newSize <= static_cast<card64>(usable_size))
+    {
+      return p;
+    }
+
+    pointer new_ptr = allocate(newSize);
+    rsl::memcpy(new_ptr, p, static_cast<card64>(usable_size));
+    heap.deallocate(p);
+    return new_ptr;
+  }
+
+  void EngineHeapAllocator::deallocate(pointer ptr, rsl::memory_size size) // NOLINT(readability-convert-member-functions-to-static)
+  {
+    deallocate(ptr, size.size_in_bytes());
+  }
+  void EngineHeapAllocator::deallocate(pointer ptr, card64 /*size*/) // NOLINT(readability-convert-member-functions-to-static)
+  {
+    // Guarded allocations are freed through the guard allocator, even if guarding got disabled since
+    GuardAllocator& guard_alloc = guard_allocator();
+    if (guard_alloc.owns(ptr))
+    {
+      guard_alloc.deallocate(ptr);
+      return;
+    }
+
+    SizeClassHeap& heap = size_class_heap();
+    if (heap.owns(ptr))
+    {
+      heap.deallocate(ptr);
+      return;
+    }
+
+    ::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+  }
+
+  // Enable or disable serving new small allocations from the size class heap
+  void enable_engine_heap(bool enable)
+  {
+    internal::g_is_engine_heap_enabled.store(enable, rsl::memory_order_relaxed);
+  }
+  bool is_engine_heap_enabled()
+  {
+    return internal::g_is_engine_heap_enabled.load(rsl::memory_order_relaxed);
+  }
+} // namespace rex
@@ -0,0 +1,487 @@
+#include "rex_engine/memory/allocators/frame_allocator.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
+#include "rex_std/mutex.h"
+#include "rex_std/thread.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  DEFINE_LOG_CATEGORY(LogFrameAllocator);
+
+  namespace internal
+  {
+    // The frame allocators that are alive
+    // A thread that exits can only give back its slot if the allocator it got it from still exists
+    rsl::mutex& live_frame_allocators_mutex()
+    {
+      static rsl::mutex mtx;
+      return mtx;
+    }
+    rsl::vector<FrameAllocator*>& live_frame_allocators()
+    {
+      static rsl::vector<FrameAllocator*> allocators;
+      return allocators;
+    }
+
+    // A thread slot the calling thread claimed from a frame allocator
+    struct FrameAllocatorThreadSlot
+    {
+      FrameAllocator* allocator = nullptr;
+      card32 generation = 0;
+      s32 slot = -1;
+
+      bool is_claimed_from(const FrameAllocator* frameAllocator, card32 frameAllocatorGeneration) const
+      {
+        return allocator == frameAllocator && generation == frameAllocatorGeneration;
+      }
+
+      // Give the slot back, if the allocator it was claimed from still exists
+      void release()
+      {
+        if (allocator == nullptr)
+        {
+          return;
+        }
+
+        const rsl::unique_lock lock(live_frame_allocators_mutex());
+        const rsl::vector<FrameAllocator*>& allocators = live_frame_allocators();
+        if (rsl::find(allocators.cbegin(), allocators.cend(), allocator) != allocators.cend() && allocator->m_generation == generation)
+        {
+          allocator->release_thread_slot(slot);
+        }
+
+        allocator = nullptr;
+        generation = 0;
+        slot = -1;
+      }
+    };
+
+    // The number of frame allocators a thread keeps its slot of
+    // A thread using more allocators than this gives back the slot it claimed first when it claims a new one
+    inline constexpr s32 g_num_frame_allocator_slots_per_thread = 4;
+
+    // The thread slots of the calling thread, one for each frame allocator it used recently
+    // Threads switching between allocators keep using the same slots, so they don't run out of them
+    struct FrameAllocatorThreadSlots
+    {
+      rsl::array<FrameAllocatorThreadSlot, g_num_frame_allocator_slots_per_thread> slots;
+      s32 next_to_replace = 0;
+
+      ~FrameAllocatorThreadSlots()
+      {
+        for (FrameAllocatorThreadSlot& slot : slots)
+        {
+          slot.release();
+        }
+      }
+
+      // Returns the slot claimed from the allocator, nullptr if the thread hasn't claimed one
+      const FrameAllocatorThreadSlot* find(const FrameAllocator* allocator, card32 generation) const
+      {
+        for (const FrameAllocatorThreadSlot& slot : slots)
+        {
+          if (slot.is_claimed_from(allocator, generation))
+          {
+            return &slot;
+          }
+        }
+
+        return nullptr;
+      }
+
+      // Returns an unused entry to store a newly claimed slot in
+      // If all are used, the oldest one is given back to its allocator
+      FrameAllocatorThreadSlot& unused_slot()
+      {
+        for (FrameAllocatorThreadSlot& slot : slots)
+        {
+          if (slot.allocator == nullptr)
+          {
+            return slot;
+          }
+        }
+
+        FrameAllocatorThreadSlot& slot = slots[next_to_replace];
+        next_to_replace = (next_to_replace + 1) % g_num_frame_allocator_slots_per_thread;
+        slot.release();
+        return slot;
+      }
+    };
+
+    thread_local FrameAllocatorThreadSlots g_frame_allocator_thread_slots; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    rsl::atomic<card32> g_next_frame_allocator_generation = 1;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  }
+
+  FrameFence::FrameFence()
+    : m_allocator(nullptr)
+    , m_frame_slot(-1)
+  {}
+  FrameFence::FrameFence(FrameAllocator* allocator, s32 frameSlot)
+    : m_allocator(allocator)
+    , m_frame_slot(frameSlot)
+  {
+    m_allocator->add_fence(m_frame_slot);
+  }
+  FrameFence::FrameFence(const FrameFence& other)
+    : m_allocator(other.m_allocator)
+    , m_frame_slot(other.m_frame_slot)
+  {
+    if (m_allocator)
+    {
+      m_allocator->add_fence(m_frame_slot);
+    }
+  }
+  FrameFence::FrameFence(FrameFence&& other)
+    : m_allocator(other.m_allocator)
+    , m_frame_slot(other.m_frame_slot)
+  {
+    other.m_allocator = nullptr;
+    other.m_frame_slot = -1;
+  }
+  FrameFence::~FrameFence()
+  {
+    release();
+  }
+
+  FrameFence& FrameFence::operator=(const FrameFence& other)
+  {
+    if (this == &other)
+    {
+      return *this;
+    }
+
+    release();
+    m_allocator = other.m_allocator;
+    m_frame_slot = other.m_frame_slot;
+    if (m_allocator)
+    {
+      m_allocator->add_fence(m_frame_slot);
+    }
+    return *this;
+  }
+  FrameFence& FrameFence::operator=(FrameFence&& other)
+  {
+    if (this == &other)
+    {
+      return *this;
+    }
+
+    release();
+    m_allocator = other.m_allocator;
+    m_frame_slot = other.m_frame_slot;
+    other.m_allocator = nullptr;
+    other.m_frame_slot = -1;
+    return *this;
+  }
+
+  // Signal that the frame's memory is no longer in use by the holder of this fence
+  void FrameFence::release()
+  {
+    if (m_allocator)
+    {
+      m_allocator->release_fence(m_frame_slot);
+      m_allocator = nullptr;
+      m_frame_slot = -1;
+    }
+  }
+  // Returns true if the fence still holds on to its frame
+  bool FrameFence::is_active() const
+  {
+    return m_allocator != nullptr;
+  }
+
+  FrameAllocator::FrameAllocator(size_type arenaSize)
+    : m_arena_size(arenaSize)
+    , m_generation(internal::g_next_frame_allocator_generation++)
+    , m_current_frame(0)
+    , m_threads()
+    , m_frames()
+    , m_stats()
+  {
+    REX_ASSERT_X(arenaSize > 0, "Frame allocator needs an arena size bigger than 0");
+
+    const rsl::unique_lock lock(internal::live_frame_allocators_mutex());
+    internal::live_frame_allocators().push_back(this);
+  }
+
+  FrameAllocator::~FrameAllocator()
+  {
+    for (const FrameSync& frame : m_frames)
+    {
+      REX_ASSERT_X(frame.num_active_fences.load(rsl::memory_order_acquire) == 0, "Destroying a frame allocator that still has active fences");
+    }
+
+    const rsl::unique_lock lock(internal::live_frame_allocators_mutex());
+    rsl::vector<FrameAllocator*>& allocators = internal::live_frame_allocators();
+    allocators.erase(rsl::find(allocators.begin(), allocators.end(), this));
+  }
+
+  // Allocate memory from the calling thread's arena of the current frame
+  FrameAllocator::pointer FrameAllocator::allocate(size_type size, s32 alignment)
+  {
+    return current_arena().allocate(size, alignment);
+  }
+  FrameAllocator::pointer FrameAllocator::allocate(size_type size)
+  {
+    return current_arena().allocate(size);
+  }
+
+  // The new memory is always allocated in the calling thread's arena
+  // the old memory is copied over, which is only safe if it's still alive.
+  FrameAllocator::pointer FrameAllocator::reallocate(pointer ptr, size_type size)
+  {
+    pointer new_ptr = allocate(size);
+    if (ptr == nullptr)
+    {
+      return new_ptr;
+    }
+
+    // The old size isn't known, so copy as much as fits without reading past the arena it lives in
+    // The new allocation can start within that range, so the ranges can overlap
+    for (const ThreadArenas& thread : m_threads)
+    {
+      for (const rsl::unique_ptr<StackAllocator>& arena : thread.arenas)
+      {
+        if (arena && arena->has_allocated_ptr(ptr))
+        {
+          const rsl::byte* arena_end = arena->buffer() + arena->buffer_size();
+          const size_type num_available = arena_end - static_cast<const rsl::byte*>(ptr);
+          rsl::memmove(new_ptr, ptr, rsl::min(size, num_available));
+          return new_ptr;
+        }
+      }
+    }
+
+    REX_ASSERT("Reallocating a pointer that wasn't allocated by the frame allocator");
+    return new_ptr;
+  }
+
+  // This does nothing, memory is freed when its frame gets recycled
+  void FrameAllocator::deallocate(pointer ptr, size_type size)
+  {
+    REX_UNUSED_PARAM(ptr);
+    REX_UNUSED_PARAM(size);
+  }
+
+  // Move to the next frame.
+  // This blocks until the frame that gets recycled has finished all its jobs and released all its fences
+  void FrameAllocator::advance_frame()
+  {
+    const s64 next_frame = m_current_frame.load(rsl::memory_order_relaxed) + 1;
+    const s32 next_frame_slot = static_cast<s32>(next_frame % g_num_frames_in_flight);
+
+    // The slot we move to still holds the memory of an older frame
+    wait_for_frame(next_frame_slot);
+    recycle_frame(next_frame_slot);
+
+    m_current_frame.store(next_frame, rsl::memory_order_release);
+  }
+
+  // Keep the current frame alive until the task has finished
+  void FrameAllocator::add_frame_job(const task_system::JobHandle& job)
+  {
+    FrameSync& frame = m_frames[current_frame_slot()];
+    const rsl::unique_lock lock(frame.jobs_lock);
+    frame.jobs.add_job(job);
+  }
+
+  // Keep the current frame alive until the fence is released
+  FrameFence FrameAllocator::acquire_fence()
+  {
+    return FrameFence(this, current_frame_slot());
+  }
+
+  bool FrameAllocator::has_allocated_ptr(void* ptr) const
+  {
+    // Frame memory is almost always checked by the thread that allocated it
+    // so look in the calling thread's arenas first before scanning those of all other threads
+    const internal::FrameAllocatorThreadSlot* thread_slot = internal::g_frame_allocator_thread_slots.find(this, m_generation);
+    const s32 own_slot = thread_slot ? thread_slot->slot : -1;
+    if (own_slot != -1 && has_allocated_ptr(m_threads[own_slot], ptr))
+    {
+      return true;
+    }
+
+    for (s32 slot = 0; slot < g_max_frame_allocator_threads; ++slot)
+    {
+      if (slot != own_slot && has_allocated_ptr(m_threads[slot], ptr))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Returns the size of a single thread's arena for a single frame
+  FrameAllocator::size_type FrameAllocator::arena_size() const
+  {
+    return m_arena_size;
+  }
+  // Returns the bytes the calling thread used so far in the current frame
+  FrameAllocator::size_type FrameAllocator::num_allocated_this_frame() const
+  {
+    const internal::FrameAllocatorThreadSlot* thread_slot = internal::g_frame_allocator_thread_slots.find(this, m_generation);
+    if (thread_slot == nullptr)
+    {
+      return 0;
+    }
+
+    return m_threads[thread_slot->slot].arenas[current_frame_slot()]->num_allocated();
+  }
+  // Returns the number of frames advanced since the allocator was created
+  s64 FrameAllocator::current_frame() const
+  {
+    return m_current_frame.load(rsl::memory_order_acquire);
+  }
+
+  FrameAllocatorStats FrameAllocator::stats() const
+  {
+    return m_stats;
+  }
+  // Log the stats gathered so far
+  void FrameAllocator::dump_stats() const
+  {
+    REX_INFO(LogFrameAllocator, "Frame allocator stats over {} frames", m_stats.num_frames_recycled);
+    REX_INFO(LogFrameAllocator, "Last frame usage: {} bytes, peak frame usage: {} bytes", m_stats.last_frame_usage, m_stats.peak_frame_usage);
+    REX_INFO(LogFrameAllocator, "Peak usage of a single thread: {} bytes of {} bytes per arena", m_stats.peak_arena_usage, m_arena_size);
+  }
+
+  // Returns the arena of the calling thread for the current frame, claiming a thread slot if needed
+  StackAllocator& FrameAllocator::current_arena()
+  {
+    internal::FrameAllocatorThreadSlots& thread_slots = internal::g_frame_allocator_thread_slots;
+    const internal::FrameAllocatorThreadSlot* thread_slot = thread_slots.find(this, m_generation);
+    if (thread_slot == nullptr)
+    {
+      internal::FrameAllocatorThreadSlot& new_thread_slot = thread_slots.unused_slot();
+      new_thread_slot.slot = claim_thread_slot();
+      new_thread_slot.allocator = this;
+      new_thread_slot.generation = m_generation;
+      thread_slot = &new_thread_slot;
+    }
+
+    return *m_threads[thread_slot->slot].arenas[current_frame_slot()];
+  }
+  s32 FrameAllocator::claim_thread_slot()
+  {
+    for (s32 slot = 0; slot < g_max_frame_allocator_threads; ++slot)
+    {
+      ThreadArenas& thread = m_threads[slot];
+      bool expected = false;
+      if (!thread.is_claimed.compare_exchange_strong(expected, true, rsl::memory_order_acquire))
+      {
+        continue;
+      }
+
+      // The arenas of a slot are kept when the thread owning it exits, so the next thread claiming it reuses them
+      // This is needed as memory of the current frames can still be in use by other threads
+      for (rsl::unique_ptr<StackAllocator>& arena : thread.arenas)
+      {
+        if (!arena)
+        {
+          arena = rsl::make_unique<StackAllocator>(m_arena_size);
+        }
+      }
+
+      return slot;
+    }
+
+    REX_ASSERT("Too many threads are using the frame allocator. max threads: {}", g_max_frame_allocator_threads);
+    return -1;
+  }
+  bool FrameAllocator::has_allocated_ptr(const ThreadArenas& thread, void* ptr) const
+  {
+    for (const rsl::unique_ptr<StackAllocator>& arena : thread.arenas)
+    {
+      if (arena && arena->has_allocated_ptr(ptr))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+  void FrameAllocator::release_thread_slot(s32 slot)
+  {
+    m_threads[slot].is_claimed.store(false, rsl::memory_order_release);
+  }
+  s32 FrameAllocator::current_frame_slot() const
+  {
+    return static_cast<s32>(m_current_frame.load(rsl::memory_order_acquire) % g_num_frames_in_flight);
+  }
+
+  // Block until all jobs and fences of a frame have finished
+  void FrameAllocator::wait_for_frame(s32 frameSlot)
+  {
+    FrameSync& frame = m_frames[frameSlot];
+
+    // The jobs are taken out of the frame before waiting on them, so the lock isn't held while running other jobs.
+    // A job can add new jobs to the frame it's waited on (eg. when there's only a single frame in flight)
+    // so keep taking them out until no new ones got added.
+    while (true)
+    {
+      task_system::JobCounter jobs;
+      {
+        const rsl::unique_lock lock(frame.jobs_lock);
+        jobs = rsl::move(frame.jobs);
+        frame.jobs = task_system::JobCounter();
+      }
+
+      if (jobs.jobs().empty())
+      {
+        break;
+      }
+
+      // Help out with pending jobs while the frame's jobs are finishing
+      while (jobs.num_pending() > 0)
+      {
+        if (!task_system::run_pending_job())
+        {
+          rsl::this_thread::yield();
+        }
+      }
+    }
+
+    while (frame.num_active_fences.load(rsl::memory_order_acquire) > 0)
+    {
+      rsl::this_thread::yield();
+    }
+  }
+  // Reset all arenas of a frame and record their usage
+  void FrameAllocator::recycle_frame(s32 frameSlot)
+  {
+    s64 frame_usage = 0;
+    for (ThreadArenas& thread : m_threads)
+    {
+      rsl::unique_ptr<StackAllocator>& arena = thread.arenas[frameSlot];
+      if (!arena)
+      {
+        continue;
+      }
+
+      const s64 arena_usage = arena->num_allocated();
+      frame_usage += arena_usage;
+      m_stats.peak_arena_usage = rsl::max(m_stats.peak_arena_usage, arena_usage);
+      arena->reset();
+    }
+
+    m_stats.last_frame_usage = frame_usage;
+    m_stats.peak_frame_usage = rsl::max(m_stats.peak_frame_usage, frame_usage);
+    ++m_stats.num_frames_recycled;
+  }
+
+  void FrameAllocator::add_fence(s32 frameSlot)
+  {
+    m_frames[frameSlot].num_active_fences.fetch_add(1, rsl::memory_order_relaxed);
+  }
+  void FrameAllocator::release_fence(s32 frameSlot)
+  {
+    m_frames[frameSlot].num_active_fences.fetch_sub(1, rsl::memory_order_release);
+  }
+}
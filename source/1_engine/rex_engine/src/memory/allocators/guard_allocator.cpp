@@ -0,0 +1,255 @@
+#include "rex_engine/memory/allocators/guard_allocator.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/memory/pointer_math.h"
+#include "rex_engine/memory/virtual_memory.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
+#include "rex_std/mutex.h"
+
+namespace rex
+{
+  namespace internal
+  {
+    static_assert(rsl::enum_refl::enum_count<MemoryTag>() <= 32, "The guarded memory tags need to fit in a 32 bit mask");
+
+    rsl::atomic<u32> g_guarded_memory_tags = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    u32 memory_tag_bit(MemoryTag tag)
+    {
+      return 1u << static_cast<u32>(rsl::enum_refl::enum_integer(tag));
+    }
+
+    s32 guard_allocation_hash(const void* ptr)
+    {
+      // Guarded pointers are at least 16 byte aligned, so the lowest bits don't tell them apart
+      const u64 key = reinterpret_cast<u64>(ptr) >> 4; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      return static_cast<s32>((key * 0x9E3779B97F4A7C15) % static_cast<u64>(g_guard_allocator_table_size));
+    }
+
+    // Return the first unused byte after the allocation and the number of unused bytes up to the end of its pages
+    rsl::byte* guard_slack_begin(const GuardAllocation& allocation)
+    {
+      return static_cast<rsl::byte*>(allocation.ptr) + allocation.size;
+    }
+    s64 guard_slack_size(const GuardAllocation& allocation)
+    {
+      const s64 page_size = vmem::page_size();
+      const s64 offset_in_data = static_cast<rsl::byte*>(allocation.ptr) - static_cast<rsl::byte*>(allocation.base) - page_size;
+      const s64 data_size = align(rsl::max(allocation.size, static_cast<s64>(1)), static_cast<card32>(page_size));
+      return data_size - offset_in_data - allocation.size;
+    }
+  } // namespace internal
+
+  GuardAllocator::GuardAllocator()
+    : m_allocations()
+    , m_quarantine()
+    , m_quarantine_start(0)
+    , m_num_quarantined(0)
+    , m_num_live_allocations(0)
+    , m_num_unguarded(0)
+    , m_num_owned(0)
+  {
+  }
+
+  GuardAllocator::~GuardAllocator()
+  {
+    for (internal::GuardAllocation& allocation : m_allocations)
+    {
+      if (allocation.ptr != nullptr)
+      {
+        vmem::release(allocation.base, allocation.reserved_size);
+      }
+    }
+  }
+
+  void* GuardAllocator::allocate(s64 size)
+  {
+    // +-------------+--------------------------------+-------------+
+    // | guard page  | data pages        [allocation] | guard page  |
+    // +-------------+--------------------------------+-------------+
+    // The allocation is placed at the end of the data pages so an overrun hits the guard page right away
+    const s64 page_size = vmem::page_size();
+    const s64 data_size = align(rsl::max(size, static_cast<s64>(1)), static_cast<card32>(page_size));
+    const s64 reserved_size = data_size + 2 * page_size;
+
+    {
+      const rsl::unique_lock lock(m_lock);
+      if (m_num_live_allocations == g_guard_allocator_max_allocations)
+      {
+        ++m_num_unguarded;
+        return nullptr;
+      }
+      ++m_num_live_allocations;
+    }
+
+    void* base = vmem::reserve(reserved_size);
+    void* data = jump_forward(base, page_size);
+    if (base == nullptr || !vmem::commit(data, data_size))
+    {
+      if (base != nullptr)
+      {
+        vmem::release(base, reserved_size);
+      }
+
+      const rsl::unique_lock lock(m_lock);
+      --m_num_live_allocations;
+      ++m_num_unguarded;
+      return nullptr;
+    }
+
+#ifdef REX_GUARD_ALLOCATOR_DETECT_UNDERRUN
+    void* ptr = data;
+#else
+    void* ptr = jump_forward(data, data_size - align(rsl::max(size, static_cast<s64>(1)), static_cast<card32>(g_guard_allocator_alignment)));
+#endif
+
+    const internal::GuardAllocation allocation {ptr, base, reserved_size, size, false};
+    rsl::memset(internal::guard_slack_begin(allocation), g_guard_allocator_fill_byte, internal::guard_slack_size(allocation));
+
+    const rsl::unique_lock lock(m_lock);
+    m_allocations[find_slot(ptr)] = allocation;
+    m_num_owned.fetch_add(1, rsl::memory_order_relaxed);
+    return ptr;
+  }
+
+  void GuardAllocator::deallocate(void* ptr)
+  {
+    internal::GuardAllocation allocation {};
+    {
+      const rsl::unique_lock lock(m_lock);
+      internal::GuardAllocation& slot = m_allocations[find_slot(ptr)];
+      allocation = slot;
+      if (slot.ptr != nullptr)
+      {
+        slot.is_freed = true;
+      }
+    }
+
+    REX_ASSERT_X(allocation.ptr != nullptr, "Freeing a pointer that wasn't allocated by the guard allocator. ptr: {}", ptr);
+    REX_ASSERT_X(!allocation.is_freed, "Double free of a guarded allocation. ptr: {}", ptr);
+    if (allocation.ptr == nullptr || allocation.is_freed)
+    {
+      return;
+    }
+
+    // Overruns that didn't reach the guard page changed the bytes after the allocation
+    const rsl::byte* slack = internal::guard_slack_begin(allocation);
+    const s64 slack_size = internal::guard_slack_size(allocation);
+    for (s64 idx = 0; idx < slack_size; ++idx)
+    {
+      REX_ASSERT_X(static_cast<u8>(slack[idx]) == g_guard_allocator_fill_byte, "Buffer overrun detected of a guarded allocation. ptr: {} size: {} overwritten byte: {}", ptr, allocation.size, idx);
+    }
+
+    // Any access from now on crashes, until the allocation leaves the quarantine
+    vmem::decommit(jump_forward(allocation.base, vmem::page_size()), allocation.reserved_size - 2 * vmem::page_size());
+
+    const rsl::unique_lock lock(m_lock);
+    if (m_num_quarantined == g_guard_allocator_quarantine_size)
+    {
+      release_oldest_quarantined();
+    }
+    m_quarantine[(m_quarantine_start + m_num_quarantined) % g_guard_allocator_quarantine_size] = ptr;
+    ++m_num_quarantined;
+    --m_num_live_allocations;
+  }
+
+  bool GuardAllocator::owns(const void* ptr)
+  {
+    if (m_num_owned.load(rsl::memory_order_relaxed) == 0)
+    {
+      return false;
+    }
+
+    const rsl::unique_lock lock(m_lock);
+    return m_allocations[find_slot(ptr)].ptr != nullptr;
+  }
+
+  s64 GuardAllocator::usable_size(const void* ptr)
+  {
+    const rsl::unique_lock lock(m_lock);
+    return m_allocations[find_slot(ptr)].size;
+  }
+
+  GuardAllocatorStats GuardAllocator::stats()
+  {
+    const rsl::unique_lock lock(m_lock);
+
+    GuardAllocatorStats stats {};
+    stats.num_live_allocations = m_num_live_allocations;
+    stats.num_quarantined = m_num_quarantined;
+    stats.num_unguarded = m_num_unguarded;
+    return stats;
+  }
+
+  s32 GuardAllocator::find_slot(const void* ptr) const
+  {
+    // Linear probing, the table is never more than half full so there's always an empty slot to stop at
+    s32 slot = internal::guard_allocation_hash(ptr);
+    while (m_allocations[slot].ptr != nullptr && m_allocations[slot].ptr != ptr)
+    {
+      slot = (slot + 1) % internal::g_guard_allocator_table_size;
+    }
+    return slot;
+  }
+
+  void GuardAllocator::remove_slot(s32 slot)
+  {
+    m_allocations[slot] = internal::GuardAllocation {};
+
+    // Move entries that probed past the removed slot back into it, otherwise their probe sequence would stop early
+    s32 empty_slot = slot;
+    s32 next_slot  = (slot + 1) % internal::g_guard_allocator_table_size;
+    while (m_allocations[next_slot].ptr != nullptr)
+    {
+      const s32 home_slot = internal::guard_allocation_hash(m_allocations[next_slot].ptr);
+      const bool is_home_between = empty_slot <= next_slot ? (empty_slot < home_slot && home_slot <= next_slot) : (empty_slot < home_slot || home_slot <= next_slot);
+      if (!is_home_between)
+      {
+        m_allocations[empty_slot] = m_allocations[next_slot];
+        m_allocations[next_slot]  = internal::GuardAllocation {};
+        empty_slot                = next_slot;
+      }
+      next_slot = (next_slot + 1) % internal::g_guard_allocator_table_size;
+    }
+  }
+
+  void GuardAllocator::release_oldest_quarantined()
+  {
+    void* oldest = m_quarantine[m_quarantine_start];
+    m_quarantine_start = (m_quarantine_start + 1) % g_guard_allocator_quarantine_size;
+    --m_num_quarantined;
+
+    const s32 slot = find_slot(oldest);
+    vmem::release(m_allocations[slot].base, m_allocations[slot].reserved_size);
+    remove_slot(slot);
+    m_num_owned.fetch_sub(1, rsl::memory_order_relaxed);
+  }
+
+  GuardAllocator& guard_allocator()
+  {
+    alignas(GuardAllocator) static rsl::byte s_storage[sizeof(GuardAllocator)]; // NOLINT(modernize-avoid-c-arrays)
+    static GuardAllocator* s_allocator = new (s_storage) GuardAllocator();
+    return *s_allocator;
+  }
+
+  void enable_guard_allocator(MemoryTag tag, bool enable)
+  {
+    if (enable)
+    {
+      internal::g_guarded_memory_tags.fetch_or(internal::memory_tag_bit(tag), rsl::memory_order_relaxed);
+    }
+    else
+    {
+      internal::g_guarded_memory_tags.fetch_and(~internal::memory_tag_bit(tag), rsl::memory_order_relaxed);
+    }
+  }
+  bool is_guard_allocator_enabled(MemoryTag tag)
+  {
+    return (internal::g_guarded_memory_tags.load(rsl::memory_order_relaxed) & internal::memory_tag_bit(tag)) != 0;
+  }
+  bool is_guard_allocator_enabled()
+  {
+    return internal::g_guarded_memory_tags.load(rsl::memory_order_relaxed) != 0;
+  }
+} // namespace rex
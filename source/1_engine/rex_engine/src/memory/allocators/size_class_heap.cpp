@@ -0,0 +1,414 @@
+#include "rex_engine/memory/allocators/size_class_heap.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/memory/pointer_math.h"
+#include "rex_engine/memory/virtual_memory.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/mutex.h"
+
+namespace rex
+{
+  namespace internal
+  {
+    // Free blocks link to the next free block using their own memory
+    void*& next_block(void* block)
+    {
+      return *static_cast<void**>(block);
+    }
+
+    // The number of blocks a thread takes from or gives back to the heap at once
+    s32 thread_cache_batch_size(s32 sizeClass)
+    {
+      const s64 num_blocks = g_size_class_heap_thread_cache_size / (2 * size_of_class(sizeClass));
+      return static_cast<s32>(rsl::clamp(num_blocks, static_cast<s64>(1), static_cast<s64>(64)));
+    }
+
+    s32 num_blocks_in_span(s32 sizeClass)
+    {
+      return static_cast<s32>(g_size_class_heap_span_size / size_of_class(sizeClass));
+    }
+
+    // The slot of a segment in the segment table
+    s32 segment_table_slot(u64 segmentBase, s32 tableSize)
+    {
+      const u64 hash = (segmentBase / g_size_class_heap_segment_size) * 0x9E3779B97F4A7C15ull;
+      return static_cast<s32>(hash % static_cast<u64>(tableSize));
+    }
+  } // namespace internal
+
+  // The blocks cached by a single thread, per size class
+  struct SizeClassHeapThreadCache
+  {
+    struct Bin
+    {
+      void* head;
+      s32 count;
+    };
+
+    rsl::array<Bin, internal::g_size_class_heap_num_classes> bins {};
+    // Threads can still allocate and free while their thread locals are destroyed
+    // once the cache is destroyed, blocks go straight to the heap
+    bool is_alive = true;
+
+    ~SizeClassHeapThreadCache()
+    {
+      flush();
+      is_alive = false;
+    }
+
+    void flush()
+    {
+      SizeClassHeap& heap = size_class_heap();
+      for (Bin& bin : bins)
+      {
+        while (bin.head != nullptr)
+        {
+          void* block = bin.head;
+          bin.head = internal::next_block(block);
+          heap.give_block(block);
+        }
+        bin.count = 0;
+      }
+    }
+  };
+
+  namespace internal
+  {
+    thread_local SizeClassHeapThreadCache g_size_class_heap_thread_cache; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  }
+
+  SizeClassHeap::SizeClassHeap()
+    : m_central_lists()
+    , m_segment_table()
+    , m_num_segments(0)
+    , m_num_spans_in_use(0)
+    , m_free_spans(nullptr)
+    , m_span_lock()
+  {}
+
+  // Allocate a block of at least size bytes, size can't be bigger than the max small size
+  // Blocks are aligned to 16 bytes
+  void* SizeClassHeap::allocate(s64 size)
+  {
+    REX_ASSERT_X(size <= g_size_class_heap_max_small_size, "Allocation too big for the size class heap. size: {} max size: {}", size, g_size_class_heap_max_small_size);
+
+    const s32 size_class = internal::size_class_of(size);
+    SizeClassHeapThreadCache& cache = internal::g_size_class_heap_thread_cache;
+    if (!cache.is_alive)
+    {
+      void* block = nullptr;
+      take_blocks(size_class, 1, block);
+      return block;
+    }
+
+    SizeClassHeapThreadCache::Bin& bin = cache.bins[size_class];
+    if (bin.head == nullptr)
+    {
+      bin.count = take_blocks(size_class, internal::thread_cache_batch_size(size_class), bin.head);
+      if (bin.head == nullptr)
+      {
+        return nullptr;
+      }
+    }
+
+    void* block = bin.head;
+    bin.head = internal::next_block(block);
+    --bin.count;
+    return block;
+  }
+
+  // Free a block that was allocated by this heap, from any thread
+  void SizeClassHeap::deallocate(void* ptr)
+  {
+    REX_ASSERT_X(owns(ptr), "Deallocating a pointer that wasn't allocated by the size class heap");
+
+    SizeClassHeapThreadCache& cache = internal::g_size_class_heap_thread_cache;
+    if (!cache.is_alive)
+    {
+      give_block(ptr);
+      return;
+    }
+
+    // The size class of a span doesn't change while it has blocks in use, so it can be read without a lock
+    const s32 size_class = span_of(ptr)->size_class;
+    SizeClassHeapThreadCache::Bin& bin = cache.bins[size_class];
+    internal::next_block(ptr) = bin.head;
+    bin.head = ptr;
+    ++bin.count;
+
+    // Give a batch back when the thread holds on to too many blocks
+    const s32 batch_size = internal::thread_cache_batch_size(size_class);
+    if (bin.count > 2 * batch_size)
+    {
+      for (s32 idx = 0; idx < batch_size; ++idx)
+      {
+        void* block = bin.head;
+        bin.head = internal::next_block(block);
+        give_block(block);
+      }
+      bin.count -= batch_size;
+    }
+  }
+
+  // Return true if the pointer points into memory owned by the heap
+  bool SizeClassHeap::owns(const void* ptr) const
+  {
+    return find_segment(ptr) != nullptr;
+  }
+  // Return the number of bytes that can be used by the block the pointer was allocated with
+  s64 SizeClassHeap::usable_size(const void* ptr) const
+  {
+    return internal::size_of_class(span_of(ptr)->size_class);
+  }
+
+  SizeClassHeapStats SizeClassHeap::stats() const
+  {
+    SizeClassHeapStats stats {};
+    stats.num_segments = m_num_segments.load(rsl::memory_order_relaxed);
+    stats.reserved_memory = stats.num_segments * internal::g_size_class_heap_segment_size;
+    stats.num_spans_in_use = m_num_spans_in_use.load(rsl::memory_order_relaxed);
+    return stats;
+  }
+
+  // Move all blocks cached by the calling thread back to the heap
+  void SizeClassHeap::flush_thread_cache()
+  {
+    SizeClassHeapThreadCache& cache = internal::g_size_class_heap_thread_cache;
+    if (cache.is_alive)
+    {
+      cache.flush();
+    }
+  }
+
+  // Move up to count blocks of a size class into a linked list, returns the number of blocks moved
+  s32 SizeClassHeap::take_blocks(s32 sizeClass, s32 count, void*& outList)
+  {
+    internal::SizeClassCentralList& central = m_central_lists[sizeClass];
+    const s64 block_size = internal::size_of_class(sizeClass);
+    const s32 num_blocks_in_span = internal::num_blocks_in_span(sizeClass);
+
+    const rsl::unique_lock lock(central.lock);
+    s32 num_taken = 0;
+    while (num_taken < count)
+    {
+      internal::SizeClassSpan* span = central.partial_spans;
+      if (span == nullptr)
+      {
+        span = acquire_span(sizeClass);
+        if (span == nullptr)
+        {
+          break;
+        }
+
+        span->is_partial = true;
+        span->next_partial = nullptr;
+        span->prev_partial = nullptr;
+        central.partial_spans = span;
+      }
+
+      // Reuse freed blocks first, only carve new ones when there are none
+      void* block = span->free_list;
+      if (block != nullptr)
+      {
+        span->free_list = internal::next_block(block);
+      }
+      else
+      {
+        block = span->start + block_size * span->num_carved;
+        ++span->num_carved;
+      }
+      ++span->num_used;
+
+      internal::next_block(block) = outList;
+      outList = block;
+      ++num_taken;
+
+      // A full span leaves the partial list until one of its blocks is freed
+      if (span->free_list == nullptr && span->num_carved == num_blocks_in_span)
+      {
+        central.partial_spans = span->next_partial;
+        if (central.partial_spans)
+        {
+          central.partial_spans->prev_partial = nullptr;
+        }
+        span->is_partial = false;
+      }
+    }
+
+    return num_taken;
+  }
+
+  // Return a single block to the span it came from
+  void SizeClassHeap::give_block(void* ptr)
+  {
+    internal::SizeClassSpan* span = span_of(ptr);
+    internal::SizeClassCentralList& central = m_central_lists[span->size_class];
+
+    const rsl::unique_lock lock(central.lock);
+    internal::next_block(ptr) = span->free_list;
+    span->free_list = ptr;
+    --span->num_used;
+
+    if (!span->is_partial)
+    {
+      span->prev_partial = nullptr;
+      span->next_partial = central.partial_spans;
+      if (central.partial_spans)
+      {
+        central.partial_spans->prev_partial = span;
+      }
+      central.partial_spans = span;
+      span->is_partial = true;
+    }
+
+    // An empty span goes back to the heap, unless it's the only span of its size class
+    // that avoids bouncing a span back and forth when a single block gets allocated and freed repeatedly
+    const bool is_only_span = span->prev_partial == nullptr && span->next_partial == nullptr;
+    if (span->num_used == 0 && !is_only_span)
+    {
+      if (span->prev_partial)
+      {
+        span->prev_partial->next_partial = span->next_partial;
+      }
+      else
+      {
+        central.partial_spans = span->next_partial;
+      }
+      if (span->next_partial)
+      {
+        span->next_partial->prev_partial = span->prev_partial;
+      }
+      span->is_partial = false;
+
+      release_span(span);
+    }
+  }
+
+  internal::SizeClassSpan* SizeClassHeap::acquire_span(s32 sizeClass)
+  {
+    internal::SizeClassSpan* span = nullptr;
+    {
+      const rsl::unique_lock lock(m_span_lock);
+      if (m_free_spans == nullptr && !add_segment())
+      {
+        return nullptr;
+      }
+
+      span = m_free_spans;
+      m_free_spans = span->next_free;
+    }
+
+    span->size_class = sizeClass;
+    span->free_list = nullptr;
+    span->next_free = nullptr;
+    span->num_used = 0;
+    span->num_carved = 0;
+    m_num_spans_in_use.fetch_add(1, rsl::memory_order_relaxed);
+    return span;
+  }
+  void SizeClassHeap::release_span(internal::SizeClassSpan* span)
+  {
+    span->size_class = -1;
+    m_num_spans_in_use.fetch_sub(1, rsl::memory_order_relaxed);
+
+    const rsl::unique_lock lock(m_span_lock);
+    span->next_free = m_free_spans;
+    m_free_spans = span;
+  }
+
+  // Request a new segment from the OS and add its spans to the free spans
+  // This is called with the span lock held
+  bool SizeClassHeap::add_segment()
+  {
+    if (m_num_segments.load(rsl::memory_order_relaxed) == internal::g_size_class_heap_max_segments)
+    {
+      REX_ASSERT("Size class heap ran out of segments. max segments: {}", internal::g_size_class_heap_max_segments);
+      return false;
+    }
+
+    // Over reserve so the segment can be aligned to its size
+    // Only the aligned segment gets committed, the rest of the reservation only costs address space
+    void* os_allocation = vmem::reserve(internal::g_size_class_heap_segment_reserve_size);
+    if (os_allocation == nullptr)
+    {
+      return false;
+    }
+    rsl::byte* base = static_cast<rsl::byte*>(align(os_allocation, static_cast<card32>(internal::g_size_class_heap_segment_size)));
+    if (!vmem::commit(base, internal::g_size_class_heap_segment_size))
+    {
+      vmem::release(os_allocation, internal::g_size_class_heap_segment_reserve_size);
+      return false;
+    }
+
+    // The first span holds the metadata of the segment, the others can be used for blocks
+    internal::SizeClassSegment* segment = new (base) internal::SizeClassSegment();
+    segment->os_allocation = os_allocation;
+    for (s32 idx = internal::g_size_class_heap_spans_per_segment - 1; idx > 0; --idx)
+    {
+      internal::SizeClassSpan& span = segment->spans[idx];
+      span.start = base + idx * internal::g_size_class_heap_span_size;
+      span.free_list = nullptr;
+      span.next_partial = nullptr;
+      span.prev_partial = nullptr;
+      span.size_class = -1;
+      span.num_used = 0;
+      span.num_carved = 0;
+      span.is_partial = false;
+      span.next_free = m_free_spans;
+      m_free_spans = &span;
+    }
+
+    // Publish the segment, so other threads can find it
+    const u64 segment_base = reinterpret_cast<u64>(base); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const s32 table_size = static_cast<s32>(m_segment_table.size());
+    s32 slot = internal::segment_table_slot(segment_base, table_size);
+    while (m_segment_table[slot].load(rsl::memory_order_relaxed) != 0)
+    {
+      slot = (slot + 1) % table_size;
+    }
+    m_segment_table[slot].store(segment_base, rsl::memory_order_release);
+    m_num_segments.fetch_add(1, rsl::memory_order_release);
+
+    return true;
+  }
+
+  internal::SizeClassSpan* SizeClassHeap::span_of(const void* ptr) const
+  {
+    internal::SizeClassSegment* segment = find_segment(ptr);
+    const s64 offset = static_cast<const rsl::byte*>(ptr) - reinterpret_cast<const rsl::byte*>(segment); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    return &segment->spans[static_cast<s32>(offset / internal::g_size_class_heap_span_size)];
+  }
+  internal::SizeClassSegment* SizeClassHeap::find_segment(const void* ptr) const
+  {
+    if (ptr == nullptr || m_num_segments.load(rsl::memory_order_acquire) == 0)
+    {
+      return nullptr;
+    }
+
+    const u64 segment_base = reinterpret_cast<u64>(ptr) & ~static_cast<u64>(internal::g_size_class_heap_segment_size - 1); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const s32 table_size = static_cast<s32>(m_segment_table.size());
+    s32 slot = internal::segment_table_slot(segment_base, table_size);
+    while (true)
+    {
+      const u64 entry = m_segment_table[slot].load(rsl::memory_order_acquire);
+      if (entry == 0)
+      {
+        return nullptr;
+      }
+      if (entry == segment_base)
+      {
+        return reinterpret_cast<internal::SizeClassSegment*>(entry); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+      }
+      slot = (slot + 1) % table_size;
+    }
+  }
+
+  // The size class heap is never destroyed
+  // threads can still free memory back to it while the process is shutting down
+  SizeClassHeap& size_class_heap()
+  {
+    alignas(SizeClassHeap) static rsl::byte s_storage[sizeof(SizeClassHeap)]; // NOLINT(modernize-avoid-c-arrays)
+    static SizeClassHeap* s_heap = new (s_storage) SizeClassHeap();
+    return *s_heap;
+  }
+}
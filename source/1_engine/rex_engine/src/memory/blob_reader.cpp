@@ -1,5 +1,7 @@
 #include "rex_engine/memory/blob_reader.h"
 
+#include "rex_std/algorithm.h"
+
 namespace rex
 {
   namespace memory
@@ -17,10 +19,14 @@ namespace rex
     }
 
     //-------------------------------------------------------------------------
-    void BlobReader::read(void* dst, rsl::memory_size size)
+    rsl::memory_size BlobReader::read(void* dst, rsl::memory_size size)
     {
-      m_blob.read_bytes(dst, size, m_read_offset);
-      m_read_offset += size;
+      const s64 num_left = static_cast<s64>(m_blob.size()) - static_cast<s64>(m_read_offset);
+      const rsl::memory_size num_to_read(num_left > 0 ? rsl::min(static_cast<s64>(size), num_left) : 0);
+
+      m_blob.read_bytes(dst, num_to_read, m_read_offset);
+      m_read_offset += num_to_read;
+      return num_to_read;
     }
 
     //-------------------------------------------------------------------------
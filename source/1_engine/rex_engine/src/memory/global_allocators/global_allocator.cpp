@@ -21,15 +21,15 @@ namespace rex
 		BackendOSAllocator& backend_allocator()
 		{
 #ifdef REX_ENABLE_MEM_TRACKING
-      static UntrackedAllocator untracked_alloc{};
+      static EngineHeapAllocator heap_alloc{};
       
       // Use the untracked allocator to create the memory tracker
       // it's the only memory 
       mem_tracker(); // simply touch it so that the local static gets initialized
 
-      static TrackedAllocator alloc(untracked_alloc);
+      static TrackedAllocator alloc(heap_alloc);
 #else
-      static UntrackedAllocator alloc{};
+      static EngineHeapAllocator alloc{};
 #endif
 			return alloc;
 		}
@@ -57,10 +57,10 @@ namespace rex
 			// Cannot use make_unique or alloc_unique here
 			// make_unique would cause a circular dependency and we'd get a deadlock the second time the GlobalAllocator ctor is called
 			// alloc_unique cannot be used here as that'd return a unique_ptr without a default_deleter argument
-			TCircularAllocator<GlobalAllocator>* scratch_allocator_ptr = globalAlloc.allocate<TCircularAllocator<GlobalAllocator>>();
-			globalAlloc.construct(scratch_allocator_ptr, minimal_global_alloc_size, globalAlloc);
+			EngineGlobals::ScratchAllocator* scratch_allocator_ptr = globalAlloc.allocate<EngineGlobals::ScratchAllocator>();
+			globalAlloc.construct(scratch_allocator_ptr, minimal_global_alloc_size);
 
-			auto scratch_allocator = rsl::unique_ptr<TCircularAllocator<GlobalAllocator>>(scratch_allocator_ptr);
+			auto scratch_allocator = rsl::unique_ptr<EngineGlobals::ScratchAllocator>(scratch_allocator_ptr);
 			auto engine_globals = globalAlloc.allocate<EngineGlobals>();
 			globalAlloc.construct(engine_globals, rsl::move(scratch_allocator), nullptr);
 			engine::init(globals::GlobalUniquePtr<EngineGlobals>(engine_globals));
@@ -0,0 +1,171 @@
+#include "rex_engine/memory/memory_budgets.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/settings/settings.h"
+#include "rex_std/bonus/memory.h"
+#include "rex_std/format.h"
+#include "rex_std/internal/exception/exit.h"
+
+namespace rex
+{
+  DEFINE_LOG_CATEGORY(LogMemoryBudgets);
+
+  MemoryBudgets::MemoryBudgets()
+    : m_budgets()
+    , m_is_over_budget()
+    , m_history()
+    , m_frame_indices()
+    , m_next_history_idx(0)
+    , m_num_recorded_frames(0)
+    , m_policy(MemoryBudgetPolicy::Warn)
+  {
+  }
+
+  void MemoryBudgets::set_budget(MemoryTag tag, s64 budget)
+  {
+    m_budgets[rsl::enum_refl::enum_integer(tag)] = budget;
+  }
+  s64 MemoryBudgets::budget(MemoryTag tag) const
+  {
+    return m_budgets[rsl::enum_refl::enum_integer(tag)];
+  }
+  void MemoryBudgets::set_policy(MemoryBudgetPolicy policy)
+  {
+    m_policy = policy;
+  }
+  MemoryBudgetPolicy MemoryBudgets::policy() const
+  {
+    return m_policy;
+  }
+
+  void MemoryBudgets::load_from_settings()
+  {
+    // eg. memory_budgets.Renderer = 512
+    for (count_t tag_idx = 0; tag_idx < m_budgets.size(); ++tag_idx)
+    {
+      const MemoryTag tag = static_cast<MemoryTag>(tag_idx);
+      const scratch_string setting_name(rsl::format("memory_budgets.{}", rsl::enum_refl::enum_name(tag)));
+      const s32 budget_in_mib = settings::instance()->get_int(setting_name, 0);
+      set_budget(tag, static_cast<s64>(budget_in_mib) * 1_mib);
+
+      if (budget_in_mib > 0)
+      {
+        REX_INFO(LogMemoryBudgets, "Memory budget of {}: {} MiB", rsl::enum_refl::enum_name(tag), budget_in_mib);
+      }
+    }
+
+    const rsl::string_view policy = settings::instance()->get_string("memory_budgets.policy", "Warn");
+    set_policy(policy == "FailFast" ? MemoryBudgetPolicy::FailFast : MemoryBudgetPolicy::Warn);
+  }
+
+  void MemoryBudgets::record_frame(card32 frameIdx, const MemoryAllocationStats::UsagePerTag& usagePerTag)
+  {
+    UsagePerTag usage{};
+    for (count_t tag_idx = 0; tag_idx < usage.size(); ++tag_idx)
+    {
+      usage[tag_idx] = usagePerTag[tag_idx].value();
+    }
+    record_frame(frameIdx, usage);
+  }
+
+  void MemoryBudgets::record_frame(card32 frameIdx, const UsagePerTag& usagePerTag)
+  {
+    m_history[m_next_history_idx] = usagePerTag;
+    m_frame_indices[m_next_history_idx] = frameIdx;
+    m_next_history_idx = (m_next_history_idx + 1) % g_memory_budget_history_size;
+    m_num_recorded_frames = rsl::min(m_num_recorded_frames + 1, g_memory_budget_history_size);
+
+    for (count_t tag_idx = 0; tag_idx < usagePerTag.size(); ++tag_idx)
+    {
+      const s64 budget = m_budgets[tag_idx];
+      const bool is_over_budget = budget > 0 && usagePerTag[tag_idx] > budget;
+
+      // Only report when a tag goes over its budget, not for every frame it stays over it
+      if (is_over_budget && !m_is_over_budget[tag_idx])
+      {
+        const rsl::string_view tag_name = rsl::enum_refl::enum_name(static_cast<MemoryTag>(tag_idx));
+        REX_WARN(LogMemoryBudgets, "Memory tag {} went over its budget in frame {}. usage: {} bytes budget: {} bytes", tag_name, frameIdx, usagePerTag[tag_idx], budget);
+
+        if (m_policy == MemoryBudgetPolicy::FailFast)
+        {
+          REX_FATAL(LogMemoryBudgets, "Exiting as memory budgets are enforced. memory tag: {}", tag_name);
+          REX_ASSERT("Memory tag {} went over its budget. usage: {} bytes budget: {} bytes", tag_name, usagePerTag[tag_idx], budget);
+          rsl::exit(1);
+        }
+      }
+
+      m_is_over_budget[tag_idx] = is_over_budget;
+    }
+  }
+
+  bool MemoryBudgets::is_over_budget(MemoryTag tag) const
+  {
+    return m_is_over_budget[rsl::enum_refl::enum_integer(tag)];
+  }
+
+  s32 MemoryBudgets::num_recorded_frames() const
+  {
+    return m_num_recorded_frames;
+  }
+  s64 MemoryBudgets::usage(MemoryTag tag, s32 idx) const
+  {
+    return m_history[ring_index(idx)][rsl::enum_refl::enum_integer(tag)];
+  }
+  card32 MemoryBudgets::frame_index(s32 idx) const
+  {
+    return m_frame_indices[ring_index(idx)];
+  }
+
+  debug_vector<f32> MemoryBudgets::usage_series(MemoryTag tag) const
+  {
+    debug_vector<f32> series;
+    series.reserve(m_num_recorded_frames);
+    for (s32 idx = 0; idx < m_num_recorded_frames; ++idx)
+    {
+      series.push_back(static_cast<f32>(usage(tag, idx)));
+    }
+    return series;
+  }
+
+  void MemoryBudgets::dump_to_csv(rsl::string_view filepath) const
+  {
+    // frame,ConsoleApp,Pokemon,...
+    debug_string csv;
+    csv += "frame";
+    for (count_t tag_idx = 0; tag_idx < m_budgets.size(); ++tag_idx)
+    {
+      csv += ',';
+      csv += rsl::enum_refl::enum_name(static_cast<MemoryTag>(tag_idx));
+    }
+    csv += '\n';
+
+    for (s32 idx = 0; idx < m_num_recorded_frames; ++idx)
+    {
+      csv += rsl::format("{}", frame_index(idx));
+      for (count_t tag_idx = 0; tag_idx < m_budgets.size(); ++tag_idx)
+      {
+        csv += rsl::format(",{}", usage(static_cast<MemoryTag>(tag_idx), idx));
+      }
+      csv += '\n';
+    }
+
+    file::write_to_file_abspath(filepath, csv.data(), csv.length());
+  }
+
+  s32 MemoryBudgets::ring_index(s32 idx) const
+  {
+    REX_ASSERT_X(idx >= 0 && idx < m_num_recorded_frames, "Memory budget history index out of range. index: {} num recorded frames: {}", idx, m_num_recorded_frames);
+
+    // When the ring buffer isn't full yet, the oldest frame is at the start
+    const s32 oldest_idx = m_num_recorded_frames < g_memory_budget_history_size ? 0 : m_next_history_idx;
+    return (oldest_idx + idx) % g_memory_budget_history_size;
+  }
+
+  MemoryBudgets& mem_budgets()
+  {
+    static MemoryBudgets budgets;
+    return budgets;
+  }
+} // namespace rex
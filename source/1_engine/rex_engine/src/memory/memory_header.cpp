@@ -9,6 +9,9 @@ namespace rex
     , m_thread_id(threadId)
     , m_tag(tag)
     , m_frame_idx(frameIdx)
+    , m_tracking_shard(-1)
+    , m_tracking_idx(-1)
+    , m_trace_id(0)
   {
   }
 
@@ -37,4 +40,35 @@ namespace rex
     return m_frame_idx;
   }
 
+  bool MemoryHeader::has_callstack() const
+  {
+    return m_callstack[0] != nullptr;
+  }
+
+  void MemoryHeader::set_tracking_shard(s32 shard)
+  {
+    m_tracking_shard = shard;
+  }
+  s32 MemoryHeader::tracking_shard() const
+  {
+    return m_tracking_shard;
+  }
+  void MemoryHeader::set_tracking_index(s32 idx)
+  {
+    m_tracking_idx = idx;
+  }
+  s32 MemoryHeader::tracking_index() const
+  {
+    return m_tracking_idx;
+  }
+
+  void MemoryHeader::set_trace_id(card32 id)
+  {
+    m_trace_id = id;
+  }
+  card32 MemoryHeader::trace_id() const
+  {
+    return m_trace_id;
+  }
+
 } // namespace rex
\ No newline at end of file
@@ -8,7 +8,9 @@
 #include "rex_engine/frameinfo/frameinfo.h"
 #include "rex_engine/memory/global_allocators/global_allocator.h"
 #include "rex_engine/memory/memory_header.h"
+#include "rex_engine/memory/alloc_trace.h"
 #include "rex_engine/memory/memory_stats.h"
+#include "rex_std/algorithm.h"
 #include "rex_std/bonus/time/timepoint.h"
 #include "rex_std/bonus/types.h"
 #include "rex_engine/engine/engine.h"
@@ -24,6 +26,29 @@ namespace rex
 
   thread_local FixedStack<MemoryTag, g_max_allowed_mem_tags> g_thread_local_mem_tags;
 
+  // The memory tracker shard of the current thread, -1 until the thread's first allocation
+  thread_local s32 g_thread_local_mem_tracking_shard = -1;
+
+  namespace internal
+  {
+    // Raise the peak to the given usage if it's higher, other threads of the shard can raise it at the same time
+    void update_peak(rsl::atomic<s64>& peak, s64 usage)
+    {
+      s64 current_peak = peak.load(rsl::memory_order_relaxed);
+      while(usage > current_peak && !peak.compare_exchange_weak(current_peak, usage, rsl::memory_order_relaxed))
+      {
+      }
+    }
+
+    // Build a high water mark at the given usage that has seen the given peak
+    rsl::high_water_mark<s64> make_high_water_mark(s64 usage, s64 peak)
+    {
+      rsl::high_water_mark<s64> mark(rsl::max(usage, peak));
+      mark += usage - mark.value();
+      return mark;
+    }
+  } // namespace internal
+
   AllocationCallStack::AllocationCallStack(CallStack callstack, card64 size)
     : m_callstack(rsl::move(callstack))
     , m_size(size)
@@ -53,10 +78,26 @@ namespace rex
   }
 
   MemoryTracker::MemoryTracker()
-      : m_mem_usage(0)
-      , m_max_mem_budget((rsl::numeric_limits<s64>::max)())
+      : m_max_mem_budget((rsl::numeric_limits<s64>::max)())
       , m_is_active(true)
+      , m_next_shard(0)
+      , m_callstack_sample_rate(g_default_callstack_sample_rate)
+      , m_num_callstack_candidates(0)
   {
+    for(internal::MemoryTrackingShard& shard: m_shards)
+    {
+      for(rsl::atomic<s64>& usage: shard.usage_per_tag)
+      {
+        usage.store(0, rsl::memory_order_relaxed);
+      }
+      for(rsl::atomic<s64>& peak: shard.max_usage_per_tag)
+      {
+        peak.store(0, rsl::memory_order_relaxed);
+      }
+      shard.used_memory.store(0, rsl::memory_order_relaxed);
+      shard.max_used_memory.store(0, rsl::memory_order_relaxed);
+      shard.num_total_allocations.store(0, rsl::memory_order_relaxed);
+    }
   }
 
   MemoryTracker::~MemoryTracker()
@@ -85,27 +126,45 @@ namespace rex
     const card32 frame_idx               = rex::engine::instance() 
       ? rex::engine::instance()->frame_info().index()
       : 0;
-    const CallStack callstack            = current_callstack();
+    // Capture the callstack before we lock, it's the most expensive part of tracking
+    // Allocations that aren't sampled keep an empty callstack
+    const CallStack callstack            = should_capture_callstack() ? current_callstack() : CallStack {};
+
+    rex::MemoryHeader* header = new(dbg_header_addr) MemoryHeader(tag, mem, rsl::memory_size(size), thread_id, frame_idx, callstack);
 
     // track the callstack, if we this callstack allocated memory before
     // add to the callstack the size of the memory we just allocated
-    const rsl::unique_lock lock(m_mem_tracking_mutex);
-    auto it          = m_allocation_info_table.find(callstack);
-    if(it == m_allocation_info_table.end())
+    if(header->has_callstack())
     {
-      m_allocation_info_table.insert({callstack, AllocationInfo {AllocationCallStack(callstack, size)}});
+      const rsl::unique_lock lock(m_mem_tracking_mutex);
+      auto it = m_allocation_info_table.find(callstack);
+      if(it == m_allocation_info_table.end())
+      {
+        m_allocation_info_table.insert({callstack, AllocationInfo {AllocationCallStack(callstack, size)}});
+      }
+      else
+      {
+        it->value.allocation_callstack.add_size(size);
+      }
     }
-    else
+
+    internal::MemoryTrackingShard& shard = current_shard();
+    shard.num_total_allocations.fetch_add(1, rsl::memory_order_relaxed);
+    const s64 alloc_size = static_cast<s64>(header->size().size_in_bytes());
+    const auto tag_idx   = rsl::enum_refl::enum_integer(header->tag());
+    internal::update_peak(shard.max_usage_per_tag[tag_idx], shard.usage_per_tag[tag_idx].fetch_add(alloc_size, rsl::memory_order_relaxed) + alloc_size);
+    internal::update_peak(shard.max_used_memory, shard.used_memory.fetch_add(alloc_size, rsl::memory_order_relaxed) + alloc_size);
+
+    // Recording can write to disk, which allocates, so it can't happen while holding the shard lock
+    if(alloc_trace::is_recording())
     {
-      it->value.allocation_callstack.add_size(size);
+      alloc_trace::internal::record_alloc(header);
     }
 
-    rex::MemoryHeader* header = new(dbg_header_addr) MemoryHeader(tag, mem, rsl::memory_size(size), thread_id, frame_idx, callstack);
-
-    ++m_num_total_allocations;
-    m_mem_usage += header->size().size_in_bytes();
-    m_usage_per_tag[rsl::enum_refl::enum_integer(header->tag())] += header->size().size_in_bytes();
-    m_allocation_headers.push_back(header);
+    header->set_tracking_shard(g_thread_local_mem_tracking_shard);
+    const rsl::unique_lock shard_lock(shard.allocation_headers_lock);
+    header->set_tracking_index(static_cast<s32>(shard.allocation_headers.size()));
+    shard.allocation_headers.push_back(header);
 
     return header;
   }
@@ -120,34 +179,57 @@ namespace rex
 
     // REX_WARN_X(LogEngine, header->frame_index() != globals::frame_info().index(), "Memory freed in the same frame it's allocated (please use single frame allocator for this)");
 
-    // Postpone lock after logging to initialize the logger first ( on first access ).
-    // Logger requires the same mutex to be locked and we cannot lock the same mutex twice from the same thread.
-    const rsl::unique_lock lock(m_mem_tracking_mutex);
+    // Only allocations that got their callstack captured get their deleter captured as well
+    // Capture it before we lock, it's the most expensive part of tracking
+    const CallStack deleter_callstack = header->has_callstack() ? rex::current_callstack() : CallStack {};
 
-    m_mem_usage -= header->size().size_in_bytes();
-    auto it = rsl::find(m_allocation_headers.cbegin(), m_allocation_headers.cend(), header);
+    if(alloc_trace::is_recording())
+    {
+      alloc_trace::internal::record_free(header);
+    }
 
-    REX_ASSERT_X(it != m_allocation_headers.cend(), "Trying to remove a memory header that wasn't tracked");
-    REX_ASSERT_X(m_mem_usage >= 0, "Mem usage below 0");
+    {
+      REX_ASSERT_X(header->tracking_shard() >= 0 && header->tracking_shard() < g_num_mem_tracking_shards, "Trying to remove a memory header that wasn't tracked");
+      internal::MemoryTrackingShard& owning_shard = m_shards[header->tracking_shard()];
 
-    auto alloc_info_it = m_allocation_info_table.find(header->callstack());
-    REX_ASSERT_X(alloc_info_it != m_allocation_info_table.end(), "tracking a deallocation which allocation didn't get tracked");
-    alloc_info_it->value.allocation_callstack.sub_size(header->size());
+      // The usage goes back to the shard that tracked the allocation, so the usage and peaks of a shard only cover its own allocations
+      owning_shard.usage_per_tag[rsl::enum_refl::enum_integer(header->tag())].fetch_sub(header->size().size_in_bytes(), rsl::memory_order_relaxed);
+      owning_shard.used_memory.fetch_sub(header->size().size_in_bytes(), rsl::memory_order_relaxed);
 
-    // add unique deleter callstacks
-    debug_vector<CallStack>& del_callstacks = m_allocation_info_table.at(header->callstack()).deleter_callstacks;
-    const CallStack current_callstack      = rex::current_callstack();
-    if(rsl::find(del_callstacks.cbegin(), del_callstacks.cend(), current_callstack) == del_callstacks.cend())
-    {
-      del_callstacks.push_back(rex::current_callstack());
+      const rsl::unique_lock shard_lock(owning_shard.allocation_headers_lock);
+
+      const s32 tracking_idx = header->tracking_index();
+      REX_ASSERT_X(tracking_idx >= 0 && tracking_idx < static_cast<s32>(owning_shard.allocation_headers.size()) && owning_shard.allocation_headers[tracking_idx] == header, "Trying to remove a memory header that wasn't tracked");
+
+      // Swap the last header into the slot of the removed one, so removing is constant time
+      MemoryHeader* last_header               = owning_shard.allocation_headers.back();
+      owning_shard.allocation_headers[tracking_idx] = last_header;
+      last_header->set_tracking_index(tracking_idx);
+      owning_shard.allocation_headers.pop_back();
     }
 
-    if(alloc_info_it->value.allocation_callstack.size() == 0)
+    if(header->has_callstack())
     {
-      m_allocation_info_table.erase(header->callstack());
-    }
+      // Postpone lock after logging to initialize the logger first ( on first access ).
+      // Logger requires the same mutex to be locked and we cannot lock the same mutex twice from the same thread.
+      const rsl::unique_lock lock(m_mem_tracking_mutex);
 
-    m_usage_per_tag[rsl::enum_refl::enum_integer(header->tag())] -= header->size().size_in_bytes();
+      auto alloc_info_it = m_allocation_info_table.find(header->callstack());
+      REX_ASSERT_X(alloc_info_it != m_allocation_info_table.end(), "tracking a deallocation which allocation didn't get tracked");
+      alloc_info_it->value.allocation_callstack.sub_size(header->size());
+
+      // add unique deleter callstacks
+      debug_vector<CallStack>& del_callstacks = alloc_info_it->value.deleter_callstacks;
+      if(rsl::find(del_callstacks.cbegin(), del_callstacks.cend(), deleter_callstack) == del_callstacks.cend())
+      {
+        del_callstacks.push_back(deleter_callstack);
+      }
+
+      if(alloc_info_it->value.allocation_callstack.size() == 0)
+      {
+        m_allocation_info_table.erase(header->callstack());
+      }
+    }
 
     rex::GlobalDebugAllocator().deallocate(header, sizeof(MemoryHeader));
   }
@@ -166,6 +248,53 @@ namespace rex
     return g_thread_local_mem_tags.current();
   }
 
+  void MemoryTracker::set_callstack_sample_rate(card32 sampleRate)
+  {
+    m_callstack_sample_rate.store(sampleRate, rsl::memory_order_relaxed);
+  }
+  card32 MemoryTracker::callstack_sample_rate() const
+  {
+    return m_callstack_sample_rate.load(rsl::memory_order_relaxed);
+  }
+
+  internal::MemoryTrackingShard& MemoryTracker::current_shard()
+  {
+    // Threads get assigned a shard round robin on their first allocation
+    if(g_thread_local_mem_tracking_shard == -1)
+    {
+      g_thread_local_mem_tracking_shard = m_next_shard.fetch_add(1, rsl::memory_order_relaxed) % g_num_mem_tracking_shards;
+    }
+
+    return m_shards[g_thread_local_mem_tracking_shard];
+  }
+
+  debug_vector<MemoryHeader*> MemoryTracker::gather_allocation_headers()
+  {
+    debug_vector<MemoryHeader*> alloc_headers;
+    for(internal::MemoryTrackingShard& shard: m_shards)
+    {
+      const rsl::unique_lock shard_lock(shard.allocation_headers_lock);
+      alloc_headers.insert(alloc_headers.end(), shard.allocation_headers.cbegin(), shard.allocation_headers.cend());
+    }
+
+    return alloc_headers;
+  }
+
+  bool MemoryTracker::should_capture_callstack()
+  {
+    const card32 sample_rate = m_callstack_sample_rate.load(rsl::memory_order_relaxed);
+    if(sample_rate == 0)
+    {
+      return false;
+    }
+    if(sample_rate == 1)
+    {
+      return true;
+    }
+
+    return m_num_callstack_candidates.fetch_add(1, rsl::memory_order_relaxed) % sample_rate == 0;
+  }
+
   void MemoryTracker::dump_stats_to_file(rsl::string_view filepath)
   {
     MemoryTrackingStats stats = current_allocation_stats();
@@ -216,13 +345,39 @@ namespace rex
 
   MemoryAllocationStats MemoryTracker::current_tracking_stats()
   {
-    const rsl::unique_lock lock(m_mem_tracking_mutex);
+    // Merge the shards into the global view
+    // The peaks of the shards are summed, the shards can peak at different times so this is an upper bound of the real peak
+    rsl::array<s64, rsl::enum_refl::enum_count<MemoryTag>()> usage_per_tag {};
+    rsl::array<s64, rsl::enum_refl::enum_count<MemoryTag>()> max_usage_per_tag {};
+    s64 mem_usage = 0;
+    s64 max_mem_usage = 0;
+    s32 num_alive_allocations = 0;
+    s32 num_total_allocations = 0;
+    for(internal::MemoryTrackingShard& shard: m_shards)
+    {
+      for(count_t tag_idx = 0; tag_idx < usage_per_tag.size(); ++tag_idx)
+      {
+        usage_per_tag[tag_idx] += shard.usage_per_tag[tag_idx].load(rsl::memory_order_relaxed);
+        max_usage_per_tag[tag_idx] += shard.max_usage_per_tag[tag_idx].load(rsl::memory_order_relaxed);
+      }
+      mem_usage += shard.used_memory.load(rsl::memory_order_relaxed);
+      max_mem_usage += shard.max_used_memory.load(rsl::memory_order_relaxed);
+      num_total_allocations += shard.num_total_allocations.load(rsl::memory_order_relaxed);
+
+      const rsl::unique_lock shard_lock(shard.allocation_headers_lock);
+      num_alive_allocations += static_cast<s32>(shard.allocation_headers.size());
+    }
+    REX_ASSERT_X(mem_usage >= 0, "Mem usage below 0");
+
     MemoryAllocationStats stats{};
-    stats.usage_per_tag = m_usage_per_tag;
-    stats.used_memory = m_mem_usage.value();
-    stats.max_used_memory = m_mem_usage.max_value();
-    stats.num_alive_allocations = m_allocation_info_table.size();
-    stats.num_total_allocations = m_num_total_allocations;
+    for(count_t tag_idx = 0; tag_idx < usage_per_tag.size(); ++tag_idx)
+    {
+      stats.usage_per_tag[tag_idx] = internal::make_high_water_mark(usage_per_tag[tag_idx], max_usage_per_tag[tag_idx]);
+    }
+    stats.used_memory = mem_usage;
+    stats.max_used_memory = rsl::max(max_mem_usage, mem_usage);
+    stats.num_alive_allocations = num_alive_allocations;
+    stats.num_total_allocations = num_total_allocations;
 
     return stats;
   }
@@ -231,7 +386,7 @@ namespace rex
   {
     MemoryTrackingStats stats {};
     stats.tracking_stats = current_tracking_stats();
-    stats.allocation_headers = m_allocation_headers;
+    stats.allocation_headers = gather_allocation_headers();
     return stats;
   }
 
@@ -247,13 +402,12 @@ namespace rex
 
   MemoryTrackingStats MemoryTracker::get_stats_for_frame(card32 idx)
   {
-    rsl::unique_lock lock(m_mem_tracking_mutex);
-    const debug_vector<MemoryHeader*> alloc_headers = m_allocation_headers; // copy here on purpose as we don't want any race conditions when looping over it
-    lock.unlock();
+    const debug_vector<MemoryHeader*> alloc_headers = gather_allocation_headers(); // copy here on purpose as we don't want any race conditions when looping over it
 
     MemoryTrackingStats stats {};
     stats.allocation_headers.reserve(alloc_headers.size());
 
+    // Headers get swapped around when they're removed, so they're not sorted by frame
     for(MemoryHeader* header: alloc_headers)
     {
       if(header->frame_index() == idx)
@@ -261,10 +415,6 @@ namespace rex
         stats.allocation_headers.push_back(header);
         stats.tracking_stats.usage_per_tag[rsl::enum_refl::enum_integer(header->tag())] += header->size();
       }
-      else if(header->frame_index() > idx)
-      {
-        break;
-      }
     }
 
     return stats;
@@ -0,0 +1,116 @@
+#include "rex_engine/memory/virtual_arena.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/memory/pointer_math.h"
+#include "rex_engine/memory/virtual_memory.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/utility.h"
+
+namespace rex
+{
+  VirtualArena::VirtualArena(s64 reserveSize)
+    : m_base(nullptr)
+    , m_reserved_size(align(reserveSize, static_cast<card32>(vmem::allocation_granularity())))
+    , m_committed_size(0)
+  {
+    REX_ASSERT_X(reserveSize > 0, "A virtual arena needs to reserve at least 1 byte");
+
+    m_base = static_cast<rsl::byte*>(vmem::reserve(m_reserved_size));
+    REX_ASSERT_X(m_base != nullptr, "Failed to reserve virtual memory for an arena. size: {}", m_reserved_size);
+    if (m_base == nullptr)
+    {
+      m_reserved_size = 0;
+    }
+  }
+
+  VirtualArena::VirtualArena(VirtualArena&& other)
+    : m_base(rsl::exchange(other.m_base, nullptr))
+    , m_reserved_size(rsl::exchange(other.m_reserved_size, 0))
+    , m_committed_size(rsl::exchange(other.m_committed_size, 0))
+  {
+  }
+
+  VirtualArena::~VirtualArena()
+  {
+    release();
+  }
+
+  VirtualArena& VirtualArena::operator=(VirtualArena&& other)
+  {
+    if (this != &other)
+    {
+      release();
+      m_base = rsl::exchange(other.m_base, nullptr);
+      m_reserved_size = rsl::exchange(other.m_reserved_size, 0);
+      m_committed_size = rsl::exchange(other.m_committed_size, 0);
+    }
+    return *this;
+  }
+
+  bool VirtualArena::commit_up_to(s64 size)
+  {
+    if (size <= m_committed_size)
+    {
+      return true;
+    }
+    if (size > m_reserved_size)
+    {
+      return false;
+    }
+
+    // Commit a bit more than asked for, so growing the arena byte by byte doesn't commit every page separately
+    const s64 page_size = vmem::page_size();
+    const s64 min_commit_size = m_committed_size + rsl::max(g_virtual_arena_commit_size, page_size);
+    const s64 new_committed_size = rsl::min(align(rsl::max(size, min_commit_size), static_cast<card32>(page_size)), m_reserved_size);
+
+    if (!vmem::commit(m_base + m_committed_size, new_committed_size - m_committed_size))
+    {
+      return false;
+    }
+
+    m_committed_size = new_committed_size;
+    return true;
+  }
+
+  void VirtualArena::decommit_after(s64 size)
+  {
+    const s64 new_committed_size = align(rsl::max(size, static_cast<s64>(0)), static_cast<card32>(vmem::page_size()));
+    if (new_committed_size >= m_committed_size)
+    {
+      return;
+    }
+
+    vmem::decommit(m_base + new_committed_size, m_committed_size - new_committed_size);
+    m_committed_size = new_committed_size;
+  }
+
+  rsl::byte* VirtualArena::base() const
+  {
+    return m_base;
+  }
+  s64 VirtualArena::reserved_size() const
+  {
+    return m_reserved_size;
+  }
+  s64 VirtualArena::committed_size() const
+  {
+    return m_committed_size;
+  }
+
+  bool VirtualArena::is_committed(const void* ptr) const
+  {
+    const rsl::byte* ptr_as_bytes = static_cast<const rsl::byte*>(ptr);
+    return ptr_as_bytes >= m_base && ptr_as_bytes < m_base + m_committed_size;
+  }
+
+  void VirtualArena::release()
+  {
+    if (m_base != nullptr)
+    {
+      vmem::release(m_base, m_reserved_size);
+      m_base = nullptr;
+      m_reserved_size = 0;
+      m_committed_size = 0;
+    }
+  }
+} // namespace rex
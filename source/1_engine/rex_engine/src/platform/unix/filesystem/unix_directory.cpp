@@ -0,0 +1,472 @@
+#include "rex_engine/filesystem/directory.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/path.h"
+#include "rex_std/bonus/utility/output_param.h"
+#include "rex_std/cstring.h"
+
+// NOLINTBEGIN(llvm-include-order)
+// clang-format off
+#include <cerrno>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// clang-format on
+// NOLINTEND(llvm-include-order)
+
+namespace rex
+{
+  namespace directory
+  {
+    DEFINE_LOG_CATEGORY(LogDirectory);
+
+    namespace internal
+    {
+      enum class EntryType
+      {
+        Any,
+        File,
+        Directory
+      };
+
+      // Return the names of the entries directly under a directory, "." and ".." are skipped
+      // When filtering, the type of symlinks is the type of what they point to
+      rsl::vector<rsl::string> entry_names(rsl::string_view path, EntryType type)
+      {
+        const path_stack_string dirpath(path);
+        DIR* dir = opendir(dirpath.data());
+        if (dir == nullptr)
+        {
+          return {};
+        }
+
+        rsl::vector<rsl::string> names;
+        path_stack_string fullpath;
+        for (const dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+        {
+          const rsl::string_view name(entry->d_name, static_cast<s32>(rsl::strlen(entry->d_name)));
+          if (name == "." || name == "..")
+          {
+            continue;
+          }
+
+          if (type != EntryType::Any)
+          {
+            fullpath.clear();
+            path::join_to(fullpath, path, name);
+
+            struct stat entry_stat {};
+            if (stat(fullpath.data(), &entry_stat) != 0 || S_ISDIR(entry_stat.st_mode) != (type == EntryType::Directory))
+            {
+              continue;
+            }
+          }
+
+          names.push_back(rsl::string(name));
+        }
+
+        closedir(dir);
+        return names;
+      }
+
+      void list_entries(rsl::string_view root, rsl::string_view path, Recursive goRecursive, rsl::Out<rsl::vector<rsl::string>> outResult)
+      {
+        // We need to store paths as a string and not a scratch string
+        // as for recursive lookups, these can go quite deep
+        // and possibly overflow the scratch buffer
+        rsl::string fullpath;
+        path::join_to(fullpath, root, path);
+
+        rsl::vector<rsl::string> dirs;
+        if (goRecursive)
+        {
+          dirs = entry_names(fullpath, EntryType::Directory);
+        }
+
+        // We want to store paths that are relative from the root
+        for (const rsl::string_view name : entry_names(fullpath, EntryType::Any))
+        {
+          outResult.get().push_back(path.empty() ? rsl::string(name) : rsl::string(path::join(path, name)));
+        }
+
+        for (const rsl::string_view dir : dirs)
+        {
+          const rsl::string subpath(path.empty() ? rsl::string(dir) : rsl::string(path::join(path, dir)));
+          list_entries(root, subpath, goRecursive, outResult);
+        }
+      }
+
+      bool is_dir(rsl::string_view path)
+      {
+        const path_stack_string fullpath(path);
+        struct stat dir_stat {};
+        return stat(fullpath.data(), &dir_stat) == 0 && S_ISDIR(dir_stat.st_mode);
+      }
+
+      Error del_no_checks(rsl::string_view path)
+      {
+        const path_stack_string fullpath(path);
+        const bool success = rmdir(fullpath.data()) == 0;
+
+        return success
+          ? Error::no_error()
+          : Error::create_with_log(LogDirectory, "Failed to delete directory at \"{}\"", path);
+      }
+
+      rsl::time_point to_timepoint(const timespec& time)
+      {
+        // rsl can only build a time point from a Windows system time at the moment
+        // until it can build one from a unix timestamp, directory times are unknown on unix
+        REX_UNUSED_PARAM(time);
+        return rsl::time_point();
+      }
+    } // namespace internal
+
+    // Create a new directory
+    Error create(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return create_abspath(path);
+    }
+    // Create a directory recursively, creating all sub directories until the leaf dir
+    Error create_recursive(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return create_recursive_abspath(path);
+    }
+    // Delete a directory
+    Error del(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return del_abspath(path);
+    }
+    // Delete a directory recursively, including all files and sub folders
+    Error del_recursive(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return del_recursive_abspath(path);
+    }
+    // Return if a directory exists
+    bool exists(rsl::string_view path)
+    {
+      // We need to validate the path first
+      // otherwise the abs_path conversion won't create an abspath
+      // and then we trigger an assert further below
+      if (!path::is_valid_path(path))
+      {
+        return false;
+      }
+
+      path = path::unsafe_abs_path(path);
+
+      return exists_abspath(path);
+    }
+    // Copy a directory and its content
+    Error copy(rsl::string_view src, rsl::string_view dst) // NOLINT(misc-no-recursion)
+    {
+      src = path::unsafe_abs_path(src);
+      dst = path::unsafe_abs_path(dst);
+
+      return copy_abspath(src, dst);
+    }
+    // Move/Rename a directory
+    Error move(rsl::string_view src, rsl::string_view dst)
+    {
+      src = path::unsafe_abs_path(src);
+      dst = path::unsafe_abs_path(dst);
+
+      return move_abspath(src, dst);
+    }
+
+    // Returns true if the directory is empty,
+    // as in, it has no files or directories
+    bool is_empty(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      // If the path doesn't exist, we pretend that the directory is empty
+      return internal::entry_names(path, internal::EntryType::Any).empty();
+    }
+
+    // List the number of entries under a directory
+    s32 num_entries(rsl::string_view path, Recursive goRecursive)
+    {
+      return static_cast<s32>(list_entries(path, goRecursive).size());
+    }
+    // List the number of directories under a directory
+    s32 num_dirs(rsl::string_view path)
+    {
+      return static_cast<s32>(list_dirs(path).size());
+    }
+    // List the number of files under a directory
+    s32 num_files(rsl::string_view path)
+    {
+      return static_cast<s32>(list_files(path).size());
+    }
+
+    // List all entries under a directory
+    rsl::vector<rsl::string> list_entries(rsl::string_view path, Recursive goRecursive)
+    {
+      rsl::vector<rsl::string> result;
+
+      // We do this through a function taking in a output parameter
+      // as it can massively improve performance due to less copying of strings
+      // and less allocations as well
+      const rsl::string abs_root(path::abs_path(path));
+      internal::list_entries(abs_root, "", goRecursive, rsl::Out(result));
+
+      return result;
+    }
+    // List all directories under a directory
+    rsl::vector<rsl::string> list_dirs(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return internal::entry_names(path, internal::EntryType::Directory);
+    }
+    // List all files under a directory
+    rsl::vector<rsl::string> list_files(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return internal::entry_names(path, internal::EntryType::File);
+    }
+
+    // Return the creation time of a directory
+    rsl::time_point creation_time(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return creation_time_abspath(path);
+    }
+    // Return the access time of a directory
+    rsl::time_point access_time(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return access_time_abspath(path);
+    }
+    // Return the modification time of a directory
+    rsl::time_point modification_time(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return modification_time_abspath(path);
+    }
+
+    // ------------------------------------------------------------------------------
+    //                          ABSOLUTE PATH IMPLEMENTATIONS
+    // ------------------------------------------------------------------------------
+
+    // Create a new directory
+    Error create_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (!rex::path::is_valid_path(path))
+      {
+        return Error::create_with_log(LogDirectory, "Cannot create directory \"{}\" as it's an invalid path", path);
+      }
+
+      if (exists_abspath(path))
+      {
+        return Error::create_with_log(LogDirectory, "Cannot create directory \"{}\" as it already exists", path);
+      }
+
+      const path_stack_string fullpath(path);
+      const bool success = mkdir(fullpath.data(), 0755) == 0; // rwxr-xr-x
+
+      return success
+        ? Error::no_error()
+        : Error::create_with_log(LogDirectory, "Failed to create directory at \"{}\"", path);
+    }
+    // Create a directory recursively, creating all sub directories until the leaf dir
+    Error create_recursive_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (exists_abspath(path))
+      {
+        return Error::no_error();
+      }
+
+      // Create every parent directory, starting from the root
+      path_stack_string to_create;
+      for (s32 idx = 1; idx <= path.length(); ++idx)
+      {
+        if (idx != path.length() && path[idx] != '/')
+        {
+          continue;
+        }
+
+        to_create.assign(path.substr(0, idx));
+        if (mkdir(to_create.data(), 0755) != 0 && errno != EEXIST) // rwxr-xr-x
+        {
+          return Error::create_with_log(LogDirectory, "Failed to create directory at \"{}\"", to_create);
+        }
+      }
+
+      return Error::no_error();
+    }
+    // Delete a directory, it's expected to be empty
+    Error del_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (!is_empty(path))
+      {
+        return Error::create_with_log(LogDirectory, "Failed to delete directory as it wasn't empty. Directory: \"{}\"", path);
+      }
+
+      return internal::del_no_checks(path);
+    }
+    // Delete a directory recursively, including all files and sub folders
+    Error del_recursive_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      Error error = Error::no_error();
+
+      path_stack_string full_path;
+      rsl::vector<rsl::string> dirs = list_dirs(path);
+      for (rsl::string_view dir : dirs)
+      {
+        full_path.clear();
+        path::join_to(full_path, path, dir);
+        error = del_recursive_abspath(full_path);
+        if (error)
+        {
+          return Error::create_with_log(LogDirectory, "Failed to recursively delete \"{}\"", path);
+        }
+      }
+
+      rsl::vector<rsl::string> files = list_files(path);
+      for (rsl::string_view file : files)
+      {
+        full_path.clear();
+        path::join_to(full_path, path, file);
+        error = file::del_abspath(full_path);
+        if (error)
+        {
+          return Error::create_with_log(LogDirectory, "Failed to recursively delete \"{}\"", path);
+        }
+      }
+
+      return internal::del_no_checks(path);
+    }
+    // Return if a directory exists
+    bool exists_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      return internal::is_dir(path);
+    }
+    // Copy a directory and its content
+    Error copy_abspath(rsl::string_view src, rsl::string_view dst)
+    {
+      REX_ASSERT_X(path::is_absolute(src), "argument is expected to be absolute here: {}", src);
+      REX_ASSERT_X(path::is_absolute(dst), "argument is expected to be absolute here: {}", dst);
+
+      const rsl::vector<rsl::string> all_files = list_files(src);
+      const rsl::vector<rsl::string> all_dirs  = list_dirs(src);
+
+      Error error = create_abspath(dst);
+      if (error)
+      {
+        return error;
+      }
+
+      for (const rsl::string_view file_entry : all_files)
+      {
+        const scratch_string entry_src = path::join(src, file_entry);
+        const scratch_string entry_dst = path::join(dst, file_entry);
+        error = file::copy_abspath(entry_src, entry_dst);
+        if (error)
+        {
+          return error;
+        }
+      }
+
+      for (const rsl::string_view dir_entry : all_dirs)
+      {
+        const scratch_string entry_src = path::join(src, dir_entry);
+        const scratch_string entry_dst = path::join(dst, dir_entry);
+        error = copy_abspath(entry_src, entry_dst);
+        if (error)
+        {
+          return error;
+        }
+      }
+
+      return Error::no_error();
+    }
+    // Move/Rename a directory
+    Error move_abspath(rsl::string_view src, rsl::string_view dst)
+    {
+      REX_ASSERT_X(path::is_absolute(src), "argument is expected to be absolute here: {}", src);
+      REX_ASSERT_X(path::is_absolute(dst), "argument is expected to be absolute here: {}", dst);
+
+      const path_stack_string src_path(src);
+      const path_stack_string dst_path(dst);
+      const bool success = rename(src_path.data(), dst_path.data()) == 0;
+
+      return success
+        ? Error::no_error()
+        : Error::create_with_log(LogDirectory, "Failed to move directory from \"{}\" to \"{}\"", src, dst);
+    }
+
+    // Return the creation time of a directory
+    rsl::time_point creation_time_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      // When the directory can't be found, we return 0
+      const path_stack_string fullpath(path);
+      struct stat dir_stat {};
+      if (stat(fullpath.data(), &dir_stat) != 0)
+      {
+        return rsl::time_point();
+      }
+
+      // stat doesn't know when a directory got created, the last status change is the closest
+      return internal::to_timepoint(dir_stat.st_ctim);
+    }
+    // Return the access time of a directory
+    rsl::time_point access_time_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      // When the directory can't be found, we return 0
+      const path_stack_string fullpath(path);
+      struct stat dir_stat {};
+      if (stat(fullpath.data(), &dir_stat) != 0)
+      {
+        return rsl::time_point();
+      }
+
+      return internal::to_timepoint(dir_stat.st_atim);
+    }
+    // Return the modification time of a directory
+    rsl::time_point modification_time_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      // When the directory can't be found, we return 0
+      const path_stack_string fullpath(path);
+      struct stat dir_stat {};
+      if (stat(fullpath.data(), &dir_stat) != 0)
+      {
+        return rsl::time_point();
+      }
+
+      return internal::to_timepoint(dir_stat.st_mtim);
+    }
+
+  } // namespace directory
+} // namespace rex
@@ -0,0 +1,924 @@
+#include "rex_engine/filesystem/file.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/filesystem/path.h"
+#include "rex_engine/platform/unix/filesystem/unix_io_ring.h"
+#include "rex_engine/text_processing/text_processing.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
+
+// NOLINTBEGIN(llvm-include-order)
+// clang-format off
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// clang-format on
+// NOLINTEND(llvm-include-order)
+
+namespace rex
+{
+  namespace file
+  {
+    DEFINE_LOG_CATEGORY(LogFile);
+
+    namespace internal
+    {
+      // Linux never reads or writes more than this in a single call, bigger files are read in chunks
+      inline constexpr s64 g_max_io_size = 1024_mib;
+
+      // Closes the file descriptor when it goes out of scope
+      class ScopedFd
+      {
+      public:
+        explicit ScopedFd(s32 fd)
+          : m_fd(fd)
+        {
+        }
+        ScopedFd(const ScopedFd&) = delete;
+        ScopedFd(ScopedFd&&) = delete;
+        ~ScopedFd()
+        {
+          if (is_valid())
+          {
+            close(m_fd);
+          }
+        }
+
+        ScopedFd& operator=(const ScopedFd&) = delete;
+        ScopedFd& operator=(ScopedFd&&) = delete;
+
+        bool is_valid() const
+        {
+          return m_fd >= 0;
+        }
+        s32 get() const
+        {
+          return m_fd;
+        }
+
+      private:
+        s32 m_fd;
+      };
+
+      s32 open_file(rsl::string_view path, s32 flags)
+      {
+        const s32 mode = 0644; // rw-r--r--, only used when the file gets created
+        s32 fd         = -1;
+        do // NOLINT(cppcoreguidelines-avoid-do-while)
+        {
+          fd = open(path.data(), flags | O_CLOEXEC, mode);
+        } while (fd < 0 && errno == EINTR);
+
+        return fd;
+      }
+
+      // Read until the buffer is full or the end of the file is reached
+      // Returns the number of bytes read or -1 on error
+      s64 pread_all(s32 fd, rsl::byte* buffer, s64 size, s64 offset)
+      {
+        s64 num_bytes_read = 0;
+        while (num_bytes_read < size)
+        {
+          const s64 chunk_size = rsl::min(size - num_bytes_read, g_max_io_size);
+          const ssize_t res    = pread(fd, buffer + num_bytes_read, static_cast<size_t>(chunk_size), offset + num_bytes_read);
+          if (res < 0)
+          {
+            if (errno == EINTR)
+            {
+              continue;
+            }
+            return -1;
+          }
+          if (res == 0)
+          {
+            break;
+          }
+
+          num_bytes_read += res;
+        }
+
+        return num_bytes_read;
+      }
+
+      bool write_all(s32 fd, const void* data, s64 size)
+      {
+        const rsl::byte* bytes = static_cast<const rsl::byte*>(data);
+        s64 num_bytes_written  = 0;
+        while (num_bytes_written < size)
+        {
+          const s64 chunk_size = rsl::min(size - num_bytes_written, g_max_io_size);
+          const ssize_t res    = write(fd, bytes + num_bytes_written, static_cast<size_t>(chunk_size));
+          if (res < 0)
+          {
+            if (errno == EINTR)
+            {
+              continue;
+            }
+            return false;
+          }
+
+          num_bytes_written += res;
+        }
+
+        return true;
+      }
+
+      Error append_to_file(rsl::string_view path, const rsl::vector<rsl::string_view>& texts)
+      {
+        const ScopedFd fd(open_file(path, O_WRONLY | O_CREAT | O_APPEND));
+        if (!fd.is_valid())
+        {
+          return Error::create_with_log(LogFile, "Cannot append to file \"{}\" as it can't be opened. errno: {}", path, errno);
+        }
+
+        for (const rsl::string_view text : texts)
+        {
+          if (!write_all(fd.get(), text.data(), text.length()))
+          {
+            return Error::create_with_log(LogFile, "Failed to append to \"{}\". errno: {}", path, errno);
+          }
+        }
+
+        return Error::no_error();
+      }
+
+      bool stat_path(rsl::string_view path, struct stat& outStat)
+      {
+        return stat(path.data(), &outStat) == 0;
+      }
+
+      rsl::time_point to_timepoint(const timespec& time)
+      {
+        // rsl can only build a time point from a Windows system time at the moment
+        // until it can build one from a unix timestamp, file times are unknown on unix
+        REX_UNUSED_PARAM(time);
+        return rsl::time_point();
+      }
+
+      Error copy_abspath_no_checks(rsl::string_view src, rsl::string_view dst)
+      {
+        const ScopedFd src_fd(open_file(src, O_RDONLY));
+        struct stat src_stat {};
+        if (!src_fd.is_valid() || fstat(src_fd.get(), &src_stat) != 0)
+        {
+          return Error::create_with_log(LogFile, "cannot copy \"{}\" to \"{}\" as the source can't be opened", src, dst);
+        }
+
+        const ScopedFd dst_fd(open_file(dst, O_WRONLY | O_CREAT | O_TRUNC));
+        if (!dst_fd.is_valid())
+        {
+          return Error::create_with_log(LogFile, "cannot copy \"{}\" to \"{}\" as the destination can't be opened", src, dst);
+        }
+
+        // The kernel copies the data directly, without going through user space
+        s64 num_bytes_copied = 0;
+        while (num_bytes_copied < src_stat.st_size)
+        {
+          const ssize_t res = sendfile(dst_fd.get(), src_fd.get(), nullptr, static_cast<size_t>(rsl::min(static_cast<s64>(src_stat.st_size) - num_bytes_copied, g_max_io_size)));
+          if (res < 0 && errno == EINTR)
+          {
+            continue;
+          }
+          if (res <= 0)
+          {
+            return Error::create_with_log(LogFile, "cannot copy \"{}\" to \"{}\". errno: {}", src, dst, errno);
+          }
+
+          num_bytes_copied += res;
+        }
+
+        return Error::no_error();
+      }
+
+      Error move_abspath_no_checks(rsl::string_view src, rsl::string_view dst)
+      {
+        const bool success = rename(src.data(), dst.data()) == 0;
+
+        return success
+          ? Error::no_error()
+          : Error::create_with_log(LogFile, "cannot move \"{}\" to \"{}\"", src, dst);
+      }
+
+      // A file that's read as part of a batch
+      struct BatchedRead
+      {
+        s32 fd;
+        rsl::unique_array<rsl::byte> buffer;
+        s64 size;
+        s64 num_bytes_read;
+        bool has_failed;
+      };
+
+      bool needs_reading(const BatchedRead& read)
+      {
+        return !read.has_failed && read.num_bytes_read < read.size;
+      }
+
+      void queue_batched_read(IoRing& ring, const BatchedRead& read, u64 readIdx)
+      {
+        // Files are read straight into the buffer of their blob, so they never need to be copied
+        const s32 size = static_cast<s32>(rsl::min(read.size - read.num_bytes_read, g_max_io_size));
+        ring.queue_read(read.fd, read.buffer.get() + read.num_bytes_read, size, read.num_bytes_read, readIdx);
+      }
+
+      // Process the completion of a read, returns true if the file needs more reading
+      bool complete_batched_read(rsl::string_view path, BatchedRead& read, s32 result)
+      {
+        if (result == -EINTR || result == -EAGAIN)
+        {
+          return true;
+        }
+        if (result < 0)
+        {
+          REX_ERROR(LogFile, "Failed to read file {}. errno: {}", quoted(path), -result);
+          read.has_failed = true;
+          return false;
+        }
+        if (result == 0)
+        {
+          REX_ERROR(LogFile, "File {} got smaller while it was read", quoted(path));
+          read.has_failed = true;
+          return false;
+        }
+
+        read.num_bytes_read += result;
+        return read.num_bytes_read < read.size;
+      }
+
+      // Read all files through the io ring
+      // As many reads as fit on the ring are submitted at once, the ring is topped up again as reads complete
+      // Returns false if the ring stopped working, the reads that didn't finish need to be read some other way
+      bool read_with_io_ring(IoRing& ring, const rsl::vector<rsl::string_view>& paths, rsl::vector<BatchedRead>& reads)
+      {
+        rsl::vector<u64> reads_to_continue;
+        count_t next_read = 0;
+        s32 num_in_flight = 0;
+        while (true)
+        {
+          while (ring.num_free_entries() > 0)
+          {
+            while (next_read < reads.size() && !needs_reading(reads[next_read]))
+            {
+              ++next_read;
+            }
+
+            u64 read_idx = 0;
+            if (!reads_to_continue.empty())
+            {
+              read_idx = reads_to_continue.back();
+              reads_to_continue.pop_back();
+            }
+            else if (next_read < reads.size())
+            {
+              read_idx = next_read;
+              ++next_read;
+            }
+            else
+            {
+              break;
+            }
+
+            queue_batched_read(ring, reads[read_idx], read_idx);
+            ++num_in_flight;
+          }
+
+          if (num_in_flight == 0)
+          {
+            return true;
+          }
+
+          // Everything that's queued goes to the kernel in one syscall
+          // When that fails, the ring can't be trusted anymore and the unfinished reads are done again by the caller
+          // The reads in flight are discarded first, or the next batch on this thread would receive their completions
+          if (!ring.submit_and_wait(1))
+          {
+            ring.discard_reads();
+            return false;
+          }
+
+          IoRingCompletion completion {};
+          while (ring.pop_completion(completion))
+          {
+            --num_in_flight;
+            if (complete_batched_read(paths[completion.user_data], reads[completion.user_data], completion.result))
+            {
+              reads_to_continue.push_back(completion.user_data);
+            }
+          }
+        }
+      }
+
+      // Read all files with blocking reads, used when io_uring isn't available
+      // Batches are read by the vfs io workers, which makes them the pread thread pool
+      void read_with_pread(const rsl::vector<rsl::string_view>& paths, rsl::vector<BatchedRead>& reads)
+      {
+        for (count_t idx = 0; idx < reads.size(); ++idx)
+        {
+          BatchedRead& read = reads[idx];
+          if (!needs_reading(read))
+          {
+            continue;
+          }
+
+          const s64 num_bytes_read = pread_all(read.fd, read.buffer.get() + read.num_bytes_read, read.size - read.num_bytes_read, read.num_bytes_read);
+          if (num_bytes_read < 0 || read.num_bytes_read + num_bytes_read != read.size)
+          {
+            REX_ERROR(LogFile, "Failed to read file {}. errno: {}", quoted(paths[idx]), errno);
+            read.has_failed = true;
+            continue;
+          }
+
+          read.num_bytes_read += num_bytes_read;
+        }
+      }
+
+      void unmap_file(const rsl::byte* data, rsl::memory_size size, void* nativeHandle)
+      {
+        // mappings on unix don't need any handle to be released
+        REX_UNUSED_PARAM(nativeHandle);
+        munmap(const_cast<rsl::byte*>(data), static_cast<size_t>(size)); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+      }
+    } // namespace internal
+
+    // Read from a file
+    memory::Blob read_file(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return read_file_abspath(path);
+    }
+    // Read from a file
+    s32 read_file(rsl::string_view path, rsl::byte* buffer, s64 size)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return read_file_abspath(path, buffer, size);
+    }
+    // Map a file into memory
+    MappedFile map_file(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return map_file_abspath(path);
+    }
+    // Save content to a file
+    Error write_to_file(rsl::string_view path, const void* data, card64 size)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return write_to_file_abspath(path, data, size);
+    }
+    Error append_line(rsl::string_view path, rsl::string_view line)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return append_line_abspath(path, line);
+    }
+
+    // Append lines to a file
+    Error append_lines(rsl::string_view path, const rsl::vector<rsl::string>& lines)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return append_lines_abspath(path, lines);
+    }
+    // Append text to a file
+    Error append_text(rsl::string_view path, rsl::string_view txt)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return append_text_abspath(path, txt);
+    }
+    // Trunc a file, removing all content
+    Error trunc(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return trunc_abspath(path);
+    }
+    // Copy a file, overwiting an existing one is possible
+    Error copy(rsl::string_view src, rsl::string_view dst, OverwriteIfExist overwriteIfExist)
+    {
+      if (src == dst)
+      {
+        return Error::create_with_log(LogFile, "Cannot copy a file to itself");
+      }
+
+      dst = path::unsafe_abs_path(dst);
+      if (!overwriteIfExist && file::exists_abspath(dst))
+      {
+        return Error::create_with_log(LogFile, "Cannot copy to a file that already exists if overwriting is disabled");
+      }
+
+      src = path::unsafe_abs_path(src);
+      return internal::copy_abspath_no_checks(src, dst);
+    }
+    // Move/Rename a file, overwriting an existing one is possible
+    Error move(rsl::string_view src, rsl::string_view dst)
+    {
+      if (src == dst)
+      {
+        return Error::create_with_log(LogFile, "Cannot move a file to itself");
+      }
+
+      dst = path::unsafe_abs_path(dst);
+      src = path::unsafe_abs_path(src);
+
+      if (file::exists_abspath(dst))
+      {
+        return Error::create_with_log(LogFile, "Cannot move to \"{}\", file already exists", dst);
+      }
+
+      return internal::move_abspath_no_checks(src, dst);
+    }
+    // Create a new empty file
+    Error create(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return create_abspath(path);
+    }
+    // Delete a file
+    Error del(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return del_abspath(path);
+    }
+    // return the file size
+    card64 size(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return size_abspath(path);
+    }
+    // Check if a file exists
+    bool exists(rsl::string_view path)
+    {
+      // We need to validate the path first
+      // otherwise the abs_path conversion won't create an abspath
+      // and then we trigger an assert further below
+      if (!path::is_valid_path(path))
+      {
+        return false;
+      }
+
+      path = path::unsafe_abs_path(path);
+
+      return exists_abspath(path);
+    }
+    // Check if a file is marked read only
+    bool is_readonly(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return is_readonly_abspath(path);
+    }
+    // Set a file to be readonly
+    Error set_readonly(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return set_readonly_abspath(path);
+    }
+    // Remove the readonly flag of a file
+    Error remove_readonly(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return remove_readonly_abspath(path);
+    }
+    // Return the creation time of a file
+    rsl::time_point creation_time(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return creation_time_abspath(path);
+    }
+    // Return the access time of a file
+    rsl::time_point access_time(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return access_time_abspath(path);
+    }
+    // Return the modification time of a file
+    rsl::time_point modification_time(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return modification_time_abspath(path);
+    }
+
+    // Read from a file
+    memory::Blob read_file_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      const internal::ScopedFd fd(internal::open_file(path, O_RDONLY));
+      struct stat file_stat {};
+      if (!fd.is_valid() || fstat(fd.get(), &file_stat) != 0 || S_ISDIR(file_stat.st_mode))
+      {
+        REX_ERROR(LogFile, "Failed to open file {}", quoted(path));
+        return {};
+      }
+
+      // prepare a buffer to receive the file content
+      // early return if the file is empty
+      if (file_stat.st_size <= 0)
+      {
+        return {};
+      }
+
+      rsl::unique_array<rsl::byte> buffer = rsl::make_unique<rsl::byte[]>(file_stat.st_size); // NOLINT(modernize-avoid-c-arrays)
+
+      // actually read the file
+      const s64 num_bytes_read = internal::pread_all(fd.get(), buffer.get(), file_stat.st_size, 0);
+      if (num_bytes_read != file_stat.st_size)
+      {
+        REX_ERROR(LogFile, "Failed to read file {}. errno: {}", quoted(path), errno);
+        return {};
+      }
+
+      // return the buffer
+      return memory::Blob(rsl::move(buffer));
+    }
+    // Read from a file, returns number of bytes read
+    s32 read_file_abspath(rsl::string_view path, rsl::byte* buffer, s64 size)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      const internal::ScopedFd fd(internal::open_file(path, O_RDONLY));
+      struct stat file_stat {};
+      if (!fd.is_valid() || fstat(fd.get(), &file_stat) != 0 || S_ISDIR(file_stat.st_mode))
+      {
+        REX_ERROR(LogFile, "Failed to open file {}", quoted(path));
+        return 0;
+      }
+
+      if (file_stat.st_size > size)
+      {
+        REX_ERROR(LogFile, "Buffer not big enough to store entire file. file: {} buffer size: {} file size: {}", quoted(path), size, file_stat.st_size);
+      }
+
+      // actually read the file
+      const s64 num_bytes_read = internal::pread_all(fd.get(), buffer, rsl::min(size, static_cast<s64>(file_stat.st_size)), 0);
+      return num_bytes_read < 0 ? 0 : static_cast<s32>(num_bytes_read);
+    }
+    // Returns true if read_files_abspath reads the files of a batch together on the calling thread
+    bool supports_batched_reads()
+    {
+      // Without io_uring, the files of a batch are read one by one with pread
+      return internal::thread_io_ring() != nullptr;
+    }
+    // Read multiple files at once, the blobs are returned in the same order as the paths
+    rsl::vector<memory::Blob> read_files_abspath(const rsl::vector<rsl::string_view>& paths)
+    {
+      rsl::vector<internal::BatchedRead> reads;
+      reads.reserve(paths.size());
+      for (const rsl::string_view path : paths)
+      {
+        REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+        reads.emplace_back();
+        internal::BatchedRead& read = reads.back();
+        read.fd                     = internal::open_file(path, O_RDONLY);
+
+        struct stat file_stat {};
+        if (read.fd < 0 || fstat(read.fd, &file_stat) != 0 || S_ISDIR(file_stat.st_mode))
+        {
+          REX_ERROR(LogFile, "Failed to open file {}", quoted(path));
+          read.has_failed = true;
+          continue;
+        }
+
+        read.size = file_stat.st_size;
+        if (read.size > 0)
+        {
+          read.buffer = rsl::make_unique<rsl::byte[]>(read.size); // NOLINT(modernize-avoid-c-arrays)
+        }
+      }
+
+      // All files are read in as few syscalls as possible through io_uring
+      // if that's not available, they're read one by one
+      internal::IoRing* ring = internal::thread_io_ring();
+      if (ring == nullptr || !internal::read_with_io_ring(*ring, paths, reads))
+      {
+        internal::read_with_pread(paths, reads);
+      }
+
+      rsl::vector<memory::Blob> blobs;
+      blobs.reserve(reads.size());
+      for (internal::BatchedRead& read : reads)
+      {
+        if (read.fd >= 0)
+        {
+          close(read.fd);
+        }
+
+        blobs.push_back(read.has_failed || read.size == 0 ? memory::Blob() : memory::Blob(rsl::move(read.buffer)));
+      }
+
+      return blobs;
+    }
+    // Map a file into memory
+    MappedFile map_file_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      const internal::ScopedFd fd(internal::open_file(path, O_RDONLY));
+      struct stat file_stat {};
+      if (!fd.is_valid() || fstat(fd.get(), &file_stat) != 0 || S_ISDIR(file_stat.st_mode))
+      {
+        REX_ERROR(LogFile, "Failed to open file {}", quoted(path));
+        return {};
+      }
+
+      // mmap doesn't accept empty ranges
+      if (file_stat.st_size <= 0)
+      {
+        return {};
+      }
+
+      // The mapping keeps its own reference to the file, so the descriptor can be closed straight away
+      void* mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd.get(), 0);
+      if (mapping == MAP_FAILED) // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+      {
+        REX_WARN(LogFile, "Failed to map file {}, reading it instead. errno: {}", quoted(path), errno);
+        return MappedFile(read_file_abspath(path));
+      }
+
+      return MappedFile(static_cast<const rsl::byte*>(mapping), rsl::memory_size(static_cast<card64>(file_stat.st_size)), nullptr);
+    }
+    // Save content to a file
+    Error write_to_file_abspath(rsl::string_view path, const void* data, card64 size)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (is_readonly_abspath(path))
+      {
+        return Error::create_with_log(LogFile, "File \"{}\" is read only. Cannot write to it", path);
+      }
+
+      const internal::ScopedFd fd(internal::open_file(path, O_WRONLY | O_CREAT | O_TRUNC));
+
+      // make sure the handle is valid
+      if (!fd.is_valid())
+      {
+        return Error::create_with_log(LogFile, "Failed to open file at \"{}\"", path);
+      }
+
+      const bool success = internal::write_all(fd.get(), data, static_cast<s64>(size));
+
+      return success
+        ? Error::no_error()
+        : Error::create_with_log(LogFile, "Failed to write to \"{}\"", path);
+    }
+    // Append a single line to a file
+    Error append_line_abspath(rsl::string_view path, rsl::string_view line)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (is_readonly_abspath(path))
+      {
+        return Error::create_with_log(LogFile, "File \"{}\" is read only. Cannot append lines", path);
+      }
+
+      rsl::vector<rsl::string_view> texts;
+      texts.push_back(line);
+      texts.push_back(rex::endline());
+      return internal::append_to_file(path, texts);
+    }
+    // Append lines to a file
+    Error append_lines_abspath(rsl::string_view path, const rsl::vector<rsl::string>& lines)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (is_readonly_abspath(path))
+      {
+        return Error::create_with_log(LogFile, "File \"{}\" is read only. Cannot append lines", path);
+      }
+
+      rsl::vector<rsl::string_view> texts;
+      texts.reserve(lines.size() * 2);
+      for (const rsl::string_view line : lines)
+      {
+        texts.push_back(line);
+        texts.push_back(rex::endline());
+      }
+      return internal::append_to_file(path, texts);
+    }
+    // Append text to a file
+    Error append_text_abspath(rsl::string_view path, rsl::string_view txt)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (is_readonly_abspath(path))
+      {
+        return Error::create_with_log(LogFile, "File \"{}\" is read only. Cannot append lines", path);
+      }
+
+      rsl::vector<rsl::string_view> texts;
+      texts.push_back(txt);
+      return internal::append_to_file(path, texts);
+    }
+    // Trunc a file, removing all content
+    Error trunc_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (is_readonly_abspath(path))
+      {
+        return Error::create_with_log(LogFile, "File \"{}\" is read only. Cannot append lines", path);
+      }
+
+      const internal::ScopedFd fd(internal::open_file(path, O_WRONLY | O_TRUNC));
+      if (!fd.is_valid())
+      {
+        return Error::create_with_log(LogFile, "Cannot trunc file \"{}\" as it doesn't exist", path);
+      }
+
+      return Error::no_error();
+    }
+    // Copy a file, overwiting an existing one is possible
+    Error copy_abspath(rsl::string_view src, rsl::string_view dst, OverwriteIfExist overwriteIfExist)
+    {
+      REX_ASSERT_X(path::is_absolute(src), "argument is expected to be absolute here: {}", src);
+      REX_ASSERT_X(path::is_absolute(dst), "argument is expected to be absolute here: {}", dst);
+
+      if (src == dst)
+      {
+        return Error::create_with_log(LogFile, "Cannot copy a file to itself");
+      }
+
+      if (!overwriteIfExist && file::exists_abspath(dst))
+      {
+        return Error::create_with_log(LogFile, "Cannot copy to a file that already exists if overwriting is disabled");
+      }
+
+      return internal::copy_abspath_no_checks(src, dst);
+    }
+    // Move/Rename a file, overwriting an existing one is possible
+    Error move_abspath(rsl::string_view src, rsl::string_view dst)
+    {
+      REX_ASSERT_X(path::is_absolute(src), "argument is expected to be absolute here: {}", src);
+      REX_ASSERT_X(path::is_absolute(dst), "argument is expected to be absolute here: {}", dst);
+
+      if (file::exists_abspath(dst))
+      {
+        return Error::create_with_log(LogFile, "Cannot move to \"{}\", file already exists", dst);
+      }
+
+      return internal::move_abspath_no_checks(src, dst);
+    }
+    // Create a new empty file
+    Error create_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (!rex::path::is_valid_path(path))
+      {
+        return Error::create_with_log(LogFile, "Cannot create file at \"{}\" as it's an invalid path", path);
+      }
+
+      if (file::exists_abspath(path))
+      {
+        return Error::create_with_log(LogFile, "cannot create file at \"{}\" as it already exists", path);
+      }
+
+      const internal::ScopedFd fd(internal::open_file(path, O_WRONLY | O_CREAT | O_EXCL));
+
+      return fd.is_valid()
+        ? Error::no_error()
+        : Error::create_with_log(LogFile, "Failed to create file at \"{}\"", path);
+    }
+    // Delete a file
+    Error del_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      if (!file::exists_abspath(path))
+      {
+        return Error::create_with_log(LogFile, "cannot delete file at \"{}\" as it doesn't exist", path);
+      }
+
+      const bool success = unlink(path.data()) == 0;
+      return success
+        ? Error::no_error()
+        : Error::create_with_log(LogFile, "Failed to delete file at \"{}\"", path);
+    }
+    // return the file size
+    card64 size_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      struct stat file_stat {};
+      if (!internal::stat_path(path, file_stat))
+      {
+        return -1;
+      }
+
+      return file_stat.st_size;
+    }
+    // Check if a file exists
+    bool exists_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      struct stat file_stat {};
+      return internal::stat_path(path, file_stat) && !S_ISDIR(file_stat.st_mode);
+    }
+    // Check if a file is marked read only
+    bool is_readonly_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      struct stat file_stat {};
+      if (!internal::stat_path(path, file_stat) || S_ISDIR(file_stat.st_mode))
+      {
+        return false;
+      }
+
+      // Like on Windows, a file is read only if its owner can't write to it
+      return (file_stat.st_mode & S_IWUSR) == 0;
+    }
+    // Set a file to be readonly
+    Error set_readonly_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      struct stat file_stat {};
+      if (!internal::stat_path(path, file_stat) || S_ISDIR(file_stat.st_mode))
+      {
+        return Error::create_with_log(LogFile, "Can't set readonly attribute for \"{}\" as the file doesn't exist", path);
+      }
+
+      chmod(path.data(), file_stat.st_mode & ~(S_IWUSR | S_IWGRP | S_IWOTH)); // NOLINT(hicpp-signed-bitwise)
+
+      return Error::no_error();
+    }
+    // Remove the readonly flag of a file
+    Error remove_readonly_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      struct stat file_stat {};
+      if (!internal::stat_path(path, file_stat) || S_ISDIR(file_stat.st_mode))
+      {
+        return Error::create_with_log(LogFile, "Can't remove readonly attribute for \"{}\" as the file doesn't exist", path);
+      }
+
+      chmod(path.data(), file_stat.st_mode | S_IWUSR); // NOLINT(hicpp-signed-bitwise)
+
+      return Error::no_error();
+    }
+    // Return the creation time of a file
+    rsl::time_point creation_time_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      // When the file can't be found, we return 0
+      struct stat file_stat {};
+      if (!internal::stat_path(path, file_stat))
+      {
+        return rsl::time_point();
+      }
+
+      // stat doesn't know when a file got created, the last status change is the closest
+      return internal::to_timepoint(file_stat.st_ctim);
+    }
+    // Return the access time of a file
+    rsl::time_point access_time_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      // When the file can't be found, we return 0
+      struct stat file_stat {};
+      if (!internal::stat_path(path, file_stat))
+      {
+        return rsl::time_point();
+      }
+
+      return internal::to_timepoint(file_stat.st_atim);
+    }
+    // Return the modification time of a file
+    rsl::time_point modification_time_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      // When the file can't be found, we return 0
+      struct stat file_stat {};
+      if (!internal::stat_path(path, file_stat))
+      {
+        return rsl::time_point();
+      }
+
+      return internal::to_timepoint(file_stat.st_mtim);
+    }
+
+  } // namespace file
+} // namespace rex
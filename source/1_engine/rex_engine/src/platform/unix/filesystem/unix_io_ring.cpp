@@ -0,0 +1,275 @@
+#include "rex_engine/platform/unix/filesystem/unix_io_ring.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/memory/pointer_math.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/cstring.h"
+
+// NOLINTBEGIN(llvm-include-order)
+// clang-format off
+#include <cerrno>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+// clang-format on
+// NOLINTEND(llvm-include-order)
+
+// We don't depend on liburing, the 2 syscalls it wraps are all we need for batched reads
+// Files are read straight into the buffers that get handed out, so no buffers are registered with the kernel
+
+namespace rex
+{
+  namespace file
+  {
+    namespace internal
+    {
+      DEFINE_LOG_CATEGORY(LogIoRing);
+
+      s32 io_uring_setup(u32 numEntries, io_uring_params* params)
+      {
+        return static_cast<s32>(syscall(__NR_io_uring_setup, numEntries, params));
+      }
+      s32 io_uring_enter(s32 fd, u32 numToSubmit, u32 numToWaitFor, u32 flags)
+      {
+        return static_cast<s32>(syscall(__NR_io_uring_enter, fd, numToSubmit, numToWaitFor, flags, nullptr, 0));
+      }
+
+      // The ring indices are shared with the kernel, the kernel reads what we write to them on another core
+      u32 load_acquire(const u32* ptr)
+      {
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+      }
+      void store_release(u32* ptr, u32 value)
+      {
+        __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+      }
+
+      template <typename T>
+      T* ring_field(void* ring, u32 offset)
+      {
+        return static_cast<T*>(jump_forward(ring, offset));
+      }
+
+      IoRing::IoRing()
+        : m_fd(-1)
+        , m_num_entries(0)
+        , m_num_cq_entries(0)
+        , m_num_unsubmitted(0)
+        , m_num_in_flight(0)
+        , m_sq_ring(nullptr)
+        , m_sq_ring_size(0)
+        , m_sq_head(nullptr)
+        , m_sq_tail(nullptr)
+        , m_sq_mask(nullptr)
+        , m_sq_array(nullptr)
+        , m_sqes(nullptr)
+        , m_sqes_size(0)
+        , m_cq_ring(nullptr)
+        , m_cq_ring_size(0)
+        , m_cq_head(nullptr)
+        , m_cq_tail(nullptr)
+        , m_cq_mask(nullptr)
+        , m_cqes(nullptr)
+      {
+        io_uring_params params {};
+        m_fd = io_uring_setup(static_cast<u32>(g_io_ring_queue_depth), &params);
+
+        // Old kernels don't have io_uring and containers often block it
+        if (m_fd < 0)
+        {
+          REX_WARN(LogIoRing, "io_uring is not available, files are read with pread. errno: {}", errno);
+          return;
+        }
+
+        m_num_entries    = static_cast<s32>(params.sq_entries);
+        m_num_cq_entries = static_cast<s32>(params.cq_entries);
+        m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+        m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        m_sqes_size    = params.sq_entries * sizeof(io_uring_sqe);
+
+        // Newer kernels map both rings with a single mmap
+        const bool is_single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (is_single_mmap)
+        {
+          m_sq_ring_size = rsl::max(m_sq_ring_size, m_cq_ring_size);
+          m_cq_ring_size = m_sq_ring_size;
+        }
+
+        m_sq_ring = mmap(nullptr, static_cast<size_t>(m_sq_ring_size), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        m_cq_ring = is_single_mmap ? m_sq_ring : mmap(nullptr, static_cast<size_t>(m_cq_ring_size), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        void* sqes = mmap(nullptr, static_cast<size_t>(m_sqes_size), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+
+        if (m_sq_ring == MAP_FAILED || m_cq_ring == MAP_FAILED || sqes == MAP_FAILED)
+        {
+          REX_WARN(LogIoRing, "Failed to map the io_uring queues, files are read with pread. errno: {}", errno);
+          m_sq_ring = m_sq_ring == MAP_FAILED ? nullptr : m_sq_ring;
+          m_cq_ring = m_cq_ring == MAP_FAILED ? nullptr : m_cq_ring;
+          m_sqes    = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes);
+          close(m_fd);
+          m_fd = -1;
+          return;
+        }
+
+        m_sq_head  = ring_field<u32>(m_sq_ring, params.sq_off.head);
+        m_sq_tail  = ring_field<u32>(m_sq_ring, params.sq_off.tail);
+        m_sq_mask  = ring_field<u32>(m_sq_ring, params.sq_off.ring_mask);
+        m_sq_array = ring_field<u32>(m_sq_ring, params.sq_off.array);
+        m_sqes     = static_cast<io_uring_sqe*>(sqes);
+
+        m_cq_head = ring_field<u32>(m_cq_ring, params.cq_off.head);
+        m_cq_tail = ring_field<u32>(m_cq_ring, params.cq_off.tail);
+        m_cq_mask = ring_field<u32>(m_cq_ring, params.cq_off.ring_mask);
+        m_cqes    = ring_field<io_uring_cqe>(m_cq_ring, params.cq_off.cqes);
+      }
+
+      IoRing::~IoRing()
+      {
+        release();
+      }
+
+      bool IoRing::is_valid() const
+      {
+        return m_fd >= 0;
+      }
+      s32 IoRing::num_free_entries() const
+      {
+        // Every read in flight posts a completion, limiting them to the size of the completion queue means it never overflows.
+        // Kernels without IORING_FEAT_NODROP would drop the completions that don't fit and we'd wait on them forever
+        const u32 num_queued  = *m_sq_tail - load_acquire(m_sq_head);
+        const s32 num_free_sq = m_num_entries - static_cast<s32>(num_queued);
+        const s32 num_free_cq = m_num_cq_entries - m_num_in_flight;
+        return rsl::min(num_free_sq, num_free_cq);
+      }
+
+      void IoRing::queue_read(s32 fd, void* buffer, s32 size, s64 offset, u64 userData)
+      {
+        io_uring_sqe* sqe = next_sqe();
+        sqe->opcode       = IORING_OP_READ;
+        sqe->fd           = fd;
+        sqe->addr         = reinterpret_cast<u64>(buffer); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        sqe->len          = static_cast<u32>(size);
+        sqe->off          = static_cast<u64>(offset);
+        sqe->user_data    = userData;
+      }
+
+      bool IoRing::submit_and_wait(s32 numToWaitFor)
+      {
+        while (true)
+        {
+          const s32 res = io_uring_enter(m_fd, static_cast<u32>(m_num_unsubmitted), static_cast<u32>(numToWaitFor), IORING_ENTER_GETEVENTS);
+          if (res >= 0)
+          {
+            m_num_unsubmitted -= res;
+            return true;
+          }
+
+          // A signal interrupted the wait, the reads keep going so we just wait again
+          if (errno != EINTR && errno != EAGAIN)
+          {
+            REX_ERROR(LogIoRing, "Failed to submit reads to io_uring. errno: {}", errno);
+            return false;
+          }
+        }
+      }
+
+      bool IoRing::pop_completion(IoRingCompletion& outCompletion)
+      {
+        const u32 head = *m_cq_head;
+        if (head == load_acquire(m_cq_tail))
+        {
+          return false;
+        }
+
+        const io_uring_cqe& cqe  = m_cqes[head & *m_cq_mask];
+        outCompletion.user_data = cqe.user_data;
+        outCompletion.result    = cqe.res;
+
+        // Give the slot back to the kernel
+        store_release(m_cq_head, head + 1);
+        --m_num_in_flight;
+        return true;
+      }
+
+      void IoRing::discard_reads()
+      {
+        // Without a polling thread, the kernel only looks at the submission queue when we enter it
+        // so reads that never got submitted can be taken back by moving the tail back
+        store_release(m_sq_tail, *m_sq_tail - static_cast<u32>(m_num_unsubmitted));
+        m_num_in_flight -= m_num_unsubmitted;
+        m_num_unsubmitted = 0;
+
+        IoRingCompletion completion {};
+        while (m_num_in_flight > 0)
+        {
+          if (pop_completion(completion))
+          {
+            continue;
+          }
+
+          const s32 res = io_uring_enter(m_fd, 0, 1, IORING_ENTER_GETEVENTS);
+          if (res < 0 && errno != EINTR && errno != EAGAIN)
+          {
+            // Closing the ring cancels the reads that are still in flight
+            REX_ERROR(LogIoRing, "Failed to wait for io_uring reads in flight, closing the ring. errno: {}", errno);
+            release();
+            return;
+          }
+        }
+      }
+
+      io_uring_sqe* IoRing::next_sqe()
+      {
+        REX_ASSERT_X(num_free_entries() > 0, "Queueing a read on a full io ring");
+
+        const u32 tail    = *m_sq_tail;
+        const u32 idx     = tail & *m_sq_mask;
+        io_uring_sqe* sqe = &m_sqes[idx];
+        rsl::memset(sqe, 0, sizeof(io_uring_sqe));
+        m_sq_array[idx] = idx;
+
+        // The kernel only looks at the entry once the tail moves past it, which happens on the next submit at the earliest
+        store_release(m_sq_tail, tail + 1);
+        ++m_num_unsubmitted;
+        ++m_num_in_flight;
+        return sqe;
+      }
+
+      void IoRing::release()
+      {
+        if (m_sqes != nullptr)
+        {
+          munmap(m_sqes, static_cast<size_t>(m_sqes_size));
+        }
+        if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring)
+        {
+          munmap(m_cq_ring, static_cast<size_t>(m_cq_ring_size));
+        }
+        if (m_sq_ring != nullptr)
+        {
+          munmap(m_sq_ring, static_cast<size_t>(m_sq_ring_size));
+        }
+
+        if (m_fd >= 0)
+        {
+          close(m_fd);
+        }
+
+        m_fd              = -1;
+        m_sqes            = nullptr;
+        m_cq_ring         = nullptr;
+        m_sq_ring         = nullptr;
+        m_num_unsubmitted = 0;
+        m_num_in_flight   = 0;
+      }
+
+      IoRing* thread_io_ring()
+      {
+        // Every io worker submits to its own ring, so rings don't need any locking
+        thread_local IoRing s_ring; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+        return s_ring.is_valid() ? &s_ring : nullptr;
+      }
+    } // namespace internal
+  }   // namespace file
+} // namespace rex
@@ -0,0 +1,166 @@
+#include "rex_engine/filesystem/path.h"
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/filesystem/directory.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_std/array.h"
+#include "rex_std/bonus/string.h"
+#include "rex_std/cstring.h"
+
+// NOLINTBEGIN(llvm-include-order)
+// clang-format off
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+// clang-format on
+// NOLINTEND(llvm-include-order)
+
+namespace rex
+{
+  namespace path
+  {
+    // Returns the current working directory
+    rsl::string_view cwd()
+    {
+      // To save on allocations, the current working dir is cached
+      rsl::medium_stack_string current_dir;
+      if (getcwd(current_dir.data(), static_cast<size_t>(current_dir.max_size())) == nullptr) // NOLINT(readability-static-accessed-through-instance)
+      {
+        current_dir.clear();
+      }
+      current_dir.reset_null_termination_offset();
+
+      static rsl::string cached_wd;
+      if (current_dir != cached_wd)
+      {
+        cached_wd.assign(current_dir);
+      }
+
+      return cached_wd;
+    }
+    // Sets a new working directory and returns the old one
+    // An existing path is expected or an assert is raised
+    scratch_string set_cwd(rsl::string_view dir)
+    {
+      dir = rex::path::unsafe_abs_path(dir);
+
+      return set_cwd_abspath(dir);
+    }
+    // Returns the path of the current user's temp folder
+    scratch_string temp_path()
+    {
+      const char8* tmp_dir = getenv("TMPDIR"); // NOLINT(concurrency-mt-unsafe)
+      return scratch_string(tmp_dir != nullptr ? rsl::string_view(tmp_dir) : rsl::string_view("/tmp"));
+    }
+    // For symlinks, returns the path the link points to
+    // Otherwise returns the input
+    scratch_string real_path(rsl::string_view path)
+    {
+      rsl::string_view fullpath = unsafe_abs_path(path);
+
+      return real_path_abspath(fullpath);
+    }
+    // Returns if the given path is an absolute path
+    bool is_absolute(rsl::string_view path)
+    {
+      // absolute paths
+      // /foo - yes
+      // anything else - no
+      return !path.empty() && path.front() == '/';
+    }
+    // Returns true if the given path points to a junction
+    bool is_junction(rsl::string_view path)
+    {
+      // Junctions only exist on Windows
+      REX_UNUSED_PARAM(path);
+      return false;
+    }
+    // Returns true if the given path points to a symlink
+    bool is_link(rsl::string_view path)
+    {
+      const path_stack_string fullpath(path);
+      struct stat link_stat {};
+      return lstat(fullpath.data(), &link_stat) == 0 && S_ISLNK(link_stat.st_mode);
+    }
+
+    // Splits the path into a head and a tail
+    // the head is either the mount point or an empty string
+    // the tail is everything else
+    SplitResult split_origin(rsl::string_view path)
+    {
+      // There are no mount points in unix paths, everything hangs under the same root
+      SplitResult res {};
+      res.tail = path;
+      return res;
+    }
+    // Split the path into 3 components
+    // drive - root - tail
+    // drive: mounting point
+    // root: string of separators after the drive
+    // tail: everything after the root
+    // eg: /home/sam (Unix)
+    // drive:
+    // root: /
+    // tail: home/sam
+    SplitRootResult split_root(rsl::string_view path)
+    {
+      SplitRootResult res {};
+
+      // fill in the values
+      if (path.starts_with('/'))
+      {
+        res.root = path.substr(0, 1);
+        res.tail = path.substr(1);
+      }
+      else
+      {
+        res.tail = path;
+      }
+
+      // return the result
+      return res;
+    }
+    // Returns true if absolute paths on this platform have a drive letter
+    bool abs_needs_drive()
+    {
+      return false;
+    }
+
+    scratch_string set_cwd_abspath(rsl::string_view dir)
+    {
+      REX_ASSERT_X(is_absolute(dir), "argument is expected to be absolute here: {}", dir);
+      REX_ASSERT_X(directory::exists_abspath(dir), "dir specified for working dir doesn't exist. This is not allowed. Dir: {}", dir);
+
+      scratch_string old_cwd(path::cwd());
+      const path_stack_string new_cwd(dir);
+      chdir(new_cwd.data());
+
+      return old_cwd;
+    }
+
+    scratch_string real_path_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(is_absolute(path), "argument is expected to be absolute here: {}", path);
+
+      path = rex::path::unsafe_norm_path(path);
+
+      // If the path doesn't exist, just return its input
+      if (!file::exists_abspath(path) && !directory::exists_abspath(path))
+      {
+        return scratch_string(path);
+      }
+
+      // realpath resolves every symlink along the way
+      const path_stack_string fullpath(path);
+      rsl::array<char8, PATH_MAX> resolved_path {};
+      if (realpath(fullpath.data(), resolved_path.data()) == nullptr)
+      {
+        return scratch_string(path);
+      }
+
+      return scratch_string(rsl::string_view(resolved_path.data()));
+    }
+
+  } // namespace path
+} // namespace rex
@@ -0,0 +1,50 @@
+#include "rex_engine/memory/virtual_memory.h"
+
+// NOLINTBEGIN(llvm-include-order)
+// clang-format off
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "rex_engine/diagnostics/assert.h"
+// clang-format on
+// NOLINTEND(llvm-include-order)
+
+namespace rex
+{
+  namespace vmem
+  {
+    s64 page_size()
+    {
+      static const s64 size = static_cast<s64>(sysconf(_SC_PAGESIZE));
+      return size;
+    }
+    s64 allocation_granularity()
+    {
+      // mmap reserves memory page by page
+      return page_size();
+    }
+
+    void* reserve(s64 size)
+    {
+      // Reserved pages can't be accessed and aren't counted against the commit limit of the system
+      void* ptr = mmap(nullptr, static_cast<size_t>(size), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+    bool commit(void* ptr, s64 size)
+    {
+      // Pages are backed by physical memory the first time they're touched
+      return mprotect(ptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE) == 0;
+    }
+    void decommit(void* ptr, s64 size)
+    {
+      // Drop the physical pages first, so they read back as zero when they're committed again
+      const bool success = madvise(ptr, static_cast<size_t>(size), MADV_DONTNEED) == 0 && mprotect(ptr, static_cast<size_t>(size), PROT_NONE) == 0;
+      REX_ASSERT_X(success, "Failed to decommit virtual memory. size: {}", size);
+    }
+    void release(void* ptr, s64 size)
+    {
+      const bool success = munmap(ptr, static_cast<size_t>(size)) == 0;
+      REX_ASSERT_X(success, "Failed to release virtual memory. size: {}", size);
+    }
+  } // namespace vmem
+} // namespace rex
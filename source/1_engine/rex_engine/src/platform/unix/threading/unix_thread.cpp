@@ -0,0 +1,16 @@
+#include "rex_engine/threading/thread.h"
+
+#include "rex_std/functional.h"
+
+namespace rex
+{
+  namespace internal
+  {
+    rsl::function<void()> crash_guard_thread_entry(rsl::function<void()>&& callable)
+    {
+      // There's no structured exception handling on unix
+      // crashes raise signals, which are process wide, so worker threads don't need to be wrapped
+      return rsl::move(callable);
+    }
+  } // namespace internal
+} // namespace rex
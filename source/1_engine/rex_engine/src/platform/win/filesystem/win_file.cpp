@@ -88,6 +88,14 @@ namespace rex
           : Error::create_with_log(LogFile, "cannot move \"{}\" to \"{}\"", src, dst);
       }
 
+
+      void unmap_file(const rsl::byte* data, rsl::memory_size size, void* nativeHandle)
+      {
+        // The size is only needed on unix, Windows unmaps the entire view
+        REX_UNUSED_PARAM(size);
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(nativeHandle));
+      }
     } // namespace internal
 
     // Read from a file
@@ -104,6 +112,13 @@ namespace rex
 
       return read_file_abspath(path, buffer, size);
     }
+    // Map a file into memory
+    MappedFile map_file(rsl::string_view path)
+    {
+      path = path::unsafe_abs_path(path);
+
+      return map_file_abspath(path);
+    }
     // Save content to a file
     Error write_to_file(rsl::string_view path, const void* data, card64 size)
     {
@@ -324,6 +339,65 @@ namespace rex
 
       return bytes_read;
     }
+    // Read multiple files at once, the blobs are returned in the same order as the paths
+    bool supports_batched_reads()
+    {
+      return false;
+    }
+    rsl::vector<memory::Blob> read_files_abspath(const rsl::vector<rsl::string_view>& paths)
+    {
+      // Windows has no batched reads, so files are read one after the other
+      rsl::vector<memory::Blob> blobs;
+      blobs.reserve(paths.size());
+      for (const rsl::string_view path : paths)
+      {
+        blobs.push_back(read_file_abspath(path));
+      }
+
+      return blobs;
+    }
+    // Map a file into memory
+    MappedFile map_file_abspath(rsl::string_view path)
+    {
+      REX_ASSERT_X(path::is_absolute(path) || path::is_drive(path), "argument is expected to be absolute here: {}", path);
+
+      if (!exists_abspath(path))
+      {
+        REX_ERROR(LogFile, "Failed to map file as it doesn't exist: {}", quoted(path));
+        return {};
+      }
+
+      internal::file_info file_info = internal::open_file_for_reading(path);
+      if (!file_info.handle.is_valid())
+      {
+        REX_ERROR(LogFile, "Failed to open file {}", quoted(path));
+        return {};
+      }
+
+      // Windows doesn't allow mapping empty files
+      if (file_info.file_size <= 0)
+      {
+        return {};
+      }
+
+      // The view keeps the mapping object alive, but we hold on to it so it can be closed together with the view
+      HANDLE mapping = WIN_CALL(CreateFileMappingA(file_info.handle.get(), NULL, PAGE_READONLY, 0, 0, NULL));
+      if (mapping == NULL)
+      {
+        REX_WARN(LogFile, "Failed to map file {}, reading it instead", quoted(path));
+        return MappedFile(read_file_abspath(path));
+      }
+
+      const void* view = WIN_CALL(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+      if (view == NULL)
+      {
+        CloseHandle(mapping);
+        REX_WARN(LogFile, "Failed to map a view of file {}, reading it instead", quoted(path));
+        return MappedFile(read_file_abspath(path));
+      }
+
+      return MappedFile(static_cast<const rsl::byte*>(view), rsl::memory_size(static_cast<card64>(file_info.file_size)), mapping);
+    }
     // Save content to a file
     Error write_to_file_abspath(rsl::string_view path, const void* data, card64 size)
     {
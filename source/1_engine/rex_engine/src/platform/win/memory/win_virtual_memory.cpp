@@ -0,0 +1,61 @@
+#include "rex_engine/memory/virtual_memory.h"
+
+// NOLINTBEGIN(llvm-include-order)
+// clang-format off
+#include <Windows.h>
+
+#include "rex_engine/diagnostics/assert.h"
+#include "rex_engine/engine/defines.h"
+// clang-format on
+// NOLINTEND(llvm-include-order)
+
+namespace rex
+{
+  namespace vmem
+  {
+    namespace internal
+    {
+      SYSTEM_INFO query_system_info()
+      {
+        SYSTEM_INFO sys_info{};
+        GetSystemInfo(&sys_info);
+        return sys_info;
+      }
+      const SYSTEM_INFO& system_info()
+      {
+        static const SYSTEM_INFO sys_info = query_system_info();
+        return sys_info;
+      }
+    } // namespace internal
+
+    s64 page_size()
+    {
+      return static_cast<s64>(internal::system_info().dwPageSize);
+    }
+    s64 allocation_granularity()
+    {
+      return static_cast<s64>(internal::system_info().dwAllocationGranularity);
+    }
+
+    void* reserve(s64 size)
+    {
+      return VirtualAlloc(nullptr, static_cast<SIZE_T>(size), MEM_RESERVE, PAGE_NOACCESS);
+    }
+    bool commit(void* ptr, s64 size)
+    {
+      return VirtualAlloc(ptr, static_cast<SIZE_T>(size), MEM_COMMIT, PAGE_READWRITE) != nullptr;
+    }
+    void decommit(void* ptr, s64 size)
+    {
+      const bool success = VirtualFree(ptr, static_cast<SIZE_T>(size), MEM_DECOMMIT) != 0;
+      REX_ASSERT_X(success, "Failed to decommit virtual memory. size: {}", size);
+    }
+    void release(void* ptr, s64 size)
+    {
+      // Windows releases the entire range that got reserved, it needs a size of 0 for that
+      REX_UNUSED_PARAM(size);
+      const bool success = VirtualFree(ptr, 0, MEM_RELEASE) != 0;
+      REX_ASSERT_X(success, "Failed to release virtual memory");
+    }
+  } // namespace vmem
+} // namespace rex
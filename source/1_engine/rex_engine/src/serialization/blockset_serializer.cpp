@@ -45,10 +45,10 @@ namespace rex
 
 	rsl::unique_array<Block> BlocksetSerializer::load_block_indices(rsl::string_view blockIndicesPath)
 	{
-		memory::Blob content = vfs::instance()->read_file(blockIndicesPath);
+		const MappedFile content = vfs::instance()->map_file(blockIndicesPath);
 
 		s64 num_blocks = content.size() / Block::num_tiles();
-		memory::BlobReader reader(content);
+		memory::BlobReader reader(content.view());
 
 		Block::indices_array blob_memory;
 		rsl::unique_array<Block> blocks = rsl::make_unique<Block[]>(static_cast<s32>(num_blocks));
@@ -6,6 +6,7 @@
 #include "rex_engine/assets/texture_asset.h"
 
 #include "rex_engine/serialization/image_loading.h"
+#include "rex_engine/task_system/parallel_for.h"
 
 #include "rex_std/bonus/math.h"
 
@@ -25,15 +26,15 @@ namespace rex
 
 		// A tileset only holds 1 channel, we have to convert it to 4 channels as that's what the GPU expects
 		rsl::unique_array<rsl::Rgba> tileset_rgba = rsl::make_unique<rsl::Rgba[]>(tileset_img_load_res.width * tileset_img_load_res.height * sizeof(rsl::Rgba));
-		for (s32 color_idx = 0; color_idx < tileset_img_load_res.width * tileset_img_load_res.height; ++color_idx)
-		{
-			u8 color = tileset_img_load_res.data[color_idx];
-			rsl::Rgba& rgba = tileset_rgba[color_idx];
-			rgba.red = color;
-			rgba.green = color;
-			rgba.blue = color;
-			rgba.alpha = 255;
-		}
+		rex::parallel_for({ 0, tileset_img_load_res.width * tileset_img_load_res.height }, 0, [&](s32 color_idx)
+			{
+				u8 color = tileset_img_load_res.data[color_idx];
+				rsl::Rgba& rgba = tileset_rgba[color_idx];
+				rgba.red = color;
+				rgba.green = color;
+				rgba.blue = color;
+				rgba.alpha = 255;
+			});
 
 		rsl::unique_ptr<rex::gfx::Texture2D> texture = rex::gfx::gal::instance()->create_texture2d(tileset_img_load_res.width, tileset_img_load_res.height, rex::gfx::TextureFormat::Unorm4, tileset_rgba.get());
 		return rsl::make_unique<Tileset>(rsl::move(texture));
@@ -0,0 +1,67 @@
+#include "rex_engine/task_system/coroutine.h"
+
+#include "rex_engine/threading/spin_lock.h"
+#include "rex_std/mutex.h"
+#include "rex_std/vector.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+#ifdef REX_HAS_COROUTINES
+    namespace internal
+    {
+      // The coroutines that get resumed at the start of the next frame
+      rsl::vector<std::coroutine_handle<>> g_frame_waiters; // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+      // The coroutines that are being resumed this frame
+      // kept around so that its memory gets reused every frame
+      rsl::vector<std::coroutine_handle<>> g_resuming_frame_waiters; // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+      SpinLock g_frame_waiters_lock;                                  // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+
+      // Add a coroutine that gets resumed at the start of the next frame
+      void add_frame_waiter(std::coroutine_handle<> coroutine)
+      {
+        const rsl::unique_lock lock(g_frame_waiters_lock);
+        g_frame_waiters.push_back(coroutine);
+      }
+
+      // Queue a job on the task system that resumes the coroutine
+      void resume_on_task_system(std::coroutine_handle<> coroutine)
+      {
+        add_job_to_queue(create_job([coroutine]() { coroutine.resume(); }));
+      }
+    } // namespace internal
+#endif
+
+    // Resume all coroutines that are waiting for the next frame
+    // This is called by the application at the start of every frame
+    void resume_frame_waiters()
+    {
+#ifdef REX_HAS_COROUTINES
+      // Coroutines that wait for the next frame again while being resumed
+      // get added to the waiters of the next frame
+      {
+        const rsl::unique_lock lock(internal::g_frame_waiters_lock);
+        rsl::swap(internal::g_frame_waiters, internal::g_resuming_frame_waiters);
+      }
+
+      for(std::coroutine_handle<> coroutine: internal::g_resuming_frame_waiters)
+      {
+        coroutine.resume();
+      }
+      internal::g_resuming_frame_waiters.clear();
+#endif
+    }
+
+    // Return the number of coroutines waiting for the next frame
+    s32 num_frame_waiters()
+    {
+#ifdef REX_HAS_COROUTINES
+      const rsl::unique_lock lock(internal::g_frame_waiters_lock);
+      return internal::g_frame_waiters.size();
+#else
+      return 0;
+#endif
+    }
+  } // namespace task_system
+} // namespace rex
@@ -1,27 +1,187 @@
 #include "rex_engine/task_system/job.h"
 
+#include "rex_engine/task_system/internal/job_pool.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_std/mutex.h"
+
 namespace rex
 {
   namespace task_system
   {
-    Job::Job(job_callable&& callable)
-        : m_callable(rsl::move(callable))
+    Job::Job()
+        : m_callable_storage()
+        , m_result_storage()
+        , m_callable(nullptr)
+        , m_invoke_func(nullptr)
+        , m_destroy_callable_func(nullptr)
+        , m_result(nullptr)
+        , m_destroy_result_func(nullptr)
         , m_finished_event("")
+        , m_priority(JobPriority::Normal)
+        , m_affinity(JobAffinity::AnyThread)
+        , m_submit_time(0)
+        , m_continuations()
+        , m_continuations_lock()
+        , m_is_finished(false)
+        , m_num_pending_dependencies(1)
+        , m_ref_count(0)
+        , m_next_free(nullptr)
+    {
+    }
+
+    Job::~Job()
     {
+      reset();
     }
 
     // Run the callable that's internally stored
+    // Afterwards, all jobs waiting on this one get queued if this was their last dependency
     void Job::run()
     {
-      m_result_buffer = m_callable();
+      m_invoke_func(*this);
+
+      // Destroy the callable as soon as we're done with it
+      // so anything it captured gets released before the job is recycled
+      m_destroy_callable_func(*this);
+      m_callable              = nullptr;
+      m_destroy_callable_func = nullptr;
+
+      // After this no new continuations will be added
+      // so we can access them without holding the lock
+      {
+        const rsl::unique_lock lock(m_continuations_lock);
+        m_is_finished = true;
+      }
+
       m_finished_event.signal();
+
+      for(JobHandle& continuation: m_continuations)
+      {
+        if(continuation->release_dependency())
+        {
+          add_job_to_queue(rsl::move(continuation));
+        }
+      }
+      m_continuations.clear();
     }
 
     // Wait for the callable to finish, this only makes sense
     // if the job is run on a different thread
     void Job::wait_for_me()
     {
+      // The event resets itself after it's been waited on
+      // so we can't wait on it again if the job has already finished
+      if(is_finished())
+      {
+        return;
+      }
+
       m_finished_event.wait_for_me();
     }
+
+    // Returns true if the callable has finished running
+    bool Job::is_finished() const
+    {
+      return m_is_finished.load();
+    }
+
+    // Add a job that needs to run after this job has finished
+    // Returns false if this job has already finished, in which case the continuation isn't stored
+    bool Job::add_continuation(const JobHandle& job)
+    {
+      const rsl::unique_lock lock(m_continuations_lock);
+      if(m_is_finished)
+      {
+        return false;
+      }
+
+      m_continuations.push_back(job);
+      return true;
+    }
+
+    // Add a dependency that needs to finish before this job is allowed to run
+    void Job::add_dependency()
+    {
+      ++m_num_pending_dependencies;
+    }
+    // Mark a dependency of this job as finished
+    // Returns true if this was the last dependency, meaning the job can be queued
+    bool Job::release_dependency()
+    {
+      return --m_num_pending_dependencies == 0;
+    }
+
+    // Set the priority and affinity of the job, this needs to happen before the job gets queued
+    void Job::set_priority(JobPriority priority)
+    {
+      m_priority = priority;
+    }
+    void Job::set_affinity(JobAffinity affinity)
+    {
+      m_affinity = affinity;
+    }
+    JobPriority Job::priority() const
+    {
+      return m_priority;
+    }
+    JobAffinity Job::affinity() const
+    {
+      return m_affinity;
+    }
+
+    // Mark the job as queued, used to measure how long it waits before it starts
+    void Job::mark_submitted(s64 submitTime)
+    {
+      m_submit_time = submitTime;
+    }
+    // Return the time the job got queued, 0 if it hasn't been queued yet
+    s64 Job::submit_time() const
+    {
+      return m_submit_time;
+    }
+
+    // Add a reference to the job, the job stays alive as long as it's referenced
+    void Job::add_ref()
+    {
+      ++m_ref_count;
+    }
+    // Remove a reference to the job
+    // When the last reference is removed, the job is returned to the pool
+    void Job::release_ref()
+    {
+      if(--m_ref_count == 0)
+      {
+        reset();
+        internal::job_pool().release(this);
+      }
+    }
+
+    // Destroy the result and callable and reset the job so it can be reused
+    void Job::reset()
+    {
+      if(m_destroy_callable_func)
+      {
+        m_destroy_callable_func(*this);
+      }
+      if(m_destroy_result_func)
+      {
+        m_destroy_result_func(*this);
+      }
+
+      m_callable              = nullptr;
+      m_invoke_func           = nullptr;
+      m_destroy_callable_func = nullptr;
+      m_result                = nullptr;
+      m_destroy_result_func   = nullptr;
+
+      // Continuations are only left behind if the job never ran
+      m_continuations.clear();
+      m_finished_event.reset();
+      m_priority                 = JobPriority::Normal;
+      m_affinity                 = JobAffinity::AnyThread;
+      m_submit_time              = 0;
+      m_is_finished              = false;
+      m_num_pending_dependencies = 1;
+    }
   } // namespace task_system
-} // namespace rex
\ No newline at end of file
+} // namespace rex
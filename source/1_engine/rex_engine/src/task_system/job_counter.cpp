@@ -0,0 +1,55 @@
+#include "rex_engine/task_system/job_counter.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    JobCounter::JobCounter()
+        : m_jobs()
+    {
+    }
+
+    // Add a job to the counter
+    void JobCounter::add_job(const JobHandle& job)
+    {
+      m_jobs.push_back(job);
+    }
+
+    // This is a blocking function.
+    // It'll wait for all jobs in the counter to finish
+    void JobCounter::wait_for_me() const
+    {
+      for(const JobHandle& job: m_jobs)
+      {
+        job->wait_for_me();
+      }
+    }
+
+    // Returns the number of jobs in the counter that haven't finished yet
+    s32 JobCounter::num_pending() const
+    {
+      s32 num_pending = 0;
+      for(const JobHandle& job: m_jobs)
+      {
+        if(!job->is_finished())
+        {
+          ++num_pending;
+        }
+      }
+
+      return num_pending;
+    }
+
+    // Returns true if all jobs in the counter have finished
+    bool JobCounter::is_finished() const
+    {
+      return num_pending() == 0;
+    }
+
+    // Returns all the jobs tracked by the counter
+    const rsl::vector<JobHandle>& JobCounter::jobs() const
+    {
+      return m_jobs;
+    }
+  } // namespace task_system
+} // namespace rex
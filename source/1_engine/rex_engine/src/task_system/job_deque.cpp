@@ -0,0 +1,99 @@
+#include "rex_engine/task_system/internal/job_deque.h"
+
+#include "rex_std/mutex.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    namespace internal
+    {
+      // The initial number of jobs a deque can hold before growing
+      // Must be a power of 2
+      constexpr s32 g_initial_job_deque_capacity = 64;
+
+      JobDeque::JobDeque()
+          : m_jobs()
+          , m_head(0)
+          , m_count(0)
+          , m_access_lock()
+      {
+        m_jobs.resize(g_initial_job_deque_capacity);
+      }
+
+      // Add a job at the back of the deque
+      void JobDeque::push_back(JobHandle&& job)
+      {
+        const rsl::unique_lock lock(m_access_lock);
+
+        if(m_count == m_jobs.size())
+        {
+          grow();
+        }
+
+        const s32 mask = m_jobs.size() - 1;
+        m_jobs[(m_head + m_count) & mask] = rsl::move(job);
+        ++m_count;
+      }
+
+      // Remove the job at the back of the deque and return it
+      // returns an empty handle if the deque is empty
+      JobHandle JobDeque::pop_back()
+      {
+        const rsl::unique_lock lock(m_access_lock);
+
+        if(m_count == 0)
+        {
+          return JobHandle();
+        }
+
+        --m_count;
+        const s32 mask = m_jobs.size() - 1;
+        return rsl::move(m_jobs[(m_head + m_count) & mask]);
+      }
+
+      // Remove the job at the front of the deque and return it
+      // returns an empty handle if the deque is empty
+      JobHandle JobDeque::steal()
+      {
+        const rsl::unique_lock lock(m_access_lock);
+
+        if(m_count == 0)
+        {
+          return JobHandle();
+        }
+
+        const s32 mask = m_jobs.size() - 1;
+        JobHandle job = rsl::move(m_jobs[m_head]);
+        m_head = (m_head + 1) & mask;
+        --m_count;
+
+        return job;
+      }
+
+      // Returns the number of jobs in the deque
+      s32 JobDeque::size() const
+      {
+        const rsl::unique_lock lock(m_access_lock);
+        return m_count;
+      }
+
+      // Double the capacity of the ring buffer, keeping the order of the jobs
+      void JobDeque::grow()
+      {
+        const s32 old_capacity = m_jobs.size();
+        const s32 mask         = old_capacity - 1;
+
+        rsl::vector<JobHandle> new_jobs;
+        new_jobs.resize(old_capacity * 2);
+        for(s32 idx = 0; idx < m_count; ++idx)
+        {
+          new_jobs[idx] = rsl::move(m_jobs[(m_head + idx) & mask]);
+        }
+
+        m_jobs = rsl::move(new_jobs);
+        m_head = 0;
+      }
+    } // namespace internal
+  } // namespace task_system
+} // namespace rex
@@ -0,0 +1,91 @@
+#include "rex_engine/task_system/job_handle.h"
+
+#include "rex_engine/task_system/job.h"
+#include "rex_std/utility.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    JobHandle::JobHandle()
+        : m_job(nullptr)
+    {
+    }
+
+    JobHandle::JobHandle(Job* job)
+        : m_job(job)
+    {
+      if(m_job)
+      {
+        m_job->add_ref();
+      }
+    }
+
+    JobHandle::JobHandle(const JobHandle& other)
+        : JobHandle(other.m_job)
+    {
+    }
+
+    JobHandle::JobHandle(JobHandle&& other)
+        : m_job(rsl::exchange(other.m_job, nullptr))
+    {
+    }
+
+    JobHandle::~JobHandle()
+    {
+      reset();
+    }
+
+    JobHandle& JobHandle::operator=(const JobHandle& other)
+    {
+      if(other.m_job)
+      {
+        other.m_job->add_ref();
+      }
+      reset();
+      m_job = other.m_job;
+
+      return *this;
+    }
+
+    JobHandle& JobHandle::operator=(JobHandle&& other)
+    {
+      if(this != &other)
+      {
+        reset();
+        m_job = rsl::exchange(other.m_job, nullptr);
+      }
+
+      return *this;
+    }
+
+    // Release the reference to the job, if any
+    void JobHandle::reset()
+    {
+      if(m_job)
+      {
+        rsl::exchange(m_job, nullptr)->release_ref();
+      }
+    }
+
+    Job* JobHandle::get() const
+    {
+      return m_job;
+    }
+
+    Job* JobHandle::operator->() const
+    {
+      return m_job;
+    }
+
+    Job& JobHandle::operator*() const
+    {
+      return *m_job;
+    }
+
+    JobHandle::operator bool() const
+    {
+      return m_job != nullptr;
+    }
+  } // namespace task_system
+} // namespace rex
@@ -0,0 +1,86 @@
+#include "rex_engine/task_system/internal/job_pool.h"
+
+#include "rex_std/mutex.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    namespace internal
+    {
+      // The number of jobs allocated at once when the pool runs out of free jobs
+#ifdef REX_JOB_POOL_BLOCK_SIZE
+      inline constexpr s32 g_job_pool_block_size = REX_JOB_POOL_BLOCK_SIZE;
+#else
+      inline constexpr s32 g_job_pool_block_size = 256;
+#endif
+
+      JobPool::JobPool()
+          : m_blocks()
+          , m_first_free_job(nullptr)
+          , m_access_lock()
+      {
+      }
+
+      JobPool::~JobPool()
+      {
+        // jobs are owned by the blocks, so they'll get destroyed with them
+        m_first_free_job = nullptr;
+      }
+
+      // Take a job from the pool, growing the pool if no free jobs are left
+      JobHandle JobPool::acquire()
+      {
+        Job* job = nullptr;
+        {
+          const rsl::unique_lock lock(m_access_lock);
+          if(m_first_free_job == nullptr)
+          {
+            grow();
+          }
+
+          job              = m_first_free_job;
+          m_first_free_job = job->m_next_free;
+        }
+
+        job->m_next_free = nullptr;
+        return JobHandle(job);
+      }
+
+      // Return a job that's no longer referenced back to the pool
+      void JobPool::release(Job* job)
+      {
+        const rsl::unique_lock lock(m_access_lock);
+        job->m_next_free = m_first_free_job;
+        m_first_free_job = job;
+      }
+
+      // Return the number of jobs allocated by the pool
+      s32 JobPool::num_allocated_jobs() const
+      {
+        const rsl::unique_lock lock(m_access_lock);
+        return m_blocks.size() * g_job_pool_block_size;
+      }
+
+      // Allocate a new block of jobs and add them to the free list
+      void JobPool::grow()
+      {
+        rsl::unique_array<Job> block = rsl::make_unique<Job[]>(g_job_pool_block_size); // NOLINT(modernize-avoid-c-arrays)
+        for(s32 idx = 0; idx < g_job_pool_block_size; ++idx)
+        {
+          block[idx].m_next_free = m_first_free_job;
+          m_first_free_job       = &block[idx];
+        }
+
+        m_blocks.push_back(rsl::move(block));
+      }
+
+      // Return the global pool all jobs are allocated from
+      JobPool& job_pool()
+      {
+        static JobPool pool;
+        return pool;
+      }
+    } // namespace internal
+  } // namespace task_system
+} // namespace rex
@@ -0,0 +1,64 @@
+#include "rex_engine/task_system/parallel_for.h"
+
+#include "rex_engine/threading/thread_pool.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/thread.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    namespace internal
+    {
+      // The number of chunks each thread gets when the grain size is picked automatically
+      constexpr s32 g_num_chunks_per_thread = 4;
+
+      // Return the grain size to use to split the range into chunks
+      // If no grain size is given, the range gets split so that every thread gets a few chunks
+      // this leaves some room for balancing work between threads when some chunks are slower than others
+      s32 calc_grain_size(const IndexRange& range, s32 grainSize)
+      {
+        if(grainSize > 0)
+        {
+          return grainSize;
+        }
+
+        const ThreadPool* pool = thread_pool::instance();
+        const s32 num_threads  = pool ? pool->num_threads() + 1 : 1; // +1 for the calling thread
+        const s32 count        = range.end - range.begin;
+
+        return rsl::max(count / (num_threads * g_num_chunks_per_thread), 1);
+      }
+
+      // Return the number of helper jobs to queue to process the given number of chunks
+      // The calling thread processes chunks as well, so it doesn't count as a helper
+      s32 calc_num_helpers(s32 numChunks)
+      {
+        const ThreadPool* pool = thread_pool::instance();
+        if(pool == nullptr)
+        {
+          return 0;
+        }
+
+        return rsl::min(numChunks - 1, pool->num_threads());
+      }
+
+      // Block until all the given tasks have finished
+      // While waiting, the calling thread executes pending jobs
+      // so that waiting from within a job doesn't stall the task system
+      void wait_while_helping(rsl::vector<Task<void>>& tasks)
+      {
+        for(Task<void>& task: tasks)
+        {
+          while(!task.is_finished())
+          {
+            if(!run_pending_job())
+            {
+              rsl::this_thread::yield();
+            }
+          }
+        }
+      }
+    } // namespace internal
+  } // namespace task_system
+} // namespace rex
@@ -1,14 +1,20 @@
 #include "rex_engine/task_system/task_system.h"
 
 #include "rex_engine/diagnostics/assert.h"
-#include "rex_engine/system/system_info.h"
+#include "rex_engine/task_system/internal/job_deque.h"
+#include "rex_engine/task_system/internal/job_pool.h"
+#include "rex_engine/task_system/internal/task_system_limits.h"
+#include "rex_engine/task_system/task_system_telemetry.h"
+#include "rex_engine/threading/spin_lock.h"
 #include "rex_engine/threading/thread_event.h"
 #include "rex_engine/threading/thread_pool.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/array.h"
 #include "rex_std/atomic.h"
 #include "rex_std/bonus/platform.h"
-#include "rex_std/iostream.h"
+#include "rex_std/bonus/utility/enum_reflection.h"
+#include "rex_std/memory.h"
 #include "rex_std/mutex.h"
-#include "rex_std/vector.h"
 
 namespace rex
 {
@@ -16,169 +22,625 @@ namespace rex
   {
     namespace internal
     {
-      class JobQueue
+      // The worker slot owned by the current thread
+      // -1 if the current thread isn't executing jobs for the task system
+      thread_local s32 g_worker_slot = -1; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+      // The number of job priorities, each priority has its own queues
+      inline constexpr s32 g_num_job_priorities = rsl::enum_refl::enum_count<JobPriority>();
+
+      // The deques of a single worker, one for each priority
+      using PriorityJobDeques = rsl::array<JobDeque, g_num_job_priorities>;
+
+      // The job scheduler distributes the jobs over the threads that execute them
+      // Every thread executing jobs claims a worker slot, which comes with its own deques of jobs.
+      // Jobs queued from within a job get pushed onto the deques of the worker running it.
+      // Jobs queued from any other thread (eg. the main thread) go into shared injection queues.
+      // When a worker runs out of jobs in its own deques, it pulls from the injection queues
+      // and if that's empty as well, it tries to steal a job from the other workers.
+      //
+      // Every priority has its own set of queues, all queues of a higher priority
+      // are checked before the ones of a lower priority are.
+      // The exception is background work, once g_max_normal_picks_over_background normal jobs got picked
+      // while a background job was pending, the background job goes first. Frame critical work always goes first.
+      // To make sure frame critical work never has to wait for all workers to finish their bulk work
+      // background jobs are never executed by all workers at the same time
+      class JobScheduler
       {
       public:
-        // check if there are any pending jobs in the queue
-        bool has_pending_jobs()
+        JobScheduler()
+            : m_worker_queues()
+            , m_worker_slot_in_use()
+            , m_num_worker_slots(0)
+            , m_injection_queues()
+            , m_num_pending_jobs()
+            , m_num_executing_background_jobs(0)
+            , m_max_executing_background_jobs(1)
+            , m_num_normal_picks_over_background(0)
         {
-          const rsl::unique_lock lock(m_access_mtx);
-          return !m_queued_jobs.empty();
+          for(rsl::atomic<bool>& in_use: m_worker_slot_in_use)
+          {
+            in_use.store(false);
+          }
+          for(rsl::atomic<s32>& num_pending_jobs: m_num_pending_jobs)
+          {
+            num_pending_jobs.store(0);
+          }
         }
 
-        // return the first pending job in the queue
-        rsl::shared_ptr<Job> pop_job()
+        // Add a new job to be executed
+        // If the calling thread is a worker, the job is added to its own deque
+        // otherwise it's added to the injection queue
+        void push_job(JobHandle&& job)
         {
-          if(!has_pending_jobs())
+          const s32 priority = static_cast<s32>(job->priority());
+          if(g_worker_slot != -1)
+          {
+            m_worker_queues[g_worker_slot][priority].push_back(rsl::move(job));
+          }
+          else
           {
-            return nullptr;
+            m_injection_queues[priority].push_back(rsl::move(job));
           }
 
-          const rsl::unique_lock lock(m_access_mtx);
-          rsl::shared_ptr<Job> job = rsl::move(m_queued_jobs.front());
-          m_queued_jobs.erase(m_queued_jobs.begin());
+          ++m_num_pending_jobs[priority];
 
-          return job;
+          s64 queue_depth = 0;
+          for(const rsl::atomic<s32>& num_pending_jobs: m_num_pending_jobs)
+          {
+            queue_depth += num_pending_jobs.load(rsl::memory_order_relaxed);
+          }
+          record_queue_depth(g_worker_slot, queue_depth);
         }
 
-        // Add a new job to the queue
-        void push_job(rsl::shared_ptr<Job>&& job)
+        // Find the next job to execute for a worker
+        // Returns an empty handle if no job is pending
+        JobHandle find_job(s32 workerSlot)
         {
-          const rsl::unique_lock lock(m_access_mtx);
-          m_queued_jobs.push_back(rsl::move(job));
+          // A background job that got passed over by too many normal jobs goes first
+          if(m_num_normal_picks_over_background.load() >= g_max_normal_picks_over_background && m_num_pending_jobs[static_cast<s32>(JobPriority::FrameCritical)].load() == 0)
+          {
+            JobHandle job = find_background_job(workerSlot);
+            if(job)
+            {
+              return job;
+            }
+          }
+
+          for(s32 priority = 0; priority < g_num_job_priorities; ++priority)
+          {
+            if(m_num_pending_jobs[priority].load() == 0)
+            {
+              continue;
+            }
+
+            if(priority == static_cast<s32>(JobPriority::Background))
+            {
+              return find_background_job(workerSlot);
+            }
+
+            JobHandle job = find_job(workerSlot, priority);
+            if(job)
+            {
+              --m_num_pending_jobs[priority];
+              if(priority == static_cast<s32>(JobPriority::Normal) && m_num_pending_jobs[static_cast<s32>(JobPriority::Background)].load() > 0)
+              {
+                ++m_num_normal_picks_over_background;
+              }
+              return job;
+            }
+          }
+
+          return JobHandle();
         }
 
-        // Increase the internal counter of job threads
-        void inc_num_executing_job_threads()
+        // Notify the scheduler that a job it handed out has finished executing
+        void finish_job(const JobHandle& job)
         {
-          m_num_executing_job_threads++;
+          if(job->priority() == JobPriority::Background)
+          {
+            --m_num_executing_background_jobs;
+          }
         }
 
-        // decrease the internal counter of job threads
-        void dec_num_executing_job_threads()
+        // check if there are any pending jobs in the queue that are allowed to execute
+        bool has_pending_jobs() const
         {
-          m_num_executing_job_threads--;
+          for(s32 priority = 0; priority < g_num_job_priorities; ++priority)
+          {
+            if(m_num_pending_jobs[priority].load() == 0)
+            {
+              continue;
+            }
+
+            if(priority != static_cast<s32>(JobPriority::Background) || m_num_executing_background_jobs.load() < m_max_executing_background_jobs.load())
+            {
+              return true;
+            }
+          }
+
+          return false;
         }
 
-        // get the number of currently running job threads
-        s32 num_executing_job_threads()
+        // Set the number of workers that are allowed to execute background jobs at the same time
+        void set_max_executing_background_jobs(s32 maxBackgroundJobs)
+        {
+          m_max_executing_background_jobs = rsl::max(maxBackgroundJobs, 1);
+        }
+
+        // Claim a free worker slot, returns -1 if all slots are taken
+        // in which case the worker only pulls from the injection queue and steals from others
+        s32 claim_worker_slot()
+        {
+          for(s32 slot = 0; slot < g_max_task_workers; ++slot)
+          {
+            bool expected = false;
+            if(m_worker_slot_in_use[slot].compare_exchange_strong(expected, true))
+            {
+              // Keep track of the highest slot ever claimed, so we know how many deques to steal from
+              s32 num_slots = m_num_worker_slots.load();
+              while(num_slots < slot + 1 && !m_num_worker_slots.compare_exchange_weak(num_slots, slot + 1))
+              {
+              }
+
+              return slot;
+            }
+          }
+
+          return -1;
+        }
+        // Release a previously claimed worker slot so it can be used by another worker
+        void release_worker_slot(s32 slot)
         {
-          return m_num_executing_job_threads;
+          if(slot != -1)
+          {
+            m_worker_slot_in_use[slot].store(false);
+          }
         }
 
       private:
-        // This holds all the jobs that are queued and waiting to be executed
+        // Find a background job, returns an empty handle if none is pending
+        // Background jobs are only executed when there's a worker left for other work
+        JobHandle find_background_job(s32 workerSlot)
+        {
+          constexpr s32 priority = static_cast<s32>(JobPriority::Background);
+          if(m_num_pending_jobs[priority].load() == 0 || !try_reserve_background_job())
+          {
+            return JobHandle();
+          }
+
+          JobHandle job = find_job(workerSlot, priority);
+          if(!job)
+          {
+            --m_num_executing_background_jobs;
+            return job;
+          }
+
+          --m_num_pending_jobs[priority];
+          m_num_normal_picks_over_background = 0;
+          return job;
+        }
+
+        // Find a job of the given priority
+        JobHandle find_job(s32 workerSlot, s32 priority)
+        {
+          JobHandle job;
+
+          // Look in our own deque first, it holds the jobs we queued most recently
+          if(workerSlot != -1)
+          {
+            job = m_worker_queues[workerSlot][priority].pop_back();
+          }
+
+          // Then look for jobs that got queued from outside the task system
+          if(!job)
+          {
+            job = m_injection_queues[priority].steal();
+          }
+
+          // Finally try to steal a job from one of the other workers
+          if(!job)
+          {
+            job = steal_job(workerSlot, priority);
+          }
+
+          return job;
+        }
+
+        // Go over the deques of all the other workers and steal the first job found
+        // We start with the worker next to us, so that not every thief hits the same victim
+        JobHandle steal_job(s32 thiefSlot, s32 priority)
+        {
+          const s32 num_slots = m_num_worker_slots.load();
+          const s32 first_victim = thiefSlot + 1;
+          for(s32 idx = 0; idx < num_slots; ++idx)
+          {
+            const s32 victim = (first_victim + idx) % num_slots;
+            if(victim == thiefSlot)
+            {
+              continue;
+            }
+
+            JobHandle job = m_worker_queues[victim][priority].steal();
+            if(job)
+            {
+              record_steal(thiefSlot);
+              return job;
+            }
+          }
+
+          return JobHandle();
+        }
+
+        // Reserve the right to execute a background job
+        // Returns false if the maximum number of background jobs are already executing
+        bool try_reserve_background_job()
+        {
+          s32 num_executing = m_num_executing_background_jobs.load();
+          while(num_executing < m_max_executing_background_jobs.load())
+          {
+            if(m_num_executing_background_jobs.compare_exchange_weak(num_executing, num_executing + 1))
+            {
+              return true;
+            }
+          }
+
+          return false;
+        }
+
+      private:
+        // The deques owned by the workers, indexed by worker slot
+        rsl::array<PriorityJobDeques, g_max_task_workers> m_worker_queues;
+
+        // Flags indicating if a worker slot is currently owned by a worker
+        rsl::array<rsl::atomic<bool>, g_max_task_workers> m_worker_slot_in_use;
+
+        // The highest worker slot that got claimed + 1
+        rsl::atomic<s32> m_num_worker_slots;
+
+        // This holds the jobs queued from threads that aren't workers
+        PriorityJobDeques m_injection_queues;
+
+        // The number of jobs of each priority that are queued and waiting to be executed
         // as soon as a thread becomes available
-        rsl::vector<rsl::shared_ptr<Job>> m_queued_jobs;
+        rsl::array<rsl::atomic<s32>, g_num_job_priorities> m_num_pending_jobs;
 
-        // A mutex that needs locking when accessing the queued jobs queue
-        rsl::mutex m_access_mtx;
+        // The number of background jobs currently executing and the maximum allowed
+        rsl::atomic<s32> m_num_executing_background_jobs;
+        rsl::atomic<s32> m_max_executing_background_jobs;
 
-        // This holds the number of threads current used for running jobs
-        // If this reaches 0, a new thread NEEDS to be allocated when a job gets queued
-        // in order for it to get executed
-        rsl::atomic<s32> m_num_executing_job_threads;
+        // The number of normal jobs picked while a background job was pending, since the last background job got picked
+        rsl::atomic<s32> m_num_normal_picks_over_background;
       };
 
-      // The global job queue of all jobs that are pending execution
-      JobQueue g_job_queue; // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+      // The global scheduler of all jobs that are pending execution
+      JobScheduler g_job_scheduler; // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+
+      // The jobs that can only be executed on the main thread
+      JobDeque g_main_thread_jobs; // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+
+      // Run a job on the calling thread and record how long it waited and ran for
+      void run_job(const JobHandle& job)
+      {
+        const s64 start_time = telemetry_timestamp();
+        job->run();
+        const s64 end_time = telemetry_timestamp();
+
+        record_job_executed(g_worker_slot, job->submit_time(), start_time, end_time);
+      }
+
+      // Execute a job handed out by the scheduler
+      void execute_job(const JobHandle& job)
+      {
+        run_job(job);
+        g_job_scheduler.finish_job(job);
+      }
+
+      // A thread that keeps executing jobs for as long as the thread pool it came from is alive
+      // When it runs out of jobs, it parks itself until a new job gets queued
+      struct JobWorker
+      {
+        ThreadHandle thread;
+        // Signaled to wake up the worker when it's parked
+        ThreadEvent wake_event;
+        // Signaled when the worker has stopped executing jobs
+        ThreadEvent exit_event;
+      };
 
-      // A wrapper around a thread holding a job.
-      // Jobs are owned by both the thread that executes them
-      // and the task that's owned by the user
-      // only when both go out of scope
-      // does the job get destroyed
-      class JobThread
+      // The persistent workers executing jobs
+      // They take all threads of the thread pool and return them when the pool gets destroyed
+      // Idle workers park on their own event and get woken up one at a time when jobs get queued
+      // so queuing a job never has to hand over a thread to execute it
+      class JobWorkers
       {
       public:
-        explicit JobThread(ThreadHandle thread)
-            : m_thread_handle(rsl::move(thread))
-            , m_job(nullptr)
-            , m_wait_for_start_event()
+        explicit JobWorkers(ThreadPool* pool)
+            : m_workers()
+            , m_parked_workers()
+            , m_parked_workers_lock()
+            , m_num_parked_workers(0)
+            , m_should_stop(false)
         {
+          m_workers.reserve(pool->num_threads());
+          m_parked_workers.reserve(pool->num_threads());
+
+          ThreadHandle thread = pool->acquire_idle_thread();
+          while(thread.thread() != nullptr)
+          {
+            m_workers.push_back(rsl::make_unique<JobWorker>());
+            JobWorker* worker = m_workers.back().get();
+            worker->thread    = rsl::move(thread);
+            worker->thread.run(
+                [this, worker](void*)
+                {
+                  run(worker);
+                  return 0;
+                });
+
+            thread = pool->acquire_idle_thread();
+          }
+
+          REX_ASSERT_X(!m_workers.empty(), "No idle threads available in the thread pool to execute jobs");
+
+          // Always keep a worker available for jobs that aren't background jobs
+          g_job_scheduler.set_max_executing_background_jobs(m_workers.size() - 1);
         }
 
-        // Blocking function that waits for the job thread to have started
-        void wait_for_start()
+        // Wake up a single parked worker, if any
+        void wake_one()
         {
-          m_wait_for_start_event.wait_for_me();
+          // Fast path, all workers are already executing jobs
+          if(m_num_parked_workers.load() == 0)
+          {
+            return;
+          }
+
+          JobWorker* worker = nullptr;
+          {
+            const rsl::unique_lock lock(m_parked_workers_lock);
+            if(!m_parked_workers.empty())
+            {
+              worker = m_parked_workers.back();
+              m_parked_workers.pop_back();
+              --m_num_parked_workers;
+            }
+          }
+
+          if(worker)
+          {
+            worker->wake_event.signal();
+          }
         }
 
-        // Start a job to be run on the thread that's owned by this class
-        // after the job has finished, check if other jobs are pending
-        // and keep using this thread to use them
-        void start_job(rsl::shared_ptr<Job>&& job)
+        // Let the workers finish all pending jobs and wait for them to stop
+        // Afterwards, all threads are returned to the thread pool
+        void stop()
         {
-          m_job = rsl::move(job);
-          m_thread_handle.run(
-              [this](void*)
-              {
-                // When this thread starts, take away the ownership of the thread handle and the job and let it be managed by this callable
-                // this allows the thread that runs this callable to be automatically be added to the thread pool again after it finished executing
-                const ThreadHandle thread_handle = rsl::move(m_thread_handle);
-                rsl::shared_ptr<Job> job                    = rsl::move(m_job);
+          m_should_stop = true;
+          while(m_num_parked_workers.load() > 0)
+          {
+            wake_one();
+          }
 
-                // signal that this job thread has started
-                // After this, the this pointer can be invalid, so we can't access it anymore
-                m_wait_for_start_event.signal();
+          for(rsl::unique_ptr<JobWorker>& worker: m_workers)
+          {
+            worker->exit_event.wait_for_me();
+          }
 
-                // Keep running jobs until there are none left
-                while(job)
-                {
-                  // Make sure we reset the job after we execute it
-                  // to not leave any trailing references to it behind.
-                  job->run();
-                  job.reset();
+          m_workers.clear();
+        }
+
+      private:
+        // Keep executing jobs on the current thread until the workers are stopped
+        void run(JobWorker* worker)
+        {
+          const s32 worker_slot = g_job_scheduler.claim_worker_slot();
+          g_worker_slot         = worker_slot;
+
+          while(true)
+          {
+            // Make sure we reset the job after we execute it
+            // to not leave any trailing references to it behind.
+            JobHandle job = g_job_scheduler.find_job(worker_slot);
+            if(job)
+            {
+              execute_job(job);
+              continue;
+            }
+
+            if(m_should_stop)
+            {
+              break;
+            }
+
+            park(worker);
+          }
+
+          g_worker_slot = -1;
+          g_job_scheduler.release_worker_slot(worker_slot);
+          worker->exit_event.signal();
+        }
+
+        // Park the worker until it gets woken up
+        void park(JobWorker* worker)
+        {
+          {
+            const rsl::unique_lock lock(m_parked_workers_lock);
+            m_parked_workers.push_back(worker);
+            ++m_num_parked_workers;
+          }
 
-                  // Check if we have any other pending jobs still in the queue
-                  // If we did, pop the first and execute it on this thread
-                  if(internal::g_job_queue.has_pending_jobs())
-                  {
-                    job = internal::g_job_queue.pop_job();
-                  }
-                }
+          // A job could've been queued after our last look but before we parked ourselves.
+          // The thread that queued it could've seen no parked workers and relies on us to pick it up
+          // so we need to have another look after we parked.
+          if(g_job_scheduler.has_pending_jobs() || m_should_stop)
+          {
+            if(unpark(worker))
+            {
+              return;
+            }
 
-                g_job_queue.dec_num_executing_job_threads();
-                return 0;
-              });
+            // Another thread already took us out of the parked workers and is waking us up
+            // so we need to consume that wake up
+          }
+
+          const s64 park_time = telemetry_timestamp();
+          worker->wake_event.wait_for_me();
+          record_idle_time(g_worker_slot, telemetry_timestamp() - park_time);
+        }
+
+        // Take the worker out of the parked workers
+        // returns false if it was already taken out by another thread to be woken up
+        bool unpark(JobWorker* worker)
+        {
+          const rsl::unique_lock lock(m_parked_workers_lock);
+          auto it = rsl::find(m_parked_workers.begin(), m_parked_workers.end(), worker);
+          if(it == m_parked_workers.end())
+          {
+            return false;
+          }
+
+          *it = m_parked_workers.back();
+          m_parked_workers.pop_back();
+          --m_num_parked_workers;
+          return true;
         }
 
       private:
-        ThreadHandle m_thread_handle;
-        rsl::shared_ptr<Job> m_job;
-        ThreadEvent m_wait_for_start_event;
+        rsl::vector<rsl::unique_ptr<JobWorker>> m_workers;
+        // The workers waiting for jobs to get queued
+        rsl::vector<JobWorker*> m_parked_workers;
+        SpinLock m_parked_workers_lock;
+        rsl::atomic<s32> m_num_parked_workers;
+        rsl::atomic<bool> m_should_stop;
       };
 
-      // Use the given thread and assign a job to it
-      // Then start the job
-      void kick_off_job(ThreadHandle threadHandle, rsl::shared_ptr<Job> job)
+      // The workers that execute the jobs, they're started when the first job gets queued
+      rsl::unique_ptr<JobWorkers> g_job_workers;                // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+      rsl::atomic<JobWorkers*> g_active_job_workers = nullptr; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+      rsl::mutex g_job_workers_mtx;                            // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+
+      // Stop the workers and return their threads to the thread pool
+      void stop_job_workers()
+      {
+        // The workers stay reachable while stopping
+        // as jobs that are still executing can queue new jobs
+        const rsl::unique_lock lock(g_job_workers_mtx);
+        if(g_job_workers)
+        {
+          g_job_workers->stop();
+        }
+        g_active_job_workers = nullptr;
+        g_job_workers.reset();
+      }
+
+      // Return the workers executing jobs, starting them if they haven't been started yet
+      JobWorkers* job_workers()
+      {
+        JobWorkers* workers = g_active_job_workers.load();
+        if(workers)
+        {
+          return workers;
+        }
+
+        const rsl::unique_lock lock(g_job_workers_mtx);
+        if(!g_job_workers)
+        {
+          ThreadPool* pool = thread_pool::instance();
+          g_job_workers    = rsl::make_unique<JobWorkers>(pool);
+
+          // The workers hold on to the threads of the pool until it gets destroyed
+          pool->add_destroy_callback([]() { stop_job_workers(); });
+        }
+
+        g_active_job_workers = g_job_workers.get();
+        return g_job_workers.get();
+      }
+
+      // Take a recycled job from the job pool
+      JobHandle acquire_job()
       {
-        JobThread job_thread(rsl::move(threadHandle));
-        job_thread.start_job(rsl::move(job));
-        job_thread.wait_for_start();
-        g_job_queue.inc_num_executing_job_threads();
+        return job_pool().acquire();
       }
     } // namespace internal
 
-    // If there's a idle thread available, execute the job immediately
-    // If not, assign the thread to the queue and it'll be executed
-    // when all previous jobs are processed
-    rsl::shared_ptr<Job> add_job_to_queue(rsl::shared_ptr<Job> job)
+    // Queue the job for execution
+    // If there's a parked worker, it's woken up to execute the job
+    // If not, the job will be executed by one of the workers currently executing jobs
+    // as soon as it's finished with the jobs queued before it
+    JobHandle add_job_to_queue(JobHandle job)
     {
+      job->mark_submitted(internal::telemetry_timestamp());
+
+      // Main thread jobs don't need a worker, they wait until the main thread drains them
+      if(job->affinity() == JobAffinity::MainThread)
+      {
+        internal::g_main_thread_jobs.push_back(JobHandle(job));
+        return job;
+      }
+
       REX_ASSERT_X(thread_pool::instance(), "Thread pool is null. Cannot create async jobs");
 
-      if(thread_pool::instance()->has_idle_threads())
+      internal::JobWorkers* workers = internal::job_workers();
+      internal::g_job_scheduler.push_job(JobHandle(job));
+      workers->wake_one();
+
+      return job;
+    }
+
+    // Queue the job as soon as all the given dependencies have finished
+    // If they've all finished already, the job gets queued immediately
+    // The job is kept alive by its dependencies until it's queued
+    JobHandle add_job_after(JobHandle job, const JobCounter& dependencies)
+    {
+      for(const JobHandle& dependency: dependencies.jobs())
       {
-        ThreadHandle thread_handle = thread_pool::instance()->acquire_idle_thread();
-        internal::kick_off_job(rsl::move(thread_handle), rsl::move(job));
+        job->add_dependency();
+
+        // If the dependency has already finished, it won't release us anymore
+        // so we have to do that ourselves
+        if(!dependency->add_continuation(job))
+        {
+          job->release_dependency();
+        }
       }
-      else
+
+      // Release the dependency the job was created with.
+      // If all other dependencies have already finished, we're the ones that need to queue it
+      if(job->release_dependency())
       {
-        REX_ASSERT_X(internal::g_job_queue.num_executing_job_threads() > 0, "Didn't get any free threads from the thread pool and don't have any threads currently processing jobs");
-        internal::g_job_queue.push_job(rsl::move(job));
+        add_job_to_queue(job);
       }
 
       return job;
     }
+
+    // Execute a single pending job on the calling thread
+    // Returns false if there was no job pending
+    bool run_pending_job()
+    {
+      JobHandle job = internal::g_job_scheduler.find_job(internal::g_worker_slot);
+      if(!job)
+      {
+        return false;
+      }
+
+      internal::execute_job(job);
+      return true;
+    }
+
+    // Execute all jobs that are queued to run on the main thread
+    // Jobs queued while draining are executed the next time the queue gets drained
+    s32 run_main_thread_jobs()
+    {
+      const s32 num_jobs = internal::g_main_thread_jobs.size();
+      for(s32 idx = 0; idx < num_jobs; ++idx)
+      {
+        const JobHandle job = internal::g_main_thread_jobs.steal();
+        internal::run_job(job);
+      }
+
+      return num_jobs;
+    }
   } // namespace task_system
-} // namespace rex
\ No newline at end of file
+} // namespace rex
@@ -0,0 +1,242 @@
+#include "rex_engine/task_system/task_system_telemetry.h"
+
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/task_system/internal/task_system_limits.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/atomic.h"
+#include "rex_std/chrono.h"
+
+namespace rex
+{
+  namespace task_system
+  {
+    DEFINE_LOG_CATEGORY(LogTaskSystem);
+
+    namespace internal
+    {
+      // The counters of a single worker slot
+      // Every worker only writes to its own counters, so relaxed atomics are enough
+      // and the counters are cache line aligned so workers don't contend with each other
+      struct alignas(64) WorkerCounters
+      {
+        rsl::atomic<s64> busy_time;
+        rsl::atomic<s64> idle_time;
+        rsl::atomic<s64> num_jobs_executed;
+        rsl::atomic<s64> num_steals;
+        rsl::atomic<s64> max_queue_depth;
+        rsl::array<rsl::atomic<s64>, g_num_latency_buckets> submit_to_start;
+        rsl::array<rsl::atomic<s64>, g_num_latency_buckets> start_to_finish;
+      };
+
+      // One set of counters for every worker slot
+      // the last one is shared by all threads that don't own a worker slot
+      rsl::array<WorkerCounters, g_max_task_workers + 1> g_worker_counters; // NOLINT(fuchsia-statically-constructed-objects, cppcoreguidelines-avoid-non-const-global-variables)
+
+      // Return the counters of the given worker slot
+      WorkerCounters& worker_counters(s32 workerSlot)
+      {
+        return workerSlot == -1 ? g_worker_counters[g_max_task_workers] : g_worker_counters[workerSlot];
+      }
+
+      // Return the histogram bucket a latency in nanoseconds falls in
+      s32 latency_bucket(s64 latency)
+      {
+        s64 latency_us = latency / 1000;
+        s32 bucket     = 0;
+        while(latency_us > 0 && bucket < g_num_latency_buckets - 1)
+        {
+          latency_us >>= 1;
+          ++bucket;
+        }
+
+        return bucket;
+      }
+
+      void add_relaxed(rsl::atomic<s64>& counter, s64 value)
+      {
+        counter.fetch_add(value, rsl::memory_order_relaxed);
+      }
+
+      // Copy the counters into the telemetry of a single worker
+      WorkerTelemetry read_counters(const WorkerCounters& counters)
+      {
+        WorkerTelemetry telemetry {};
+        telemetry.busy_time         = rsl::chrono::nanoseconds(counters.busy_time.load(rsl::memory_order_relaxed));
+        telemetry.idle_time         = rsl::chrono::nanoseconds(counters.idle_time.load(rsl::memory_order_relaxed));
+        telemetry.num_jobs_executed = counters.num_jobs_executed.load(rsl::memory_order_relaxed);
+        telemetry.num_steals        = counters.num_steals.load(rsl::memory_order_relaxed);
+        telemetry.max_queue_depth   = counters.max_queue_depth.load(rsl::memory_order_relaxed);
+        for(s32 bucket = 0; bucket < g_num_latency_buckets; ++bucket)
+        {
+          telemetry.submit_to_start.counts[bucket] = counters.submit_to_start[bucket].load(rsl::memory_order_relaxed);
+          telemetry.start_to_finish.counts[bucket] = counters.start_to_finish[bucket].load(rsl::memory_order_relaxed);
+        }
+
+        return telemetry;
+      }
+
+      // Add the telemetry of a worker to the totals
+      void accumulate(TaskSystemTelemetry& total, const WorkerTelemetry& worker)
+      {
+        total.max_queue_depth = rsl::max(total.max_queue_depth, worker.max_queue_depth);
+        for(s32 bucket = 0; bucket < g_num_latency_buckets; ++bucket)
+        {
+          total.submit_to_start.counts[bucket] += worker.submit_to_start.counts[bucket];
+          total.start_to_finish.counts[bucket] += worker.start_to_finish.counts[bucket];
+        }
+      }
+
+      // Log the telemetry of a single worker
+      void dump_worker(rsl::string_view name, s32 idx, const WorkerTelemetry& worker)
+      {
+        const f32 busy_ms = rsl::chrono::duration_cast<rsl::chrono::duration<f32, rsl::milli>>(worker.busy_time).count();
+        const f32 idle_ms = rsl::chrono::duration_cast<rsl::chrono::duration<f32, rsl::milli>>(worker.idle_time).count();
+        REX_INFO(LogTaskSystem, "{} {}: {} jobs, {} steals, busy {}ms, idle {}ms, max queue depth {}", name, idx, worker.num_jobs_executed, worker.num_steals, busy_ms, idle_ms, worker.max_queue_depth);
+      }
+
+      // Log the percentiles of a latency histogram
+      void dump_histogram(rsl::string_view name, const LatencyHistogram& histogram)
+      {
+        REX_INFO(LogTaskSystem, "{}: {} samples, p50 <= {}us, p90 <= {}us, p99 <= {}us", name, histogram.num_samples(), histogram.percentile_upper_bound_us(0.5f), histogram.percentile_upper_bound_us(0.9f), histogram.percentile_upper_bound_us(0.99f));
+      }
+
+      // Return the current time used for job timestamps in nanoseconds
+      s64 telemetry_timestamp()
+      {
+        return rsl::chrono::duration_cast<rsl::chrono::nanoseconds>(rsl::chrono::steady_clock::now().time_since_epoch()).count();
+      }
+
+      // Record that a job was executed by the given worker slot
+      void record_job_executed(s32 workerSlot, s64 submitTime, s64 startTime, s64 endTime)
+      {
+        WorkerCounters& counters = worker_counters(workerSlot);
+        add_relaxed(counters.num_jobs_executed, 1);
+        add_relaxed(counters.busy_time, endTime - startTime);
+        add_relaxed(counters.start_to_finish[latency_bucket(endTime - startTime)], 1);
+
+        // Jobs that got run directly, without getting queued, don't have a submit time
+        const s64 wait_time = submitTime != 0 ? startTime - submitTime : 0;
+        add_relaxed(counters.submit_to_start[latency_bucket(wait_time)], 1);
+      }
+      // Record time a worker spent parked
+      void record_idle_time(s32 workerSlot, s64 idleTime)
+      {
+        add_relaxed(worker_counters(workerSlot).idle_time, idleTime);
+      }
+      // Record that a worker stole a job from another worker
+      void record_steal(s32 workerSlot)
+      {
+        add_relaxed(worker_counters(workerSlot).num_steals, 1);
+      }
+      // Record the number of pending jobs after a job got queued
+      void record_queue_depth(s32 workerSlot, s64 queueDepth)
+      {
+        rsl::atomic<s64>& max_queue_depth = worker_counters(workerSlot).max_queue_depth;
+        s64 current_max                   = max_queue_depth.load(rsl::memory_order_relaxed);
+        while(queueDepth > current_max && !max_queue_depth.compare_exchange_weak(current_max, queueDepth, rsl::memory_order_relaxed))
+        {
+        }
+      }
+    } // namespace internal
+
+    // Returns the total number of latencies recorded
+    s64 LatencyHistogram::num_samples() const
+    {
+      s64 num_samples = 0;
+      for(const s64 count: counts)
+      {
+        num_samples += count;
+      }
+
+      return num_samples;
+    }
+    // Returns the upper bound, in microseconds, of the bucket the given percentile falls in
+    // percentile is expected to be in the range [0, 1]
+    s64 LatencyHistogram::percentile_upper_bound_us(f32 percentile) const
+    {
+      const s64 num_total = num_samples();
+      if(num_total == 0)
+      {
+        return 0;
+      }
+
+      const s64 target = rsl::max(static_cast<s64>(static_cast<f32>(num_total) * percentile), static_cast<s64>(1));
+      s64 num_seen     = 0;
+      for(s32 bucket = 0; bucket < g_num_latency_buckets; ++bucket)
+      {
+        num_seen += counts[bucket];
+        if(num_seen >= target)
+        {
+          return static_cast<s64>(1) << bucket;
+        }
+      }
+
+      return static_cast<s64>(1) << (g_num_latency_buckets - 1);
+    }
+
+    // Gather the telemetry recorded so far
+    // Counters are updated while this is running, so they can be slightly off from each other
+    TaskSystemTelemetry query_telemetry()
+    {
+      TaskSystemTelemetry telemetry {};
+
+      // Only report the slots up to the last one that was ever used
+      s32 num_used_slots = 0;
+      for(s32 slot = 0; slot < internal::g_max_task_workers; ++slot)
+      {
+        const internal::WorkerCounters& counters = internal::g_worker_counters[slot];
+        if(counters.num_jobs_executed.load(rsl::memory_order_relaxed) != 0 || counters.idle_time.load(rsl::memory_order_relaxed) != 0)
+        {
+          num_used_slots = slot + 1;
+        }
+      }
+
+      telemetry.workers.reserve(num_used_slots);
+      for(s32 slot = 0; slot < num_used_slots; ++slot)
+      {
+        telemetry.workers.push_back(internal::read_counters(internal::g_worker_counters[slot]));
+        internal::accumulate(telemetry, telemetry.workers.back());
+      }
+
+      telemetry.external = internal::read_counters(internal::g_worker_counters[internal::g_max_task_workers]);
+      internal::accumulate(telemetry, telemetry.external);
+
+      return telemetry;
+    }
+
+    // Reset all telemetry back to 0
+    void reset_telemetry()
+    {
+      for(internal::WorkerCounters& counters: internal::g_worker_counters)
+      {
+        counters.busy_time.store(0, rsl::memory_order_relaxed);
+        counters.idle_time.store(0, rsl::memory_order_relaxed);
+        counters.num_jobs_executed.store(0, rsl::memory_order_relaxed);
+        counters.num_steals.store(0, rsl::memory_order_relaxed);
+        counters.max_queue_depth.store(0, rsl::memory_order_relaxed);
+        for(s32 bucket = 0; bucket < g_num_latency_buckets; ++bucket)
+        {
+          counters.submit_to_start[bucket].store(0, rsl::memory_order_relaxed);
+          counters.start_to_finish[bucket].store(0, rsl::memory_order_relaxed);
+        }
+      }
+    }
+
+    // Log the telemetry recorded so far
+    void dump_telemetry()
+    {
+      const TaskSystemTelemetry telemetry = query_telemetry();
+
+      REX_INFO(LogTaskSystem, "Task system telemetry");
+      for(s32 idx = 0; idx < telemetry.workers.size(); ++idx)
+      {
+        internal::dump_worker("Worker", idx, telemetry.workers[idx]);
+      }
+      internal::dump_worker("External threads", 0, telemetry.external);
+
+      REX_INFO(LogTaskSystem, "Max queue depth: {}", telemetry.max_queue_depth);
+      internal::dump_histogram("Submit to start", telemetry.submit_to_start);
+      internal::dump_histogram("Start to finish", telemetry.start_to_finish);
+    }
+  } // namespace task_system
+} // namespace rex
@@ -20,8 +20,8 @@ namespace rex
 
 		json::json read_from_file(rsl::string_view filepath)
 		{
-			rex::memory::Blob file_content = rex::vfs::instance()->read_file(filepath);
-			return rex::json::parse(file_content);
+			const rex::MappedFile file_content = rex::vfs::instance()->map_file(filepath);
+			return rex::json::parse(file_content.view());
 		}
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "rex_engine/threading/thread_pool.h"
 
+#include "rex_engine/diagnostics/assert.h"
 #include "rex_engine/system/system_info.h"
 #include "rex_engine/threading/thread_event.h"
 #include "rex_std/atomic.h"
@@ -9,24 +10,37 @@
 namespace rex
 {
 	ThreadPool::ThreadPool()
-	{
 		// To maximize core usage, we query the amount of local processors
 		// and create a thread for each one of them.
-		const s32 num_threads_to_spawn = rex::sys_info::num_logical_processors();
-		m_threads.reserve(num_threads_to_spawn);
-		m_idle_threads.reserve(num_threads_to_spawn);
+		: ThreadPool(rex::sys_info::num_logical_processors())
+	{
+	}
+
+	ThreadPool::ThreadPool(s32 numThreads)
+	{
+		REX_ASSERT_X(numThreads > 0, "A thread pool needs at least 1 thread. num threads: {}", numThreads);
 
-		for (s32 idx = 0; idx < num_threads_to_spawn; ++idx)
+		m_threads.reserve(numThreads);
+		m_idle_threads.reserve(numThreads);
+
+		for (s32 idx = 0; idx < numThreads; ++idx)
 		{
 			m_threads.push_back(rsl::make_unique<internal::Thread>());
 			m_idle_threads.push_back(m_threads.back().get());
 		}
 	}
 
-	//ThreadPool::~ThreadPool()
-	//{
+	ThreadPool::~ThreadPool()
+	{
+		destroy_threads();
+	}
 
-	//}
+	// Return the total number of threads owned by the pool
+	// This only changes when the threads get destroyed
+	s32 ThreadPool::num_threads() const
+	{
+		return m_threads.size();
+	}
 
 	// Query if we have any idle threads available
 	// An idle thread is a thread that's not executing a job at the moment.
@@ -58,9 +72,29 @@ namespace rex
 		m_idle_threads.push_back(thread);
 	}
 
+	// Register a callable that gets called before the threads get destroyed
+	// Systems that keep threads of the pool busy indefinitely use this
+	// to finish their work and return the threads, so they can be joined
+	void ThreadPool::add_destroy_callback(rsl::function<void()>&& callback)
+	{
+		const rsl::unique_lock lock(m_threads_access_mtx);
+		m_destroy_callbacks.push_back(rsl::move(callback));
+	}
+
 	// Destroy all threads. Used at shutdown of the engine
 	void ThreadPool::destroy_threads()
 	{
+		// The callbacks return threads to the pool, so we can't hold the lock while calling them
+		rsl::vector<rsl::function<void()>> destroy_callbacks;
+		{
+			const rsl::unique_lock lock(m_threads_access_mtx);
+			destroy_callbacks = rsl::move(m_destroy_callbacks);
+		}
+		for (rsl::function<void()>& callback : destroy_callbacks)
+		{
+			callback();
+		}
+
 		const rsl::unique_lock lock(m_threads_access_mtx);
 		m_idle_threads.clear();
 		m_threads.clear();
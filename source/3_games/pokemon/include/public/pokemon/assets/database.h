@@ -2,7 +2,9 @@
 
 #include "rex_std/memory.h"
 
+#include "rex_engine/memory/blob_view.h"
 #include "rex_engine/text_processing/json.h"
+#include "rex_engine/filesystem/path_id.h"
 
 #include "pokemon/poke_structs.h"
 
@@ -10,9 +12,9 @@ namespace pokemon
 {
 	namespace asset_db
 	{
-		MapData* find_map(rsl::string_view mapPath);
-		MapData* find_map_without_connections(rsl::string_view mapPath);
-		const rsl::unique_array<u8>& find_map_blocks(const MapHeader& mapHeader);
+		MapData* find_map(rex::PathId mapPath);
+		MapData* find_map_without_connections(rex::PathId mapPath);
+		rex::memory::BlobView find_map_blocks(const MapHeader& mapHeader);
 
 		MapHeader load_map_header(const rex::json::json& jsonBlob);
 		MapHeader load_map_header(rsl::string_view mapPath);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rex_engine/engine/types.h"
+#include "rex_engine/filesystem/path_id.h"
 
 namespace pokemon
 {
@@ -73,8 +74,8 @@ namespace pokemon
 	struct MapHeader
 	{
 		rsl::string name;											// name of the map
-		rsl::string map_blocks_filepath;			// path to the map blocks
-		rsl::string map_render_data_filepath;	// path to metadata for rendering (eg blockset)
+		rex::PathId map_blocks_filepath;			// path to the map blocks
+		rex::PathId map_render_data_filepath;	// path to metadata for rendering (eg blockset)
 		s8 width;															// represented in block count
 		s8 height;														// represented in block count
 		s8 border_block_idx;									// Index of the block used for the border if no connection blocks are present
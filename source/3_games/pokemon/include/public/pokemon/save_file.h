@@ -5,6 +5,8 @@
 
 #include "rex_std/bonus/math/point.h"
 
+#include "rex_engine/filesystem/path_id.h"
+
 #include "pokemon/map_coordinates.h"
 
 namespace pokemon
@@ -15,7 +17,7 @@ namespace pokemon
     SaveFile(rsl::string_view filepath);
 
   public:
-    rsl::string current_map_filepath;
+    rex::PathId current_map_filepath;
     TileCoord position;
   };
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "rex_engine/filesystem/vfs.h"
 #include "rex_engine/filesystem/path.h"
 #include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/path_id.h"
 
 #include "rex_engine/text_processing/text_processing.h"
 
@@ -16,54 +17,65 @@ namespace pokemon
 {
 	namespace asset_db
 	{
+		// The maps are keyed by path id, the paths are interned so the keys stay valid
+		// after the json they were read from is gone
+
 		// This holds the information about the map, width, height, blockset to use, ...
-		rsl::unordered_map<rsl::string_view, rsl::unique_ptr<MapData>> g_maps;
+		rsl::unordered_map<rex::PathId, rsl::unique_ptr<MapData>> g_maps;
 
 		// This holds the map blcoks themselves, as in the block indices themselves
-		rsl::unordered_map<rsl::string_view, rsl::unique_array<u8>> g_map_blocks;
+		// The files are mapped into memory, so they're never copied
+		rsl::unordered_map<rex::PathId, rex::MappedFile> g_map_blocks;
 
-		rsl::unordered_map<rsl::string_view, MapRenderData> g_map_render_data;
+		rsl::unordered_map<rex::PathId, MapRenderData> g_map_render_data;
 
-		const rsl::unique_array<u8>& find_map_blocks(const MapHeader& mapHeader)
+		rex::memory::BlobView find_map_blocks(const MapHeader& mapHeader)
 		{
-			if (!g_map_blocks.contains(mapHeader.map_blocks_filepath))
+			// The path id of the map blocks is created when the map header is loaded, so this doesn't rehash the path
+			auto it = g_map_blocks.find(mapHeader.map_blocks_filepath);
+			if (it == g_map_blocks.end())
 			{
-				rex::memory::Blob file_content = rex::vfs::instance()->read_file(mapHeader.map_blocks_filepath);
-				return g_map_blocks.emplace(mapHeader.map_blocks_filepath, rsl::unique_array<u8>(file_content.release_as_array<u8>())).inserted_element->value;
+				rex::MappedFile file_content = rex::vfs::instance()->map_file(mapHeader.map_blocks_filepath.string());
+				return g_map_blocks.emplace(mapHeader.map_blocks_filepath, rsl::move(file_content)).inserted_element->value.view();
 			}
 
-			return g_map_blocks.at(mapHeader.map_blocks_filepath);
+			return it->value.view();
 		}
 
-		MapData* find_map(rsl::string_view mapPath)
+		MapData* find_map(rex::PathId mapPath)
 		{
-			if (!g_maps.contains(mapPath))
+			// The path id is created when the reference to the map is loaded, so this doesn't rehash the path
+			auto it = g_maps.find(mapPath);
+			if (it == g_maps.end())
 			{
-				rsl::unique_ptr<MapData> map_data = load_map_data(mapPath);
-
-				// If the map wasn't fully loaded (eg. it was loaded as a connection)
-				// We need to load it fully now
-				if (!map_data->fully_loaded)
-				{
-					rex::memory::Blob file_content = rex::vfs::instance()->read_file(mapPath);
-					rex::json::json json_blob = rex::json::parse(file_content);
-					load_map_data(map_data.get(), json_blob);
-				}
+				rsl::unique_ptr<MapData> map_data = load_map_data(mapPath.string());
 				return g_maps.emplace(mapPath, rsl::move(map_data)).inserted_element->value.get();
 			}
 
-			return g_maps.at(mapPath).get();
+			// If the map wasn't fully loaded (eg. it was loaded as a connection)
+			// We need to load it fully now
+			MapData* map_data = it->value.get();
+			if (!map_data->fully_loaded)
+			{
+				// The json is only needed while parsing, so map the file instead of copying it into a buffer
+				rex::MappedFile file_content = rex::vfs::instance()->map_file(mapPath.string());
+				rex::json::json json_blob = rex::json::parse(file_content.view());
+				load_map_data(map_data, json_blob);
+			}
+
+			return map_data;
 		}
-		MapData* find_map_without_connections(rsl::string_view mapPath)
+		MapData* find_map_without_connections(rex::PathId mapPath)
 		{
-			if (!g_maps.contains(mapPath))
+			auto it = g_maps.find(mapPath);
+			if (it == g_maps.end())
 			{
-				rsl::unique_ptr<MapData> map_object = load_map_header_only(mapPath);
+				rsl::unique_ptr<MapData> map_object = load_map_header_only(mapPath.string());
 				map_object->fully_loaded = false;
 				return g_maps.emplace(mapPath, rsl::move(map_object)).inserted_element->value.get();
 			}
 
-			return g_maps.at(mapPath).get();
+			return it->value.get();
 		}
 
 		MapHeader load_map_header(const rex::json::json& jsonBlob)
@@ -71,8 +83,8 @@ namespace pokemon
 			MapHeader map_header{};
 
 			map_header.name = jsonBlob["name"];
-			map_header.map_blocks_filepath = jsonBlob["map_blocks"];
-			map_header.map_render_data_filepath = jsonBlob["tileset"];
+			map_header.map_blocks_filepath = rex::PathId::create(jsonBlob["map_blocks"].get<rsl::string_view>());
+			map_header.map_render_data_filepath = rex::PathId::create(jsonBlob["tileset"].get<rsl::string_view>());
 			map_header.width = jsonBlob["width"];
 			map_header.height = jsonBlob["height"];
 			map_header.border_block_idx = jsonBlob["border_block_idx"];
@@ -99,7 +111,7 @@ namespace pokemon
 				{
 					MapConnection& connection = mapObject->connections.emplace_back();
 					connection.direction = rsl::enum_refl::enum_cast<Direction>(connection_json["direction"].get<rsl::string_view>()).value();
-					connection.map = find_map_without_connections(connection_json["map"]);
+					connection.map = find_map_without_connections(rex::PathId::create(connection_json["map"].get<rsl::string_view>()));
 					connection.offset = connection_json["offset"]; // is in squares (2x2 tiles)
 				}
 			}
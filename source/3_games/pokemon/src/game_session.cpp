@@ -133,7 +133,7 @@ namespace pokemon
 		MapMatrix map_matrix(map_data);
 
 		// Load the map render data, which is the tileset and blockset into memory
-		MapRenderData map_render_data = load_map_render_data(map_data->map_header.map_render_data_filepath);
+		MapRenderData map_render_data = load_map_render_data(map_data->map_header.map_render_data_filepath.string());
 
 		// Load all the warp and bg objects
 
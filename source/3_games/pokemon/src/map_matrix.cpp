@@ -174,7 +174,7 @@ namespace pokemon
       rsl::pointi8 top_left_conn = project_point_to_conn(mapObject, conn, rect.top_left);
 
       // Load the map blocks of the connection so we can assign the right block index to the map matrix
-      const rsl::unique_array<u8>& conn_map_blocks = asset_db::find_map_blocks(conn.map->map_header);
+      const u8* conn_map_blocks = asset_db::find_map_blocks(conn.map->map_header).data_as<u8>();
 
       // Go over the blocks of the connection and assign the block index to the map matrix
       for (s8 y = rect.top_left.y, conn_y = top_left_conn.y; y < rect.bottom_right.y; ++y, ++conn_y)
@@ -197,7 +197,7 @@ namespace pokemon
     s32 height = mapObject->map_header.height;
     s32 width = mapObject->map_header.width;
 
-    const rsl::unique_array<u8>& map_blocks = asset_db::find_map_blocks(mapObject->map_header);
+    const u8* map_blocks = asset_db::find_map_blocks(mapObject->map_header).data_as<u8>();
     for (s8 y = 0; y < height; ++y)
     {
       for (s8 x = 0; x < width; ++x)
@@ -73,7 +73,7 @@ namespace backup_creator
           REX_INFO(LogBackup, "Backing up: {}", fullpath);
           rex::scratch_string backuppath = rex::path::join("H:\\Backup_21_04_2025", rex::path::rel_path(fullpath, root));
           rex::directory::create_recursive(rex::path::parent_path(backuppath));
-          rex::run_async([=]() { rex::file::copy(fullpath, backuppath, rex::file::OverwriteIfExist::yes); });
+          rex::run_async(rex::task_system::JobPriority::Background, [=]() { rex::file::copy(fullpath, backuppath, rex::file::OverwriteIfExist::yes); });
           ++m_backup_info.num_items;
           m_backup_info.size += rex::file::size(fullpath);
         }
@@ -0,0 +1,80 @@
+#include "rex_engine/engine/entrypoint.h"
+#include "rex_engine/cmdline/cmdline.h"
+#include "rex_engine/engine/engine.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/filesystem/pak_archive.h"
+#include "rex_engine/filesystem/path.h"
+
+#include "rex_engine/event_system/event_system.h"
+#include "rex_engine/event_system/events/app/quit_app.h"
+#include "rex_engine/profiling/timer.h"
+
+DEFINE_LOG_CATEGORY(LogPakBuilder);
+
+// The pak builder packs every file under a directory into a single .rexpak archive
+// eg. PakBuilder -Root=data/rex creates data/rex.rexpak
+// PakBuilder -Project=pokemon packs both the engine and project data, creating data/rex.rexpak and data/pokemon.rexpak
+// The engine mounts the archives on top of the directories they were built from
+
+namespace pak_builder
+{
+  bool initialize(const rex::ApplicationCreationParams& /*appCreationParams*/)
+  {
+    return true;
+  }
+  void pack(rsl::string_view root, rsl::string_view output)
+  {
+    rex::Timer timer("pak timer");
+    const rex::Error error = rex::pak::build(root, output);
+    if (!error)
+    {
+      REX_INFO(LogPakBuilder, "Packed {} in {} seconds", root, timer.elapsed_seconds());
+    }
+  }
+
+  void update()
+  {
+    const rsl::optional<rsl::string_view> root = rex::cmdline::instance()->get_argument("Root");
+    const rsl::optional<rsl::string_view> project = rex::cmdline::instance()->get_argument("Project");
+    if (!root.has_value() && !project.has_value())
+    {
+      REX_ERROR(LogPakBuilder, "Nothing to pack was specified. Specify a directory with -Root=<dir> or a project with -Project=<name>");
+      rex::event_system::instance()->enqueue_event(rex::QuitApp("Nothing to pack"));
+      return;
+    }
+
+    if (root.has_value())
+    {
+      const rex::scratch_string default_output = rex::path::change_extension(root.value(), rex::pak::g_extension);
+      pack(root.value(), rex::cmdline::instance()->get_argument("Output").value_or(default_output));
+    }
+
+    // A project needs both the engine data and its own data, the archives are created next to both directories
+    if (project.has_value())
+    {
+      const rsl::string_view engine_root = rex::engine::instance()->engine_root();
+      pack(engine_root, rex::path::change_extension(engine_root, rex::pak::g_extension));
+
+      const rex::scratch_string project_root = rex::path::join(rex::engine::instance()->data_root(), project.value());
+      pack(project_root, rex::path::change_extension(project_root, rex::pak::g_extension));
+    }
+
+    rex::event_system::instance()->enqueue_event(rex::QuitApp("Finished packing"));
+  }
+  void shutdown() {}
+
+} // namespace pak_builder
+
+namespace rex
+{
+  ApplicationCreationParams app_entry(PlatformCreationParams& platformParams)
+  {
+    ApplicationCreationParams app_params(platformParams);
+
+    app_params.engine_params.app_init_func     = pak_builder::initialize;
+    app_params.engine_params.app_update_func   = pak_builder::update;
+    app_params.engine_params.app_shutdown_func = pak_builder::shutdown;
+
+    return app_params;
+  }
+} // namespace rex
@@ -368,8 +368,8 @@ namespace regina
 
 		// This data should be initialized through data, not hardcoded
 		renderpass_desc.renderpass_desc.pso_desc.output_merger.raster_state = rex::gfx::gal::instance()->common_raster_state(rex::gfx::CommonRasterState::DefaultDepth);
-		renderpass_desc.renderpass_desc.pso_desc.shader_pipeline.vs = rex::gfx::shader_lib::instance()->load(rex::path::join(rex::engine::instance()->project_root(), "shaders", "render_tile_vertex.hlsl"), rex::gfx::ShaderType::Vertex);
-		renderpass_desc.renderpass_desc.pso_desc.shader_pipeline.ps = rex::gfx::shader_lib::instance()->load(rex::path::join(rex::engine::instance()->project_root(), "shaders", "render_tile_pixel.hlsl"), rex::gfx::ShaderType::Pixel);
+		renderpass_desc.renderpass_desc.pso_desc.shader_pipeline.vs = rex::gfx::shader_lib::instance()->load(rex::PathId::create(rex::path::join(rex::engine::instance()->project_root(), "shaders", "render_tile_vertex.hlsl")), rex::gfx::ShaderType::Vertex);
+		renderpass_desc.renderpass_desc.pso_desc.shader_pipeline.ps = rex::gfx::shader_lib::instance()->load(rex::PathId::create(rex::path::join(rex::engine::instance()->project_root(), "shaders", "render_tile_pixel.hlsl")), rex::gfx::ShaderType::Pixel);
 		renderpass_desc.renderpass_desc.pso_desc.input_layout =
 		{
 			// Per vertex data
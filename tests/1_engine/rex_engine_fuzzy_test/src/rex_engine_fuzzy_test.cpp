@@ -1,14 +1,50 @@
 #include "rex_fuzzy_test/rex_fuzzy_test.h"
 
+#include "rex_engine/memory/allocators/guard_allocator.h"
+#include "rex_engine/memory/blob.h"
+#include "rex_engine/memory/blob_reader.h"
+#include "rex_engine/memory/memory_tracking.h"
+
+#include "rex_std/array.h"
 #include "rex_std/iostream.h"
+#include "rex_std/memory.h"
 
 namespace rex
 {
   namespace fuzzy
   {
-    int fuzzy_entry(fuzz_span )
+    // Reads length prefixed chunks out of the fuzz input
+    // The input is copied into guarded memory, so any read past its end crashes right at the faulty read
+    void fuzz_blob_reader(fuzz_span input)
+    {
+      rsl::unique_array<rsl::byte> buffer;
+      {
+        REX_MEM_TAG_SCOPE(MemoryTag::FileIO);
+        buffer = rsl::make_unique<rsl::byte[]>(input.size()); // NOLINT(modernize-avoid-c-arrays)
+      }
+      rsl::memcpy(buffer.get(), input.data(), input.size());
+
+      const memory::Blob blob(rsl::move(buffer));
+      memory::BlobReader reader(blob);
+
+      rsl::array<rsl::byte, 256> chunk {};
+      while (reader.read_offset() < static_cast<s32>(blob.size()))
+      {
+        // The chunk size can point past the end of the blob, the reader stops at its end
+        const u8 chunk_size = reader.read<u8>();
+        reader.read(chunk.data(), chunk_size);
+      }
+    }
+
+    int fuzzy_entry(fuzz_span input)
     {
+      // Memory bugs should be found on the exact access that causes them, not when something else ends up corrupted
+      static const bool s_guard_memory = []() { enable_guard_allocator(MemoryTag::FileIO, true); return true; }();
+      REX_UNUSED_PARAM(s_guard_memory);
+
+      fuzz_blob_reader(input);
+
       return 0;
     }
   }
-}
\ No newline at end of file
+}
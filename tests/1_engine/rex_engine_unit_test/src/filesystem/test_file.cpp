@@ -7,6 +7,7 @@
 #include "rex_engine/text_processing/text_processing.h"
 
 #include "rex_std/thread.h"
+#include "rex_std/vector.h"
 
 TEST_CASE("TEST - File - Creation Time")
 {
@@ -131,6 +132,56 @@ TEST_CASE("TEST - File - Reading")
   }
 }
 
+TEST_CASE("TEST - File - Batched Reading")
+{
+  rex::TempCwd tmp_cwd("file_tests");
+
+  const rex::scratch_string test_file = rex::path::abs_path("test_file.txt");
+  const rex::scratch_string empty_file = rex::path::abs_path("empty_file.txt");
+  const rex::scratch_string missing_file = rex::path::abs_path("file_that_doesnt_exist.txt");
+
+  // A batch can read the same file multiple times, every read gets its own blob
+  rsl::vector<rsl::string_view> paths;
+  paths.push_back(test_file);
+  paths.push_back(empty_file);
+  paths.push_back(test_file);
+  paths.push_back(missing_file);
+  paths.push_back(test_file);
+
+  const rsl::vector<rex::memory::Blob> file_contents = rex::file::read_files_abspath(paths);
+  REX_CHECK(file_contents.size() == paths.size());
+
+  for (s32 idx : {0, 2, 4})
+  {
+    REX_CHECK(file_contents[idx].size() == 26);
+    REX_CHECK(rex::memory::blob_to_string_view(file_contents[idx]) == "this is some dummy content");
+  }
+
+  REX_CHECK(file_contents[1].data() == nullptr);
+  REX_CHECK(file_contents[1].size() == 0);
+  REX_CHECK(file_contents[3].data() == nullptr);
+  REX_CHECK(file_contents[3].size() == 0);
+}
+
+TEST_CASE("TEST - File - Mapping")
+{
+  rex::TempCwd tmp_cwd("file_tests");
+
+  const rex::MappedFile test_file = rex::file::map_file("test_file.txt");
+  REX_CHECK(test_file.is_mapped());
+  REX_CHECK(test_file.size() == 26);
+  REX_CHECK(rsl::string_view(test_file.view().data_as<char8>(), 26) == "this is some dummy content");
+
+  // Empty files can't be mapped and don't have any content
+  const rex::MappedFile empty_file = rex::file::map_file("empty_file.txt");
+  REX_CHECK(!empty_file);
+  REX_CHECK(empty_file.size() == 0);
+
+  const rex::MappedFile missing_file = rex::file::map_file("file_that_doesnt_exist.txt");
+  REX_CHECK(!missing_file);
+  REX_CHECK(missing_file.data() == nullptr);
+}
+
 TEST_CASE("TEST - File - Saving")
 {
   rex::TempCwd tmp_cwd("file_tests");
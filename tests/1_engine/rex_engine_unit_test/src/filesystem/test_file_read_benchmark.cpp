@@ -0,0 +1,108 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/filesystem/directory.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/path.h"
+#include "rex_engine/profiling/timer.h"
+#include "rex_engine/diagnostics/log.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/vector.h"
+
+#ifndef REX_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Benchmarks are hidden by default as they take a while to run
+// run them explicitly by passing "[benchmark]" on the commandline
+
+DEFINE_LOG_CATEGORY(LogFileReadBenchmark);
+
+namespace
+{
+	// Returns the absolute paths of all json and blk files under the data directory
+	rsl::vector<rsl::string> data_files()
+	{
+		const rex::scratch_string data_root = rex::path::find_in_parent("data");
+
+		rsl::vector<rsl::string> files;
+		for (const rsl::string_view entry : rex::directory::list_entries(data_root, rex::Recursive::yes))
+		{
+			const rex::scratch_string fullpath = rex::path::join(data_root, entry);
+			const rsl::string_view extension = rex::path::extension(fullpath);
+			if ((extension.ends_with(".json") || extension.ends_with(".blk")) && rex::file::exists_abspath(fullpath))
+			{
+				files.push_back(rsl::string(fullpath));
+			}
+		}
+
+		return files;
+	}
+
+	// Drop the files from the page cache so the next read comes from disk
+	// Windows doesn't allow this for single files, there the cold reads are only as cold as the cache allows
+	void evict_from_cache(const rsl::vector<rsl::string_view>& files)
+	{
+#ifdef REX_PLATFORM_WINDOWS
+		REX_UNUSED_PARAM(files);
+#else
+		for (const rsl::string_view file : files)
+		{
+			const s32 fd = open(file.data(), O_RDONLY | O_CLOEXEC);
+			if (fd >= 0)
+			{
+				posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+				close(fd);
+			}
+		}
+#endif
+	}
+
+	// Returns the time in milliseconds it takes to read all files one by one
+	f32 read_one_by_one(const rsl::vector<rsl::string_view>& files)
+	{
+		rex::Timer timer("file read benchmark");
+		for (const rsl::string_view file : files)
+		{
+			const rex::memory::Blob content = rex::file::read_file_abspath(file);
+			REX_UNUSED_PARAM(content);
+		}
+		return timer.elapsed_ms();
+	}
+
+	// Returns the time in milliseconds it takes to read all files as a single batch
+	f32 read_batched(const rsl::vector<rsl::string_view>& files)
+	{
+		rex::Timer timer("file read benchmark");
+		const rsl::vector<rex::memory::Blob> contents = rex::file::read_files_abspath(files);
+		const f32 elapsed_ms = timer.elapsed_ms();
+
+		REX_CHECK(contents.size() == files.size());
+		return elapsed_ms;
+	}
+}
+
+TEST_CASE("TEST - File Read Benchmark - Data Files Cold And Warm", "[.][benchmark]")
+{
+	const rsl::vector<rsl::string> files = data_files();
+	rsl::vector<rsl::string_view> file_views;
+	file_views.reserve(files.size());
+	for (const rsl::string& file : files)
+	{
+		file_views.push_back(file);
+	}
+	REX_CHECK(!file_views.empty());
+
+	evict_from_cache(file_views);
+	const f32 cold_one_by_one_ms = read_one_by_one(file_views);
+	const f32 warm_one_by_one_ms = read_one_by_one(file_views);
+
+	evict_from_cache(file_views);
+	const f32 cold_batched_ms = read_batched(file_views);
+	const f32 warm_batched_ms = read_batched(file_views);
+
+	REX_INFO(LogFileReadBenchmark, "Read {} json and blk files", file_views.size());
+	REX_INFO(LogFileReadBenchmark, "One by one - cold: {}ms warm: {}ms", cold_one_by_one_ms, warm_one_by_one_ms);
+	REX_INFO(LogFileReadBenchmark, "Batched    - cold: {}ms warm: {}ms", cold_batched_ms, warm_batched_ms);
+}
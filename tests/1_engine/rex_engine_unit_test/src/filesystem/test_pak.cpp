@@ -0,0 +1,214 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/filesystem/pak_archive.h"
+#include "rex_engine/filesystem/pak_filesystem.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/path.h"
+#include "rex_engine/filesystem/tmp_dir.h"
+
+#include "rex_engine/engine/casting.h"
+
+#include "rex_std/algorithm.h"
+#include "rex_std/limits.h"
+#include "rex_std/vector.h"
+
+namespace rex::test
+{
+	// A directory with a few files to pack, the archive is built inside the directory itself
+	class PakTestDirectory
+	{
+	public:
+		PakTestDirectory()
+			: m_tmp_dir()
+		{
+			m_root.assign(m_tmp_dir.dirname());
+			m_pak_path.assign(path::join(m_root, "test.rexpak"));
+
+			m_tmp_dir.create_dir("sub");
+			m_tmp_dir.create_file("empty_file.txt");
+			file::write_to_file(path::join(m_root, "root_file.txt"), "root file content", 17);
+			file::write_to_file(path::join(m_root, "sub", "sub_file.json"), "{ \"name\": \"sub file\" }", 22);
+		}
+
+		rsl::string_view root() const
+		{
+			return m_root;
+		}
+		rsl::string_view pak_path() const
+		{
+			return m_pak_path;
+		}
+
+	private:
+		TempDirectory m_tmp_dir;
+		rsl::string m_root;
+		rsl::string m_pak_path;
+	};
+
+	rsl::string_view to_string_view(memory::BlobView view)
+	{
+		return rsl::string_view(view.data_as<char8>(), narrow_cast<s32>(view.size()));
+	}
+
+	// Overwrite the first entry of the table of contents of an archive on disk
+	template <typename Func>
+	void corrupt_first_entry(rsl::string_view pakPath, Func&& corruptFunc)
+	{
+		rsl::vector<rsl::byte> content;
+		content.resize(static_cast<count_t>(file::size_abspath(pakPath)));
+		file::read_file_abspath(pakPath, content.data(), static_cast<s64>(content.size()));
+
+		const pak::PakHeader* header = reinterpret_cast<const pak::PakHeader*>(content.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		pak::PakEntry* entry = reinterpret_cast<pak::PakEntry*>(content.data() + header->toc_offset); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		corruptFunc(*entry);
+
+		file::write_to_file_abspath(pakPath, content.data(), content.size());
+	}
+}
+
+TEST_CASE("TEST - Pak - Build And Open")
+{
+	rex::test::PakTestDirectory test_dir;
+	REX_CHECK(!rex::pak::build(test_dir.root(), test_dir.pak_path()));
+
+	rex::PakArchive archive;
+	REX_CHECK(!archive.open(test_dir.pak_path()));
+	REX_CHECK(archive.is_open());
+
+	// The archive itself is not packed
+	REX_CHECK(archive.end() - archive.begin() == 3);
+	REX_CHECK(archive.find("test.rexpak") == nullptr);
+
+	// The table of contents is sorted by hash and every file is aligned
+	for (const rex::pak::PakEntry* it = archive.begin(); it != archive.end(); ++it)
+	{
+		REX_CHECK(it->data_offset % rex::pak::g_entry_alignment == 0);
+		REX_CHECK(it->compression == rex::pak::Compression::None);
+		if (it != archive.begin())
+		{
+			REX_CHECK((it - 1)->path_hash <= it->path_hash);
+		}
+	}
+
+	const rex::pak::PakEntry* root_file = archive.find("root_file.txt");
+	REX_CHECK(root_file != nullptr);
+	REX_CHECK(archive.name(*root_file) == "root_file.txt");
+	REX_CHECK(rex::test::to_string_view(archive.data(*root_file)) == "root file content");
+
+	// Both seperators find the same file
+	const rex::pak::PakEntry* sub_file = archive.find("sub/sub_file.json");
+	REX_CHECK(sub_file != nullptr);
+	REX_CHECK(archive.find("sub\\sub_file.json") == sub_file);
+	REX_CHECK(rex::test::to_string_view(archive.data(*sub_file)) == "{ \"name\": \"sub file\" }");
+
+	const rex::pak::PakEntry* empty_file = archive.find("empty_file.txt");
+	REX_CHECK(empty_file != nullptr);
+	REX_CHECK(empty_file->size == 0);
+
+	REX_CHECK(archive.find("file_that_doesnt_exist.txt") == nullptr);
+}
+
+TEST_CASE("TEST - Pak - Open Invalid Archive")
+{
+	rex::test::PakTestDirectory test_dir;
+
+	rex::PakArchive archive;
+	REX_CHECK(archive.open(rex::path::join(test_dir.root(), "root_file.txt")));
+	REX_CHECK(!archive.is_open());
+	REX_CHECK(archive.find("root_file.txt") == nullptr);
+	REX_CHECK(archive.begin() == archive.end());
+}
+
+TEST_CASE("TEST - Pak - Open Archive With Corrupt Entries")
+{
+	rex::test::PakTestDirectory test_dir;
+
+	// Data that reaches past the end of the archive, with an offset and size that wrap around when they're added
+	REX_CHECK(!rex::pak::build(test_dir.root(), test_dir.pak_path()));
+	rex::test::corrupt_first_entry(test_dir.pak_path(), [](rex::pak::PakEntry& entry)
+		{
+			entry.stored_size = (rsl::numeric_limits<u64>::max)() - entry.data_offset + 1;
+			entry.size = entry.stored_size;
+		});
+	{
+		rex::PakArchive archive;
+		REX_CHECK(archive.open(test_dir.pak_path()));
+		REX_CHECK(!archive.is_open());
+	}
+
+	// Uncompressed data that claims to load to a different size than it's stored with
+	REX_CHECK(!rex::pak::build(test_dir.root(), test_dir.pak_path()));
+	rex::test::corrupt_first_entry(test_dir.pak_path(), [](rex::pak::PakEntry& entry) { entry.size = entry.stored_size + 1; });
+	{
+		rex::PakArchive archive;
+		REX_CHECK(archive.open(test_dir.pak_path()));
+		REX_CHECK(!archive.is_open());
+	}
+}
+
+TEST_CASE("TEST - Pak - Filesystem Reads Packed Files")
+{
+	rex::test::PakTestDirectory test_dir;
+	REX_CHECK(!rex::pak::build(test_dir.root(), test_dir.pak_path()));
+
+	rex::PakFileSystem filesystem(rex::path::cwd(), rex::LooseFilesOverride::no);
+	REX_CHECK(!filesystem.mount_pak(test_dir.root(), test_dir.pak_path()));
+
+	// Remove the loose file, it can only be read from the archive now
+	const rex::scratch_string root_file = rex::path::join(test_dir.root(), "root_file.txt");
+	rex::file::del(root_file);
+
+	REX_CHECK(filesystem.is_file(root_file));
+	REX_CHECK(filesystem.exists(root_file));
+	REX_CHECK(rex::memory::blob_to_string_view(filesystem.read_file(root_file)) == "root file content");
+
+	rex::MappedFile mapped_file = filesystem.map_file(root_file);
+	REX_CHECK(mapped_file.is_mapped());
+	REX_CHECK(rex::test::to_string_view(mapped_file.view()) == "root file content");
+
+	// Batched reads mix packed and loose files
+	const rex::scratch_string sub_file = rex::path::join(test_dir.root(), "sub", "sub_file.json");
+	const rex::scratch_string pak_path(test_dir.pak_path());
+	rsl::vector<rsl::string_view> paths;
+	paths.push_back(root_file);
+	paths.push_back(pak_path);
+	paths.push_back(sub_file);
+	const rsl::vector<rex::memory::Blob> contents = filesystem.read_files(paths);
+	REX_CHECK(contents.size() == 3);
+	REX_CHECK(rex::memory::blob_to_string_view(contents[0]) == "root file content");
+	REX_CHECK(rex::file::size(pak_path) == static_cast<card64>(contents[1].size()));
+	REX_CHECK(rex::memory::blob_to_string_view(contents[2]) == "{ \"name\": \"sub file\" }");
+
+	// Directories only exist in the archive if a file is packed under them
+	REX_CHECK(filesystem.is_directory(rex::path::join(test_dir.root(), "sub")));
+	REX_CHECK(!filesystem.is_directory(rex::path::join(test_dir.root(), "dir_that_doesnt_exist")));
+
+	// Listing merges the packed files with the loose ones
+	const rsl::vector<rsl::string> files = filesystem.list_files(test_dir.root());
+	REX_CHECK(rsl::find(files.cbegin(), files.cend(), "root_file.txt") != files.cend());
+	REX_CHECK(rsl::find(files.cbegin(), files.cend(), "empty_file.txt") != files.cend());
+	REX_CHECK(rsl::find(files.cbegin(), files.cend(), "test.rexpak") != files.cend());
+	REX_CHECK(rsl::find(files.cbegin(), files.cend(), "sub_file.json") == files.cend());
+
+	const rsl::vector<rsl::string> dirs = filesystem.list_dirs(test_dir.root());
+	REX_CHECK(dirs.size() == 1);
+	REX_CHECK(dirs.front() == "sub");
+}
+
+TEST_CASE("TEST - Pak - Loose Files Override Packed Files")
+{
+	rex::test::PakTestDirectory test_dir;
+	REX_CHECK(!rex::pak::build(test_dir.root(), test_dir.pak_path()));
+
+	rex::PakFileSystem filesystem(rex::path::cwd(), rex::LooseFilesOverride::yes);
+	REX_CHECK(!filesystem.mount_pak(test_dir.root(), test_dir.pak_path()));
+
+	// Change the loose file after it got packed, the loose file is read instead of the packed one
+	const rex::scratch_string root_file = rex::path::join(test_dir.root(), "root_file.txt");
+	rex::file::write_to_file(root_file, "changed content", 15);
+	REX_CHECK(rex::memory::blob_to_string_view(filesystem.read_file(root_file)) == "changed content");
+
+	// Without a loose file, the packed file is read
+	rex::file::del(root_file);
+	REX_CHECK(rex::memory::blob_to_string_view(filesystem.read_file(root_file)) == "root file content");
+}
@@ -0,0 +1,52 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/filesystem/path_id.h"
+
+#include "rex_std/functional.h"
+#include "rex_std/unordered_map.h"
+
+TEST_CASE("TEST - PathId - Invalid Path Id")
+{
+	rex::PathId id;
+	REX_CHECK(id.is_valid() == false);
+	REX_CHECK(id.operator bool() == false);
+
+	REX_CHECK(rex::PathId::create("").is_valid() == false);
+	REX_CHECK(rex::PathId::create("") == id);
+}
+
+TEST_CASE("TEST - PathId - Normalization")
+{
+	REX_CHECK(rex::PathId::create("path/to/file.txt").string() == "path/to/file.txt");
+	REX_CHECK(rex::PathId::create("path\\to\\file.txt").string() == "path/to/file.txt");
+	REX_CHECK(rex::PathId::create("path/./to/file.txt").string() == "path/to/file.txt");
+	REX_CHECK(rex::PathId::create("path/to/../to/file.txt").string() == "path/to/file.txt");
+}
+
+TEST_CASE("TEST - PathId - Interning")
+{
+	rex::PathId id = rex::PathId::create("path/to/file.txt");
+	rex::PathId same_id = rex::PathId::create("path\\to\\..\\to\\file.txt");
+	rex::PathId other_id = rex::PathId::create("path/to/other_file.txt");
+
+	// Paths that normalize to the same string share the same interned string
+	REX_CHECK(id == same_id);
+	REX_CHECK(id.string().data() == same_id.string().data());
+	REX_CHECK(id.hash() == same_id.hash());
+	REX_CHECK(id.hash() == rsl::hash<rsl::string_view>{}("path/to/file.txt"));
+
+	REX_CHECK(id != other_id);
+	REX_CHECK(id.string().data() != other_id.string().data());
+}
+
+TEST_CASE("TEST - PathId - Hash Table Key")
+{
+	rsl::unordered_map<rex::PathId, s32> map;
+	map.emplace(rex::PathId::create("path/to/file.txt"), 1);
+	map.emplace(rex::PathId::create("path/to/other_file.txt"), 2);
+
+	REX_CHECK(map.size() == 2);
+	REX_CHECK(map.at(rex::PathId::create("path\\to\\file.txt")) == 1);
+	REX_CHECK(map.at(rex::PathId::create("path/to/./other_file.txt")) == 2);
+	REX_CHECK(map.contains(rex::PathId::create("path/to/missing_file.txt")) == false);
+}
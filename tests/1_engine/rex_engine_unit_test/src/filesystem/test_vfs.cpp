@@ -10,6 +10,11 @@
 
 #include "rex_engine/engine/casting.h"
 
+#include "rex_std/atomic.h"
+#include "rex_std/chrono.h"
+#include "rex_std/thread.h"
+#include "rex_std/vector.h"
+
 namespace rex::test
 {
 	class ScopedVfsInitialization
@@ -104,6 +109,39 @@ TEST_CASE("TEST - VFS - read file")
 	file_blob = rex::vfs::instance()->read_file(rex::MountingPoint::TestPath1, filename);
 	REX_CHECK(rex::memory::blob_to_string_view(file_blob) == expected_content);
 }
+TEST_CASE("TEST - VFS - map file")
+{
+	rex::test::ScopedVfsInitialization vfs_init;
+
+	rsl::string_view test_path1 = "vfs_tests";
+	rex::vfs::instance()->mount(rex::MountingPoint::TestPath1, test_path1);
+
+	rsl::string_view filename = "vfs_test_file.txt";
+	rex::scratch_string filepath = rex::path::join(test_path1, filename);
+
+	rsl::string_view expected_content = "this is a test file";
+
+	// Map a file using just the filepath
+	rex::MappedFile mapped_file = rex::vfs::instance()->map_file(filepath);
+	REX_CHECK(mapped_file.is_mapped());
+	REX_CHECK(rsl::string_view(mapped_file.view().data_as<char8>(), rex::narrow_cast<s32>(mapped_file.size())) == expected_content);
+
+	// Map a file using a mounting point, the previous mapping gets released
+	mapped_file = rex::vfs::instance()->map_file(rex::MountingPoint::TestPath1, filename);
+	REX_CHECK(mapped_file.is_mapped());
+	REX_CHECK(rsl::string_view(mapped_file.view().data_as<char8>(), rex::narrow_cast<s32>(mapped_file.size())) == expected_content);
+
+	// Moving a mapped file hands over the mapping
+	rex::MappedFile moved_file = rsl::move(mapped_file);
+	REX_CHECK(!mapped_file);
+	REX_CHECK(moved_file.is_mapped());
+	REX_CHECK(rsl::string_view(moved_file.view().data_as<char8>(), rex::narrow_cast<s32>(moved_file.size())) == expected_content);
+
+	// Try mapping a file that doesn't exist
+	mapped_file = rex::vfs::instance()->map_file(rex::MountingPoint::TestPath1, "vfs_file_that_doesnt_exist.txt");
+	REX_CHECK(!mapped_file);
+	REX_CHECK(mapped_file.size() == 0);
+}
 TEST_CASE("TEST - VFS - read file async")
 {
 	rex::test::ScopedVfsInitialization vfs_init;
@@ -117,7 +155,7 @@ TEST_CASE("TEST - VFS - read file async")
 	rsl::string_view expected_content = "this is a test file";
 
 	// Read a file using just the filepath
-	auto read_request = rex::vfs::instance()->read_file_async(filepath);
+	auto read_request = rex::vfs::instance()->read_file_async(rex::PathId::create(rex::vfs::instance()->abs_path(filepath)));
 	read_request.wait();
 	rsl::string_view file_blob(rex::char_cast(read_request.data()) , rex::narrow_cast<s32>(read_request.count().size_in_bytes()));
 	REX_CHECK(file_blob == expected_content);
@@ -133,7 +171,7 @@ TEST_CASE("TEST - VFS - read file async")
 	expected_content = "";
 
 	// Try reading a file that doesn't exist using just the filepath
-	read_request = rex::vfs::instance()->read_file_async(filepath);
+	read_request = rex::vfs::instance()->read_file_async(rex::PathId::create(rex::vfs::instance()->abs_path(filepath)));
 	read_request.wait();
 	file_blob = rsl::string_view(rex::char_cast(read_request.data()), rex::narrow_cast<s32>(read_request.count().size_in_bytes()));
 	REX_CHECK(file_blob == expected_content);
@@ -144,6 +182,83 @@ TEST_CASE("TEST - VFS - read file async")
 	file_blob = rsl::string_view(rex::char_cast(read_request.data()), rex::narrow_cast<s32>(read_request.count().size_in_bytes()));
 	REX_CHECK(file_blob == expected_content);
 }
+TEST_CASE("TEST - VFS - read file async with callback")
+{
+	rex::test::ScopedVfsInitialization vfs_init;
+
+	rsl::string_view test_path1 = "vfs_tests";
+	rex::vfs::instance()->mount(rex::MountingPoint::TestPath1, test_path1);
+
+	rsl::atomic<bool> is_called = false;
+	auto read_request = rex::vfs::instance()->read_file_async(rex::MountingPoint::TestPath1, "vfs_test_file.txt");
+	read_request.when_done([&is_called]() { is_called = true; });
+	read_request.wait();
+
+	// The callback is called after the request is done, on the io worker
+	while (!is_called)
+	{
+		using namespace rsl::chrono_literals; // NOLINT(google-build-using-namespace)
+		rsl::this_thread::sleep_for(1ms);
+	}
+	rsl::string_view file_blob(rex::char_cast(read_request.data()), rex::narrow_cast<s32>(read_request.count().size_in_bytes()));
+	REX_CHECK(file_blob == "this is a test file");
+
+	// Registering a callback on a request that's done calls it immediately
+	bool is_called_immediately = false;
+	read_request.when_done([&is_called_immediately]() { is_called_immediately = true; });
+	REX_CHECK(is_called_immediately);
+}
+TEST_CASE("TEST - VFS - read same file async multiple times")
+{
+	rex::test::ScopedVfsInitialization vfs_init;
+	rex::vfs::instance()->set_num_io_workers(4);
+	REX_CHECK(rex::vfs::instance()->num_io_workers() == 4);
+
+	rsl::string_view test_path1 = "vfs_tests";
+	rex::vfs::instance()->mount(rex::MountingPoint::TestPath1, test_path1);
+
+	// Requests for the same file that are queued at the same time share the data
+	rsl::vector<rex::ReadRequest> read_requests;
+	for (s32 i = 0; i < 20; ++i)
+	{
+		read_requests.push_back(rex::vfs::instance()->read_file_async(rex::MountingPoint::TestPath1, "vfs_test_file.txt"));
+	}
+
+	for (const rex::ReadRequest& read_request : read_requests)
+	{
+		read_request.wait();
+		rsl::string_view file_blob(rex::char_cast(read_request.data()), rex::narrow_cast<s32>(read_request.count().size_in_bytes()));
+		REX_CHECK(file_blob == "this is a test file");
+	}
+}
+TEST_CASE("TEST - VFS - read file async data outlives the original request")
+{
+	rex::test::ScopedVfsInitialization vfs_init;
+
+	rsl::string_view test_path1 = "vfs_tests";
+	rex::vfs::instance()->mount(rex::MountingPoint::TestPath1, test_path1);
+
+	// Once a file is read, its data is owned by the read requests using it
+	// Copies keep it alive after the original request is gone, the last one to go frees it
+	rsl::vector<rex::ReadRequest> copies;
+	{
+		rex::ReadRequest read_request = rex::vfs::instance()->read_file_async(rex::MountingPoint::TestPath1, "vfs_test_file.txt");
+		read_request.wait();
+		copies.push_back(read_request);
+		copies.push_back(read_request);
+	}
+
+	copies.erase(copies.begin());
+	rsl::string_view file_blob(rex::char_cast(copies.back().data()), rex::narrow_cast<s32>(copies.back().count().size_in_bytes()));
+	REX_CHECK(file_blob == "this is a test file");
+	copies.clear();
+
+	// Reading the file again after all requests are gone reads it from disk again
+	rex::ReadRequest read_request = rex::vfs::instance()->read_file_async(rex::MountingPoint::TestPath1, "vfs_test_file.txt");
+	read_request.wait();
+	file_blob = rsl::string_view(rex::char_cast(read_request.data()), rex::narrow_cast<s32>(read_request.count().size_in_bytes()));
+	REX_CHECK(file_blob == "this is a test file");
+}
 TEST_CASE("TEST - VFS - save to file")
 {
 	rex::test::ScopedVfsInitialization vfs_init;
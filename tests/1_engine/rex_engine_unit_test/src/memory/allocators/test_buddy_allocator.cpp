@@ -2,6 +2,10 @@
 
 #include "rex_engine/memory/allocators/buddy_allocator.h"
 
+#include "rex_std/vector.h"
+
+#include <cstdlib>
+
 TEST_CASE("TEST - Buddy Allocator")
 {
 	rex::BuddyAllocator alloc(1_kib);
@@ -22,3 +26,87 @@ TEST_CASE("TEST - Buddy Allocator")
 	alloc.deallocate(p2);
 	alloc.deallocate(p3);
 }
+
+TEST_CASE("TEST - Buddy Allocator - Coalescing")
+{
+	rex::BuddyAllocator alloc(1_kib);
+	REX_CHECK(alloc.capacity() == 1_kib);
+	REX_CHECK(alloc.largest_free_block() == 1_kib);
+
+	// Splitting the buffer into the smallest blocks and freeing them again should merge them back into a single block
+	rsl::vector<void*> ptrs;
+	for (s32 i = 0; i < 1_kib / rex::g_buddy_allocator_min_block_size; ++i)
+	{
+		ptrs.push_back(alloc.allocate(1));
+	}
+	REX_CHECK(alloc.largest_free_block() == 0);
+
+	for (void* ptr : ptrs)
+	{
+		alloc.deallocate(ptr, 1);
+	}
+	REX_CHECK(alloc.largest_free_block() == 1_kib);
+
+	void* full = alloc.allocate(1_kib);
+	REX_CHECK(full != nullptr);
+	alloc.deallocate(full, 1_kib);
+}
+
+TEST_CASE("TEST - Buddy Allocator - Alignment")
+{
+	rex::BuddyAllocator alloc(4_kib);
+
+	void* p1 = alloc.allocate(1, 1);
+	void* p2 = alloc.allocate(24, 64);
+	void* p3 = alloc.allocate(100, 128);
+
+	REX_CHECK(reinterpret_cast<intptr>(p2) % 64 == 0);
+	REX_CHECK(reinterpret_cast<intptr>(p3) % 128 == 0);
+
+	alloc.deallocate(p1, 1);
+	alloc.deallocate(p2, 24);
+	alloc.deallocate(p3, 100);
+
+	REX_CHECK(alloc.largest_free_block() == 4_kib);
+}
+
+TEST_CASE("TEST - Buddy Allocator - Fragmentation Stress")
+{
+	rex::BuddyAllocator alloc(4_mib);
+
+	// Randomly allocate and free blocks of different sizes for a while
+	// the allocator should never end up too fragmented to serve a small allocation
+	constexpr s32 max_live_allocations = 256;
+	constexpr s32 num_iterations = 100'000;
+	rsl::vector<void*> live_allocations;
+	live_allocations.reserve(max_live_allocations);
+
+	std::srand(1);
+	for (s32 i = 0; i < num_iterations; ++i)
+	{
+		const bool should_free = live_allocations.size() == max_live_allocations || (!live_allocations.empty() && std::rand() % 2 == 0);
+		if (should_free)
+		{
+			const s32 idx = std::rand() % live_allocations.size();
+			alloc.deallocate(live_allocations[idx], 0);
+			live_allocations[idx] = live_allocations.back();
+			live_allocations.pop_back();
+		}
+		else
+		{
+			// Between 1 byte and 2KiB, 256 of those take at most an eighth of the allocator
+			const s32 size = (std::rand() % 2048) + 1;
+			void* ptr = alloc.allocate(size);
+			REX_CHECK(ptr != nullptr);
+			live_allocations.push_back(ptr);
+		}
+	}
+
+	for (void* ptr : live_allocations)
+	{
+		alloc.deallocate(ptr, 0);
+	}
+
+	// Once everything is freed, all blocks should have merged back together
+	REX_CHECK(alloc.largest_free_block() == 4_mib);
+}
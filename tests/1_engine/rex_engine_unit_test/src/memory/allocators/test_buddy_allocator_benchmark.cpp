@@ -0,0 +1,131 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/buddy_allocator.h"
+#include "rex_engine/profiling/timer.h"
+#include "rex_engine/diagnostics/log.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/vector.h"
+
+// Benchmarks are hidden by default as they take a while to run
+// run them explicitly by passing "[benchmark]" on the commandline
+
+DEFINE_LOG_CATEGORY(LogBuddyAllocatorBenchmark);
+
+namespace
+{
+	// The first fit free list the buddy allocator used to be, kept here as a baseline
+	// It walks the free list on every allocation and never merges freed blocks
+	class FirstFitAllocator
+	{
+	public:
+		explicit FirstFitAllocator(s64 size)
+			: m_buffer(rsl::make_unique<rsl::byte[]>(size))
+		{
+			m_head = reinterpret_cast<Block*>(m_buffer.get());
+			m_head->size = size - static_cast<s64>(sizeof(Block));
+			m_head->next = nullptr;
+		}
+
+		void* allocate(s64 size)
+		{
+			Block* prev = nullptr;
+			for (Block* current = m_head; current != nullptr; prev = current, current = current->next)
+			{
+				if (current->size < size)
+				{
+					continue;
+				}
+
+				if (current->size - size > static_cast<s64>(sizeof(Block)))
+				{
+					Block* new_block = reinterpret_cast<Block*>(reinterpret_cast<rsl::byte*>(current) + sizeof(Block) + size);
+					new_block->size = current->size - static_cast<s64>(sizeof(Block)) - size;
+					new_block->next = current->next;
+					current->size = size;
+					current->next = new_block;
+				}
+
+				(prev ? prev->next : m_head) = current->next;
+				return reinterpret_cast<rsl::byte*>(current) + sizeof(Block);
+			}
+
+			return nullptr;
+		}
+		void deallocate(void* ptr)
+		{
+			Block* block = reinterpret_cast<Block*>(static_cast<rsl::byte*>(ptr) - sizeof(Block));
+			block->next = m_head;
+			m_head = block;
+		}
+
+	private:
+		struct Block
+		{
+			s64 size;
+			Block* next;
+		};
+
+		rsl::unique_array<rsl::byte> m_buffer;
+		Block* m_head;
+	};
+
+	constexpr s32 g_num_rounds = 1'000;
+	constexpr s32 g_num_allocations_per_round = 256;
+
+	// Allocates a batch of allocations of varying size and frees them again, for a number of rounds
+	// Returns the number of allocations per second
+	template <typename AllocFunc, typename FreeFunc>
+	f32 measure_allocations_per_second(AllocFunc&& allocFunc, FreeFunc&& freeFunc)
+	{
+		rsl::vector<void*> ptrs;
+		ptrs.reserve(g_num_allocations_per_round);
+
+		rex::Timer timer("buddy allocator benchmark");
+		for (s32 round = 0; round < g_num_rounds; ++round)
+		{
+			for (s32 i = 0; i < g_num_allocations_per_round; ++i)
+			{
+				ptrs.push_back(allocFunc(16 + (i % 8) * 64));
+			}
+			for (void* ptr : ptrs)
+			{
+				freeFunc(ptr);
+			}
+			ptrs.clear();
+		}
+		const f32 elapsed_seconds = timer.elapsed_seconds();
+
+		return static_cast<f32>(g_num_rounds * g_num_allocations_per_round) / elapsed_seconds;
+	}
+}
+
+TEST_CASE("TEST - Buddy Allocator Benchmark - Throughput", "[.][benchmark]")
+{
+	rex::BuddyAllocator buddy_allocator(1_mib);
+	const f32 buddy_allocs_per_second = measure_allocations_per_second(
+		[&](s64 size) { return buddy_allocator.allocate(size); },
+		[&](void* ptr) { buddy_allocator.deallocate(ptr, 0); });
+
+	// The first fit free list never merges blocks, so it can run out of blocks that are big enough
+	s32 num_first_fit_failures = 0;
+	FirstFitAllocator first_fit_allocator(1_mib);
+	const f32 first_fit_allocs_per_second = measure_allocations_per_second(
+		[&](s64 size) { return first_fit_allocator.allocate(size); },
+		[&](void* ptr)
+		{
+			if (ptr)
+			{
+				first_fit_allocator.deallocate(ptr);
+			}
+			else
+			{
+				++num_first_fit_failures;
+			}
+		});
+
+	REX_INFO(LogBuddyAllocatorBenchmark, "Buddy allocator: {} allocations/sec", buddy_allocs_per_second);
+	REX_INFO(LogBuddyAllocatorBenchmark, "First fit free list: {} allocations/sec, {} failed allocations", first_fit_allocs_per_second, num_first_fit_failures);
+
+	REX_CHECK(buddy_allocator.largest_free_block() == 1_mib);
+}
@@ -21,4 +21,24 @@ TEST_CASE("TEST - Circular Allocator")
 	alloc.deallocate(p1);
 	alloc.deallocate(p2);
 	alloc.deallocate(p3);
-}
\ No newline at end of file
+}
+TEST_CASE("TEST - Circular Allocator - Reallocate Keeps Contents")
+{
+	rex::CircularAllocator alloc(1_kib);
+
+	s32* p1 = static_cast<s32*>(alloc.allocate(sizeof(s32)));
+	*p1 = 5;
+
+	// The last allocation grows in place
+	s32* p2 = static_cast<s32*>(alloc.reallocate(p1, 2 * sizeof(s32)));
+	REX_CHECK(p2 == p1);
+	REX_CHECK(*p2 == 5);
+
+	// Any other allocation gets copied
+	s32* p3 = alloc.allocate<s32>();
+	*p3 = 6;
+	s32* p4 = static_cast<s32*>(alloc.reallocate(p2, 4 * sizeof(s32)));
+	REX_CHECK(p4 != p2);
+	REX_CHECK(*p4 == 5);
+	REX_CHECK(*p3 == 6);
+}
@@ -0,0 +1,212 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/frame_allocator.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+
+#include "rex_std/atomic.h"
+#include "rex_std/vector.h"
+
+TEST_CASE("TEST - Frame Allocator - Allocate")
+{
+	rex::FrameAllocator allocator(1_kib);
+
+	s32* p1 = allocator.allocate<s32>();
+	s32* p2 = allocator.allocate<s32>();
+	*p1 = 1;
+	*p2 = 2;
+
+	REX_CHECK(p1 != p2);
+	REX_CHECK(*p1 == 1);
+	REX_CHECK(*p2 == 2);
+	REX_CHECK(allocator.has_allocated_ptr(p1));
+	REX_CHECK(allocator.has_allocated_ptr(p2));
+	REX_CHECK(allocator.num_allocated_this_frame() >= static_cast<s64>(2 * sizeof(s32)));
+
+	s32 not_allocated = 0;
+	REX_CHECK(allocator.has_allocated_ptr(&not_allocated) == false);
+}
+
+TEST_CASE("TEST - Frame Allocator - Reallocate Keeps Contents")
+{
+	rex::FrameAllocator allocator(1_kib);
+
+	s32* p1 = static_cast<s32*>(allocator.allocate(sizeof(s32)));
+	*p1 = 5;
+
+	s32* p2 = static_cast<s32*>(allocator.reallocate(p1, 4 * sizeof(s32)));
+	REX_CHECK(*p2 == 5);
+}
+
+TEST_CASE("TEST - Frame Allocator - Frames In Flight")
+{
+	rex::FrameAllocator allocator(1_kib);
+
+	// Memory of a frame isn't reused until all frames in flight have passed
+	s32* first_frame_ptr = allocator.allocate<s32>();
+	*first_frame_ptr = 5;
+	for (s32 i = 0; i < rex::g_num_frames_in_flight - 1; ++i)
+	{
+		allocator.advance_frame();
+		s32* ptr = allocator.allocate<s32>();
+		*ptr = 10;
+		REX_CHECK(ptr != first_frame_ptr);
+		REX_CHECK(*first_frame_ptr == 5);
+	}
+
+	// Now the first frame got recycled, so its memory is used again
+	allocator.advance_frame();
+	REX_CHECK(allocator.num_allocated_this_frame() == 0);
+	REX_CHECK(allocator.allocate<s32>() == first_frame_ptr);
+	REX_CHECK(allocator.current_frame() == rex::g_num_frames_in_flight);
+}
+
+TEST_CASE("TEST - Frame Allocator - Stats")
+{
+	rex::FrameAllocator allocator(1_kib);
+
+	REX_CHECK(allocator.stats().num_frames_recycled == 0);
+
+	// The stats of a frame are recorded when it gets recycled
+	(void)allocator.allocate(100);
+	(void)allocator.allocate(200);
+	for (s32 i = 0; i < rex::g_num_frames_in_flight; ++i)
+	{
+		allocator.advance_frame();
+	}
+
+	const rex::FrameAllocatorStats stats = allocator.stats();
+	REX_CHECK(stats.num_frames_recycled == rex::g_num_frames_in_flight);
+	REX_CHECK(stats.last_frame_usage >= 300);
+	REX_CHECK(stats.peak_frame_usage >= 300);
+	REX_CHECK(stats.peak_arena_usage >= 300);
+	REX_CHECK(stats.peak_arena_usage <= allocator.arena_size());
+}
+
+TEST_CASE("TEST - Frame Allocator - Fence Keeps Frame Alive")
+{
+	rex::FrameAllocator allocator(1_kib);
+
+	rex::FrameFence fence = allocator.acquire_fence();
+	REX_CHECK(fence.is_active());
+
+	// Copying the fence adds another hold on the frame
+	rex::FrameFence copied_fence = fence;
+	fence.release();
+	REX_CHECK(fence.is_active() == false);
+	REX_CHECK(copied_fence.is_active());
+
+	// The fence is released on another thread while this one is waiting to recycle the frame
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(1));
+	rex::task_system::Task<void> task = rex::run_async([fence = rsl::move(copied_fence)]() mutable
+		{
+			fence.release();
+		});
+
+	for (s32 i = 0; i < rex::g_num_frames_in_flight; ++i)
+	{
+		allocator.advance_frame();
+	}
+
+	// The frame got recycled once the fence was released, the job itself can still be finishing up
+	task.wait_for_me();
+	REX_CHECK(task.is_finished());
+	REX_CHECK(allocator.stats().num_frames_recycled == rex::g_num_frames_in_flight);
+
+	rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Frame Allocator - Switching Between Allocators")
+{
+	rex::FrameAllocator allocator1(8_kib);
+	rex::FrameAllocator allocator2(8_kib);
+
+	// A thread keeps its slot in both allocators, so switching between them doesn't claim new slots
+	for (s32 i = 0; i < rex::g_max_frame_allocator_threads * 2; ++i)
+	{
+		s32* p1 = allocator1.allocate<s32>();
+		s32* p2 = allocator2.allocate<s32>();
+		REX_CHECK(allocator1.has_allocated_ptr(p1));
+		REX_CHECK(allocator2.has_allocated_ptr(p2));
+	}
+
+	REX_CHECK(allocator1.num_allocated_this_frame() >= rex::g_max_frame_allocator_threads * 2 * static_cast<s32>(sizeof(s32)));
+	REX_CHECK(allocator2.num_allocated_this_frame() >= rex::g_max_frame_allocator_threads * 2 * static_cast<s32>(sizeof(s32)));
+}
+
+TEST_CASE("TEST - Frame Allocator - Allocations On Multiple Threads")
+{
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(4));
+	rex::FrameAllocator allocator(4_kib);
+
+	// Every thread allocates from its own arena and the jobs outlive the frame they were started in
+	constexpr s32 num_jobs = 64;
+	rsl::vector<rex::task_system::Task<bool>> tasks;
+	tasks.reserve(num_jobs);
+	for (s32 i = 0; i < num_jobs; ++i)
+	{
+		rex::task_system::Task<bool> task = rex::run_async([i, &allocator]()
+			{
+				s32* values = static_cast<s32*>(allocator.allocate(8 * sizeof(s32)));
+				for (s32 j = 0; j < 8; ++j)
+				{
+					values[j] = i;
+				}
+				for (s32 j = 0; j < 8; ++j)
+				{
+					if (values[j] != i)
+					{
+						return false;
+					}
+				}
+				return true;
+			});
+		allocator.add_frame_job(task);
+		tasks.push_back(rsl::move(task));
+	}
+
+	// Recycling a frame waits for the jobs that were added in it
+	for (s32 i = 0; i < rex::g_num_frames_in_flight; ++i)
+	{
+		allocator.advance_frame();
+	}
+
+	for (rex::task_system::Task<bool>& task : tasks)
+	{
+		REX_CHECK(task.is_finished());
+		REX_CHECK(task.result() == true);
+	}
+
+	tasks.clear();
+	rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Frame Allocator - Frame Jobs Adding Frame Jobs")
+{
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(4));
+	rex::FrameAllocator allocator(4_kib);
+
+	// A frame job can keep the frame alive for longer by adding new jobs to it
+	// while the thread advancing the frames is waiting on it and running pending jobs
+	rsl::atomic<s32> num_finished = 0;
+	constexpr s32 num_jobs = 16;
+	for (s32 i = 0; i < num_jobs; ++i)
+	{
+		allocator.add_frame_job(rex::run_async([&allocator, &num_finished]()
+			{
+				allocator.add_frame_job(rex::run_async([&num_finished]() { ++num_finished; }));
+				return true;
+			}));
+	}
+
+	for (s32 i = 0; i < rex::g_num_frames_in_flight * 2; ++i)
+	{
+		allocator.advance_frame();
+	}
+
+	REX_CHECK(num_finished.load() == num_jobs);
+
+	rex::thread_pool::shutdown();
+}
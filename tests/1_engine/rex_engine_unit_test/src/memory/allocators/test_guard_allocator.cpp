@@ -0,0 +1,99 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/engine_heap_allocator.h"
+#include "rex_engine/memory/allocators/guard_allocator.h"
+#include "rex_engine/memory/memory_tracking.h"
+#include "rex_engine/memory/virtual_memory.h"
+
+#include "rex_engine/engine/types.h"
+
+#include "rex_std/memory.h"
+
+TEST_CASE("TEST - Guard Allocator - Allocation Ends At Guard Page")
+{
+	// The guard allocator is too big to live on the stack
+	rsl::unique_ptr<rex::GuardAllocator> alloc = rsl::make_unique<rex::GuardAllocator>();
+	const s64 page_size = rex::vmem::page_size();
+
+	for (s64 size : { 1, 16, 100, 4096, 10000 })
+	{
+		void* ptr = alloc->allocate(size);
+		REX_CHECK(ptr != nullptr);
+		REX_CHECK(alloc->owns(ptr));
+		REX_CHECK(alloc->usable_size(ptr) == size);
+
+		// The memory is usable up to the requested size
+		rsl::memset(ptr, 0xAB, static_cast<card64>(size));
+
+#ifndef REX_GUARD_ALLOCATOR_DETECT_UNDERRUN
+		// The end of the allocation, rounded up to the alignment, is where the guard page starts
+		const u64 end = reinterpret_cast<u64>(ptr) + static_cast<u64>(size); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		const u64 aligned_end = (end + rex::g_guard_allocator_alignment - 1) & ~static_cast<u64>(rex::g_guard_allocator_alignment - 1);
+		REX_CHECK(aligned_end % static_cast<u64>(page_size) == 0);
+#endif
+
+		alloc->deallocate(ptr);
+	}
+}
+
+TEST_CASE("TEST - Guard Allocator - Freed Allocations Are Quarantined")
+{
+	rsl::unique_ptr<rex::GuardAllocator> alloc = rsl::make_unique<rex::GuardAllocator>();
+
+	void* ptr = alloc->allocate(64);
+	REX_CHECK(alloc->stats().num_live_allocations == 1);
+	REX_CHECK(alloc->stats().num_quarantined == 0);
+
+	alloc->deallocate(ptr);
+	REX_CHECK(alloc->stats().num_live_allocations == 0);
+	REX_CHECK(alloc->stats().num_quarantined == 1);
+
+	// The pointer is still known, so a double free or use after free can be reported
+	REX_CHECK(alloc->owns(ptr));
+}
+
+TEST_CASE("TEST - Guard Allocator - Quarantine Releases Oldest")
+{
+	rsl::unique_ptr<rex::GuardAllocator> alloc = rsl::make_unique<rex::GuardAllocator>();
+
+	void* first_ptr = alloc->allocate(64);
+	alloc->deallocate(first_ptr);
+	for (s32 i = 0; i < rex::g_guard_allocator_quarantine_size; ++i)
+	{
+		alloc->deallocate(alloc->allocate(64));
+	}
+
+	REX_CHECK(alloc->stats().num_quarantined == rex::g_guard_allocator_quarantine_size);
+	REX_CHECK(alloc->owns(first_ptr) == false);
+}
+
+TEST_CASE("TEST - Guard Allocator - Enabled Per Memory Tag")
+{
+	rex::enable_guard_allocator(rex::MemoryTag::FileIO, true);
+	REX_CHECK(rex::is_guard_allocator_enabled());
+	REX_CHECK(rex::is_guard_allocator_enabled(rex::MemoryTag::FileIO));
+	REX_CHECK(rex::is_guard_allocator_enabled(rex::MemoryTag::Renderer) == false);
+
+	rex::EngineHeapAllocator heap_alloc;
+	void* guarded_ptr = nullptr;
+	{
+		REX_MEM_TAG_SCOPE(rex::MemoryTag::FileIO);
+		guarded_ptr = heap_alloc.allocate(static_cast<card64>(100));
+	}
+	void* unguarded_ptr = heap_alloc.allocate(static_cast<card64>(100));
+
+	REX_CHECK(rex::guard_allocator().owns(guarded_ptr));
+	REX_CHECK(rex::guard_allocator().owns(unguarded_ptr) == false);
+
+	// Reallocating keeps the content, no matter where the new memory comes from
+	rsl::memset(guarded_ptr, 0x12, 100);
+	guarded_ptr = heap_alloc.reallocate(guarded_ptr, 200);
+	REX_CHECK(static_cast<u8*>(guarded_ptr)[99] == 0x12);
+
+	rex::enable_guard_allocator(rex::MemoryTag::FileIO, false);
+	REX_CHECK(rex::is_guard_allocator_enabled() == false);
+
+	// Guarded memory is freed through the guard allocator, even when guarding is disabled
+	heap_alloc.deallocate(guarded_ptr, static_cast<card64>(200));
+	heap_alloc.deallocate(unguarded_ptr, static_cast<card64>(100));
+}
@@ -0,0 +1,122 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/pool_allocator.h"
+#include "rex_engine/task_system/parallel_for.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+
+#include "rex_std/atomic.h"
+#include "rex_std/vector.h"
+
+TEST_CASE("TEST - Pool Allocator - Allocate And Free")
+{
+	rex::PoolAllocator alloc(sizeof(s32), 4);
+
+	s32* p1 = alloc.allocate<s32>();
+	s32* p2 = alloc.allocate<s32>();
+	s32* p3 = alloc.allocate<s32>();
+
+	REX_CHECK(p1 != nullptr);
+	REX_CHECK(p2 != nullptr);
+	REX_CHECK(p3 != nullptr);
+	REX_CHECK(p1 != p2);
+	REX_CHECK(p2 != p3);
+	REX_CHECK(alloc.num_free_blocks() == 1);
+
+	*p1 = 1;
+	*p2 = 2;
+	*p3 = 3;
+	REX_CHECK(*p1 == 1);
+	REX_CHECK(*p2 == 2);
+	REX_CHECK(*p3 == 3);
+
+	alloc.deallocate(p1);
+	alloc.deallocate(p2);
+	alloc.deallocate(p3);
+	REX_CHECK(alloc.num_free_blocks() == 4);
+}
+
+TEST_CASE("TEST - Pool Allocator - No Overhead Per Block")
+{
+	rex::PoolAllocator alloc(64, 16, 16);
+	REX_CHECK(alloc.block_size() == 64);
+
+	// Blocks are laid out back to back
+	rsl::byte* p1 = static_cast<rsl::byte*>(alloc.allocate(64));
+	rsl::byte* p2 = static_cast<rsl::byte*>(alloc.allocate(64));
+	REX_CHECK(p2 - p1 == 64);
+
+	alloc.deallocate(p1, 64);
+	alloc.deallocate(p2, 64);
+}
+
+TEST_CASE("TEST - Pool Allocator - Alignment")
+{
+	// The block size gets rounded up so every block is aligned
+	rex::PoolAllocator alloc(24, 32, 64);
+	REX_CHECK(alloc.block_size() == 64);
+	REX_CHECK(alloc.alignment() == 64);
+
+	rsl::vector<void*> ptrs;
+	for (s32 i = 0; i < alloc.num_blocks(); ++i)
+	{
+		void* ptr = alloc.allocate(24, 64);
+		REX_CHECK(reinterpret_cast<u64>(ptr) % 64 == 0);
+		ptrs.push_back(ptr);
+	}
+
+	for (void* ptr : ptrs)
+	{
+		alloc.deallocate(ptr, 24);
+	}
+	REX_CHECK(alloc.num_free_blocks() == alloc.num_blocks());
+}
+
+TEST_CASE("TEST - Pool Allocator - Reuses Freed Blocks")
+{
+	rex::PoolAllocator alloc(sizeof(s64), 2);
+
+	s64* p1 = alloc.allocate<s64>();
+	s64* p2 = alloc.allocate<s64>();
+	REX_CHECK(alloc.num_free_blocks() == 0);
+	REX_CHECK(alloc.has_allocated_ptr(p1));
+	REX_CHECK(alloc.has_allocated_ptr(p2));
+
+	alloc.deallocate(p2);
+	s64* p3 = alloc.allocate<s64>();
+	REX_CHECK(p3 == p2);
+
+	alloc.deallocate(p1);
+	alloc.deallocate(p3);
+}
+
+TEST_CASE("TEST - Pool Allocator - Allocations On Multiple Threads")
+{
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(4));
+
+	constexpr s32 num_blocks = 256;
+	rex::PoolAllocator alloc(sizeof(s64), num_blocks);
+
+	// Every index allocates and frees its block a number of times
+	// if 2 threads ever got the same block, the value written to it would be overwritten
+	rsl::atomic<s32> num_corrupted_blocks = 0;
+	rex::parallel_for({ 0, num_blocks }, 1, [&](s32 idx)
+		{
+			for (s32 round = 0; round < 100; ++round)
+			{
+				s64* ptr = alloc.allocate<s64>();
+				*ptr = idx;
+				if (*ptr != idx)
+				{
+					++num_corrupted_blocks;
+				}
+				alloc.deallocate(ptr);
+			}
+		});
+
+	REX_CHECK(num_corrupted_blocks == 0);
+	REX_CHECK(alloc.num_free_blocks() == num_blocks);
+
+	rex::thread_pool::shutdown();
+}
@@ -0,0 +1,102 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/block_allocator.h"
+#include "rex_engine/memory/allocators/pool_allocator.h"
+#include "rex_engine/profiling/timer.h"
+#include "rex_engine/diagnostics/log.h"
+#include "rex_engine/system/system_info.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/threading/spin_lock.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/algorithm.h"
+#include "rex_std/mutex.h"
+#include "rex_std/vector.h"
+
+// Benchmarks are hidden by default as they take a while to run
+// run them explicitly by passing "[benchmark]" on the commandline
+
+DEFINE_LOG_CATEGORY(LogPoolAllocatorBenchmark);
+
+namespace
+{
+	constexpr s32 g_block_size = 64;
+	constexpr s32 g_num_rounds = 1'000;
+	constexpr s32 g_num_allocations_per_round = 64;
+
+	// Every thread allocates a batch of blocks and frees them again, for a number of rounds
+	// Returns the number of allocations per second over all threads
+	template <typename AllocFunc, typename FreeFunc>
+	f32 measure_allocations_per_second(s32 numThreads, AllocFunc&& allocFunc, FreeFunc&& freeFunc)
+	{
+		rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(numThreads));
+
+		rsl::vector<rex::task_system::Task<void>> tasks;
+		tasks.reserve(numThreads);
+
+		rex::Timer timer("pool allocator benchmark");
+		for (s32 thread_idx = 0; thread_idx < numThreads; ++thread_idx)
+		{
+			tasks.push_back(rex::run_async([&]()
+				{
+					rsl::vector<void*> ptrs;
+					ptrs.reserve(g_num_allocations_per_round);
+					for (s32 round = 0; round < g_num_rounds; ++round)
+					{
+						for (s32 i = 0; i < g_num_allocations_per_round; ++i)
+						{
+							ptrs.push_back(allocFunc());
+						}
+						for (void* ptr : ptrs)
+						{
+							freeFunc(ptr);
+						}
+						ptrs.clear();
+					}
+				}));
+		}
+		for (rex::task_system::Task<void>& task : tasks)
+		{
+			task.wait_for_me();
+		}
+		const f32 elapsed_seconds = timer.elapsed_seconds();
+
+		tasks.clear();
+		rex::thread_pool::shutdown();
+
+		return static_cast<f32>(numThreads * g_num_rounds * g_num_allocations_per_round) / elapsed_seconds;
+	}
+}
+
+TEST_CASE("TEST - Pool Allocator Benchmark - Contention", "[.][benchmark]")
+{
+	const s32 max_num_threads = rsl::max(rex::sys_info::num_logical_processors(), 1);
+	for (s32 num_threads = 1; num_threads <= max_num_threads; ++num_threads)
+	{
+		const s32 num_blocks = num_threads * g_num_allocations_per_round;
+
+		rex::PoolAllocator pool_allocator(g_block_size, num_blocks);
+		const f32 pool_allocs_per_second = measure_allocations_per_second(num_threads,
+			[&]() { return pool_allocator.allocate(g_block_size); },
+			[&](void* ptr) { pool_allocator.deallocate(ptr, g_block_size); });
+		REX_CHECK(pool_allocator.num_free_blocks() == num_blocks);
+
+		// The block allocator isn't thread safe, so it needs a lock as a baseline
+		rex::BlockAllocator block_allocator((g_block_size + sizeof(void*)) * num_blocks, g_block_size);
+		rex::SpinLock block_allocator_lock;
+		const f32 block_allocs_per_second = measure_allocations_per_second(num_threads,
+			[&]()
+			{
+				const rsl::unique_lock lock(block_allocator_lock);
+				return block_allocator.allocate(g_block_size);
+			},
+			[&](void* ptr)
+			{
+				const rsl::unique_lock lock(block_allocator_lock);
+				block_allocator.deallocate(ptr, g_block_size);
+			});
+
+		REX_INFO(LogPoolAllocatorBenchmark, "{} threads - pool allocator: {} allocations/sec, locked block allocator: {} allocations/sec", num_threads, pool_allocs_per_second, block_allocs_per_second);
+	}
+}
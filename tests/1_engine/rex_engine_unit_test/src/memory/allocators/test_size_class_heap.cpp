@@ -0,0 +1,130 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/engine_heap_allocator.h"
+#include "rex_engine/memory/allocators/size_class_heap.h"
+#include "rex_engine/task_system/parallel_for.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+
+#include "rex_std/atomic.h"
+#include "rex_std/vector.h"
+
+TEST_CASE("TEST - Size Class Heap - Size Classes")
+{
+	REX_CHECK(rex::internal::size_class_of(1) == 0);
+	REX_CHECK(rex::internal::size_class_of(16) == 0);
+	REX_CHECK(rex::internal::size_class_of(17) == 1);
+	REX_CHECK(rex::internal::size_class_of(128) == 7);
+
+	// Every size fits in its size class and the size class before it is too small
+	for (s64 size = 1; size <= rex::g_size_class_heap_max_small_size; ++size)
+	{
+		const s32 size_class = rex::internal::size_class_of(size);
+		REX_CHECK(rex::internal::size_of_class(size_class) >= size);
+		if (size_class > 0)
+		{
+			REX_CHECK(rex::internal::size_of_class(size_class - 1) < size);
+		}
+	}
+}
+
+TEST_CASE("TEST - Size Class Heap - Allocate And Free")
+{
+	rex::SizeClassHeap& heap = rex::size_class_heap();
+
+	rsl::vector<void*> ptrs;
+	for (s64 size = 8; size <= rex::g_size_class_heap_max_small_size; size *= 2)
+	{
+		void* ptr = heap.allocate(size);
+		REX_CHECK(ptr != nullptr);
+		REX_CHECK(heap.owns(ptr));
+		REX_CHECK(heap.usable_size(ptr) >= size);
+		REX_CHECK(reinterpret_cast<u64>(ptr) % 16 == 0);
+		ptrs.push_back(ptr);
+	}
+
+	for (void* ptr : ptrs)
+	{
+		heap.deallocate(ptr);
+	}
+	heap.flush_thread_cache();
+
+	s32 not_owned = 0;
+	REX_CHECK(heap.owns(&not_owned) == false);
+}
+
+TEST_CASE("TEST - Size Class Heap - Freed Blocks Are Reused")
+{
+	rex::SizeClassHeap& heap = rex::size_class_heap();
+
+	void* p1 = heap.allocate(48);
+	heap.deallocate(p1);
+	void* p2 = heap.allocate(48);
+	REX_CHECK(p1 == p2);
+	heap.deallocate(p2);
+}
+
+TEST_CASE("TEST - Size Class Heap - Allocations On Multiple Threads")
+{
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(4));
+	rex::SizeClassHeap& heap = rex::size_class_heap();
+
+	// Blocks get allocated on one thread and freed on another
+	constexpr s32 num_allocations = 10'000;
+	rsl::vector<void*> ptrs;
+	ptrs.resize(num_allocations);
+	rex::parallel_for({ 0, num_allocations }, 0, [&](s32 idx)
+		{
+			const s64 size = 16 + (idx % 64) * 24;
+			ptrs[idx] = heap.allocate(size);
+			*static_cast<s32*>(ptrs[idx]) = idx;
+		});
+
+	rsl::atomic<s32> num_corrupted_blocks = 0;
+	rex::parallel_for({ 0, num_allocations }, 0, [&](s32 idx)
+		{
+			const s32 reverse_idx = num_allocations - 1 - idx;
+			if (*static_cast<s32*>(ptrs[reverse_idx]) != reverse_idx)
+			{
+				++num_corrupted_blocks;
+			}
+			heap.deallocate(ptrs[reverse_idx]);
+		});
+
+	REX_CHECK(num_corrupted_blocks == 0);
+
+	rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Engine Heap Allocator - Routing")
+{
+	rex::EngineHeapAllocator alloc;
+	rex::SizeClassHeap& heap = rex::size_class_heap();
+
+	const bool was_enabled = rex::is_engine_heap_enabled();
+	rex::enable_engine_heap(true);
+
+	// Small allocations come from the heap, big ones from the OS
+	void* small_ptr = alloc.allocate(static_cast<card64>(64));
+	void* big_ptr = alloc.allocate(static_cast<card64>(rex::g_size_class_heap_max_small_size + 1));
+	REX_CHECK(heap.owns(small_ptr));
+	REX_CHECK(heap.owns(big_ptr) == false);
+
+	// Growing a block copies its contents
+	*static_cast<s32*>(small_ptr) = 5;
+	small_ptr = alloc.reallocate(small_ptr, 1024);
+	REX_CHECK(heap.owns(small_ptr));
+	REX_CHECK(*static_cast<s32*>(small_ptr) == 5);
+
+	// Memory can be freed after the heap gets disabled
+	rex::enable_engine_heap(false);
+	void* os_ptr = alloc.allocate(static_cast<card64>(64));
+	REX_CHECK(heap.owns(os_ptr) == false);
+
+	alloc.deallocate(small_ptr, static_cast<card64>(1024));
+	alloc.deallocate(big_ptr, static_cast<card64>(rex::g_size_class_heap_max_small_size + 1));
+	alloc.deallocate(os_ptr, static_cast<card64>(64));
+
+	rex::enable_engine_heap(was_enabled);
+}
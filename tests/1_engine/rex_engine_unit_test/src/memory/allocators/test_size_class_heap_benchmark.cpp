@@ -0,0 +1,162 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/alloc_trace.h"
+#include "rex_engine/memory/alloc_trace_replay.h"
+#include "rex_engine/memory/allocators/engine_heap_allocator.h"
+#include "rex_engine/memory/allocators/size_class_heap.h"
+#include "rex_engine/memory/allocators/untracked_allocator.h"
+#include "rex_engine/profiling/timer.h"
+#include "rex_engine/diagnostics/log.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/vector.h"
+
+#include <cstdlib>
+
+// Benchmarks are hidden by default as they take a while to run
+// run them explicitly by passing "[benchmark]" on the commandline
+
+DEFINE_LOG_CATEGORY(LogSizeClassHeapBenchmark);
+
+namespace
+{
+	constexpr s32 g_num_rounds = 100;
+	constexpr s32 g_num_allocations_per_round = 10'000;
+
+	// A mix that looks like engine startup, lots of small strings and growing containers
+	// with a few bigger buffers in between. Half of the allocations are freed right away
+	s64 startup_like_size(s32 idx)
+	{
+		if (idx % 100 == 0)
+		{
+			return 4_kib + std::rand() % 16_kib; // file buffers and tables
+		}
+		if (idx % 4 == 0)
+		{
+			return static_cast<s64>(16) << (std::rand() % 7); // container growth, 16 to 1024 bytes
+		}
+		return 8 + std::rand() % 120; // strings and paths
+	}
+
+	// Returns the number of allocations per second
+	template <typename AllocFunc, typename FreeFunc>
+	f32 measure_allocations_per_second(AllocFunc&& allocFunc, FreeFunc&& freeFunc)
+	{
+		std::srand(0);
+		rsl::vector<s64> sizes;
+		sizes.reserve(g_num_allocations_per_round);
+		for (s32 i = 0; i < g_num_allocations_per_round; ++i)
+		{
+			sizes.push_back(startup_like_size(i));
+		}
+
+		rsl::vector<void*> ptrs;
+		ptrs.reserve(g_num_allocations_per_round);
+
+		rex::Timer timer("size class heap benchmark");
+		for (s32 round = 0; round < g_num_rounds; ++round)
+		{
+			for (s32 i = 0; i < g_num_allocations_per_round; ++i)
+			{
+				ptrs.push_back(allocFunc(sizes[i]));
+
+				// Temporaries die young
+				if (i % 2 == 1)
+				{
+					freeFunc(ptrs.back());
+					ptrs.pop_back();
+				}
+			}
+			for (void* ptr : ptrs)
+			{
+				freeFunc(ptr);
+			}
+			ptrs.clear();
+		}
+		const f32 elapsed_seconds = timer.elapsed_seconds();
+
+		return static_cast<f32>(g_num_rounds * g_num_allocations_per_round) / elapsed_seconds;
+	}
+
+	constexpr s32 g_num_trace_replays = 10;
+
+	// Replays the trace a few times and returns the number of allocations per second
+	template <typename AllocFunc, typename FreeFunc>
+	f32 measure_trace_allocations_per_second(const rex::alloc_trace::AllocTrace& trace, AllocFunc&& allocFunc, FreeFunc&& freeFunc)
+	{
+		s64 num_allocations = 0;
+		rex::Timer timer("size class heap trace replay");
+		for (s32 replay = 0; replay < g_num_trace_replays; ++replay)
+		{
+			const rex::alloc_trace::AllocTraceReplayResult result = rex::alloc_trace::replay_trace(trace, allocFunc, freeFunc);
+			REX_CHECK(result.num_failed_allocations == 0);
+			num_allocations += result.num_allocations;
+		}
+		const f32 elapsed_seconds = timer.elapsed_seconds();
+
+		return static_cast<f32>(num_allocations) / elapsed_seconds;
+	}
+}
+
+TEST_CASE("TEST - Size Class Heap Benchmark - Startup Mix", "[.][benchmark]")
+{
+	rex::SizeClassHeap& heap = rex::size_class_heap();
+	const f32 heap_allocs_per_second = measure_allocations_per_second(
+		[&](s64 size) { return heap.allocate(size); },
+		[&](void* ptr) { heap.deallocate(ptr); });
+
+	rex::UntrackedAllocator os_alloc;
+	const f32 os_allocs_per_second = measure_allocations_per_second(
+		[&](s64 size) { return os_alloc.allocate(static_cast<card64>(size)); },
+		[&](void* ptr) { os_alloc.deallocate(ptr, static_cast<card64>(0)); });
+
+	heap.flush_thread_cache();
+	const rex::SizeClassHeapStats stats = heap.stats();
+
+	REX_INFO(LogSizeClassHeapBenchmark, "Size class heap: {} allocations/sec, {} bytes reserved, {} spans in use", heap_allocs_per_second, stats.reserved_memory, stats.num_spans_in_use);
+	REX_INFO(LogSizeClassHeapBenchmark, "OS allocator: {} allocations/sec", os_allocs_per_second);
+}
+
+// Replays a trace recorded with -TraceAllocations, so the heap is measured against the allocations the engine really makes
+// Copy the trace of a session into the working directory of the unit tests to run this benchmark
+TEST_CASE("TEST - Size Class Heap Benchmark - Startup Trace Replay", "[.][benchmark]")
+{
+	const rex::alloc_trace::AllocTrace trace = rex::alloc_trace::load_trace(rex::alloc_trace::g_alloc_trace_filename);
+	if (trace.records.empty())
+	{
+		REX_WARN(LogSizeClassHeapBenchmark, "No allocation trace found at \"{}\", record one by launching the engine with -TraceAllocations", rex::alloc_trace::g_alloc_trace_filename);
+		return;
+	}
+
+	// Traces hold allocations that are too big for the size class heap
+	// so the trace is replayed through the engine heap allocator, which passes those on to the OS, like it does in the engine
+	s64 num_large_allocations = 0;
+	for (const rex::alloc_trace::AllocTraceRecord& record : trace.records)
+	{
+		if (record.op == rex::alloc_trace::AllocTraceOp::Alloc && static_cast<s64>(record.size) > rex::g_size_class_heap_max_small_size)
+		{
+			++num_large_allocations;
+		}
+	}
+
+	const bool was_engine_heap_enabled = rex::is_engine_heap_enabled();
+	rex::enable_engine_heap(true);
+	rex::EngineHeapAllocator engine_heap_alloc;
+	const f32 heap_allocs_per_second = measure_trace_allocations_per_second(trace,
+		[&](s64 size) { return engine_heap_alloc.allocate(static_cast<card64>(size)); },
+		[&](void* ptr, s64 size) { engine_heap_alloc.deallocate(ptr, static_cast<card64>(size)); });
+	rex::enable_engine_heap(was_engine_heap_enabled);
+
+	rex::UntrackedAllocator os_alloc;
+	const f32 os_allocs_per_second = measure_trace_allocations_per_second(trace,
+		[&](s64 size) { return os_alloc.allocate(static_cast<card64>(size)); },
+		[&](void* ptr, s64 size) { os_alloc.deallocate(ptr, static_cast<card64>(size)); });
+
+	rex::SizeClassHeap& heap = rex::size_class_heap();
+	heap.flush_thread_cache();
+	const rex::SizeClassHeapStats stats = heap.stats();
+
+	REX_INFO(LogSizeClassHeapBenchmark, "Replayed {} trace records, {} allocations were too big for the size class heap and went to the OS", trace.records.size(), num_large_allocations);
+	REX_INFO(LogSizeClassHeapBenchmark, "Size class heap: {} allocations/sec, {} bytes reserved, {} spans in use", heap_allocs_per_second, stats.reserved_memory, stats.num_spans_in_use);
+	REX_INFO(LogSizeClassHeapBenchmark, "OS allocator: {} allocations/sec", os_allocs_per_second);
+}
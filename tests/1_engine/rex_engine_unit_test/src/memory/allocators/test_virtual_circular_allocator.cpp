@@ -0,0 +1,70 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/virtual_circular_allocator.h"
+
+#include "rex_engine/engine/types.h"
+
+TEST_CASE("TEST - Virtual Circular Allocator - Wraps Around")
+{
+	rex::VirtualCircularAllocator alloc(1_kib, 1_mib);
+
+	// Allocations that fit in the ring wrap around, the ring doesn't grow
+	void* first = alloc.allocate(512);
+	(void)alloc.allocate(512);
+	void* wrapped = alloc.allocate(512);
+
+	REX_CHECK(wrapped == first);
+	REX_CHECK(alloc.num_grows() == 0);
+	REX_CHECK(alloc.buffer_size() == 1_kib);
+}
+
+TEST_CASE("TEST - Virtual Circular Allocator - Grows When Allocation Doesn't Fit")
+{
+	rex::VirtualCircularAllocator alloc(1_kib, 1_mib);
+
+	s32* p1 = alloc.allocate<s32>();
+	*p1 = 1;
+
+	// An allocation bigger than the ring grows it instead of running out of memory
+	rsl::byte* big = static_cast<rsl::byte*>(alloc.allocate(4_kib));
+	REX_CHECK(big != nullptr);
+	big[4_kib - 1] = static_cast<rsl::byte>(1);
+	REX_CHECK(alloc.num_grows() == 1);
+	REX_CHECK(alloc.buffer_size() >= 4_kib);
+	REX_CHECK(alloc.has_allocated_ptr(big + 4_kib - 1));
+}
+
+TEST_CASE("TEST - Virtual Circular Allocator - Decommit On Reset")
+{
+	rex::VirtualCircularAllocator alloc(1_kib, 8_mib, rex::DecommitOnReset::yes);
+
+	(void)alloc.allocate(4_mib);
+	REX_CHECK(alloc.buffer_size() >= 4_mib);
+	const s64 grown_committed_size = alloc.committed_size();
+
+	// The ring shrinks back to its initial size
+	alloc.reset();
+	REX_CHECK(alloc.buffer_size() == 1_kib);
+	REX_CHECK(alloc.committed_size() < grown_committed_size);
+}
+
+TEST_CASE("TEST - Virtual Circular Allocator - Reallocate Keeps Contents")
+{
+	rex::VirtualCircularAllocator alloc(1_kib, 1_mib);
+
+	s32* p1 = static_cast<s32*>(alloc.allocate(sizeof(s32)));
+	*p1 = 5;
+
+	// The last allocation grows in place
+	s32* p2 = static_cast<s32*>(alloc.reallocate(p1, 2 * sizeof(s32)));
+	REX_CHECK(p2 == p1);
+	REX_CHECK(*p2 == 5);
+
+	// Any other allocation gets copied
+	s32* p3 = alloc.allocate<s32>();
+	*p3 = 6;
+	s32* p4 = static_cast<s32*>(alloc.reallocate(p2, 4 * sizeof(s32)));
+	REX_CHECK(p4 != p2);
+	REX_CHECK(*p4 == 5);
+	REX_CHECK(*p3 == 6);
+}
@@ -0,0 +1,83 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocators/virtual_stack_allocator.h"
+#include "rex_engine/memory/virtual_memory.h"
+
+#include "rex_engine/engine/types.h"
+
+TEST_CASE("TEST - Virtual Stack Allocator - Commits On Demand")
+{
+	rex::VirtualStackAllocator allocator(64_mib);
+
+	// Nothing is committed until something is allocated
+	REX_CHECK(allocator.committed_size() == 0);
+	REX_CHECK(allocator.buffer_size() >= 64_mib);
+
+	s32* p1 = allocator.allocate<s32>();
+	*p1 = 1;
+	REX_CHECK(allocator.committed_size() > 0);
+	REX_CHECK(allocator.committed_size() < 64_mib);
+
+	// Allocations past the committed range commit more memory
+	const s64 committed_size = allocator.committed_size();
+	rsl::byte* big = static_cast<rsl::byte*>(allocator.allocate(committed_size * 2));
+	big[committed_size * 2 - 1] = static_cast<rsl::byte>(5);
+	REX_CHECK(allocator.committed_size() > committed_size);
+	REX_CHECK(allocator.has_allocated_ptr(big));
+	REX_CHECK(*p1 == 1);
+}
+
+TEST_CASE("TEST - Virtual Stack Allocator - Markers")
+{
+	rex::VirtualStackAllocator allocator(1_mib);
+
+	s32* p1 = allocator.allocate<s32>();
+	const rex::StackMarker marker = allocator.current_marker();
+	s32* p2 = allocator.allocate<s32>();
+
+	allocator.set_marker(marker);
+	s32* p3 = allocator.allocate<s32>();
+	REX_CHECK(p3 == p2);
+
+	allocator.reset();
+	s32* p4 = allocator.allocate<s32>();
+	REX_CHECK(p4 == p1);
+}
+
+TEST_CASE("TEST - Virtual Stack Allocator - Decommit On Reset")
+{
+	rex::VirtualStackAllocator allocator(64_mib, rex::DecommitOnReset::yes);
+
+	rsl::byte* mem = static_cast<rsl::byte*>(allocator.allocate(4_mib));
+	mem[0] = static_cast<rsl::byte>(1);
+	REX_CHECK(allocator.committed_size() >= 4_mib);
+
+	allocator.reset();
+	REX_CHECK(allocator.committed_size() == 0);
+
+	// Memory that got committed again is zero initialized
+	rsl::byte* new_mem = static_cast<rsl::byte*>(allocator.allocate(4_mib));
+	REX_CHECK(new_mem == mem);
+	REX_CHECK(new_mem[0] == static_cast<rsl::byte>(0));
+}
+
+TEST_CASE("TEST - Virtual Stack Allocator - Reallocate Keeps Contents")
+{
+	rex::VirtualStackAllocator allocator(1_mib);
+
+	s32* p1 = static_cast<s32*>(allocator.allocate(sizeof(s32)));
+	*p1 = 5;
+
+	// The last allocation grows in place
+	s32* p2 = static_cast<s32*>(allocator.reallocate(p1, 2 * sizeof(s32)));
+	REX_CHECK(p2 == p1);
+	REX_CHECK(*p2 == 5);
+
+	// Any other allocation gets copied
+	s32* p3 = allocator.allocate<s32>();
+	*p3 = 6;
+	s32* p4 = static_cast<s32*>(allocator.reallocate(p2, 4 * sizeof(s32)));
+	REX_CHECK(p4 != p2);
+	REX_CHECK(*p4 == 5);
+	REX_CHECK(*p3 == 6);
+}
@@ -0,0 +1,94 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/global_allocators/global_scratch_allocator.h"
+#include "rex_engine/memory/memory_types.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_std/vector.h"
+
+TEST_CASE("TEST - Global Scratch Allocator - Reallocate Keeps Contents")
+{
+	rex::GlobalScratchAllocator alloc;
+
+	s32* p1 = static_cast<s32*>(alloc.allocate(sizeof(s32)));
+	*p1 = 5;
+	REX_CHECK(alloc.has_allocated_ptr(p1));
+
+	s32* p2 = static_cast<s32*>(alloc.reallocate(p1, 4 * sizeof(s32)));
+	REX_CHECK(*p2 == 5);
+
+	alloc.deallocate(p2, 4 * sizeof(s32));
+}
+
+TEST_CASE("TEST - Global Scratch Allocator - Allocations On Multiple Threads")
+{
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(4));
+
+	// Every thread builds strings in its own arena, so they don't overwrite each other
+	constexpr s32 num_jobs = 64;
+	rsl::vector<rex::task_system::Task<bool>> tasks;
+	tasks.reserve(num_jobs);
+	for (s32 i = 0; i < num_jobs; ++i)
+	{
+		tasks.push_back(rex::run_async([i]()
+			{
+				const char8 c = static_cast<char8>('a' + (i % 26));
+				rex::scratch_string str;
+				for (s32 j = 0; j < 32; ++j)
+				{
+					str += c;
+				}
+
+				bool is_valid = rex::GlobalScratchAllocator().has_allocated_ptr(str.data());
+				for (const char8 str_char : str)
+				{
+					is_valid &= str_char == c;
+				}
+
+				return is_valid && str.size() == 32;
+			}));
+	}
+
+	for (rex::task_system::Task<bool>& task : tasks)
+	{
+		REX_CHECK(task.result());
+	}
+
+	rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Global Scratch Allocator - Allocations Of Other Threads")
+{
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(4));
+
+	// Scratch memory of another thread is recognized, even after that thread exited
+	constexpr s32 num_jobs = 16;
+	rsl::vector<rex::task_system::Task<s32*>> tasks;
+	tasks.reserve(num_jobs);
+	for (s32 i = 0; i < num_jobs; ++i)
+	{
+		tasks.push_back(rex::run_async([i]()
+			{
+				s32* value = static_cast<s32*>(rex::GlobalScratchAllocator().allocate(sizeof(s32)));
+				*value = i;
+				return value;
+			}));
+	}
+
+	rsl::vector<s32*> values;
+	values.reserve(num_jobs);
+	for (rex::task_system::Task<s32*>& task : tasks)
+	{
+		values.push_back(task.result());
+	}
+	tasks.clear();
+
+	rex::thread_pool::shutdown();
+
+	for (s32 i = 0; i < num_jobs; ++i)
+	{
+		REX_CHECK(rex::GlobalScratchAllocator().has_allocated_ptr(values[i]));
+		REX_CHECK(*values[i] == i);
+	}
+}
@@ -0,0 +1,155 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/alloc_trace.h"
+#include "rex_engine/memory/alloc_trace_replay.h"
+#include "rex_engine/memory/allocators/block_allocator.h"
+#include "rex_engine/memory/allocators/buddy_allocator.h"
+#include "rex_engine/memory/global_allocators/global_allocator.h"
+#include "rex_engine/filesystem/tmp_cwd.h"
+#include "rex_engine/filesystem/tmp_file.h"
+
+#include "rex_engine/engine/types.h"
+
+namespace
+{
+	rex::alloc_trace::AllocTraceRecord make_record(rex::alloc_trace::AllocTraceOp op, u32 ptrId, u32 size)
+	{
+		rex::alloc_trace::AllocTraceRecord record{};
+		record.op = op;
+		record.ptr_id = ptrId;
+		record.size = size;
+		return record;
+	}
+
+	// Allocates 3 blocks, frees the first 2 and leaves the last one alive
+	rex::alloc_trace::AllocTrace make_test_trace()
+	{
+		rex::alloc_trace::AllocTrace trace{};
+		trace.records.push_back(make_record(rex::alloc_trace::AllocTraceOp::Alloc, 1, 16));
+		trace.records.push_back(make_record(rex::alloc_trace::AllocTraceOp::Alloc, 2, 32));
+		trace.records.push_back(make_record(rex::alloc_trace::AllocTraceOp::Free, 1, 16));
+		trace.records.push_back(make_record(rex::alloc_trace::AllocTraceOp::Alloc, 3, 64));
+		trace.records.push_back(make_record(rex::alloc_trace::AllocTraceOp::Free, 2, 32));
+		trace.max_ptr_id = 3;
+		return trace;
+	}
+}
+
+TEST_CASE("TEST - Alloc Trace - Write And Load")
+{
+	rex::TempCwd tmp_cwd("alloc_trace_tests");
+	rex::TempFile tmp_file;
+
+	const rex::alloc_trace::AllocTrace trace = make_test_trace();
+	{
+		rex::alloc_trace::AllocTraceWriter writer(tmp_file.filepath());
+		for (const rex::alloc_trace::AllocTraceRecord& record : trace.records)
+		{
+			writer.write(record);
+		}
+		writer.flush();
+		REX_CHECK(writer.num_records_written() == static_cast<s64>(trace.records.size()));
+	}
+
+	const rex::alloc_trace::AllocTrace loaded_trace = rex::alloc_trace::load_trace(tmp_file.filepath());
+	REX_CHECK(loaded_trace.records.size() == trace.records.size());
+	REX_CHECK(loaded_trace.max_ptr_id == 3);
+	for (count_t i = 0; i < loaded_trace.records.size(); ++i)
+	{
+		REX_CHECK(loaded_trace.records[i].op == trace.records[i].op);
+		REX_CHECK(loaded_trace.records[i].ptr_id == trace.records[i].ptr_id);
+		REX_CHECK(loaded_trace.records[i].size == trace.records[i].size);
+	}
+}
+
+TEST_CASE("TEST - Alloc Trace - Load Invalid File")
+{
+	rex::TempCwd tmp_cwd("alloc_trace_tests");
+	rex::TempFile tmp_file;
+
+	const char8 not_a_trace[] = "this is not an allocation trace";
+	tmp_file.write(not_a_trace, sizeof(not_a_trace));
+
+	const rex::alloc_trace::AllocTrace loaded_trace = rex::alloc_trace::load_trace(tmp_file.filepath());
+	REX_CHECK(loaded_trace.records.empty());
+}
+
+TEST_CASE("TEST - Alloc Trace - Replay")
+{
+	const rex::alloc_trace::AllocTrace trace = make_test_trace();
+
+	rex::BuddyAllocator buddy_allocator(1_kib);
+	const rex::alloc_trace::AllocTraceReplayResult buddy_result = rex::alloc_trace::replay_trace(trace, buddy_allocator);
+	REX_CHECK(buddy_result.num_allocations == 3);
+	REX_CHECK(buddy_result.num_frees == 2);
+	REX_CHECK(buddy_result.num_failed_allocations == 0);
+	REX_CHECK(buddy_result.num_leaked_allocations == 1);
+	REX_CHECK(buddy_result.peak_live_bytes == 32 + 64);
+
+	// The block allocator needs every allocation to fit in a block
+	rex::BlockAllocator block_allocator(1_kib, 64);
+	const rex::alloc_trace::AllocTraceReplayResult block_result = rex::alloc_trace::replay_trace(trace, block_allocator);
+	REX_CHECK(block_result.num_allocations == 3);
+	REX_CHECK(block_result.num_frees == 2);
+	REX_CHECK(block_result.num_failed_allocations == 0);
+
+	rex::GlobalAllocator global_allocator;
+	const rex::alloc_trace::AllocTraceReplayResult global_result = rex::alloc_trace::replay_trace(trace, global_allocator);
+	REX_CHECK(global_result.num_allocations == 3);
+	REX_CHECK(global_result.num_frees == 2);
+	REX_CHECK(global_result.num_failed_allocations == 0);
+}
+
+TEST_CASE("TEST - Alloc Trace - Replay Skips Unknown Frees")
+{
+	rex::alloc_trace::AllocTrace trace{};
+	trace.records.push_back(make_record(rex::alloc_trace::AllocTraceOp::Free, 1, 16));
+	trace.max_ptr_id = 1;
+
+	rex::BuddyAllocator allocator(1_kib);
+	const rex::alloc_trace::AllocTraceReplayResult result = rex::alloc_trace::replay_trace(trace, allocator);
+	REX_CHECK(result.num_frees == 0);
+	REX_CHECK(result.num_skipped_frees == 1);
+}
+
+#ifdef REX_ENABLE_MEM_TRACKING
+TEST_CASE("TEST - Alloc Trace - Record Tracked Allocations")
+{
+	rex::TempCwd tmp_cwd("alloc_trace_tests");
+	rex::TempFile tmp_file;
+
+	rex::alloc_trace::start_recording(tmp_file.filepath());
+	REX_CHECK(rex::alloc_trace::is_recording());
+	s32* ptr = new s32(1);
+	delete ptr;
+	rex::alloc_trace::stop_recording();
+	REX_CHECK(rex::alloc_trace::is_recording() == false);
+
+	// Other threads can allocate while recording, so look for an allocation that got freed again
+	const rex::alloc_trace::AllocTrace trace = rex::alloc_trace::load_trace(tmp_file.filepath());
+	REX_CHECK(trace.records.size() >= 2);
+
+	bool found_free_of_alloc = false;
+	for (count_t i = 0; i < trace.records.size(); ++i)
+	{
+		if (trace.records[i].op != rex::alloc_trace::AllocTraceOp::Free)
+		{
+			continue;
+		}
+		for (count_t j = 0; j < i; ++j)
+		{
+			if (trace.records[j].op == rex::alloc_trace::AllocTraceOp::Alloc && trace.records[j].ptr_id == trace.records[i].ptr_id)
+			{
+				found_free_of_alloc = true;
+			}
+		}
+	}
+	REX_CHECK(found_free_of_alloc);
+
+	// Replaying the recorded trace leaves nothing alive
+	rex::GlobalAllocator allocator;
+	const rex::alloc_trace::AllocTraceReplayResult result = rex::alloc_trace::replay_trace(trace, allocator);
+	REX_CHECK(result.num_failed_allocations == 0);
+	REX_CHECK(result.num_allocations >= 1);
+}
+#endif
@@ -0,0 +1,123 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/allocation_sampler.h"
+#include "rex_engine/memory/memory_tracking.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/tmp_cwd.h"
+#include "rex_engine/filesystem/tmp_file.h"
+
+#include "rex_engine/engine/types.h"
+
+TEST_CASE("TEST - Allocation Sampler - Disabled")
+{
+	rex::AllocationSampler sampler;
+	sampler.set_sample_rate(0);
+	REX_CHECK(sampler.is_enabled() == false);
+
+	for (s32 i = 0; i < 1000; ++i)
+	{
+		sampler.on_allocation(1_kib);
+	}
+
+	REX_CHECK(sampler.stats().num_samples == 0);
+}
+
+TEST_CASE("TEST - Allocation Sampler - Estimates Allocated Bytes")
+{
+	rex::AllocationSampler sampler;
+	sampler.set_sample_rate(1_kib);
+	REX_CHECK(sampler.is_enabled());
+
+	// Samples are taken at random distances, but on average there's one every sample rate bytes
+	constexpr s32 num_allocations = 100'000;
+	constexpr s64 alloc_size = 64;
+	for (s32 i = 0; i < num_allocations; ++i)
+	{
+		sampler.on_allocation(alloc_size);
+	}
+
+	const rex::AllocationSamplerStats stats = sampler.stats();
+	const s64 total_bytes = num_allocations * alloc_size;
+	REX_CHECK(stats.num_samples > 0);
+	REX_CHECK(stats.num_samples < num_allocations / 4);
+	REX_CHECK(stats.estimated_bytes > total_bytes / 2);
+	REX_CHECK(stats.estimated_bytes < total_bytes * 2);
+
+	// All allocations came from the same callstack
+	REX_CHECK(stats.num_callstacks == 1);
+
+	sampler.clear();
+	REX_CHECK(sampler.stats().num_samples == 0);
+}
+
+TEST_CASE("TEST - Allocation Sampler - Samplers Don't Share Countdowns")
+{
+	// Start a countdown for a small sample rate on this thread
+	rex::AllocationSampler small_rate_sampler;
+	small_rate_sampler.set_sample_rate(1_kib);
+	small_rate_sampler.on_allocation(1);
+
+	// A different sampler restarts the countdown for its own sample rate, which is at least half of it away
+	rex::AllocationSampler big_rate_sampler;
+	big_rate_sampler.set_sample_rate(1_mib);
+	for (s32 i = 0; i < 100; ++i)
+	{
+		big_rate_sampler.on_allocation(64);
+	}
+
+	REX_CHECK(big_rate_sampler.stats().num_samples == 0);
+}
+
+TEST_CASE("TEST - Allocation Sampler - Big Allocations Are Always Sampled")
+{
+	rex::AllocationSampler sampler;
+	sampler.set_sample_rate(1_kib);
+
+	for (s32 i = 0; i < 10; ++i)
+	{
+		sampler.on_allocation(4_kib);
+	}
+
+	const rex::AllocationSamplerStats stats = sampler.stats();
+	REX_CHECK(stats.num_samples == 10);
+	REX_CHECK(stats.estimated_bytes == 10 * 4_kib);
+}
+
+TEST_CASE("TEST - Allocation Sampler - Samples Per Memory Tag")
+{
+	rex::AllocationSampler sampler;
+	sampler.set_sample_rate(1_kib);
+
+	{
+		REX_MEM_TAG_SCOPE(rex::MemoryTag::FileIO);
+		sampler.on_allocation(4_kib);
+	}
+
+	const debug_hash_map<rex::CallStack, rex::AllocationSample> samples = sampler.samples();
+	REX_CHECK(samples.size() == 1);
+	for (const auto& [callstack, sample] : samples)
+	{
+		REX_CHECK(sample.num_samples_per_tag[rsl::enum_refl::enum_integer(rex::MemoryTag::FileIO)] == 1);
+		REX_CHECK(sample.estimated_bytes_per_tag[rsl::enum_refl::enum_integer(rex::MemoryTag::FileIO)] == 4_kib);
+	}
+}
+
+TEST_CASE("TEST - Allocation Sampler - Export Folded Stacks")
+{
+	rex::TempCwd tmp_cwd("alloc_sampler_tests");
+	rex::TempFile tmp_file;
+
+	rex::AllocationSampler sampler;
+	sampler.set_sample_rate(1_kib);
+	{
+		REX_MEM_TAG_SCOPE(rex::MemoryTag::FileIO);
+		sampler.on_allocation(4_kib);
+	}
+	sampler.export_folded_stacks(tmp_file.filepath());
+
+	// Every line starts with the memory tag and ends with the estimated bytes
+	const rex::memory::Blob blob = rex::file::read_file_abspath(tmp_file.filepath());
+	const rsl::string_view content(reinterpret_cast<const char8*>(blob.data()), static_cast<s32>(blob.size())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	REX_CHECK(content.starts_with("FileIO;"));
+	REX_CHECK(content.ends_with(" 4096\n"));
+}
@@ -4,6 +4,8 @@
 #include "rex_engine/memory/blob.h"
 #include "rex_engine/engine/types.h"
 
+#include "rex_std/array.h"
+
 TEST_CASE("TEST - BlobReader - Read from blob")
 {
   auto data = rsl::make_unique<s32[]>(5);
@@ -98,4 +100,21 @@ TEST_CASE("TEST - BlobReader - Read from blob from offset with skipping")
   REX_CHECK(reader.read_offset() == sizeof(s32) * 4);
   REX_CHECK(reader.read<s32>() == 5);
   REX_CHECK(reader.read_offset() == sizeof(s32) * 5);
-}
\ No newline at end of file
+}
+TEST_CASE("TEST - BlobReader - Read past the end of the blob")
+{
+  auto data = rsl::make_unique<s32[]>(2);
+  data[0] = 1;
+  data[1] = 2;
+
+  rex::memory::Blob blob(rsl::move(data));
+  rex::memory::BlobReader reader(blob, sizeof(s32));
+
+  rsl::array<s32, 2> values{};
+  REX_CHECK(static_cast<s64>(reader.read(values.data(), sizeof(values))) == sizeof(s32));
+  REX_CHECK(values[0] == 2);
+  REX_CHECK(reader.read_offset() == sizeof(s32) * 2);
+
+  REX_CHECK(static_cast<s64>(reader.read(values.data(), sizeof(values))) == 0);
+  REX_CHECK(reader.read_offset() == sizeof(s32) * 2);
+}
@@ -0,0 +1,115 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/memory_budgets.h"
+#include "rex_engine/filesystem/file.h"
+#include "rex_engine/filesystem/tmp_cwd.h"
+#include "rex_engine/filesystem/tmp_file.h"
+
+#include "rex_engine/engine/types.h"
+
+namespace
+{
+	rex::MemoryBudgets::UsagePerTag usage_of(rex::MemoryTag tag, s64 usage)
+	{
+		rex::MemoryBudgets::UsagePerTag usage_per_tag{};
+		usage_per_tag[rsl::enum_refl::enum_integer(tag)] = usage;
+		return usage_per_tag;
+	}
+}
+
+TEST_CASE("TEST - Memory Budgets - Empty")
+{
+	rex::MemoryBudgets budgets;
+
+	REX_CHECK(budgets.num_recorded_frames() == 0);
+	REX_CHECK(budgets.usage_series(rex::MemoryTag::Renderer).empty());
+	REX_CHECK(budgets.budget(rex::MemoryTag::Renderer) == 0);
+	REX_CHECK(budgets.is_over_budget(rex::MemoryTag::Renderer) == false);
+}
+
+TEST_CASE("TEST - Memory Budgets - Record Frames")
+{
+	rex::MemoryBudgets budgets;
+
+	for (s32 i = 0; i < 3; ++i)
+	{
+		const rex::MemoryBudgets::UsagePerTag usage = usage_of(rex::MemoryTag::FileIO, i * 10);
+		budgets.record_frame(static_cast<card32>(i), usage);
+	}
+
+	REX_CHECK(budgets.num_recorded_frames() == 3);
+	for (s32 i = 0; i < 3; ++i)
+	{
+		REX_CHECK(budgets.frame_index(i) == static_cast<card32>(i));
+		REX_CHECK(budgets.usage(rex::MemoryTag::FileIO, i) == i * 10);
+		REX_CHECK(budgets.usage(rex::MemoryTag::Renderer, i) == 0);
+	}
+}
+
+TEST_CASE("TEST - Memory Budgets - History Wraps Around")
+{
+	rex::MemoryBudgets budgets;
+
+	const s32 num_frames = rex::g_memory_budget_history_size + 10;
+	for (s32 i = 0; i < num_frames; ++i)
+	{
+		const rex::MemoryBudgets::UsagePerTag usage = usage_of(rex::MemoryTag::FileIO, i);
+		budgets.record_frame(static_cast<card32>(i), usage);
+	}
+
+	// Only the last frames are kept, from oldest to newest
+	REX_CHECK(budgets.num_recorded_frames() == rex::g_memory_budget_history_size);
+	REX_CHECK(budgets.frame_index(0) == 10);
+	REX_CHECK(budgets.frame_index(rex::g_memory_budget_history_size - 1) == static_cast<card32>(num_frames - 1));
+
+	const debug_vector<f32> series = budgets.usage_series(rex::MemoryTag::FileIO);
+	REX_CHECK(series.size() == rex::g_memory_budget_history_size);
+	REX_CHECK(series.front() == 10.0f);
+	REX_CHECK(series.back() == static_cast<f32>(num_frames - 1));
+}
+
+TEST_CASE("TEST - Memory Budgets - Over Budget")
+{
+	rex::MemoryBudgets budgets;
+	budgets.set_policy(rex::MemoryBudgetPolicy::Warn);
+	budgets.set_budget(rex::MemoryTag::Renderer, 1_kib);
+	REX_CHECK(budgets.budget(rex::MemoryTag::Renderer) == 1_kib);
+
+	const rex::MemoryBudgets::UsagePerTag under_budget = usage_of(rex::MemoryTag::Renderer, 1_kib);
+	const rex::MemoryBudgets::UsagePerTag over_budget = usage_of(rex::MemoryTag::Renderer, 2_kib);
+
+	budgets.record_frame(0, under_budget);
+	REX_CHECK(budgets.is_over_budget(rex::MemoryTag::Renderer) == false);
+
+	budgets.record_frame(1, over_budget);
+	REX_CHECK(budgets.is_over_budget(rex::MemoryTag::Renderer) == true);
+
+	budgets.record_frame(2, over_budget);
+	REX_CHECK(budgets.is_over_budget(rex::MemoryTag::Renderer) == true);
+
+	budgets.record_frame(3, under_budget);
+	REX_CHECK(budgets.is_over_budget(rex::MemoryTag::Renderer) == false);
+
+	// Tags without a budget are never over budget
+	const rex::MemoryBudgets::UsagePerTag file_io_usage = usage_of(rex::MemoryTag::FileIO, 1024_mib);
+	budgets.record_frame(4, file_io_usage);
+	REX_CHECK(budgets.is_over_budget(rex::MemoryTag::FileIO) == false);
+}
+
+TEST_CASE("TEST - Memory Budgets - Dump To CSV")
+{
+	rex::TempCwd tmp_cwd("memory_budgets_tests");
+	rex::TempFile tmp_file;
+
+	rex::MemoryBudgets budgets;
+	const rex::MemoryBudgets::UsagePerTag usage = usage_of(rex::MemoryTag::ConsoleApp, 4_kib);
+	budgets.record_frame(7, usage);
+	budgets.dump_to_csv(tmp_file.filepath());
+
+	// A header line with the memory tags, followed by a line per frame
+	const rex::memory::Blob blob = rex::file::read_file_abspath(tmp_file.filepath());
+	const rsl::string_view content(reinterpret_cast<const char8*>(blob.data()), static_cast<s32>(blob.size())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	REX_CHECK(content.starts_with("frame,ConsoleApp,"));
+	REX_CHECK(content.find("\n7,4096,") != rsl::string_view::npos());
+	REX_CHECK(content.ends_with("\n"));
+}
@@ -74,17 +74,35 @@ TEST_CASE("TEST - Memory Stats - Memory Tracking Stats")
 
 	// After the deallocation, the memory should come back
 	rex::MemoryAllocationStats stats4 = rex::query_mem_tracking_stats();
-	REX_CHECK(stats4.max_used_memory >= stats1.max_used_memory);
+	REX_CHECK(stats4.max_used_memory == stats3.max_used_memory);
 	REX_CHECK(stats4.used_memory == stats1.used_memory);
 	REX_CHECK(stats4.num_alive_allocations == stats1.num_alive_allocations);
 	REX_CHECK(stats4.num_total_allocations == stats1.num_total_allocations + 1);
 	REX_CHECK(stats4.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Global).value()].value() == stats1.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Global).value()].value());
-	REX_CHECK(stats4.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Global).value()].max_value() == stats1.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Global).value()].max_value());
+	REX_CHECK(stats4.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Global).value()].max_value() == stats3.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Global).value()].max_value());
 	REX_CHECK(stats4.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Engine).value()].value() == stats1.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::Engine).value()].value());
 	REX_CHECK(stats4.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::FileIO).value()].value() == stats1.usage_per_tag[rsl::enum_refl::enum_index(rex::MemoryTag::FileIO).value()].value());
 
 }
 
+TEST_CASE("TEST - Memory Stats - Peaks Between Queries")
+{
+	const count_t file_io_idx = rsl::enum_refl::enum_index(rex::MemoryTag::FileIO).value();
+	rex::MemoryAllocationStats stats1 = rex::query_mem_tracking_stats();
+
+	// An allocation that's freed before the next query still shows up in the peaks
+	{
+		REX_MEM_TAG_SCOPE(rex::MemoryTag::FileIO);
+		s8* buffer = new s8[1_mib];
+		delete[] buffer;
+	}
+
+	rex::MemoryAllocationStats stats2 = rex::query_mem_tracking_stats();
+	REX_CHECK(stats2.usage_per_tag[file_io_idx].value() == stats1.usage_per_tag[file_io_idx].value());
+	REX_CHECK(stats2.usage_per_tag[file_io_idx].max_value() >= stats1.usage_per_tag[file_io_idx].value() + 1_mib);
+	REX_CHECK(stats2.max_used_memory >= stats1.used_memory.size_in_bytes() + 1_mib);
+}
+
 TEST_CASE("TEST - Memory Stats - All Memory Stats")
 {
 	// This is essentially the same as the above, just put together into 1 test case
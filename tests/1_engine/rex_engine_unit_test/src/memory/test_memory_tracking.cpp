@@ -3,6 +3,9 @@
 #include "rex_engine/memory/memory_tracking.h"
 #include "rex_engine/memory/memory_header.h"
 #include "rex_engine/engine/casting.h"
+#include "rex_engine/task_system/parallel_for.h"
+#include "rex_engine/threading/thread_pool.h"
+#include "rex_std/vector.h"
 
 TEST_CASE("TEST - Memory Tracking - Single Memory Tag Allocation")
 {
@@ -52,4 +55,83 @@ TEST_CASE("TEST - Memory Tracking - Multiple Memory Tag Allocation")
 	stats = rex::mem_tracker().current_tracking_stats();
 	REX_CHECK(current_global_mem_usage == stats.usage_per_tag[rex::to_int(rex::MemoryTag::Global)].value());
 	REX_CHECK(current_engine_mem_usage == stats.usage_per_tag[rex::to_int(rex::MemoryTag::Engine)].value());
-}
\ No newline at end of file
+}
+TEST_CASE("TEST - Memory Tracking - Out Of Order Deallocation")
+{
+	const s32 num_alive_allocations = rex::mem_tracker().current_tracking_stats().num_alive_allocations;
+
+	s32* x = new int(1);
+	s32* y = new int(2);
+	s32* z = new int(3);
+
+	// Freeing from the middle swaps the last allocation into its place
+	delete y;
+	REX_CHECK(rex::mem_tracker().current_tracking_stats().num_alive_allocations == num_alive_allocations + 2);
+	delete x;
+	delete z;
+
+	REX_CHECK(rex::mem_tracker().current_tracking_stats().num_alive_allocations == num_alive_allocations);
+}
+
+TEST_CASE("TEST - Memory Tracking - Callstack Sampling")
+{
+	const card32 sample_rate = rex::mem_tracker().callstack_sample_rate();
+	rex::mem_tracker().set_callstack_sample_rate(0);
+
+	rex::MemoryAllocationStats stats = rex::mem_tracker().current_tracking_stats();
+	const s64 current_global_mem_usage = stats.usage_per_tag[rex::to_int(rex::MemoryTag::Global)].value();
+
+	// Allocations without a callstack are still tracked
+	s32* y = new int(1);
+	stats = rex::mem_tracker().current_tracking_stats();
+	REX_CHECK(current_global_mem_usage < stats.usage_per_tag[rex::to_int(rex::MemoryTag::Global)].value());
+
+	delete y;
+	stats = rex::mem_tracker().current_tracking_stats();
+	REX_CHECK(current_global_mem_usage == stats.usage_per_tag[rex::to_int(rex::MemoryTag::Global)].value());
+
+	rex::mem_tracker().set_callstack_sample_rate(sample_rate);
+}
+
+TEST_CASE("TEST - Memory Tracking - Allocations On Multiple Threads")
+{
+	rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(4));
+
+	constexpr s32 num_allocations = 10'000;
+	rsl::vector<s32*> allocations;
+	allocations.reserve(num_allocations);
+	for (s32 i = 0; i < num_allocations; ++i)
+	{
+		allocations.push_back(nullptr);
+	}
+
+	s32 debug_allocation_overhead = 0;
+#ifdef REX_ENABLE_MEM_TRACKING
+	debug_allocation_overhead += sizeof(rex::InlineMemoryHeader);
+#endif
+
+	rex::MemoryAllocationStats stats = rex::mem_tracker().current_tracking_stats();
+	const s64 current_file_io_mem_usage = stats.usage_per_tag[rex::to_int(rex::MemoryTag::FileIO)].value();
+	const s32 num_total_allocations = stats.num_total_allocations;
+
+	rex::parallel_for({ 0, num_allocations }, 0, [&allocations](s32 idx)
+		{
+			REX_MEM_TAG_SCOPE(rex::MemoryTag::FileIO);
+			allocations[idx] = new s32(idx);
+		});
+
+	stats = rex::mem_tracker().current_tracking_stats();
+	REX_CHECK(stats.usage_per_tag[rex::to_int(rex::MemoryTag::FileIO)].value() == current_file_io_mem_usage + num_allocations * (static_cast<s32>(sizeof(s32)) + debug_allocation_overhead));
+	REX_CHECK(stats.num_total_allocations >= num_total_allocations + num_allocations);
+
+	// Free in the opposite order, so most allocations get freed on a different thread than the one that allocated them
+	rex::parallel_for({ 0, num_allocations }, 0, [&allocations](s32 idx)
+		{
+			delete allocations[num_allocations - idx - 1];
+		});
+
+	stats = rex::mem_tracker().current_tracking_stats();
+	REX_CHECK(stats.usage_per_tag[rex::to_int(rex::MemoryTag::FileIO)].value() == current_file_io_mem_usage);
+
+	rex::thread_pool::shutdown();
+}
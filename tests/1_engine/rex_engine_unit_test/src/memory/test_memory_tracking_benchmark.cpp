@@ -0,0 +1,72 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/memory/memory_tracking.h"
+#include "rex_engine/profiling/timer.h"
+#include "rex_engine/diagnostics/log.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/vector.h"
+
+// Benchmarks are hidden by default as they take a while to run
+// run them explicitly by passing "[benchmark]" on the commandline
+
+DEFINE_LOG_CATEGORY(LogMemoryTrackingBenchmark);
+
+namespace
+{
+	// The number of allocations that get freed to measure the cost of a free
+	constexpr s32 g_num_measured_frees = 10'000;
+
+	// Returns the average time in nanoseconds it takes to free an allocation
+	// while the given number of other allocations are alive
+	f32 measure_free_cost(s32 numLiveAllocations)
+	{
+		rsl::vector<s32*> live_allocations;
+		live_allocations.reserve(numLiveAllocations);
+		for (s32 i = 0; i < numLiveAllocations; ++i)
+		{
+			live_allocations.push_back(new s32(i));
+		}
+
+		// The most recent allocations are the ones furthest away from the start of the tracked allocations
+		rsl::vector<s32*> measured_allocations;
+		measured_allocations.reserve(g_num_measured_frees);
+		for (s32 i = 0; i < g_num_measured_frees; ++i)
+		{
+			measured_allocations.push_back(new s32(i));
+		}
+
+		rex::Timer timer("memory tracking benchmark");
+		for (s32* ptr : measured_allocations)
+		{
+			delete ptr;
+		}
+		const f32 elapsed_ns = static_cast<f32>(timer.elapsed_time().count());
+
+		for (s32* ptr : live_allocations)
+		{
+			delete ptr;
+		}
+
+		return elapsed_ns / g_num_measured_frees;
+	}
+}
+
+TEST_CASE("TEST - Memory Tracking Benchmark - Free Cost", "[.][benchmark]")
+{
+	// Callstack capturing has a constant cost per allocation, it's disabled so we only measure the tracking itself
+	const card32 sample_rate = rex::mem_tracker().callstack_sample_rate();
+	rex::mem_tracker().set_callstack_sample_rate(0);
+
+	const f32 small_heap_cost = measure_free_cost(1'000);
+	const f32 large_heap_cost = measure_free_cost(1'000'000);
+
+	REX_INFO(LogMemoryTrackingBenchmark, "Free cost with 1K live allocations: {}ns", small_heap_cost);
+	REX_INFO(LogMemoryTrackingBenchmark, "Free cost with 1M live allocations: {}ns", large_heap_cost);
+
+	// The cost of a free shouldn't depend on the number of live allocations
+	// leave some room for cache effects of a bigger heap
+	REX_CHECK(large_heap_cost < small_heap_cost * 4.0f);
+
+	rex::mem_tracker().set_callstack_sample_rate(sample_rate);
+}
@@ -0,0 +1,154 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/task_system/coroutine.h"
+#include "rex_engine/engine/casting.h"
+#include "rex_engine/filesystem/native_filesystem.h"
+#include "rex_engine/filesystem/path.h"
+#include "rex_engine/filesystem/vfs.h"
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/atomic.h"
+#include "rex_std/string.h"
+#include "rex_std/thread.h"
+
+#ifdef REX_HAS_COROUTINES
+
+namespace
+{
+  // Wait for a coroutine to finish without being a coroutine ourselves
+  template <typename T>
+  void wait_for_coroutine(const rex::Coroutine<T>& coroutine)
+  {
+    while (!coroutine.is_finished())
+    {
+      if (!rex::task_system::run_pending_job())
+      {
+        rsl::this_thread::yield();
+      }
+    }
+  }
+
+  rex::Coroutine<s32> add_async(s32 lhs, s32 rhs)
+  {
+    const s32 res = co_await rex::run_async([lhs, rhs]() { return lhs + rhs; });
+    co_return res;
+  }
+
+  rex::Coroutine<s32> add_three_async(s32 x, s32 y, s32 z)
+  {
+    const s32 xy = co_await add_async(x, y);
+    const s32 xyz = co_await add_async(xy, z);
+    co_return xyz;
+  }
+
+  // Read a file without blocking, the coroutine is resumed on the task system once the file is read
+  rex::Coroutine<rsl::string> read_file_coroutine(rex::MountingPoint root, rsl::string_view filepath)
+  {
+    const rex::ReadRequest request = co_await rex::vfs::instance()->read_file_async(root, filepath);
+    co_return rsl::string(rsl::string_view(rex::char_cast(request.data()), rex::narrow_cast<s32>(request.count().size_in_bytes())));
+  }
+
+  rex::Coroutine<void> count_frames(s32 numFrames, s32& counter)
+  {
+    for (s32 i = 0; i < numFrames; ++i)
+    {
+      co_await rex::next_frame();
+      ++counter;
+    }
+  }
+}
+
+TEST_CASE("TEST - Coroutine - Await Task")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  auto coroutine = add_async(1, 2);
+  wait_for_coroutine(coroutine);
+
+  REX_CHECK(coroutine.result() == 3);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Coroutine - Await Coroutine")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  auto coroutine = add_three_async(1, 2, 3);
+  wait_for_coroutine(coroutine);
+
+  REX_CHECK(coroutine.result() == 6);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Coroutine - Await Read Request")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+  rex::vfs::init(rex::globals::make_unique<rex::NativeFileSystem>(rex::path::cwd()));
+  rex::vfs::instance()->mount(rex::MountingPoint::TestPath1, "vfs_tests");
+
+  auto coroutine = read_file_coroutine(rex::MountingPoint::TestPath1, "vfs_test_file.txt");
+  wait_for_coroutine(coroutine);
+  REX_CHECK(coroutine.result() == "this is a test file");
+
+  // A file that doesn't exist resumes the coroutine as well, with an empty request
+  auto missing_file_coroutine = read_file_coroutine(rex::MountingPoint::TestPath1, "vfs_file_that_doesnt_exist.txt");
+  wait_for_coroutine(missing_file_coroutine);
+  REX_CHECK(missing_file_coroutine.result().empty());
+
+  rex::vfs::shutdown();
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Coroutine - Next Frame")
+{
+  s32 counter = 0;
+  auto coroutine = count_frames(3, counter);
+
+  // The coroutine suspends until it's resumed at the start of the next frame
+  REX_CHECK(counter == 0);
+  REX_CHECK(rex::task_system::num_frame_waiters() == 1);
+
+  rex::task_system::resume_frame_waiters();
+  REX_CHECK(counter == 1);
+  rex::task_system::resume_frame_waiters();
+  REX_CHECK(counter == 2);
+  REX_CHECK(!coroutine.is_finished());
+  rex::task_system::resume_frame_waiters();
+  REX_CHECK(counter == 3);
+  REX_CHECK(coroutine.is_finished());
+  REX_CHECK(rex::task_system::num_frame_waiters() == 0);
+}
+
+TEST_CASE("TEST - Coroutine - Detach")
+{
+  // A detached coroutine keeps running and destroys itself when it finishes
+  s32 counter = 0;
+  count_frames(2, counter).detach();
+  REX_CHECK(rex::task_system::num_frame_waiters() == 1);
+
+  rex::task_system::resume_frame_waiters();
+  REX_CHECK(counter == 1);
+  rex::task_system::resume_frame_waiters();
+  REX_CHECK(counter == 2);
+  REX_CHECK(rex::task_system::num_frame_waiters() == 0);
+
+  // Dropping a coroutine before it finished detaches it as well, instead of destroying it while it's waiting
+  {
+    auto coroutine = count_frames(1, counter);
+    REX_CHECK(!coroutine.is_finished());
+  }
+  REX_CHECK(rex::task_system::num_frame_waiters() == 1);
+  rex::task_system::resume_frame_waiters();
+  REX_CHECK(counter == 3);
+
+  // Detaching a finished coroutine destroys it right away
+  auto finished_coroutine = count_frames(0, counter);
+  REX_CHECK(finished_coroutine.is_finished());
+  finished_coroutine.detach();
+}
+
+#endif
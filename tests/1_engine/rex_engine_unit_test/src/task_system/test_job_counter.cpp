@@ -0,0 +1,79 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/task_system/job_counter.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/atomic.h"
+
+TEST_CASE("TEST - Job Counter - Chain")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  rsl::atomic<s32> x = 0;
+
+  auto first = rex::run_async([&x]() { x += 1; });
+  auto second = rex::run_async_after(first, [&x]() { x *= 10; });
+  auto third = rex::run_async_after(second, [&x]() { return x.load() + 1; });
+
+  REX_CHECK(third.result() == 11);
+  REX_CHECK(first.is_finished());
+  REX_CHECK(second.is_finished());
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Job Counter - Fan In")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  constexpr s32 num_jobs = 100;
+  rsl::atomic<s32> x = 0;
+
+  rex::task_system::JobCounter counter;
+  for (s32 i = 0; i < num_jobs; ++i)
+  {
+    counter.add(rex::run_async([&x]() { x += 1; }));
+  }
+
+  auto sum = rex::run_async_after(counter, [&x]() { return x.load(); });
+
+  REX_CHECK(sum.result() == num_jobs);
+  REX_CHECK(counter.is_finished());
+  REX_CHECK(counter.num_pending() == 0);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Job Counter - Finished Dependency")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  rsl::atomic<s32> x = 0;
+
+  auto first = rex::run_async([&x]() { x += 1; });
+  first.wait_for_me();
+
+  // The dependency has finished already, so the job gets queued immediately
+  auto second = rex::run_async_after(first, [&x]() { x += 1; });
+  second.wait_for_me();
+
+  REX_CHECK(x == 2);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Job Counter - Empty")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  rex::task_system::JobCounter counter;
+  REX_CHECK(counter.is_finished());
+
+  // A job without dependencies gets queued immediately
+  auto task = rex::run_async_after(counter, []() { return 5; });
+  REX_CHECK(task.result() == 5);
+
+  rex::thread_pool::shutdown();
+}
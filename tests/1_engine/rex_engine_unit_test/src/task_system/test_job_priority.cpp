@@ -0,0 +1,160 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/task_system/internal/task_system_limits.h"
+#include "rex_engine/threading/thread_pool.h"
+#include "rex_engine/profiling/timer.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/atomic.h"
+#include "rex_std/chrono.h"
+#include "rex_std/thread.h"
+#include "rex_std/vector.h"
+
+TEST_CASE("TEST - Job Priority - Higher Priority First")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(1));
+
+  // Block the only worker, so that all jobs below are pending at the same time
+  rsl::atomic<bool> release_worker = false;
+  auto blocker = rex::run_async([&release_worker]()
+    {
+      while (!release_worker)
+      {
+        rsl::this_thread::yield();
+      }
+    });
+
+  rsl::vector<rex::task_system::JobPriority> execution_order;
+  execution_order.reserve(4);
+  auto background = rex::run_async(rex::task_system::JobPriority::Background, [&]() { execution_order.push_back(rex::task_system::JobPriority::Background); });
+  auto normal = rex::run_async(rex::task_system::JobPriority::Normal, [&]() { execution_order.push_back(rex::task_system::JobPriority::Normal); });
+  auto frame_critical = rex::run_async(rex::task_system::JobPriority::FrameCritical, [&]() { execution_order.push_back(rex::task_system::JobPriority::FrameCritical); });
+
+  release_worker = true;
+  blocker.wait_for_me();
+  background.wait_for_me();
+  normal.wait_for_me();
+  frame_critical.wait_for_me();
+
+  REX_CHECK(execution_order.size() == 3);
+  REX_CHECK(execution_order[0] == rex::task_system::JobPriority::FrameCritical);
+  REX_CHECK(execution_order[1] == rex::task_system::JobPriority::Normal);
+  REX_CHECK(execution_order[2] == rex::task_system::JobPriority::Background);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Job Priority - Frame Critical Latency")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(2));
+
+  // Queue more bulk work than the workers could get through in the time we allow for the frame critical job
+  constexpr s32 num_background_jobs = 100;
+  rsl::atomic<s32> num_background_jobs_finished = 0;
+  rsl::vector<rex::task_system::Task<void>> background_tasks;
+  background_tasks.reserve(num_background_jobs);
+  for (s32 i = 0; i < num_background_jobs; ++i)
+  {
+    background_tasks.push_back(rex::run_async(rex::task_system::JobPriority::Background, [&num_background_jobs_finished]()
+      {
+        rsl::this_thread::sleep_for(rsl::chrono::milliseconds(5));
+        ++num_background_jobs_finished;
+      }));
+  }
+
+  // A worker is always kept free of background work, so the frame critical job starts right away
+  f32 latency_ms = 0.0f;
+  const rex::Timer timer("frame critical latency");
+  auto frame_critical = rex::run_async(rex::task_system::JobPriority::FrameCritical, [&timer, &latency_ms]() { latency_ms = timer.elapsed_ms(); });
+  frame_critical.wait_for_me();
+
+  REX_CHECK(latency_ms < 50.0f);
+  REX_CHECK(num_background_jobs_finished < num_background_jobs);
+
+  // The background work isn't starved either, it all finishes eventually
+  for (rex::task_system::Task<void>& task : background_tasks)
+  {
+    task.wait_for_me();
+  }
+  REX_CHECK(num_background_jobs_finished == num_background_jobs);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Job Priority - Background Jobs Are Not Starved")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(1));
+
+  // Block the only worker, so that all jobs below are pending at the same time
+  rsl::atomic<bool> worker_blocked = false;
+  rsl::atomic<bool> release_worker = false;
+  auto blocker = rex::run_async([&worker_blocked, &release_worker]()
+    {
+      worker_blocked = true;
+      while (!release_worker)
+      {
+        rsl::this_thread::yield();
+      }
+    });
+  while (!worker_blocked)
+  {
+    rsl::this_thread::yield();
+  }
+
+  constexpr s32 num_background_jobs = 3;
+  constexpr s32 normal_picks_per_background = rex::task_system::internal::g_max_normal_picks_over_background;
+  constexpr s32 num_normal_jobs = num_background_jobs * normal_picks_per_background;
+
+  rsl::vector<rex::task_system::JobPriority> execution_order;
+  execution_order.reserve(num_background_jobs + num_normal_jobs);
+  rsl::vector<rex::task_system::Task<void>> tasks;
+  tasks.reserve(num_background_jobs + num_normal_jobs);
+  for (s32 i = 0; i < num_background_jobs; ++i)
+  {
+    tasks.push_back(rex::run_async(rex::task_system::JobPriority::Background, [&]() { execution_order.push_back(rex::task_system::JobPriority::Background); }));
+  }
+  for (s32 i = 0; i < num_normal_jobs; ++i)
+  {
+    tasks.push_back(rex::run_async(rex::task_system::JobPriority::Normal, [&]() { execution_order.push_back(rex::task_system::JobPriority::Normal); }));
+  }
+
+  release_worker = true;
+  blocker.wait_for_me();
+  for (rex::task_system::Task<void>& task : tasks)
+  {
+    task.wait_for_me();
+  }
+
+  // Every background job goes after a fixed number of normal jobs got picked over it
+  REX_CHECK(execution_order.size() == num_background_jobs + num_normal_jobs);
+  for (count_t idx = 0; idx < execution_order.size(); ++idx)
+  {
+    const bool is_background_turn = (idx + 1) % (normal_picks_per_background + 1) == 0;
+    REX_CHECK(execution_order[idx] == (is_background_turn ? rex::task_system::JobPriority::Background : rex::task_system::JobPriority::Normal));
+  }
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Job Priority - Main Thread Jobs")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  rsl::atomic<s32> x = 0;
+  auto task = rex::run_on_main_thread([&x]() { x += 1; return 5; });
+
+  // Workers never pick up main thread jobs
+  rsl::this_thread::sleep_for(rsl::chrono::milliseconds(10));
+  REX_CHECK(x == 0);
+  REX_CHECK(!task.is_finished());
+
+  REX_CHECK(rex::task_system::run_main_thread_jobs() == 1);
+  REX_CHECK(x == 1);
+  REX_CHECK(task.result() == 5);
+
+  // Nothing left to execute
+  REX_CHECK(rex::task_system::run_main_thread_jobs() == 0);
+
+  rex::thread_pool::shutdown();
+}
@@ -0,0 +1,98 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/task_system/parallel_for.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/atomic.h"
+#include "rex_std/string.h"
+#include "rex_std/vector.h"
+
+TEST_CASE("TEST - Parallel For - Every Index Once")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  constexpr s32 count = 10000;
+  rsl::vector<s32> values;
+  values.resize(count);
+
+  rex::parallel_for({0, count}, 0, [&values](s32 idx) { values[idx] += idx; });
+
+  for (s32 idx = 0; idx < count; ++idx)
+  {
+    REX_CHECK(values[idx] == idx);
+  }
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Parallel For - Grain Size")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  rsl::atomic<s32> x = 0;
+
+  // Range that doesn't start at 0 and doesn't split evenly into chunks
+  rex::parallel_for({10, 1011}, 7, [&x](s32 idx) { x += idx; });
+  s32 expected = 0;
+  for (s32 idx = 10; idx < 1011; ++idx)
+  {
+    expected += idx;
+  }
+  REX_CHECK(x == expected);
+
+  // Empty ranges don't call the callable
+  x = 0;
+  rex::parallel_for({5, 5}, 0, [&x](s32) { x += 1; });
+  rex::parallel_for({5, 0}, 0, [&x](s32) { x += 1; });
+  REX_CHECK(x == 0);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Parallel For - Nested")
+{
+  // Running a parallel for from within a job shouldn't stall the task system
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(2));
+
+  rsl::atomic<s32> x = 0;
+  rex::parallel_for({0, 16}, 1, [&x](s32)
+    {
+      rex::parallel_for({0, 100}, 10, [&x](s32) { x += 1; });
+    });
+
+  REX_CHECK(x == 1600);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Parallel Reduce - Sum")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  constexpr s32 count = 10000;
+  const s64 sum = rex::parallel_reduce({0, count}, 0, s64(0), [](s32 idx) { return static_cast<s64>(idx); }, [](s64 lhs, s64 rhs) { return lhs + rhs; });
+
+  REX_CHECK(sum == static_cast<s64>(count) * (count - 1) / 2);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Parallel Reduce - Order Is Kept")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  // String concatenation isn't commutative, so the chunks need to be combined in order
+  const rsl::string result = rex::parallel_reduce({0, 26}, 3, rsl::string(""),
+    [](s32 idx)
+    {
+      rsl::string letter;
+      letter.push_back(static_cast<char8>('a' + idx));
+      return letter;
+    },
+    [](const rsl::string& lhs, const rsl::string& rhs) { return lhs + rhs; });
+
+  REX_CHECK(result == "abcdefghijklmnopqrstuvwxyz");
+
+  rex::thread_pool::shutdown();
+}
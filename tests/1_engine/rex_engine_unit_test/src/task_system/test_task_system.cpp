@@ -1,10 +1,15 @@
 #include "rex_unit_test/rex_catch2.h"
 
+#include "rex_engine/memory/memory_stats.h"
+#include "rex_engine/task_system/internal/job_pool.h"
 #include "rex_engine/task_system/task_system.h"
 #include "rex_engine/threading/thread_pool.h"
 
 #include "rex_engine/engine/types.h"
+#include "rex_std/array.h"
 #include "rex_std/atomic.h"
+#include "rex_std/string.h"
+#include "rex_std/vector.h"
 
 TEST_CASE("TEST - Task System - Execution")
 {
@@ -27,4 +32,167 @@ TEST_CASE("TEST - Task System - Execution")
   REX_CHECK(x == 5);
 
   rex::thread_pool::shutdown();
-}
\ No newline at end of file
+}
+
+TEST_CASE("TEST - Task System - Result")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  auto task = rex::run_async([]() { return 5; });
+
+  REX_CHECK(task.result() == 5);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Task System - Many Jobs")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  constexpr s32 num_jobs = 10000;
+  rsl::atomic<s32> x = 0;
+
+  rsl::vector<rex::task_system::Task<void>> tasks;
+  tasks.reserve(num_jobs);
+  for (s32 i = 0; i < num_jobs; ++i)
+  {
+    tasks.push_back(rex::run_async([&x]() { x += 1; }));
+  }
+
+  for (rex::task_system::Task<void>& task : tasks)
+  {
+    task.wait_for_me();
+  }
+
+  REX_CHECK(x == num_jobs);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Task System - Jobs Queued From Jobs")
+{
+  // Jobs queued from within a job end up in the deque of the worker running it
+  // the other workers need to steal them to execute them
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  constexpr s32 num_jobs = 1000;
+  rsl::atomic<s32> x = 0;
+
+  rsl::vector<rex::task_system::Task<void>> tasks;
+  tasks.reserve(num_jobs);
+
+  auto spawner = rex::run_async([&x, &tasks]()
+    {
+      for (s32 i = 0; i < num_jobs; ++i)
+      {
+        tasks.push_back(rex::run_async([&x]() { x += 1; }));
+      }
+    });
+
+  spawner.wait_for_me();
+  for (rex::task_system::Task<void>& task : tasks)
+  {
+    task.wait_for_me();
+  }
+
+  REX_CHECK(x == num_jobs);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Task System - Single Thread")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(1));
+
+  constexpr s32 num_jobs = 1000;
+  rsl::atomic<s32> x = 0;
+
+  rsl::vector<rex::task_system::Task<void>> tasks;
+  tasks.reserve(num_jobs);
+  for (s32 i = 0; i < num_jobs; ++i)
+  {
+    tasks.push_back(rex::run_async([&x]() { x += 1; }));
+  }
+
+  for (rex::task_system::Task<void>& task : tasks)
+  {
+    task.wait_for_me();
+  }
+
+  REX_CHECK(x == num_jobs);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Task System - Non Trivial Result")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  // The result is constructed in place, so it doesn't need to be trivially copyable
+  auto task = rex::run_async([]() { return rsl::string("this string is too long for the small string optimization"); });
+
+  REX_CHECK(task.result() == "this string is too long for the small string optimization");
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Task System - Big Callable")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  // Callables that don't fit in the job fall back to a heap allocation
+  rsl::array<s32, 256> values {};
+  values[0] = 1;
+  values[255] = 2;
+
+  auto task = rex::run_async([values]() { return values[0] + values[255]; });
+
+  REX_CHECK(task.result() == 3);
+
+  rex::thread_pool::shutdown();
+}
+
+TEST_CASE("TEST - Task System - No Allocations On Submit")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  constexpr s32 num_jobs = 1000;
+  rsl::atomic<s32> x = 0;
+
+  rsl::vector<rex::task_system::Task<void>> tasks;
+  tasks.reserve(num_jobs);
+
+  auto submit_jobs = [&]()
+  {
+    for (s32 i = 0; i < num_jobs; ++i)
+    {
+      tasks.push_back(rex::run_async([&x]() { x += 1; }));
+    }
+    for (rex::task_system::Task<void>& task : tasks)
+    {
+      task.wait_for_me();
+    }
+    tasks.clear();
+  };
+
+  // The first burst warms up the job pool and the job deques
+  submit_jobs();
+  const s32 num_pooled_jobs = rex::task_system::internal::job_pool().num_allocated_jobs();
+#ifdef REX_ENABLE_MEM_TRACKING
+  const rex::MemoryAllocationStats stats_before = rex::query_mem_tracking_stats();
+#endif
+
+  // Any burst after that should be able to recycle the jobs of the previous one
+  submit_jobs();
+
+  // The job pool doesn't grow and submitting didn't allocate anything
+  REX_CHECK(x == num_jobs * 2);
+  REX_CHECK(rex::task_system::internal::job_pool().num_allocated_jobs() == num_pooled_jobs);
+#ifdef REX_ENABLE_MEM_TRACKING
+  const rex::MemoryAllocationStats stats_after = rex::query_mem_tracking_stats();
+  REX_CHECK(stats_after.num_total_allocations == stats_before.num_total_allocations);
+  REX_CHECK(stats_after.num_alive_allocations == stats_before.num_alive_allocations);
+#endif
+
+  rex::thread_pool::shutdown();
+}
@@ -0,0 +1,135 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/threading/thread_pool.h"
+#include "rex_engine/system/system_info.h"
+#include "rex_engine/profiling/timer.h"
+#include "rex_engine/diagnostics/log.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_engine/threading/thread_event.h"
+#include "rex_std/atomic.h"
+#include "rex_std/chrono.h"
+#include "rex_std/thread.h"
+#include "rex_std/vector.h"
+
+// Benchmarks are hidden by default as they take a while to run
+// run them explicitly by passing "[benchmark]" on the commandline
+
+DEFINE_LOG_CATEGORY(LogTaskSystemBenchmark);
+
+namespace
+{
+  // Submits a burst of small jobs, the way a frame would, and returns the number of jobs executed per second
+  f32 measure_jobs_per_second(s32 numThreads, s32 numJobs)
+  {
+    rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(numThreads));
+
+    rsl::atomic<s32> x = 0;
+    rsl::vector<rex::task_system::Task<void>> tasks;
+    tasks.reserve(numJobs);
+
+    rex::Timer timer("task system benchmark");
+    for (s32 i = 0; i < numJobs; ++i)
+    {
+      tasks.push_back(rex::run_async([&x]() { x += 1; }));
+    }
+    for (rex::task_system::Task<void>& task : tasks)
+    {
+      task.wait_for_me();
+    }
+    const f32 elapsed_seconds = timer.elapsed_seconds();
+
+    REX_CHECK(x == numJobs);
+
+    rex::thread_pool::shutdown();
+
+    return static_cast<f32>(numJobs) / elapsed_seconds;
+  }
+
+  // The number of times a latency gets measured, the average is reported
+  constexpr s32 g_num_latency_samples = 1000;
+
+  // Submits a single job at a time and returns the average time in microseconds between submitting the job and it starting
+  // We sleep between jobs, so the workers have run out of work and need to get woken up every time
+  f32 measure_submit_to_start_latency()
+  {
+    f32 total_latency_ms = 0.0f;
+    for (s32 i = 0; i < g_num_latency_samples; ++i)
+    {
+      rsl::this_thread::sleep_for(rsl::chrono::microseconds(200));
+
+      f32 latency_ms = 0.0f;
+      const rex::Timer timer("submit to start");
+      auto task = rex::run_async([&timer, &latency_ms]() { latency_ms = timer.elapsed_ms(); });
+      task.wait_for_me();
+
+      total_latency_ms += latency_ms;
+    }
+
+    return total_latency_ms * 1000.0f / static_cast<f32>(g_num_latency_samples);
+  }
+
+  // Performs the handshake the task system used to do for every burst of jobs
+  // acquire an idle thread from the pool, hand it the work and wait for it to start.
+  // Returns the average time in microseconds between acquiring the thread and the work starting
+  f32 measure_thread_handoff_latency()
+  {
+    rex::ThreadPool pool(1);
+
+    f32 total_latency_ms = 0.0f;
+    for (s32 i = 0; i < g_num_latency_samples; ++i)
+    {
+      rsl::this_thread::sleep_for(rsl::chrono::microseconds(200));
+
+      f32 latency_ms = 0.0f;
+      rex::ThreadEvent started_event;
+      rex::ThreadEvent finished_event;
+      const rex::Timer timer("thread handoff");
+      {
+        rex::ThreadHandle thread = pool.acquire_idle_thread();
+        thread.run([&](void*)
+          {
+            latency_ms = timer.elapsed_ms();
+            started_event.signal();
+            finished_event.signal();
+            return 0;
+          });
+        started_event.wait_for_me();
+      }
+      finished_event.wait_for_me();
+
+      total_latency_ms += latency_ms;
+    }
+
+    return total_latency_ms * 1000.0f / static_cast<f32>(g_num_latency_samples);
+  }
+}
+
+TEST_CASE("TEST - Task System - Benchmark - Jobs Per Second", "[.][benchmark]")
+{
+  constexpr s32 num_jobs = 10000;
+  const s32 max_num_threads = rex::sys_info::num_logical_processors();
+
+  for (s32 num_threads = 1; num_threads <= max_num_threads; ++num_threads)
+  {
+    const f32 jobs_per_second = measure_jobs_per_second(num_threads, num_jobs);
+    REX_INFO(LogTaskSystemBenchmark, "{} threads: {} jobs/sec", num_threads, jobs_per_second);
+  }
+}
+
+TEST_CASE("TEST - Task System - Benchmark - Submit To Start Latency", "[.][benchmark]")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>());
+
+  // Warm up the workers so their start up isn't part of the measurement
+  rex::run_async([]() {}).wait_for_me();
+
+  const f32 worker_latency_us = measure_submit_to_start_latency();
+  REX_INFO(LogTaskSystemBenchmark, "Persistent workers: {} us from submit to start", worker_latency_us);
+
+  rex::thread_pool::shutdown();
+
+  const f32 handoff_latency_us = measure_thread_handoff_latency();
+  REX_INFO(LogTaskSystemBenchmark, "Thread handle handoff: {} us from submit to start", handoff_latency_us);
+}
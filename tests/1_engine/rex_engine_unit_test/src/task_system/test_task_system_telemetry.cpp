@@ -0,0 +1,72 @@
+#include "rex_unit_test/rex_catch2.h"
+
+#include "rex_engine/task_system/task_system.h"
+#include "rex_engine/task_system/task_system_telemetry.h"
+#include "rex_engine/threading/thread_pool.h"
+
+#include "rex_engine/engine/types.h"
+#include "rex_std/vector.h"
+
+TEST_CASE("TEST - Task System Telemetry - Jobs Are Counted")
+{
+  rex::task_system::reset_telemetry();
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(2));
+
+  constexpr s32 num_jobs = 100;
+  rsl::vector<rex::task_system::Task<void>> tasks;
+  tasks.reserve(num_jobs);
+  for (s32 i = 0; i < num_jobs; ++i)
+  {
+    tasks.push_back(rex::run_async([]() {}));
+  }
+
+  for (rex::task_system::Task<void>& task : tasks)
+  {
+    task.wait_for_me();
+  }
+
+  // A job is recorded after it finished, shutting down the pool makes sure all workers are done recording
+  tasks.clear();
+  rex::thread_pool::shutdown();
+
+  const rex::task_system::TaskSystemTelemetry telemetry = rex::task_system::query_telemetry();
+
+  s64 num_jobs_executed = telemetry.external.num_jobs_executed;
+  for (const rex::task_system::WorkerTelemetry& worker : telemetry.workers)
+  {
+    num_jobs_executed += worker.num_jobs_executed;
+  }
+
+  REX_CHECK(num_jobs_executed == num_jobs);
+  REX_CHECK(telemetry.submit_to_start.num_samples() == num_jobs);
+  REX_CHECK(telemetry.start_to_finish.num_samples() == num_jobs);
+  REX_CHECK(telemetry.max_queue_depth > 0);
+}
+
+TEST_CASE("TEST - Task System Telemetry - Reset")
+{
+  rex::thread_pool::init(rex::globals::make_unique<rex::ThreadPool>(1));
+  rex::run_async([]() {}).wait_for_me();
+  rex::thread_pool::shutdown();
+
+  rex::task_system::reset_telemetry();
+  const rex::task_system::TaskSystemTelemetry telemetry = rex::task_system::query_telemetry();
+
+  REX_CHECK(telemetry.workers.empty());
+  REX_CHECK(telemetry.external.num_jobs_executed == 0);
+  REX_CHECK(telemetry.submit_to_start.num_samples() == 0);
+  REX_CHECK(telemetry.max_queue_depth == 0);
+}
+
+TEST_CASE("TEST - Task System Telemetry - Histogram Percentiles")
+{
+  rex::task_system::LatencyHistogram histogram {};
+  REX_CHECK(histogram.percentile_upper_bound_us(0.5f) == 0);
+
+  histogram.counts[0] = 90;
+  histogram.counts[4] = 10;
+
+  REX_CHECK(histogram.num_samples() == 100);
+  REX_CHECK(histogram.percentile_upper_bound_us(0.5f) == 1);
+  REX_CHECK(histogram.percentile_upper_bound_us(0.99f) == 16);
+}
@@ -41,8 +41,8 @@ public:
     if (rex::engine::instance() == nullptr)
     {
       s64 size = 1_kib;
-      auto single_frame_allocator = rsl::make_unique<rex::TStackAllocator<rex::GlobalAllocator>>(size);
-      auto scratch_allocator = rsl::make_unique<rex::TCircularAllocator<rex::GlobalAllocator>>(size);
+      auto single_frame_allocator = rsl::make_unique<rex::FrameAllocator>(size);
+      auto scratch_allocator = rsl::make_unique<rex::EngineGlobals::ScratchAllocator>(size);
 
       rex::engine::init(rex::globals::make_unique<rex::EngineGlobals>(rsl::move(scratch_allocator), rsl::move(single_frame_allocator)));
     }